@@ -0,0 +1,134 @@
+/**
+ * @file type_converter_benchmark.cpp
+ * @brief Compares the TypeConverter conversions with the standard library ones
+ *        they replaced, and the typed get/set throughput of IniParser.
+ *
+ * Usage: type_converter_benchmark [iterations]
+ */
+
+#include "IniParser.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Keeps results alive so the optimizer cannot drop the measured work
+    volatile double g_sink = 0.0;
+
+    template <typename Fn>
+    void measure(char const *name, size_t operations, Fn fn)
+    {
+        auto begin = Clock::now();
+        fn();
+        double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        std::printf("  %-34s %9.1f ns/op\n", name, seconds * 1e9 / static_cast<double>(operations));
+    }
+
+    std::vector<double> makeDoubles(size_t count)
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> scale(-1e6, 1e6);
+        std::vector<double> values;
+        values.reserve(count);
+        for (size_t i = 0; i < count; i++)
+            values.push_back(i % 4 == 0 ? static_cast<double>(rng() % 10000) / 100.0 : scale(rng));
+        return values;
+    }
+
+    // How many values survive toString -> fromString unchanged
+    template <typename Format, typename Parse>
+    size_t countRoundTrips(std::vector<double> const &values, Format format, Parse parse)
+    {
+        size_t exact = 0;
+        for (double value : values)
+            exact += parse(format(value)) == value;
+        return exact;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    size_t const iterations = argc > 1 ? static_cast<size_t>(std::strtoul(argv[1], nullptr, 10)) : 200000;
+
+    std::vector<double> doubles = makeDoubles(iterations);
+    std::vector<std::string> doubleTexts;
+    std::vector<std::string> intTexts;
+    doubleTexts.reserve(iterations);
+    intTexts.reserve(iterations);
+    for (size_t i = 0; i < iterations; i++)
+    {
+        doubleTexts.push_back(ini::detail::TypeConverter<double>::toString(doubles[i]));
+        intTexts.push_back(std::to_string(static_cast<int>(i * 7919 % 1000003) - 500000));
+    }
+
+    std::printf("Conversions (%zu values):\n", iterations);
+    measure("std::stoi", iterations, [&] {
+        long sum = 0;
+        for (auto const &text : intTexts)
+            sum += std::stoi(text);
+        g_sink = static_cast<double>(sum);
+    });
+    measure("TypeConverter<int>::fromString", iterations, [&] {
+        long sum = 0;
+        for (auto const &text : intTexts)
+            sum += ini::detail::TypeConverter<int>::fromString(text);
+        g_sink = static_cast<double>(sum);
+    });
+    measure("std::stod", iterations, [&] {
+        double sum = 0.0;
+        for (auto const &text : doubleTexts)
+            sum += std::stod(text);
+        g_sink = sum;
+    });
+    measure("TypeConverter<double>::fromString", iterations, [&] {
+        double sum = 0.0;
+        for (auto const &text : doubleTexts)
+            sum += ini::detail::TypeConverter<double>::fromString(text);
+        g_sink = sum;
+    });
+    measure("std::to_string(double)", iterations, [&] {
+        size_t length = 0;
+        for (double value : doubles)
+            length += std::to_string(value).size();
+        g_sink = static_cast<double>(length);
+    });
+    measure("TypeConverter<double>::toString", iterations, [&] {
+        size_t length = 0;
+        for (double value : doubles)
+            length += ini::detail::TypeConverter<double>::toString(value).size();
+        g_sink = static_cast<double>(length);
+    });
+
+    size_t oldExact = countRoundTrips(
+        doubles, [](double value) { return std::to_string(value); },
+        [](std::string const &text) { return std::stod(text); });
+    size_t newExact = countRoundTrips(
+        doubles, [](double value) { return ini::detail::TypeConverter<double>::toString(value); },
+        [](std::string const &text) { return ini::detail::TypeConverter<double>::fromString(text); });
+    std::printf("\nExact round trips: std::to_string/std::stod %zu of %zu, TypeConverter %zu of %zu\n", oldExact,
+                iterations, newExact, iterations);
+
+    // Typed access through the wrapper, one key rewritten and read back per value
+    size_t const accesses = iterations < 100000 ? iterations : 100000;
+    ini::IniParser parser;
+    std::printf("\nIniParser typed access (%zu operations):\n", accesses);
+    measure("set<double>", accesses, [&] {
+        for (size_t i = 0; i < accesses; i++)
+            parser.set<double>("bench", "value", doubles[i]);
+    });
+    measure("get<double>", accesses, [&] {
+        double sum = 0.0;
+        for (size_t i = 0; i < accesses; i++)
+            sum += parser.get<double>("bench", "value");
+        g_sink = sum;
+    });
+
+    return newExact == iterations ? EXIT_SUCCESS : EXIT_FAILURE;
+}
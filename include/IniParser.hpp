@@ -1,7 +1,10 @@
 #ifndef INI_PARSER_HPP
 #define INI_PARSER_HPP
 
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -13,6 +16,7 @@
 // Include C headers
 extern "C"
 {
+#include "ini_number.h"
 #include "ini_parser.h"
 #include "ini_status.h"
 }
@@ -143,39 +147,77 @@ namespace ini
             static std::string toString(std::string const &value) { return value; }
         };
 
+        // Integers go through the locale-independent C parser, then get range-checked
+        template <typename T>
+        T parseInteger(std::string const &str)
+        {
+            int64_t value = 0;
+            if (ini_parse_int64(str.c_str(), &value) != INI_STATUS_SUCCESS)
+                throw std::invalid_argument("Invalid integer value: " + str);
+            if (value < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+                value > static_cast<int64_t>(std::numeric_limits<T>::max()))
+                throw std::out_of_range("Integer value out of range: " + str);
+            return static_cast<T>(value);
+        }
+
+        inline double parseDouble(std::string const &str)
+        {
+            double value = 0.0;
+            if (ini_parse_double(str.c_str(), &value) != INI_STATUS_SUCCESS)
+                throw std::invalid_argument("Invalid floating-point value: " + str);
+            return value;
+        }
+
         template <>
         struct TypeConverter<int>
         {
-            static int fromString(std::string const &str) { return std::stoi(str); }
+            static int fromString(std::string const &str) { return parseInteger<int>(str); }
             static std::string toString(int const &value) { return std::to_string(value); }
         };
 
         template <>
         struct TypeConverter<long>
         {
-            static long fromString(std::string const &str) { return std::stol(str); }
+            static long fromString(std::string const &str) { return parseInteger<long>(str); }
             static std::string toString(long const &value) { return std::to_string(value); }
         };
 
         template <>
         struct TypeConverter<long long>
         {
-            static long long fromString(std::string const &str) { return std::stoll(str); }
+            static long long fromString(std::string const &str) { return parseInteger<long long>(str); }
             static std::string toString(long long const &value) { return std::to_string(value); }
         };
 
+        // Floating-point values are written in the shortest form that reads back exactly
         template <>
         struct TypeConverter<float>
         {
-            static float fromString(std::string const &str) { return std::stof(str); }
-            static std::string toString(float const &value) { return std::to_string(value); }
+            static float fromString(std::string const &str)
+            {
+                double value = parseDouble(str);
+                if (std::isfinite(value) && std::fabs(value) > std::numeric_limits<float>::max())
+                    throw std::out_of_range("Floating-point value out of range: " + str);
+                return static_cast<float>(value);
+            }
+
+            static std::string toString(float const &value)
+            {
+                char buffer[INI_NUMBER_BUFFER_SIZE];
+                return std::string(buffer, ini_format_float(value, buffer));
+            }
         };
 
         template <>
         struct TypeConverter<double>
         {
-            static double fromString(std::string const &str) { return std::stod(str); }
-            static std::string toString(double const &value) { return std::to_string(value); }
+            static double fromString(std::string const &str) { return parseDouble(str); }
+
+            static std::string toString(double const &value)
+            {
+                char buffer[INI_NUMBER_BUFFER_SIZE];
+                return std::string(buffer, ini_format_double(value, buffer));
+            }
         };
 
         template <>
@@ -183,11 +225,10 @@ namespace ini
         {
             static bool fromString(std::string const &str)
             {
-                if (str == "true" || str == "1" || str == "yes" || str == "on")
-                    return true;
-                if (str == "false" || str == "0" || str == "no" || str == "off")
-                    return false;
-                throw std::invalid_argument("Invalid boolean value: " + str);
+                int value = 0;
+                if (ini_parse_bool(str.c_str(), &value) != INI_STATUS_SUCCESS)
+                    throw std::invalid_argument("Invalid boolean value: " + str);
+                return value != 0;
             }
 
             static std::string toString(const bool &value) { return value ? "true" : "false"; }
@@ -209,6 +250,18 @@ public:
         using SectionMap = std::unordered_map<std::string, std::string>;
         using DataMap = std::unordered_map<std::string, SectionMap>;
 
+        /**
+         * @brief One change applied by reload()
+         */
+        struct Change
+        {
+            ini_change_kind_t kind; ///< Added, removed or modified
+            std::string section;    ///< Section name
+            std::string key;        ///< Key name (empty if wholeSection)
+            bool wholeSection;      ///< The section itself was added or removed
+        };
+        using ChangeList = std::vector<Change>;
+
         // ==================== Constructors ====================
 
         /**
@@ -269,6 +322,30 @@ public:
          */
         ini_status_t loadNoThrow(std::string const &filepath) noexcept;
 
+        /**
+         * @brief Loads and merges every matching file of a directory
+         *
+         * Files are parsed concurrently and merged in lexical order, so later
+         * files override keys of earlier ones (see ini_load_dir()).
+         *
+         * @param dirpath Directory to scan
+         * @param pattern File name pattern with `*` and `?`
+         * @throws FileException if the directory or any file cannot be loaded
+         */
+        void loadDirectory(std::string const &dirpath, std::string const &pattern = "*.ini");
+
+        /**
+         * @brief Reloads a changed INI file, patching only what differs
+         *
+         * Unlike load(), the cached data is updated in place instead of being
+         * rebuilt, so reloading a large file with a few edits stays cheap.
+         *
+         * @param filepath Path to INI file (the one previously loaded)
+         * @return Changes applied (empty if the file did not change)
+         * @throws FileException if reloading fails
+         */
+        ChangeList reload(std::string const &filepath);
+
         /**
          * @brief Saves to INI file
          * @param filepath Path to save to
@@ -276,6 +353,38 @@ public:
          */
         void save(std::string const &filepath) const;
 
+        /**
+         * @brief Returns the text save() would write, without touching the filesystem
+         * @throws IniException if the data cannot be rendered
+         */
+        std::string saveToString() const;
+
+        /**
+         * @brief Writes only the values set since the last load or save
+         *
+         * Rewrites the lines of the changed keys in the existing file and
+         * copies everything else unchanged; does nothing if no value was set.
+         * A missing file is written in full.
+         *
+         * @param filepath File the data was loaded from or last saved to
+         * @throws FileException if saving fails
+         */
+        void saveIncremental(std::string const &filepath);
+
+        /**
+         * @brief Saves a compiled binary image of the data
+         * @param filepath Path to save to
+         * @throws FileException if saving fails
+         */
+        void saveBinary(std::string const &filepath) const;
+
+        /**
+         * @brief Loads a binary image written by saveBinary() without parsing
+         * @param filepath Path to the image
+         * @throws FileException if the image cannot be loaded or is damaged
+         */
+        void loadBinary(std::string const &filepath);
+
         /**
          * @brief Saves specific section to INI file
          * @param filepath Path to save to
@@ -334,6 +443,34 @@ public:
             }
         }
 
+        /**
+         * @brief Gets list value, one element per item
+         *
+         * Items come from `key = a, b, c` or repeated `key[]=` lines (see `ini_get_array()`).
+         *
+         * @tparam T Type to convert each item to
+         * @param section Section name
+         * @param key Key name (without `[]`)
+         * @return Items converted to type T
+         * @throws KeyNotFoundException if not found
+         * @throws std::invalid_argument if an item cannot be converted
+         */
+        template <typename T>
+        std::vector<T> getArray(std::string const &section, std::string const &key) const
+        {
+            ini_span_t const *items = nullptr;
+            size_t count = 0;
+            getItems(section, key, items, count);
+
+            std::vector<T> result;
+            result.reserve(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                result.push_back(detail::TypeConverter<T>::fromString(std::string(items[i].ptr, items[i].len)));
+            }
+            return result;
+        }
+
         /**
          * @brief Checks if key exists
          * @param section Section name
@@ -375,6 +512,85 @@ public:
             return *this;
         }
 
+        // ==================== Transactions ====================
+
+        /**
+         * @brief Changes written together by commit()
+         *
+         * Values set or removed on a transaction reach the parser and the
+         * file in one step: the file is read once and replaced once, however
+         * many keys changed (see `ini_txn_commit()`). A transaction that is
+         * destroyed without commit() changes nothing.
+         */
+        class Transaction
+        {
+        public:
+            Transaction(Transaction &&) noexcept = default;
+            Transaction &operator=(Transaction &&) noexcept = default;
+            Transaction(const Transaction &) = delete;
+            Transaction &operator=(const Transaction &) = delete;
+
+            /**
+             * @brief Stages a string value
+             * @return Reference to this transaction for chaining
+             */
+            Transaction &setString(std::string const &section, std::string const &key, std::string const &value);
+
+            /**
+             * @brief Stages a typed value
+             * @return Reference to this transaction for chaining
+             */
+            template <typename T>
+            Transaction &set(std::string const &section, std::string const &key, const T &value)
+            {
+                return setString(section, key, detail::TypeConverter<T>::toString(value));
+            }
+
+            /**
+             * @brief Stages removing a key (a missing key is not an error)
+             * @return Reference to this transaction for chaining
+             */
+            Transaction &remove(std::string const &section, std::string const &key);
+
+            /**
+             * @brief Number of staged changes
+             */
+            size_t size() const noexcept { return m_ops.size(); }
+
+            /**
+             * @brief Applies the staged changes to the parser and to a file
+             *
+             * On failure neither the parser nor the file changes. The staged
+             * changes are dropped either way.
+             *
+             * @param filepath File to update (written in full if missing)
+             * @throws FileException if writing fails
+             */
+            void commit(std::string const &filepath);
+
+        private:
+            friend class IniParser;
+
+            struct Op
+            {
+                std::string section;
+                std::string key;
+                std::string value;
+                bool remove;
+            };
+
+            explicit Transaction(IniParser &parser) : m_parser(&parser) {}
+
+            IniParser *m_parser;
+            std::vector<Op> m_ops;
+        };
+
+        /**
+         * @brief Starts a transaction on this parser
+         * @return Transaction whose commit() writes to this parser and a file
+         */
+        Transaction transaction() { return Transaction(*this); }
+
         // ==================== Container Interface ====================
 
         /**
@@ -437,6 +653,9 @@ private:
             m_data.clear();
         }
         void populateCache() const;
+        void patchCache(ChangeList const &changes) const;
+        void getItems(std::string const &section, std::string const &key, ini_span_t const *&items,
+                      size_t &count) const;
         static void checkStatus(ini_status_t status);
     };
 
@@ -0,0 +1,86 @@
+#ifndef INI_BATCH_READ_H
+#define INI_BATCH_READ_H
+
+#include <stddef.h>
+
+#include "ini_constants.h"
+#include "ini_export.h"
+#include "ini_filesystem.h"
+#include "ini_status.h"
+
+INI_EXTERN_C_BEGIN
+
+/**
+ * @file ini_batch_read.h
+ * @brief Reads many whole files with as few system calls as the platform allows.
+ *
+ * On Linux builds with io_uring support (`INI_HAVE_IO_URING`, detected by
+ * CMake) a reader owns one ring and handles `INI_BATCH_READ_SIZE` files per
+ * round: the statx and openat requests of the whole round go out in one
+ * submission, then every read is submitted linked to its close in a second
+ * one. Everywhere else, and whenever the kernel refuses the ring or one of
+ * these operations, each file is read with `ini_read_file_reuse()`. Both paths
+ * report the same statuses.
+ */
+
+/// @brief Opaque reader; one per thread (a reader is not thread-safe).
+typedef struct ini_batch_reader_s ini_batch_reader_t;
+
+/// @brief Options for `ini_batch_reader_create()`.
+typedef enum
+{
+    INI_BATCH_READ_DEFAULT = 0,          ///< Use io_uring where available.
+    INI_BATCH_READ_NO_IO_URING = 1 << 0, ///< Always use the portable path.
+} ini_batch_read_flags_t;
+
+/**
+ * @brief Receives one file of a batch.
+ * @param user Pointer passed to `ini_batch_reader_read()`.
+ * @param index Position of the file in the `paths` array.
+ * @param status Same result `ini_check_file_status()` and `ini_read_file()` would give.
+ * @param data Null-terminated, writable contents (NULL on error); only valid during the call.
+ * @param size Number of bytes in `data`.
+ * @param fingerprint File version the contents belong to (NULL on error).
+ */
+typedef void (*ini_batch_read_callback_t)(void *user, size_t index, ini_status_t status, char *data,
+                                          size_t size, ini_file_fingerprint_t const *fingerprint);
+
+/**
+ * @brief Creates a reader.
+ * @param flags Combination of `ini_batch_read_flags_t` values.
+ * @return The reader, or NULL if out of memory.
+ */
+INI_PUBLIC_API ini_batch_reader_t *ini_batch_reader_create(unsigned flags);
+
+/**
+ * @brief Destroys a reader and its buffers.
+ * @param reader Reader to destroy (safe to call with NULL).
+ */
+INI_PUBLIC_API void ini_batch_reader_destroy(ini_batch_reader_t *reader);
+
+/**
+ * @brief Non-zero if the reader submits its I/O through io_uring.
+ * @param reader Reader to query.
+ */
+INI_PUBLIC_API int ini_batch_reader_uses_io_uring(ini_batch_reader_t const *reader);
+
+/**
+ * @brief Reads every file in `paths` and hands the contents to `callback`.
+ *
+ * Files are delivered in `paths` order. Buffers are owned by the reader and
+ * reused, so a callback that keeps the data must copy it.
+ *
+ * @param reader Reader to use.
+ * @param paths Files to read.
+ * @param count Number of entries in `paths`.
+ * @param callback Called once per file.
+ * @param user Passed to `callback`.
+ * @return INI_STATUS_SUCCESS once every file was delivered (per-file problems
+ *         go to the callback), or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_batch_reader_read(ini_batch_reader_t *reader, char const *const *paths, size_t count,
+                                                  ini_batch_read_callback_t callback, void *user);
+
+INI_EXTERN_C_END
+
+#endif // !INI_BATCH_READ_H
@@ -0,0 +1,124 @@
+#ifndef INI_BINARY_H
+#define INI_BINARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ini_constants.h"
+#include "ini_export.h"
+#include "ini_hash_table.h"
+#include "ini_status.h"
+
+INI_EXTERN_C_BEGIN
+
+/**
+ * @file ini_binary.h
+ * @brief Compiled snapshot of a context that can be used straight from a mapping.
+ *
+ * Layout (native byte order, every offset relative to the image start):
+ *
+ *     header | sections[] | pairs[] | section index | key indexes | strings
+ *
+ * Strings are null-terminated and referenced by their offset in the string
+ * blob. The section index and each section's key index are open-addressing
+ * tables of `hash_key()` values; a slot holds 1 + the record number, 0 if empty.
+ * Nothing in the image is a pointer, so it can be mapped anywhere and read
+ * without fixups. Images are limited to 4 GiB.
+ *
+ * The `source_*` header fields identify the INI file an image was compiled
+ * from (see `ini_set_cache_dir()`). They are outside the checksum, so a cache
+ * can re-stamp an image whose source was touched but not changed.
+ */
+
+#define INI_BINARY_MAGIC "INIBIN\r\n" ///< Eight bytes; the CR LF catches text-mode transfers.
+#define INI_BINARY_VERSION 2u         ///< Bumped whenever the layout, `hash_key()` or `hash_bytes()` change.
+#define INI_BINARY_BYTE_ORDER 0x01020304u
+
+/// @brief Fixed-size header at offset 0.
+typedef struct
+{
+    char magic[8];                   ///< `INI_BINARY_MAGIC`.
+    uint32_t version;                ///< `INI_BINARY_VERSION`.
+    uint32_t byte_order;             ///< `INI_BINARY_BYTE_ORDER` as written by the producer.
+    uint64_t size;                   ///< Total image size in bytes.
+    uint64_t checksum;               ///< `hash_bytes()` of everything after the header.
+    uint32_t section_count;          ///< Entries in the section array.
+    uint32_t pair_count;             ///< Entries in the pair array.
+    uint32_t section_index_capacity; ///< Slots in the section index (power of two).
+    uint32_t key_index_size;         ///< Slots of all key indexes together.
+    uint32_t sections_offset;        ///< Offset of the `ini_binary_section_t` array.
+    uint32_t pairs_offset;           ///< Offset of the `ini_binary_pair_t` array.
+    uint32_t section_index_offset;   ///< Offset of the section index slots.
+    uint32_t key_index_offset;       ///< Offset of the key index slots.
+    uint32_t strings_offset;         ///< Offset of the string blob.
+    uint32_t strings_size;           ///< Size of the string blob (ends with a null byte).
+    uint64_t source_device;          ///< Device of the INI file the image was compiled from (0 if none).
+    uint64_t source_inode;           ///< Inode of the source file.
+    uint64_t source_size;            ///< Size of the source file.
+    int64_t source_mtime_ns;         ///< Modification time of the source file.
+    uint64_t source_hash;            ///< `hash_bytes()` of the source file.
+} ini_binary_header_t;
+
+/// @brief One section: its pairs are contiguous in the pair array.
+typedef struct
+{
+    uint32_t name;           ///< Offset of the section name in the string blob.
+    uint32_t first_pair;     ///< Index of the first pair.
+    uint32_t pair_count;     ///< Number of pairs.
+    uint32_t index;          ///< First slot of this section's key index.
+    uint32_t index_capacity; ///< Slots in the key index (power of two, larger than `pair_count`).
+} ini_binary_section_t;
+
+/// @brief One key-value pair.
+typedef struct
+{
+    uint32_t key;   ///< Offset of the key in the string blob.
+    uint32_t value; ///< Offset of the value in the string blob.
+} ini_binary_pair_t;
+
+/**
+ * @brief Compiles a section table into a binary image.
+ * @param sections Top-level table (section name → section table, as in `ini_context_t`).
+ * @param[out] image Receives the image (caller must free).
+ * @param[out] size Receives the image size.
+ * @return INI_STATUS_SUCCESS, or INI_STATUS_LACK_OF_MEMORY if the image would exceed 4 GiB.
+ */
+INI_PUBLIC_API ini_status_t ini_binary_build(ini_ht_t *sections, char **image, size_t *size);
+
+/**
+ * @brief Checks an image before it is used.
+ *
+ * Verifies the header, the checksum and that every offset stays inside the
+ * image, so the lookup functions never read out of bounds.
+ *
+ * @param image Image bytes (must be 8-byte aligned, as mappings and malloc are).
+ * @param size Image size.
+ * @return INI_STATUS_SUCCESS, or INI_STATUS_FILE_BAD_FORMAT.
+ */
+INI_PUBLIC_API ini_status_t ini_binary_validate(void const *image, size_t size);
+
+/**
+ * @brief Looks a value up in a validated image without allocating.
+ * @param image Validated image.
+ * @param section Section name.
+ * @param key Key name.
+ * @param[out] value Receives a pointer into the image.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_SECTION_NOT_FOUND or INI_STATUS_KEY_NOT_FOUND.
+ */
+INI_PUBLIC_API ini_status_t ini_binary_lookup(void const *image, char const *section, char const *key,
+                                              char const **value);
+
+/**
+ * @brief Copies the index of a validated image into hash tables.
+ *
+ * The tables borrow every string from the image, which must outlive them.
+ *
+ * @param image Validated image.
+ * @param sections Top-level table to add the sections to (names are borrowed).
+ * @return INI_STATUS_SUCCESS, or INI_STATUS_MEMORY_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_binary_materialize(void const *image, ini_ht_t *sections);
+
+INI_EXTERN_C_END
+
+#endif // !INI_BINARY_H
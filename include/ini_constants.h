@@ -9,7 +9,19 @@
 
 #define INI_LINE_MAX 8192
 #define INI_BUFFER_SIZE 2048
+#define INI_STREAM_BUFFER_SIZE (64 * 1024) ///< Read block used by `ini_parse_stream()`. Must exceed INI_LINE_MAX.
 #define INI_HT_INITIAL_CAPACITY 16 ///< Initial capacity for the hash table. Must be a power of 2.
+#define INI_PARALLEL_MIN_CHUNK_SIZE (256 * 1024) ///< Smallest input slice handed to a parallel load worker.
+#define INI_WATCH_DEBOUNCE_MS 50 ///< Quiet time after the last change event before a watched file is reloaded.
+#define INI_WATCH_POLL_INTERVAL_MS 250 ///< Stat polling period where no change notification API is used.
+#define INI_INCLUDE_SECTION "include" ///< Section whose values name further files with `INI_LOAD_INCLUDES`.
+#define INI_INCLUDE_MAX_DEPTH 8 ///< Deepest include nesting accepted (also stops include cycles).
+#define INI_BATCH_READ_SIZE 64 ///< Files per submission round of a batch reader.
+#define INI_NUMBER_BUFFER_SIZE 32 ///< Longest text `ini_format_double()` writes, terminator included.
+#define INI_JOURNAL_SUFFIX ".journal" ///< Appended to an INI path to name its change journal.
+#define INI_JOURNAL_COMPACT_THRESHOLD (1024 * 1024) ///< Default journal size that starts a background compaction.
+#define INI_JOURNAL_SYNC_INTERVAL 32 ///< Default number of journal records written between two syncs.
+#define INI_WRITER_BUFFER_SIZE (1024 * 1024) ///< Output buffered by an `ini_writer_t` between two writes.
 
 /// @brief BOM (Byte Order Mark) for UTF-8 encoding
 #define INI_UTF8_BOM_SIZE 3
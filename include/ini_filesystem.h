@@ -1,6 +1,7 @@
 #ifndef INI_FILESYSTEM_H
 #define INI_FILESYSTEM_H
 
+#include <stdint.h>
 #include <stdio.h>
 
 #include "ini_constants.h"
@@ -17,6 +18,35 @@ typedef struct
     int execute; // 0 = false, 1 = true
 } ini_file_permission_t;
 
+/// @brief Metadata that identifies one version of a file without reading it.
+typedef struct
+{
+    uint64_t device;  ///< Device (volume) holding the file.
+    uint64_t inode;   ///< File serial number; changes when a save renames a new file into place.
+    uint64_t size;    ///< Size in bytes.
+    int64_t mtime_ns; ///< Modification time in nanoseconds since the epoch (seconds resolution on Windows).
+} ini_file_fingerprint_t;
+
+/// @brief How far `ini_write_file_atomic_ex()` pushes a replaced file towards the disk.
+typedef enum
+{
+    INI_DURABILITY_NONE,      ///< Atomic rename only; the data may still sit in the page cache after a power loss.
+    INI_DURABILITY_FILE,      ///< Also flush the file's data to the device before renaming it into place.
+    INI_DURABILITY_DIRECTORY, ///< Also flush the directory afterwards, so the rename itself survives a power loss.
+} ini_durability_t;
+
+/// @brief One replacement applied by `ini_patch_file_atomic()`.
+typedef struct
+{
+    uint64_t offset;  ///< Start of the replaced range in the original file.
+    uint64_t length;  ///< Number of original bytes replaced (0 inserts).
+    void const *data; ///< New bytes (may be NULL if `size` is 0, which deletes).
+    size_t size;      ///< Number of new bytes.
+} ini_file_edit_t;
+
+/// @brief A file being replaced piece by piece (opaque, see `ini_replace_begin()`).
+typedef struct ini_file_replace_s ini_file_replace_t;
+
 /**
  * @brief Get the file permission of a file.
  *
@@ -91,6 +121,209 @@ INI_PUBLIC_API ini_status_t ini_get_file_size(char const *filepath, size_t *size
  */
 INI_PUBLIC_API ini_status_t ini_check_utf8_bom(FILE *file);
 
+/**
+ * @brief Read a whole file into a single heap buffer.
+ *
+ * The buffer is allocated with one extra byte and null-terminated, so
+ * parsers can terminate the last line in place.
+ *
+ * @param filepath Path to the file.
+ * @param[out] data Receives the buffer (caller must free).
+ * @param[out] size Receives the number of bytes read (without the terminator).
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_OPEN_FAILED or INI_STATUS_MEMORY_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_read_file(char const *filepath, char **data, size_t *size);
+
+/**
+ * @brief Read a whole file into a caller-owned buffer that is reused across calls.
+ *
+ * The buffer only grows (to the file size, plus one byte for the terminator),
+ * so reading many files through one buffer settles at a single allocation.
+ * It stays owned by the caller on every outcome, including errors.
+ *
+ * @param filepath Path to the file.
+ * @param[in, out] buffer Buffer to read into (NULL to allocate one); caller must free.
+ * @param[in, out] capacity Usable bytes of `*buffer`, excluding the terminator.
+ * @param[out] size Receives the number of bytes read (without the terminator).
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_OPEN_FAILED or INI_STATUS_MEMORY_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_read_file_reuse(char const *filepath, char **buffer, size_t *capacity, size_t *size);
+
+/**
+ * @brief Get the fingerprint of a file with a single stat() call.
+ * @param filepath Path to the file.
+ * @param[out] fingerprint Receives the file metadata.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_NOT_FOUND or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_get_file_fingerprint(char const *filepath, ini_file_fingerprint_t *fingerprint);
+
+/**
+ * @brief Compare two file fingerprints.
+ * @return Non-zero if every field matches, 0 otherwise.
+ */
+INI_PUBLIC_API int ini_file_fingerprint_equal(ini_file_fingerprint_t const *lhs, ini_file_fingerprint_t const *rhs);
+
+/**
+ * @brief Map a whole file read-only into memory.
+ *
+ * The pages are loaded on demand by the OS, so mapping costs the same whatever
+ * the file size. The mapping stays valid after the file is renamed over or
+ * deleted, but not if it is truncated in place.
+ *
+ * @param filepath Path to the file.
+ * @param[out] data Receives the start of the mapping.
+ * @param[out] size Receives the file size.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_EMPTY for an empty file, or an open/platform error.
+ */
+INI_PUBLIC_API ini_status_t ini_map_file(char const *filepath, void const **data, size_t *size);
+
+/**
+ * @brief Map a whole file and report the fingerprint of the mapped version.
+ *
+ * Same as `ini_map_file()`. The fingerprint comes from the descriptor that
+ * was mapped, so it can be handed to `ini_patch_file_atomic()` to make sure
+ * offsets taken from the mapping still describe the file. It is filled in
+ * for an empty file too.
+ *
+ * @param filepath Path to the file.
+ * @param[out] data Receives the start of the mapping.
+ * @param[out] size Receives the file size.
+ * @param[out] fingerprint Receives the file metadata (may be NULL).
+ * @return Same as `ini_map_file()`.
+ */
+INI_PUBLIC_API ini_status_t ini_map_file_ex(char const *filepath, void const **data, size_t *size,
+                                            ini_file_fingerprint_t *fingerprint);
+
+/**
+ * @brief Release a mapping created by `ini_map_file()`.
+ * @param data Start of the mapping (safe to call with NULL).
+ * @param size Size returned by `ini_map_file()`.
+ */
+INI_PUBLIC_API void ini_unmap_file(void const *data, size_t size);
+
+/**
+ * @brief Replace a file's contents atomically.
+ *
+ * The data is written to a uniquely named temporary file next to `filepath`,
+ * which is then renamed over it, so readers see either the old or the new
+ * contents, never a partial write. Concurrent writers do not clobber each
+ * other's temporary files; the last rename wins.
+ *
+ * @param filepath Destination path (its directory must exist).
+ * @param data Bytes to write (may be NULL if `size` is 0).
+ * @param size Number of bytes.
+ * @return INI_STATUS_SUCCESS, or the failing step's error (the destination is then unchanged).
+ */
+INI_PUBLIC_API ini_status_t ini_write_file_atomic(char const *filepath, void const *data, size_t size);
+
+/**
+ * @brief Replace a file's contents atomically, with a choice of durability.
+ *
+ * Same as `ini_write_file_atomic()`, plus the flushes `durability` asks for.
+ * An existing destination keeps its permission bits, a new one gets the
+ * usual `0666 & ~umask`, and a symbolic link is followed so the link survives.
+ *
+ * @param filepath Destination path (its directory must exist and be writable).
+ * @param data Bytes to write (may be NULL if `size` is 0).
+ * @param size Number of bytes.
+ * @param durability One of `ini_durability_t`.
+ * @return INI_STATUS_SUCCESS, or the failing step's error. INI_STATUS_CLOSE_FAILED
+ *         from the directory flush means the new contents are in place but may
+ *         not survive a crash; any other error leaves the destination unchanged.
+ */
+INI_PUBLIC_API ini_status_t ini_write_file_atomic_ex(char const *filepath, void const *data, size_t size,
+                                                     ini_durability_t durability);
+
+/**
+ * @brief Replace byte ranges of a file atomically, copying the rest kernel-side.
+ *
+ * The new file is the original with every edit applied, written next to it
+ * and renamed into place as by `ini_write_file_atomic_ex()`. Unchanged spans
+ * are copied with `copy_file_range()` or `sendfile()` where the system has
+ * them, so patching a small part of a large file moves little data through
+ * user space; other systems fall back to buffered copies.
+ *
+ * If `expected` is given, the file the copy reads from must still match it;
+ * otherwise the edits were computed against another version and nothing is
+ * written. On Windows the check is made by path just before reading.
+ *
+ * @param filepath File to patch (must exist).
+ * @param edits Replacements sorted by offset, not overlapping, within the file.
+ * @param count Number of edits (0 rewrites the file unchanged).
+ * @param durability One of `ini_durability_t`.
+ * @param expected Fingerprint the edits were computed against (NULL skips the check).
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT for bad edits,
+ *         INI_STATUS_FILE_CHANGED if the file no longer matches `expected`, or
+ *         the failing step's error (see `ini_write_file_atomic_ex()`).
+ */
+INI_PUBLIC_API ini_status_t ini_patch_file_atomic(char const *filepath, ini_file_edit_t const *edits, size_t count,
+                                                  ini_durability_t durability, ini_file_fingerprint_t const *expected);
+
+/**
+ * @brief Write a whole buffer to an open file descriptor (file, pipe or socket).
+ *
+ * Short writes and interrupted calls are retried. The descriptor is neither
+ * synced nor closed.
+ *
+ * @param fd Descriptor open for writing.
+ * @param data Bytes to write (may be NULL if `size` is 0).
+ * @param size Number of bytes.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT, or INI_STATUS_FILE_OPEN_FAILED
+ *         if a write fails (part of the data may have been written).
+ */
+INI_PUBLIC_API ini_status_t ini_write_fd(int fd, void const *data, size_t size);
+
+/**
+ * @brief Start replacing a file with contents written in several steps.
+ *
+ * The streaming counterpart of `ini_write_file_atomic_ex()`: the data goes to
+ * a temporary file next to `filepath` (write it with `ini_write_fd()` on
+ * `ini_replace_fd()`), and only `ini_replace_commit()` renames it into
+ * place, so the destination never holds partial contents.
+ *
+ * @param filepath Destination path (its directory must exist and be writable).
+ * @param durability One of `ini_durability_t`, applied by the commit.
+ * @param[out] replace Receives the open replacement, freed by the commit or the abort.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT, INI_STATUS_MEMORY_ERROR
+ *         or INI_STATUS_FILE_OPEN_FAILED.
+ */
+INI_PUBLIC_API ini_status_t ini_replace_begin(char const *filepath, ini_durability_t durability,
+                                              ini_file_replace_t **replace);
+
+/// @brief Returns the descriptor of the temporary file (-1 for NULL).
+INI_PUBLIC_API int ini_replace_fd(ini_file_replace_t const *replace);
+
+/**
+ * @brief Flush the written contents, rename them over the destination and free the replacement.
+ * @return INI_STATUS_SUCCESS, or the failing step's error (see `ini_write_file_atomic_ex()`).
+ *         The temporary file is gone either way.
+ */
+INI_PUBLIC_API ini_status_t ini_replace_commit(ini_file_replace_t *replace);
+
+/// @brief Drop a replacement, leaving the destination untouched, and free it (NULL is ignored).
+INI_PUBLIC_API void ini_replace_abort(ini_file_replace_t *replace);
+
+/**
+ * @brief List the regular files matching a path whose last component may hold wildcards.
+ *
+ * `*` matches any run of characters and `?` any single one; a leading dot
+ * must be matched explicitly, so hidden and editor swap files are skipped.
+ * Without wildcards the path names one file, which must exist.
+ *
+ * @param pattern Path such as `conf.d/\*.ini` (wildcards only in the last component).
+ * @param[out] paths Receives the matching paths in lexical (byte) order; free with `ini_free_file_list()`.
+ * @param[out] count Receives the number of paths (may be 0 for a wildcard pattern).
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_NOT_FOUND for a missing directory or file, or a memory error.
+ */
+INI_PUBLIC_API ini_status_t ini_list_files(char const *pattern, char ***paths, size_t *count);
+
+/**
+ * @brief Release a list returned by `ini_list_files()`.
+ * @param paths The list (safe to call with NULL).
+ * @param count Number of entries.
+ */
+INI_PUBLIC_API void ini_free_file_list(char **paths, size_t count);
+
 INI_EXTERN_C_END
 
 #endif // !INI_FILESYSTEM_H
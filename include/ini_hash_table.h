@@ -10,15 +10,43 @@
 
 INI_EXTERN_C_BEGIN
 
+/// @brief Slice of a string: `len` bytes at `ptr`, not null-terminated.
+typedef struct
+{
+    char const *ptr; ///< First byte.
+    size_t len;      ///< Number of bytes.
+} ini_span_t;
+
 /**
  * @brief Key-value pair for hash table entries.
  */
 typedef struct
 {
-    char *key;   ///< Null-terminated string key.
-    char *value; ///< Null-terminated string value.
+    char *key;           ///< Null-terminated string key.
+    char *value;         ///< Null-terminated string value.
+    unsigned flags;      ///< Ownership bits (INI_HT_BORROW_KEY, INI_HT_BORROW_VALUE).
+    unsigned typed;      ///< Which conversions of `value` are cached (INI_HT_TYPED_* bits).
+    int64_t int_value;   ///< `value` as an integer, valid with INI_HT_TYPED_INT.
+    double double_value; ///< `value` as a double, valid with INI_HT_TYPED_DOUBLE.
+    ini_span_t *items;   ///< `value` split into list items (owned by the table), valid with INI_HT_TYPED_ARRAY.
+    size_t item_count;   ///< Number of `items`.
 } ini_ht_key_value_t;
 
+#define INI_HT_BORROW_NONE 0x0  ///< Key and value are copied into the table (default).
+#define INI_HT_BORROW_KEY 0x1   ///< Key is referenced, not copied; the caller keeps it alive.
+#define INI_HT_BORROW_VALUE 0x2 ///< Value is referenced, not copied; the caller keeps it alive.
+
+// Typed-value cache bits; the table clears them (and frees `items`) whenever the value changes.
+// A *_CHECKED bit without its partner records that `value` has no such form.
+#define INI_HT_TYPED_INT_CHECKED 0x01    ///< Integer conversion attempted.
+#define INI_HT_TYPED_INT 0x02            ///< `int_value` holds the integer.
+#define INI_HT_TYPED_DOUBLE_CHECKED 0x04 ///< Double conversion attempted.
+#define INI_HT_TYPED_DOUBLE 0x08         ///< `double_value` holds the double.
+#define INI_HT_TYPED_BOOL_CHECKED 0x10   ///< Boolean conversion attempted.
+#define INI_HT_TYPED_BOOL 0x20           ///< `value` is a boolean ...
+#define INI_HT_TYPED_BOOL_TRUE 0x40      ///< ... and this bit is its truth value.
+#define INI_HT_TYPED_ARRAY 0x80          ///< `items` holds the list items of `value`.
+
 /**
  * @brief Hash table structure.
  * @note Thread-safe if used with `ini_mutex_t`.
@@ -48,6 +76,19 @@ typedef struct
  */
 INI_PUBLIC_API uint64_t hash_key(char const *key);
 
+/**
+ * @brief Fast 64-bit hash of a byte range, used to detect content changes.
+ *
+ * FNV-1a applied to eight-byte words (the tail is folded in byte by byte), so
+ * it is about eight times faster than `hash_key()` on large inputs. The values
+ * differ from `hash_key()` and must not be persisted across library versions.
+ *
+ * @param data Bytes to hash (may be NULL if `size` is 0).
+ * @param size Number of bytes.
+ * @return 64-bit hash value.
+ */
+INI_PUBLIC_API uint64_t hash_bytes(void const *data, size_t size);
+
 /**
  * @brief Creates a new hash table.
  * @return Pointer to the table, or NULL on failure.
@@ -70,6 +111,19 @@ INI_PUBLIC_API ini_status_t ini_ht_destroy(ini_ht_t *table);
  */
 INI_PUBLIC_API char const *ini_ht_get(ini_ht_t *table, char const *key);
 
+/**
+ * @brief Finds the entry stored for a key.
+ *
+ * Gives access to the typed-value cache next to the string. The pointer stays
+ * valid until the table is modified or destroyed.
+ *
+ * @param table Hash table to query.
+ * @param key Null-terminated string key.
+ * @return The entry, or NULL if key not found.
+ * @note Thread-safe lookup; the caller serializes access to the entry itself.
+ */
+INI_PUBLIC_API ini_ht_key_value_t *ini_ht_find(ini_ht_t *table, char const *key);
+
 /**
  * @brief Inserts or updates a key-value pair.
  * @param table Hash table to modify.
@@ -80,6 +134,36 @@ INI_PUBLIC_API char const *ini_ht_get(ini_ht_t *table, char const *key);
  */
 INI_PUBLIC_API char const *ini_ht_set(ini_ht_t *table, char const *key, char const *value);
 
+/**
+ * @brief Inserts or updates a key-value pair, optionally without copying.
+ *
+ * Borrowed strings are stored as-is and never freed by the table, which lets
+ * callers index slices of a buffer they own (see `INI_LOAD_INSITU`).
+ *
+ * @param table Hash table to modify.
+ * @param key Null-terminated string key.
+ * @param value Null-terminated string value.
+ * @param flags Combination of INI_HT_BORROW_KEY and INI_HT_BORROW_VALUE.
+ * @return `value` on success, or NULL on failure.
+ * @note Thread-safe (uses mutex locking).
+ * @warning Borrowed strings must outlive the entry.
+ */
+INI_PUBLIC_API char const *ini_ht_set_ex(ini_ht_t *table, char const *key, char const *value, unsigned flags);
+
+/**
+ * @brief Removes a key and its value from the table.
+ *
+ * Uses backward-shift deletion, so lookups stay tombstone-free and the probe
+ * sequences of the remaining keys are unchanged in length or shorter.
+ *
+ * @param table Hash table to modify.
+ * @param key Null-terminated string key.
+ * @return INI_STATUS_SUCCESS, or INI_STATUS_KEY_NOT_FOUND if `key` is absent.
+ * @note Thread-safe (uses mutex locking).
+ * @warning Invalidates iterators over `table`.
+ */
+INI_PUBLIC_API ini_status_t ini_ht_remove(ini_ht_t *table, char const *key);
+
 /**
  * @brief Returns the number of entries in the table.
  * @param table Hash table to query.
@@ -0,0 +1,148 @@
+#ifndef INI_JOURNAL_H
+#define INI_JOURNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ini_constants.h"
+#include "ini_export.h"
+#include "ini_status.h"
+
+INI_EXTERN_C_BEGIN
+
+/**
+ * @file ini_journal.h
+ * @brief Append-only log of value changes kept next to an INI file.
+ *
+ * Layout (native byte order):
+ *
+ *     header | batch | batch | ...
+ *
+ * A batch holds the records of one `ini_journal_append()`: an
+ * `ini_journal_batch_t`, then `count` records. A record is an
+ * `ini_journal_record_t` followed by the section name, the key and (unless
+ * the record removes the key) the value, each null-terminated. The checksum
+ * of a batch covers all of its records, so a batch torn by a crash is
+ * recognized and dropped whole, together with everything after it; a
+ * transaction never comes back in part. Replaying the same batch twice gives
+ * the same result, which is what lets compaction replace the INI file before
+ * it shortens the journal.
+ */
+
+#define INI_JOURNAL_MAGIC "INIJRNL\n" ///< Eight bytes at offset 0.
+#define INI_JOURNAL_VERSION 2u        ///< Bumped whenever the layout or `hash_bytes()` change.
+#define INI_JOURNAL_BYTE_ORDER 0x01020304u
+#define INI_JOURNAL_REMOVED UINT32_MAX ///< `value_size` of a record that removes its key.
+
+/// @brief Fixed-size header at offset 0.
+typedef struct
+{
+    char magic[8];       ///< `INI_JOURNAL_MAGIC`.
+    uint32_t version;    ///< `INI_JOURNAL_VERSION`.
+    uint32_t byte_order; ///< `INI_JOURNAL_BYTE_ORDER` as written by the producer.
+} ini_journal_header_t;
+
+/// @brief Head of one batch.
+typedef struct
+{
+    uint32_t checksum; ///< Low 32 bits of `hash_bytes()` of the rest of the batch.
+    uint32_t count;    ///< Number of records in the batch.
+    uint64_t size;     ///< Bytes of the records that follow.
+} ini_journal_batch_t;
+
+/// @brief Head of one record.
+typedef struct
+{
+    uint32_t section_size; ///< Length of the section name.
+    uint32_t key_size;     ///< Length of the key.
+    uint32_t value_size;   ///< Length of the value, or `INI_JOURNAL_REMOVED`.
+} ini_journal_record_t;
+
+/// @brief One change handed to `ini_journal_append()`.
+typedef struct
+{
+    char const *section; ///< Section name ("" for global keys).
+    char const *key;     ///< Key name.
+    char const *value;   ///< New value, or NULL to remove the key.
+} ini_journal_entry_t;
+
+/// @brief Receives the records of `ini_journal_replay()` in order; strings are null-terminated.
+typedef ini_status_t (*ini_journal_apply_t)(void *user, char const *section, char const *key, char const *value);
+
+/// @brief Journal opened for appending (opaque).
+typedef struct ini_journal_s ini_journal_t;
+
+/**
+ * @brief Opens a journal for appending, creating it if needed.
+ *
+ * A torn batch at the end of an existing journal is cut off.
+ *
+ * @param path Journal file.
+ * @param sync_interval Records written between two syncs (0 = never sync, 1 = sync every append).
+ * @param[out] journal Receives the journal.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_BAD_FORMAT if `path` is not a journal,
+ *         INI_STATUS_FILE_OPEN_FAILED or INI_STATUS_MEMORY_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_journal_open(char const *path, unsigned sync_interval, ini_journal_t **journal);
+
+/**
+ * @brief Appends records as one batch, with a single write.
+ *
+ * The records are replayed all together or, if a crash tears the batch, not
+ * at all. The journal is synced once the records written since the last sync
+ * reach the interval given to `ini_journal_open()`. If the write fails, the
+ * journal is cut back so no partial batch stays behind.
+ *
+ * @param journal Journal.
+ * @param entries Changes to record, in order.
+ * @param count Number of entries.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_OPEN_FAILED, INI_STATUS_CLOSE_FAILED (sync
+ *         failed) or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_journal_append(ini_journal_t *journal, ini_journal_entry_t const *entries,
+                                               size_t count);
+
+/**
+ * @brief Syncs records that were written but not synced yet.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_CLOSE_FAILED or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_journal_sync(ini_journal_t *journal);
+
+/// @brief Returns the journal size in bytes, header included (0 for NULL).
+INI_PUBLIC_API uint64_t ini_journal_size(ini_journal_t const *journal);
+
+/**
+ * @brief Removes the records before `end` once they are folded into the INI file.
+ *
+ * A journal dropped entirely is truncated in place; otherwise the records
+ * from `end` on are moved to the front through an atomic replace.
+ *
+ * @param journal Journal.
+ * @param end A size returned by `ini_journal_size()` since the last drop.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_FILE_OPEN_FAILED, INI_STATUS_MEMORY_ERROR
+ *         or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_journal_drop(ini_journal_t *journal, uint64_t end);
+
+/// @brief Syncs pending records, closes the file and frees the journal (NULL is ignored).
+INI_PUBLIC_API void ini_journal_close(ini_journal_t *journal);
+
+/**
+ * @brief Passes every intact record of a journal file to `apply`.
+ *
+ * Reading stops quietly at the first torn or damaged batch; none of its
+ * records are passed on.
+ *
+ * @param path Journal file.
+ * @param apply Callback; a status other than INI_STATUS_SUCCESS stops the replay and is returned.
+ * @param user Passed to `apply`.
+ * @param[out] count Receives the number of records applied (optional).
+ * @return INI_STATUS_SUCCESS (also for a missing or empty file), INI_STATUS_FILE_BAD_FORMAT,
+ *         INI_STATUS_FILE_OPEN_FAILED or the status of `apply`.
+ */
+INI_PUBLIC_API ini_status_t ini_journal_replay(char const *path, ini_journal_apply_t apply, void *user,
+                                               size_t *count);
+
+INI_EXTERN_C_END
+
+#endif // !INI_JOURNAL_H
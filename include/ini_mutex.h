@@ -9,21 +9,33 @@
 
 #if INI_OS_WINDOWS
 #include <windows.h>
-typedef CRITICAL_SECTION ini_mutex_base_t; ///< Windows mutex type.
+typedef CRITICAL_SECTION ini_mutex_base_t;  ///< Windows mutex type.
+typedef DWORD ini_mutex_owner_t;            ///< Windows thread id.
+typedef CONDITION_VARIABLE ini_cond_base_t; ///< Windows condition variable type.
 #else
 #include <pthread.h>
 typedef pthread_mutex_t ini_mutex_base_t; ///< POSIX mutex type.
+typedef pthread_t ini_mutex_owner_t;      ///< POSIX thread id.
+typedef pthread_cond_t ini_cond_base_t;   ///< POSIX condition variable type.
 #endif
 
 INI_EXTERN_C_BEGIN
 
 typedef struct
 {
-    ini_mutex_base_t base; ///< Mutex base type (platform specific, for Windows: CRITICAL_SECTION, for POSIX: pthread_mutex_t).
-    int initialized;       ///< INI_MUTEX_INITIALIZED if initialized, INI_MUTEX_NOT_INITIALIZED if not initialized.
-    int locked;            ///< INI_MUTEX_LOCKED if locked, INI_MUTEX_UNLOCKED if not locked.
+    ini_mutex_base_t base;   ///< Mutex base type (platform specific, for Windows: CRITICAL_SECTION, for POSIX: pthread_mutex_t).
+    int initialized;         ///< INI_MUTEX_INITIALIZED if initialized, INI_MUTEX_NOT_INITIALIZED if not initialized.
+    int locked;              ///< INI_MUTEX_LOCKED if locked, INI_MUTEX_UNLOCKED if not locked.
+    ini_mutex_owner_t owner; ///< Thread holding the lock (meaningful only while `locked` is set).
+    unsigned depth;          ///< Lock calls of the owner not matched by an unlock yet.
 } ini_mutex_t;
 
+typedef struct
+{
+    ini_cond_base_t base; ///< Condition variable base type (platform specific).
+    int initialized;      ///< INI_MUTEX_INITIALIZED if initialized, INI_MUTEX_NOT_INITIALIZED if not initialized.
+} ini_cond_t;
+
 #define INI_MUTEX_INITIALIZER {0, INI_MUTEX_NOT_INITIALIZED, INI_MUTEX_UNLOCKED}
 
 #define INI_MUTEX_INITIALIZED 1
@@ -78,7 +90,9 @@ INI_PUBLIC_API ini_status_t ini_mutex_destroy(ini_mutex_t *mutex);
  * @return INI_MUTEX_SUCCESS on success, INI_MUTEX_ERROR on error.
  *
  * Blocks until the mutex is available.
- * For recursive mutexes, same thread can lock multiple times.
+ * Locking again from the thread that already holds the mutex only counts the
+ * nesting and returns success; other threads wait until the holder has
+ * unlocked as many times as it locked.
  */
 INI_PUBLIC_API ini_status_t ini_mutex_lock(ini_mutex_t *mutex);
 
@@ -87,10 +101,43 @@ INI_PUBLIC_API ini_status_t ini_mutex_lock(ini_mutex_t *mutex);
  * @param mutex Pointer to mutex to unlock.
  * @return INI_MUTEX_SUCCESS on success, INI_MUTEX_ERROR on error.
  *
- * Releases the mutex. For recursive mutexes, must be called same number of times as lock.
+ * Undoes one `ini_mutex_lock()`; the mutex is released when the outermost
+ * lock of the owning thread is undone. Unlocking a mutex that is not locked
+ * does nothing and returns success.
  */
 INI_PUBLIC_API ini_status_t ini_mutex_unlock(ini_mutex_t *mutex);
 
+/**
+ * @brief Initialize a condition variable.
+ * @param cond Pointer to condition variable to initialize.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT or INI_STATUS_MUTEX_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_cond_init(ini_cond_t *cond);
+
+/**
+ * @brief Destroy a condition variable.
+ * @param cond Pointer to condition variable to destroy; no thread may be waiting on it.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT or INI_STATUS_MUTEX_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_cond_destroy(ini_cond_t *cond);
+
+/**
+ * @brief Releases `mutex`, waits for a broadcast on `cond` and locks `mutex` again.
+ * @param cond Condition variable.
+ * @param mutex Mutex held by the calling thread, at any nesting depth; the depth is restored.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT or INI_STATUS_MUTEX_ERROR.
+ *
+ * Wake-ups may be spurious, so the caller re-checks its condition in a loop.
+ */
+INI_PUBLIC_API ini_status_t ini_cond_wait(ini_cond_t *cond, ini_mutex_t *mutex);
+
+/**
+ * @brief Wakes every thread waiting on `cond`.
+ * @param cond Condition variable.
+ * @return INI_STATUS_SUCCESS or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_cond_broadcast(ini_cond_t *cond);
+
 INI_EXTERN_C_END
 
 #endif // !INI_MUTEX_H
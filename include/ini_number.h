@@ -0,0 +1,90 @@
+#ifndef INI_NUMBER_H
+#define INI_NUMBER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ini_constants.h"
+#include "ini_export.h"
+#include "ini_status.h"
+
+INI_EXTERN_C_BEGIN
+
+/**
+ * @file ini_number.h
+ * @brief Locale-independent conversions between INI values and numbers.
+ *
+ * Unlike `strtol()`/`strtod()`, the whole string must be a number (no
+ * leading blanks, no trailing text) and the decimal separator is always `.`,
+ * whatever `setlocale()` selected. The formatters write text these parsers
+ * read back to the identical value.
+ */
+
+/**
+ * @brief Parses a signed 64-bit integer.
+ *
+ * Accepts an optional sign followed by decimal digits, or by `0x`/`0X` and
+ * hexadecimal digits.
+ *
+ * @param str Null-terminated text.
+ * @param[out] value Receives the number.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_TYPE_MISMATCH (not an integer or out
+ *         of range) or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_parse_int64(char const *str, int64_t *value);
+
+/**
+ * @brief Parses a double.
+ *
+ * Accepts `[sign] digits [. digits] [e|E [sign] digits]` (at least one digit
+ * in the mantissa), `inf`, `infinity` and `nan` (case-insensitive). When the
+ * digits fit in 53 bits and the decimal exponent is within ±22, the value is
+ * computed exactly with one multiplication or division; other inputs go
+ * through `strtod()` with the separator adjusted to the current locale. Both
+ * paths round correctly.
+ *
+ * @param str Null-terminated text.
+ * @param[out] value Receives the number.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_TYPE_MISMATCH (not a number or out
+ *         of range) or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_parse_double(char const *str, double *value);
+
+/**
+ * @brief Parses a boolean.
+ *
+ * `true`, `yes`, `on` and `1` are true; `false`, `no`, `off` and `0` are
+ * false. Letters are matched case-insensitively.
+ *
+ * @param str Null-terminated text.
+ * @param[out] value Receives 1 or 0.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_TYPE_MISMATCH or INI_STATUS_INVALID_ARGUMENT.
+ */
+INI_PUBLIC_API ini_status_t ini_parse_bool(char const *str, int *value);
+
+/**
+ * @brief Formats a double as short text that reads back to the same value.
+ *
+ * Uses the Grisu2 algorithm, whose output is the shortest round-trip form for
+ * more than 99.9% of doubles and at most one digit longer otherwise (`0.1`
+ * rather than `0.10000000000000001`). Numbers from 1e-6 up to
+ * 1e21 are written without an exponent (`1500`, `0.25`), others as
+ * `1.5e+300`; infinities and NaN as `inf`, `-inf` and `nan`.
+ *
+ * @param value Number to format.
+ * @param[out] buffer At least `INI_NUMBER_BUFFER_SIZE` bytes; receives a null-terminated string.
+ * @return Length of the text, or 0 if `buffer` is NULL.
+ */
+INI_PUBLIC_API size_t ini_format_double(double value, char *buffer);
+
+/**
+ * @brief Formats a float as short text that reads back to the same value.
+ *
+ * Same as `ini_format_double()` with the float's precision, so `0.1f` gives
+ * `0.1` and not the digits of its double value.
+ */
+INI_PUBLIC_API size_t ini_format_float(float value, char *buffer);
+
+INI_EXTERN_C_END
+
+#endif // !INI_NUMBER_H
@@ -3,17 +3,102 @@
 
 #include <stdio.h>
 
+#include "ini_filesystem.h"
 #include "ini_hash_table.h"
+#include "ini_journal.h"
+#include "ini_thread.h"
 
 INI_EXTERN_C_BEGIN
 
+/// @brief Flags that select how `ini_load()` stores what it parses.
+typedef enum
+{
+    INI_LOAD_DEFAULT = 0,              ///< Every section name, key and value gets its own allocation.
+    INI_LOAD_INSITU = 1 << 0,          ///< The context owns the file buffer; entries point into it (terminated in place).
+    INI_LOAD_PARALLEL = 1 << 1,        ///< Split the file at section headers and parse the chunks on worker threads.
+    INI_LOAD_LAZY = 1 << 2,            ///< Only index section byte ranges; parse a section when it is first accessed.
+    INI_LOAD_CONTENT_HASH = 1 << 3,    ///< Record a content hash so `ini_reload_if_changed()` can skip rewritten but identical files.
+    INI_LOAD_INCLUDES = 1 << 4,        ///< Also load the files named by `[include]` sections (see `ini_load_dir()`).
+    INI_LOAD_JOURNAL = 1 << 5,         ///< Replay the change journal of the file after loading it (see `ini_set_journal()`).
+    INI_LOAD_PRESERVE_FORMAT = 1 << 6, ///< Keep the file text so `ini_save()` only rewrites the lines of changed keys.
+} ini_load_flags_t;
+
+/// @brief Byte range of a section that a lazy load has not parsed yet.
+typedef struct
+{
+    char const *name; ///< Section name inside the context buffer (not null-terminated).
+    size_t name_len;  ///< Length of `name`.
+    size_t begin;     ///< Offset of the section header line.
+    size_t end;       ///< Offset just past the last line of the section.
+    int materialized; ///< Non-zero once the range was parsed into `sections`.
+} ini_section_span_t;
+
+/// @brief What happened to a section or key between two loads.
+typedef enum
+{
+    INI_CHANGE_ADDED,    ///< Present in the new file only.
+    INI_CHANGE_REMOVED,  ///< Present in the old context only.
+    INI_CHANGE_MODIFIED, ///< Present in both with a different value.
+} ini_change_kind_t;
+
+/// @brief One entry of a change set reported by `ini_reload_incremental()`.
+typedef struct
+{
+    ini_change_kind_t kind; ///< Kind of change.
+    char *section;          ///< Section name.
+    char *key;              ///< Key name, or NULL when the whole section was added or removed.
+} ini_change_t;
+
+/// @brief Changes applied by an incremental reload (release with `ini_free_changes()`).
+typedef struct
+{
+    ini_change_t *items; ///< Changes, grouped by section.
+    size_t count;        ///< Number of entries in `items`.
+    size_t capacity;     ///< Allocated entries in `items`.
+} ini_change_set_t;
+
+/// @brief How `ini_set_journal()` batches syncs and when it compacts.
+typedef struct
+{
+    uint64_t compact_threshold; ///< Journal size in bytes that starts a background compaction (0 = only `ini_compact_journal()`).
+    unsigned sync_interval;     ///< Records written between two syncs (0 = never sync, 1 = sync every change).
+} ini_journal_options_t;
+
 /// @brief Represents an INI context using nested hash tables.
 typedef struct
 {
-    ini_ht_t *sections; ///< Top-level hash table: section_name → (ini_ht_t* of key-value pairs).
-    ini_mutex_t mutex;  ///< Mutex for thread safety.
+    ini_ht_t *sections;                 ///< Top-level hash table: section_name → (ini_ht_t* of key-value pairs).
+    ini_mutex_t mutex;                  ///< Mutex for thread safety.
+    unsigned load_flags;                ///< Combination of `ini_load_flags_t` values used by `ini_load()`.
+    unsigned load_threads;              ///< Worker count for `INI_LOAD_PARALLEL` (0 = one per hardware thread).
+    char *buffer;                       ///< File contents referenced by in-situ entries (NULL if none).
+    size_t buffer_size;                 ///< Size of `buffer` in bytes.
+    ini_section_span_t *spans;          ///< Section ranges indexed by `INI_LOAD_LAZY`, sorted by name then offset.
+    size_t span_count;                  ///< Number of entries in `spans`.
+    ini_file_fingerprint_t fingerprint; ///< File metadata at the last successful load.
+    uint64_t content_hash;              ///< `hash_bytes()` of the loaded file (with `INI_LOAD_CONTENT_HASH`).
+    int has_fingerprint;                ///< Non-zero if `fingerprint` describes the current contents.
+    void const *image;                  ///< Binary image mapped by `ini_load_binary()` (NULL if none).
+    size_t image_size;                  ///< Size of `image` in bytes.
+    int image_materialized;             ///< Non-zero once `image` was copied into `sections`.
+    char *cache_dir;                    ///< Directory of compiled images consulted by `ini_load()` (NULL = none).
+    ini_durability_t durability;        ///< Flushes done by `ini_save()` and `ini_save_section_value()`.
+    ini_ht_t *dirty;                    ///< Keys changed by `ini_set_value()` since the last load or save: section → key set.
+    ini_journal_t *journal;             ///< Change journal written by `ini_set_value()` (NULL unless `ini_set_journal()` enabled it).
+    char *journal_base;                 ///< INI file the journal belongs to and compactions rewrite.
+    uint64_t journal_threshold;         ///< Journal size that starts a background compaction (0 = never).
+    ini_mutex_t compact_mutex;          ///< Serializes compactions; taken before `mutex`.
+    ini_thread_t compactor;             ///< Background compaction thread.
+    int compactor_state;                ///< 0 = none, 1 = running, 2 = finished but not joined.
+    char *document;                     ///< Text loaded with `INI_LOAD_PRESERVE_FORMAT` or saved since (NULL if none).
+    size_t document_size;               ///< Size of `document` in bytes.
+    ini_ht_t *document_edits;           ///< Keys changed since `document` was loaded or saved: section → key set.
+    unsigned document_version;          ///< Bumped whenever `document` is replaced.
 } ini_context_t;
 
+/// @brief Changes staged by `ini_txn_begin()` and written by `ini_txn_commit()` (opaque).
+typedef struct ini_txn_s ini_txn_t;
+
 /**
  * @brief Helper functions to store and retrieve section hash tables.
  * @param sections Top-level hash table.
@@ -31,6 +116,31 @@ INI_PUBLIC_API void ini_store_section_ht(ini_ht_t *sections, char const *section
  */
 INI_PUBLIC_API ini_ht_t *ini_get_section_ht(ini_ht_t *sections, char const *section_name);
 
+/**
+ * @brief Retrieves a section table from a context.
+ *
+ * Unlike `ini_get_section_ht()` this parses the section first if the context
+ * was loaded with `INI_LOAD_LAZY` and has not touched it yet.
+ *
+ * @param ctx Context to query.
+ * @param section_name Section name.
+ * @return Section hash table, or NULL if not found (or on allocation failure).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_ht_t *ini_get_section(ini_context_t *ctx, char const *section_name);
+
+/**
+ * @brief Returns the top-level table of a context with every section materialized.
+ *
+ * Use this instead of `ctx->sections` to iterate a context that may have been
+ * loaded with `INI_LOAD_LAZY`.
+ *
+ * @param ctx Context to query.
+ * @return Top-level hash table, or NULL on bad input or allocation failure.
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_ht_t *ini_get_sections(ini_context_t *ctx);
+
 /**
  * @brief Initializes a new INI parser context.
  *
@@ -57,6 +167,145 @@ INI_PUBLIC_API ini_context_t *ini_create_context();
  */
 INI_PUBLIC_API ini_status_t ini_free(ini_context_t *ctx);
 
+/**
+ * @brief Selects how subsequent `ini_load()` calls store the parsed data.
+ *
+ * With `INI_LOAD_INSITU` the whole file is read into one buffer owned by the
+ * context and section names, keys and values point into it instead of being
+ * duplicated, so memory use is roughly the file size plus the hash index.
+ * Values updated later through `ini_ht_set()` are copied as usual.
+ *
+ * With `INI_LOAD_PARALLEL` the file is split at section header boundaries
+ * (`\n[`), the chunks are parsed concurrently into private tables and then
+ * merged in file order, so repeated sections and keys keep last-wins semantics.
+ * Files smaller than two `INI_PARALLEL_MIN_CHUNK_SIZE` slices are parsed serially.
+ *
+ * With `INI_LOAD_LAZY` the load only validates the syntax and records the byte
+ * range of every section; a section's key table is built (in-situ, from the
+ * buffer the context keeps) the first time `ini_get_value()`, `ini_get_section()`
+ * or another context function touches it, and iteration through
+ * `ini_get_sections()` builds all of them. Code that reads `ctx->sections`
+ * directly only sees the sections materialized so far. `INI_LOAD_PARALLEL`
+ * is ignored in this mode.
+ *
+ * With `INI_LOAD_INCLUDES` every value of an `[include]` section names a file
+ * or a wildcard pattern (relative to the including file) to load after it;
+ * see `ini_load_dir()`. Such loads parse every file into private tables and
+ * ignore the other flags and the cache directory.
+ *
+ * With `INI_LOAD_JOURNAL` the records of `<file>.journal` are applied after
+ * the file itself, so a reader sees changes not compacted into the file yet.
+ *
+ * With `INI_LOAD_PRESERVE_FORMAT` the context also keeps a copy of the file
+ * text and the keys changed since through `ini_set_value()`,
+ * `ini_remove_value()`, transactions or the journal. `ini_save()` then copies
+ * comments, blank lines, ordering and quoting as they were and only rewrites
+ * the lines of changed keys, so saving an unchanged context reproduces the
+ * file byte for byte. Multi-file loads (`INI_LOAD_INCLUDES`) keep no text.
+ *
+ * @param ctx Context to configure.
+ * @param flags Combination of `ini_load_flags_t` values.
+ * @return INI_SUCCESS on success, INI_STATUS_INVALID_ARGUMENT on bad input.
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_set_load_flags(ini_context_t *ctx, unsigned flags);
+
+/**
+ * @brief Sets the number of worker threads used by `INI_LOAD_PARALLEL`.
+ * @param ctx Context to configure.
+ * @param threads Number of workers, or 0 to use one per hardware thread.
+ * @return INI_SUCCESS on success, INI_STATUS_INVALID_ARGUMENT on bad input.
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_set_load_threads(ini_context_t *ctx, unsigned threads);
+
+/**
+ * @brief Lets `ini_load()` reuse compiled images of the files it loads.
+ *
+ * With a cache directory set, `ini_load()` first looks for an image of the
+ * file (named after a hash of its canonical path). If the fingerprint recorded
+ * in the image matches the file, the image is mapped as by `ini_load_binary()`
+ * and the text is not even read. If only the metadata changed but the content
+ * hash still matches, the image is used and re-stamped. Otherwise the text is
+ * parsed as usual and a fresh image is written atomically for the next run.
+ * Cache problems (missing directory, stale or damaged images) never fail a
+ * load; they only cost the parse. `ini_load_sections()` bypasses the cache.
+ *
+ * @param[in, out] ctx The context to configure.
+ * @param[in] cache_dir Existing directory to keep images in, or NULL to stop caching.
+ * @return Error details (INI_STATUS_FILE_NOT_FOUND if `cache_dir` is not a directory).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_set_cache_dir(ini_context_t *ctx, char const *cache_dir);
+
+/**
+ * @brief Chooses how durable `ini_save()` and `ini_save_section_value()` are.
+ *
+ * Saves always write a temporary file next to the destination and rename it
+ * over the original, so a crash leaves either the old or the new file. The
+ * level decides whether the data (`INI_DURABILITY_FILE`) and the rename
+ * (`INI_DURABILITY_DIRECTORY`) are also flushed to the device before the save
+ * returns. The default is `INI_DURABILITY_NONE`.
+ *
+ * @param[in, out] ctx The context to configure.
+ * @param[in] durability One of `ini_durability_t`.
+ * @return INI_SUCCESS on success, INI_STATUS_INVALID_ARGUMENT on bad input.
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_set_durability(ini_context_t *ctx, ini_durability_t durability);
+
+/**
+ * @brief Makes value changes cheap appends to a journal next to an INI file.
+ *
+ * Once enabled, every `ini_set_value()` and `ini_remove_value()`, and every
+ * `ini_txn_commit()` to `filepath`, appends a compact record to
+ * `filepath` + `INI_JOURNAL_SUFFIX` instead of rewriting the file. Records
+ * are synced in batches of `sync_interval` (or by `ini_sync_journal()`), so a
+ * change costs one small write. `INI_LOAD_JOURNAL` is added to the load
+ * flags: `ini_load()` of `filepath` replays the journal over the file, so
+ * enable the journal before loading. When the journal outgrows
+ * `compact_threshold`, a background thread folds it into `filepath` (see
+ * `ini_compact_journal()`). A transaction is journaled as one batch, so a
+ * crash never leaves part of it behind: a batch torn by a crash is dropped
+ * whole on the next open or replay.
+ *
+ * @param ctx Context to configure.
+ * @param filepath INI file, or NULL to sync, close and stop using the current journal.
+ * @param options Batching and compaction settings, or NULL for `INI_JOURNAL_SYNC_INTERVAL`
+ *                and `INI_JOURNAL_COMPACT_THRESHOLD`.
+ * @return Error details (INI_STATUS_FILE_BAD_FORMAT if the journal file is damaged).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ * @note `ini_save()` and the other save functions do not touch the journal;
+ *       the records they leave behind replay to the values they wrote.
+ */
+INI_PUBLIC_API ini_status_t ini_set_journal(ini_context_t *ctx, char const *filepath,
+                                            ini_journal_options_t const *options);
+
+/**
+ * @brief Syncs journal records written since the last sync.
+ * @param ctx Context with a journal.
+ * @return Error details (INI_STATUS_INVALID_ARGUMENT if no journal is enabled).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_sync_journal(ini_context_t *ctx);
+
+/**
+ * @brief Folds the journal into its INI file and empties it.
+ *
+ * The context is rendered under the lock as `ini_save()` would write it, so
+ * a context loaded with `INI_LOAD_PRESERVE_FORMAT` keeps its layout and
+ * continues from the written text. The file is then replaced atomically and
+ * durably (`INI_DURABILITY_DIRECTORY`) without holding the lock, so readers
+ * and writers are only blocked for the copy. Records appended in the
+ * meantime stay in the journal. A crash between the two steps merely replays
+ * records the new file already contains.
+ *
+ * @param ctx Context with a journal, loaded from its INI file.
+ * @return Error details (INI_STATUS_INVALID_ARGUMENT if no journal is enabled).
+ * @note Thread-safe: Compactions run one at a time.
+ */
+INI_PUBLIC_API ini_status_t ini_compact_journal(ini_context_t *ctx);
+
 /**
  * @brief Validates an INI file's existence, accessibility, and basic format.
  *
@@ -83,6 +332,175 @@ INI_PUBLIC_API ini_status_t ini_good(char const *filepath);
  */
 INI_PUBLIC_API ini_status_t ini_load(ini_context_t *ctx, char const *filepath);
 
+/**
+ * @brief Loads every file of a directory that matches a pattern (a `conf.d` layout).
+ *
+ * The matching files are parsed concurrently (on `ini_set_load_threads()`
+ * workers) into private tables, which are then merged in lexical file name
+ * order: later files add sections and override keys of earlier ones. With
+ * `INI_LOAD_INCLUDES` the `[include]` sections are honoured as well; the files
+ * they name are parsed in the next concurrent batch and merged right after the
+ * including file, in lexical key order. Includes nest up to
+ * `INI_INCLUDE_MAX_DEPTH` levels, and deeper nesting (such as a cycle) fails
+ * with INI_STATUS_FILE_BAD_FORMAT. Empty files contribute nothing.
+ *
+ * The context is only replaced if every file loads. Since several files make
+ * up the result, `ini_reload_if_changed()` always reloads it.
+ *
+ * @param[in, out] ctx The context to populate.
+ * @param[in] dirpath Directory to scan (not recursively).
+ * @param[in] pattern File name pattern with `*` and `?`, or NULL for `*.ini`.
+ *                    Names starting with a dot only match a pattern that does.
+ * @return Error details (INI_SUCCESS on success, also when nothing matched).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_load_dir(ini_context_t *ctx, char const *dirpath, char const *pattern);
+
+/**
+ * @brief Loads many independent files into one context each, on a worker pool.
+ *
+ * Meant for batch jobs that check thousands of unrelated files. Workers claim
+ * the next file from a shared cursor, so a large or slow file does not hold
+ * up the rest. Every worker reads its files through one `ini_batch_reader_t`,
+ * so on Linux the stat/open/read/close calls of up to `INI_BATCH_READ_SIZE`
+ * files go to io_uring in two submissions, and the read buffers are reused.
+ * Each context is loaded as by `ini_load()` with default flags.
+ *
+ * @param[in] paths Files to load.
+ * @param[in] count Number of entries in `paths` (0 does nothing).
+ * @param[out] out Receives a new context per file, or NULL where loading
+ *                 failed (release with `ini_free()`). NULL only validates.
+ * @param[out] statuses Receives the status of every file (may be NULL).
+ * @param[in] threads Number of workers, or 0 to use one per hardware thread.
+ * @return INI_SUCCESS if every file loaded, otherwise the status of the first
+ *         failing file in `paths` order (or a memory/platform error).
+ * @note Thread-safe: Uses no shared resources
+ */
+INI_PUBLIC_API ini_status_t ini_load_many(char const *const *paths, size_t count, ini_context_t **out,
+                                          ini_status_t *statuses, unsigned threads);
+
+/**
+ * @brief Reloads a context only if its file changed since the last load.
+ *
+ * Every load records the file's device, inode, size and nanosecond mtime.
+ * When they still match, this returns without reading the file. Otherwise the
+ * file is read; with `INI_LOAD_CONTENT_HASH` set it is only parsed if its
+ * content hash differs from the one recorded at load time, else a full
+ * `ini_load()` is done. A failed reload leaves the context and the recorded
+ * fingerprint unchanged, so the next call retries. With `INI_LOAD_JOURNAL` the
+ * journal is replayed after the reload, as `ini_load()` does.
+ *
+ * @param[in, out] ctx The context to refresh.
+ * @param[in] filepath Path to the INI file (the one the context was loaded from).
+ * @param[out] reloaded Set to 1 if the context was reloaded, 0 otherwise (may be NULL).
+ * @return Error details (INI_SUCCESS on success, including when nothing changed).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_reload_if_changed(ini_context_t *ctx, char const *filepath, int *reloaded);
+
+/**
+ * @brief Reloads a changed file by patching only the sections that differ.
+ *
+ * Skips unchanged files like `ini_reload_if_changed()`. Otherwise the file is
+ * parsed into scratch tables and compared to the context section by section:
+ * an order-independent digest of each section's pairs decides whether its
+ * keys need comparing at all. Only added, removed and modified entries are
+ * written, so untouched sections keep their tables (and pointers into them).
+ * With `INI_LOAD_LAZY` every pending section is materialized first. With
+ * `INI_LOAD_JOURNAL` the journal is replayed over the scratch tables, so
+ * journaled values are kept and do not show up as changes.
+ *
+ * Added and removed sections are reported by one entry with a NULL key,
+ * followed by one entry per key they hold.
+ *
+ * @param[in, out] ctx The context to patch.
+ * @param[in] filepath Path to the INI file (the one the context was loaded from).
+ * @param[in, out] changes Receives the applied changes (may be NULL). Must be
+ *                 zero-initialized or hold an earlier result, which is released
+ *                 first; release it with `ini_free_changes()`, even on failure.
+ * @return Error details (INI_SUCCESS on success, including when nothing changed).
+ *         A bad file leaves the context untouched; a memory error while
+ *         patching can leave it partially updated.
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_reload_incremental(ini_context_t *ctx, char const *filepath,
+                                                   ini_change_set_t *changes);
+
+/**
+ * @brief Releases the entries of a change set and resets it to empty.
+ * @param changes Change set to clear (safe to call with NULL).
+ */
+INI_PUBLIC_API void ini_free_changes(ini_change_set_t *changes);
+
+/**
+ * @brief Loads only the named sections of an INI file into a context.
+ *
+ * Behaves like `ini_load()` (same load flags, same all-or-nothing swap), but
+ * sections not listed in `sections` are skipped at scan speed: their lines are
+ * neither validated nor allocated, so a syntax error inside a skipped section
+ * does not fail the load. Repeated headers of a kept section are merged as usual.
+ *
+ * @param[in, out] ctx The context to populate (NULL only validates the kept sections).
+ * @param[in] filepath Path to the INI file.
+ * @param[in] sections Exact section names to keep.
+ * @param[in] count Number of names in `sections` (0 loads an empty context).
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_load_sections(ini_context_t *ctx, char const *filepath,
+                                              char const *const *sections, size_t count);
+
+/**
+ * @brief Loads only the sections whose names start with one of `prefixes`.
+ *
+ * Same contract as `ini_load_sections()`, e.g. the prefix "db." keeps
+ * `[db.primary]` and `[db.replica]`.
+ *
+ * @param[in, out] ctx The context to populate (NULL only validates the kept sections).
+ * @param[in] filepath Path to the INI file.
+ * @param[in] prefixes Section name prefixes to keep.
+ * @param[in] count Number of prefixes (0 loads an empty context).
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_load_sections_prefix(ini_context_t *ctx, char const *filepath,
+                                                     char const *const *prefixes, size_t count);
+
+/**
+ * @brief Saves a context as a compiled binary image (see ini_binary.h).
+ *
+ * The image holds the strings and a prebuilt hash index with offsets instead
+ * of pointers, plus a checksum, so `ini_load_binary()` can use it in place.
+ * Images use the native byte order and are tied to `INI_BINARY_VERSION`; keep
+ * the text file as the source of truth and treat the image as a cache.
+ * The image is written to a temporary file and renamed into place (with the
+ * context's durability), so processes that have the old image mapped keep
+ * reading it intact.
+ *
+ * @param[in] ctx The context to save.
+ * @param[in] filepath Path to the image file.
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_save_binary(ini_context_t const *ctx, char const *filepath);
+
+/**
+ * @brief Loads a binary image written by `ini_save_binary()` without parsing it.
+ *
+ * The file is mapped read-only and checked once (header, bounds, checksum);
+ * `ini_get_value()` then looks values up in the mapping directly. The first
+ * call that needs tables (`ini_get_section()`, `ini_get_sections()`, saving,
+ * printing, incremental reloads) indexes the image into tables that borrow
+ * every string from the mapping. The reload functions read text files only.
+ *
+ * @param[in, out] ctx The context to load into (its previous contents are replaced).
+ * @param[in] filepath Path to the image file.
+ * @return Error details (INI_SUCCESS on success, INI_STATUS_FILE_BAD_FORMAT for a damaged
+ *         or incompatible image, in which case the context is unchanged).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_load_binary(ini_context_t *ctx, char const *filepath);
+
 /**
  * @brief Gets a value from a section in the INI context.
  * @param ctx Context to query.
@@ -97,8 +515,121 @@ INI_PUBLIC_API ini_status_t ini_get_value(ini_context_t const *ctx,
                                           char const *key,
                                           char **value);
 
+/**
+ * @brief Gets a value as a signed 64-bit integer, without allocating.
+ *
+ * The text is converted by `ini_parse_int64()` on first use and the result is
+ * cached in the entry, so later reads of the same key are a lookup only until
+ * the value changes. Values of a mapped binary image are converted on every
+ * call until the image is indexed into tables.
+ *
+ * @param ctx Context to query.
+ * @param section Section name.
+ * @param key Key name.
+ * @param[out] value Receives the number (unchanged on error).
+ * @return Error details (INI_SUCCESS on success, INI_STATUS_TYPE_MISMATCH if the
+ *         value is not an integer in range).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_get_int64(ini_context_t const *ctx, char const *section, char const *key,
+                                          int64_t *value);
+
+/**
+ * @brief Gets a value as a double, without allocating.
+ *
+ * Same as `ini_get_int64()`, converting with `ini_parse_double()`.
+ */
+INI_PUBLIC_API ini_status_t ini_get_double(ini_context_t const *ctx, char const *section, char const *key,
+                                           double *value);
+
+/**
+ * @brief Gets a value as a boolean, without allocating.
+ *
+ * Same as `ini_get_int64()`, converting with `ini_parse_bool()`.
+ *
+ * @param[out] value Receives 1 or 0 (unchanged on error).
+ */
+INI_PUBLIC_API ini_status_t ini_get_bool(ini_context_t const *ctx, char const *section, char const *key, int *value);
+
+/**
+ * @brief Gets a value as a list of items, without copying them.
+ *
+ * A list is written either on one line, `hosts = a, b, c`, or as repeated
+ * `hosts[]=a` lines, which `ini_load()` joins into `a,b,c` under `hosts`.
+ * The value is split at every comma and each item is trimmed of blanks; an
+ * empty value has no items and a value without commas has one. Quotes do not
+ * protect commas (`ini_save()` quotes any value with a blank); an item keeps
+ * a comma written as `\,` and a backslash written as `\\`. Repeated `key[]=`
+ * lines are escaped that way when they are joined, so each line is one item.
+ * The split happens once per value and is cached in the entry, so repeated
+ * calls are a lookup. A mapped binary image is indexed into tables first.
+ *
+ * @param ctx Context to query.
+ * @param section Section name.
+ * @param key Key name (without `[]`).
+ * @param[out] items Receives the items; they point into the stored value (or an unescaped
+ *             copy of it) and stay valid until the key is changed, or the context is
+ *             reloaded or freed.
+ * @param[out] count Receives the number of items.
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_get_array(ini_context_t const *ctx, char const *section, char const *key,
+                                          ini_span_t const **items, size_t *count);
+
+/**
+ * @brief Sets a value, creating the section if needed, and marks the key dirty.
+ *
+ * Dirty keys are what `ini_save_incremental()` writes. With a journal (see
+ * `ini_set_journal()`) the change is appended to it first. Editing the section
+ * tables directly (`ini_ht_set()` on `ini_get_section()`) is not tracked.
+ *
+ * @param ctx Context to modify.
+ * @param section Section name (NULL for global keys).
+ * @param key Key name.
+ * @param value New value (copied).
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_set_value(ini_context_t *ctx, char const *section, char const *key, char const *value);
+
+/**
+ * @brief Removes a key and marks it dirty, so the next incremental save deletes its line.
+ *
+ * With a journal the removal is appended to it first.
+ *
+ * @param ctx Context to modify.
+ * @param section Section name (NULL for global keys).
+ * @param key Key name.
+ * @return Error details (INI_STATUS_SECTION_NOT_FOUND or INI_STATUS_KEY_NOT_FOUND if absent).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_remove_value(ini_context_t *ctx, char const *section, char const *key);
+
+/**
+ * @brief Tells whether the context has changes `ini_save_incremental()` would write.
+ * @param ctx Context to query.
+ * @return Non-zero if a key was set or removed since the last load or save.
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API int ini_is_dirty(ini_context_t const *ctx);
+
 /**
  * @brief Saves an INI context to a file.
+ *
+ * The text is written to a temporary file in the same directory and renamed
+ * over `filepath`, so readers and crashes see the old or the new file, never
+ * a truncated one (see `ini_set_durability()`).
+ *
+ * A context loaded with `INI_LOAD_PRESERVE_FORMAT` writes its loaded text
+ * with the lines of changed keys replaced (removed keys lose their line, new
+ * keys follow the last line of their section, new sections go at the end) and
+ * keeps the result as the text for the next save. Otherwise every section is
+ * written out in table order.
+ *
+ * A value the parser would not give back as it is (see `ini_value_writable()`)
+ * fails the save with INI_STATUS_INVALID_ARGUMENT before anything is written.
+ *
  * @param ctx Context to save.
  * @param filepath Path to save to.
  * @return Error details (INI_SUCCESS on success).
@@ -106,6 +637,33 @@ INI_PUBLIC_API ini_status_t ini_get_value(ini_context_t const *ctx,
  */
 INI_PUBLIC_API ini_status_t ini_save(ini_context_t const *ctx, char const *filepath);
 
+/**
+ * @brief Renders the text `ini_save()` would write into a new buffer.
+ *
+ * Nothing is written and the changed keys stay dirty, so the context can be
+ * shipped over a pipe or into a cache without a temporary file.
+ *
+ * @param ctx Context to render.
+ * @param[out] text Receives the null-terminated text (caller must free).
+ * @param[out] size Receives the text length, terminator excluded.
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_save_to_buffer(ini_context_t const *ctx, char **text, size_t *size);
+
+/**
+ * @brief Writes the text `ini_save()` would write to an open file descriptor.
+ *
+ * The text is rendered under the lock and written after it is released; the
+ * descriptor is neither synced nor closed (see `ini_write_fd()`).
+ *
+ * @param ctx Context to write.
+ * @param fd Descriptor open for writing (file, pipe or socket).
+ * @return Error details (INI_SUCCESS on success, INI_STATUS_FILE_OPEN_FAILED if a write fails).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_save_fd(ini_context_t const *ctx, int fd);
+
 /**
  * @brief Saves a specific section and key/value pair to a file.
  * @param ctx Context to query.
@@ -115,13 +673,89 @@ INI_PUBLIC_API ini_status_t ini_save(ini_context_t const *ctx, char const *filep
  * @return Error details (INI_SUCCESS on success).
  * @note Thread-safe: Uses mutex/semaphore internally.
  * @note If the file already exists, only the specified section/key will be updated,
- *       preserving all other content.
+ *       preserving all other content. The file is replaced atomically like by `ini_save()`.
+ *       If it is replaced by someone else while being patched, nothing is written and
+ *       INI_STATUS_FILE_CHANGED is returned.
  */
 INI_PUBLIC_API ini_status_t ini_save_section_value(ini_context_t const *ctx,
                                                    char const *filepath,
                                                    char const *section,
                                                    char const *key);
 
+/**
+ * @brief Writes only the keys changed since the last load or save into an existing file.
+ *
+ * Lines of dirty keys are replaced (or deleted, for removed keys), new keys
+ * are added after the last key of their section and new sections appended;
+ * every other byte of the file is copied unchanged, kernel-side where the
+ * system allows (see `ini_patch_file_atomic()`). If `filepath` does not exist
+ * the whole context is saved as by `ini_save()`. Nothing is written when the
+ * context is clean. The dirty set is cleared on success. If the file is
+ * replaced by someone else while being patched, nothing is written and
+ * INI_STATUS_FILE_CHANGED is returned with the dirty set kept.
+ *
+ * @param ctx Context to save.
+ * @param filepath File the context was loaded from or last saved to.
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Uses mutex/semaphore internally.
+ */
+INI_PUBLIC_API ini_status_t ini_save_incremental(ini_context_t *ctx, char const *filepath);
+
+/**
+ * @brief Starts a transaction: changes staged on it reach the context and the
+ *        file together, in one merge pass and one atomic replace.
+ *
+ * Staging does not lock or modify the context; everything happens in
+ * `ini_txn_commit()`.
+ *
+ * @param ctx Context the changes are for; it must outlive the transaction.
+ * @return New transaction, or NULL if `ctx` is NULL or memory ran out.
+ */
+INI_PUBLIC_API ini_txn_t *ini_txn_begin(ini_context_t *ctx);
+
+/**
+ * @brief Stages setting a value (creating the section if needed).
+ * @param txn Transaction.
+ * @param section Section name (NULL for global keys).
+ * @param key Key name.
+ * @param value New value (copied).
+ * @return Error details (INI_SUCCESS on success).
+ */
+INI_PUBLIC_API ini_status_t ini_txn_set(ini_txn_t *txn, char const *section, char const *key, char const *value);
+
+/**
+ * @brief Stages removing a key; removing a missing key is not an error.
+ * @param txn Transaction.
+ * @param section Section name (NULL for global keys).
+ * @param key Key name.
+ * @return Error details (INI_SUCCESS on success).
+ */
+INI_PUBLIC_API ini_status_t ini_txn_remove(ini_txn_t *txn, char const *section, char const *key);
+
+/// @brief Returns the number of staged changes (0 for NULL).
+INI_PUBLIC_API size_t ini_txn_size(ini_txn_t const *txn);
+
+/**
+ * @brief Applies the staged changes to the context, in order, and writes them to a file.
+ *
+ * An existing file is patched as by `ini_save_incremental()`, restricted to
+ * the keys of the transaction: however many changes were staged, the file is
+ * read once and replaced once. A missing file receives the whole context. If
+ * anything fails, including the file changing under the patch
+ * (INI_STATUS_FILE_CHANGED), the context is put back as it was and the file
+ * is left untouched. Either way the transaction is freed.
+ *
+ * @param txn Transaction from `ini_txn_begin()`.
+ * @param filepath File to update.
+ * @return Error details (INI_SUCCESS on success).
+ * @note Thread-safe: Holds the context's mutex while applying and writing.
+ * @note The changes do not join the dirty set of `ini_save_incremental()`.
+ */
+INI_PUBLIC_API ini_status_t ini_txn_commit(ini_txn_t *txn, char const *filepath);
+
+/// @brief Drops the staged changes and frees the transaction (NULL is ignored).
+INI_PUBLIC_API void ini_txn_abort(ini_txn_t *txn);
+
 /**
  * @brief Prints the INI context contents (for debugging).
  * @param stream Stream to print to. Example: stderr, stdout, file, etc.
@@ -30,6 +30,8 @@ typedef enum
     INI_STATUS_ITERATOR_END,                ///< Iterator has reached the end of the table.
     INI_STATUS_HAS_UTF8_BOM,                ///< File contains UTF-8 BOM.
     INI_STATUS_HASNT_UTF8_BOM,              ///< File does not contain UTF-8 BOM.
+    INI_STATUS_TYPE_MISMATCH,               ///< Value cannot be read as the requested type.
+    INI_STATUS_FILE_CHANGED,                ///< File changed since it was read.
     INI_STATUS_UNKNOWN_ERROR                ///< Unknown error.
 } ini_status_t;
 
@@ -0,0 +1,85 @@
+#ifndef INI_STREAM_H
+#define INI_STREAM_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "ini_constants.h"
+#include "ini_export.h"
+#include "ini_status.h"
+
+INI_EXTERN_C_BEGIN
+
+/// @brief What the tokenizer should do after a callback returns.
+typedef enum
+{
+    INI_PARSE_CONTINUE,    ///< Keep going.
+    INI_PARSE_STOP,        ///< Stop parsing; the parse function returns immediately.
+    INI_PARSE_SKIP_SECTION ///< Skip the rest of the current section without tokenizing it.
+} ini_parse_action_t;
+
+/**
+ * @brief Callbacks invoked by `ini_parse_stream()` and `ini_parse_buffer()`.
+ *
+ * Every string is passed as a pointer + length slice that is only valid for
+ * the duration of the call and is not null-terminated. Values are trimmed and
+ * stripped of surrounding quotes exactly as `ini_load()` stores them.
+ * Any callback may be NULL.
+ *
+ * Returning `INI_PARSE_SKIP_SECTION` fast-forwards to the next line that opens
+ * a section: skipped lines are only scanned for their first character, so they
+ * are neither validated nor reported (line numbers keep counting).
+ */
+typedef struct
+{
+    /// @brief A section header `[name]` was read.
+    ini_parse_action_t (*on_section)(void *user, char const *name, size_t name_len, unsigned line);
+
+    /// @brief A `key=value` pair was read inside `section`.
+    ini_parse_action_t (*on_key_value)(void *user,
+                                       char const *section, size_t section_len,
+                                       char const *key, size_t key_len,
+                                       char const *value, size_t value_len,
+                                       unsigned line);
+
+    /// @brief A comment line was read; `text` follows the `;` or `#` marker.
+    ini_parse_action_t (*on_comment)(void *user, char const *text, size_t text_len, unsigned line);
+
+    /// @brief A line violates the INI syntax accepted by `ini_good()`.
+    /// Returning INI_PARSE_CONTINUE skips the line. Without this callback parsing stops.
+    ini_parse_action_t (*on_error)(void *user, ini_status_t status, unsigned line);
+} ini_handler_t;
+
+/**
+ * @brief Tokenizes INI data from a stream without materializing it.
+ *
+ * Reads `source` in `INI_STREAM_BUFFER_SIZE` blocks and reports every line to
+ * `handler`, so memory use is constant regardless of the input size. A UTF-8
+ * BOM at the start of the stream is skipped.
+ *
+ * @param source Stream to read from (read until EOF).
+ * @param handler Callbacks to invoke, or NULL to only validate the syntax.
+ * @param user Opaque pointer passed to every callback.
+ * @return INI_STATUS_SUCCESS if the input was valid or a callback stopped the parse,
+ *         otherwise the first error encountered (e.g. INI_STATUS_FILE_BAD_FORMAT).
+ * @note Thread-safe: Uses no shared resources.
+ */
+INI_PUBLIC_API ini_status_t ini_parse_stream(FILE *source, ini_handler_t const *handler, void *user);
+
+/**
+ * @brief Tokenizes INI data held in memory.
+ *
+ * Same contract as `ini_parse_stream()`; slices point directly into `data`.
+ *
+ * @param data Input bytes (need not be null-terminated).
+ * @param size Number of bytes in `data`.
+ * @param handler Callbacks to invoke, or NULL to only validate the syntax.
+ * @param user Opaque pointer passed to every callback.
+ * @return INI_STATUS_SUCCESS if the input was valid or a callback stopped the parse,
+ *         otherwise the first error encountered.
+ */
+INI_PUBLIC_API ini_status_t ini_parse_buffer(char const *data, size_t size, ini_handler_t const *handler, void *user);
+
+INI_EXTERN_C_END
+
+#endif // !INI_STREAM_H
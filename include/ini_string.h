@@ -1,6 +1,8 @@
 #ifndef INI_STRING_H
 #define INI_STRING_H
 
+#include <stddef.h>
+
 #include "ini_export.h"
 
 INI_EXTERN_C_BEGIN
@@ -19,6 +21,47 @@ INI_PUBLIC_API char *ini_strdup(char const *s);
  */
 INI_PUBLIC_API unsigned ini_strstrip(char *s);
 
+/**
+ * @brief Tells whether a value must be written in double quotes.
+ *
+ * Blanks, `;` and `#` would be trimmed or read as a comment if the value
+ * were written bare. The check looks at eight bytes per step.
+ *
+ * @param value Value to check (need not be null-terminated).
+ * @param length Number of bytes in `value`.
+ * @return Non-zero if the value contains a space, a tab, `;` or `#`.
+ */
+INI_PUBLIC_API int ini_needs_quotes(char const *value, size_t length);
+
+/**
+ * @brief Tells whether a value reads back unchanged once written as `ini_save()` writes it.
+ *
+ * A line break would end the line, and a double quote cannot be escaped: a
+ * value that starts with one, or that needs quotes and holds one, would lose
+ * its quotes or break the line.
+ *
+ * @param value Value to check (need not be null-terminated).
+ * @param length Number of bytes in `value`.
+ * @return Non-zero if the value can be written.
+ */
+INI_PUBLIC_API int ini_value_writable(char const *value, size_t length);
+
+/**
+ * @brief `qsort()` comparator for an array of `char *`, in `strcmp()` order.
+ * @param lhs Pointer to the first string pointer.
+ * @param rhs Pointer to the second string pointer.
+ * @return Negative, zero or positive as `strcmp()`.
+ */
+INI_PUBLIC_API int ini_compare_strings(void const *lhs, void const *rhs);
+
+/**
+ * @brief Length of the UTF-8 BOM at the start of a buffer.
+ * @param data Buffer to check (need not be null-terminated).
+ * @param size Number of bytes in `data`.
+ * @return INI_UTF8_BOM_SIZE if `data` starts with a BOM, 0 otherwise.
+ */
+INI_PUBLIC_API size_t ini_utf8_bom_length(char const *data, size_t size);
+
 INI_EXTERN_C_END
 
 #endif // !INI_STRING_H
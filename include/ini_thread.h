@@ -0,0 +1,66 @@
+#ifndef INI_THREAD_H
+#define INI_THREAD_H
+
+#include <stddef.h>
+
+#include "ini_export.h"
+#include "ini_os_check.h"
+#include "ini_status.h"
+
+#if INI_OS_WINDOWS
+#include <windows.h>
+typedef HANDLE ini_thread_base_t; ///< Windows thread handle.
+#else
+#include <pthread.h>
+typedef pthread_t ini_thread_base_t; ///< POSIX thread type.
+#endif
+
+INI_EXTERN_C_BEGIN
+
+/// @brief Function executed by a thread created with `ini_thread_create()`.
+typedef void (*ini_thread_func_t)(void *arg);
+
+typedef struct
+{
+    ini_thread_base_t base; ///< Thread base type (platform specific, for Windows: HANDLE, for POSIX: pthread_t).
+} ini_thread_t;
+
+/**
+ * @brief Start a new thread.
+ * @param thread Thread object to initialize.
+ * @param func Function to run.
+ * @param arg Argument passed to `func`.
+ * @return INI_STATUS_SUCCESS on success, INI_STATUS_MEMORY_ERROR or INI_STATUS_PLATFORM_ERROR on error.
+ * @note Every successfully created thread must be joined with `ini_thread_join()`.
+ */
+INI_PUBLIC_API ini_status_t ini_thread_create(ini_thread_t *thread, ini_thread_func_t func, void *arg);
+
+/**
+ * @brief Wait for a thread to finish and release its resources.
+ * @param thread Thread to join.
+ * @return INI_STATUS_SUCCESS on success, INI_STATUS_PLATFORM_ERROR on error.
+ */
+INI_PUBLIC_API ini_status_t ini_thread_join(ini_thread_t *thread);
+
+/**
+ * @brief Check whether the calling thread is `thread`.
+ * @param thread Thread to compare with (must have been started and not joined).
+ * @return Non-zero if the caller runs on `thread`, 0 otherwise.
+ */
+INI_PUBLIC_API int ini_thread_is_current(ini_thread_t const *thread);
+
+/**
+ * @brief Suspend the calling thread.
+ * @param milliseconds Minimum time to sleep.
+ */
+INI_PUBLIC_API void ini_thread_sleep(unsigned milliseconds);
+
+/**
+ * @brief Number of hardware threads available to the process.
+ * @return Number of online processors, at least 1.
+ */
+INI_PUBLIC_API unsigned ini_thread_hardware_concurrency(void);
+
+INI_EXTERN_C_END
+
+#endif // !INI_THREAD_H
@@ -0,0 +1,57 @@
+#ifndef INI_WATCH_H
+#define INI_WATCH_H
+
+#include "ini_parser.h"
+
+INI_EXTERN_C_BEGIN
+
+/**
+ * @brief Called on the watcher thread after a watched file was reloaded.
+ * @param ctx Context that was reloaded.
+ * @param filepath Path passed to `ini_watch()`.
+ * @param status Result of the `ini_load()` call (the context is unchanged on error).
+ * @param user Pointer passed to `ini_watch()`.
+ */
+typedef void (*ini_watch_callback_t)(ini_context_t *ctx, char const *filepath, ini_status_t status, void *user);
+
+/**
+ * @brief Reloads `ctx` from `filepath` whenever the file changes.
+ *
+ * All watched files share one background thread. On Linux it sleeps in
+ * inotify on the parent directory of each file, so saves that replace the file
+ * through a rename are seen as well; elsewhere the files are polled with stat()
+ * every `INI_WATCH_POLL_INTERVAL_MS`. Bursts of events are debounced: the
+ * reload happens once no event arrived for `INI_WATCH_DEBOUNCE_MS` through
+ * `ini_reload_if_changed()`, so files whose fingerprint (or, with
+ * `INI_LOAD_CONTENT_HASH`, content) is unchanged are not parsed again and the
+ * callback is not invoked. The reload uses the context's load flags.
+ *
+ * @param ctx Context to keep up to date (already loaded by the caller).
+ * @param filepath Path of an existing INI file.
+ * @param callback Function notified after each reload, or NULL.
+ * @param user Opaque pointer passed to `callback`.
+ * @return INI_STATUS_SUCCESS on success, INI_STATUS_INVALID_ARGUMENT if the pair is
+ *         already watched, a file status error, or INI_STATUS_PLATFORM_ERROR.
+ * @note Thread-safe. Call `ini_unwatch()` before `ini_free()` on the context.
+ */
+INI_PUBLIC_API ini_status_t ini_watch(ini_context_t *ctx, char const *filepath,
+                                      ini_watch_callback_t callback, void *user);
+
+/**
+ * @brief Stops watching `filepath` for `ctx`.
+ *
+ * When called from another thread, waits for a reload of this pair that is in
+ * progress, so the callback never runs after `ini_unwatch()` returns. May also
+ * be called from within the callback. The background thread is stopped once no
+ * file is watched anymore.
+ *
+ * @param ctx Context passed to `ini_watch()`.
+ * @param filepath Path passed to `ini_watch()`.
+ * @return INI_STATUS_SUCCESS on success, INI_STATUS_INVALID_ARGUMENT if the pair is not watched.
+ * @note Thread-safe.
+ */
+INI_PUBLIC_API ini_status_t ini_unwatch(ini_context_t *ctx, char const *filepath);
+
+INI_EXTERN_C_END
+
+#endif // !INI_WATCH_H
@@ -0,0 +1,92 @@
+#ifndef INI_WRITER_H
+#define INI_WRITER_H
+
+#include <stddef.h>
+
+#include "ini_constants.h"
+#include "ini_export.h"
+#include "ini_filesystem.h"
+#include "ini_status.h"
+
+INI_EXTERN_C_BEGIN
+
+/**
+ * @file ini_writer.h
+ * @brief Writes INI text section by section without building a context.
+ *
+ * Output is collected in an `INI_WRITER_BUFFER_SIZE` buffer and handed to the
+ * system in large writes, so memory use stays constant however much is
+ * written. The text has the layout `ini_save()` produces: keys written before
+ * the first section are global, sections are separated by a blank line and
+ * values are quoted by the same rule.
+ *
+ * Names and values are written as given; text the parser would read back
+ * differently is rejected with INI_STATUS_INVALID_ARGUMENT and nothing is
+ * written. That is a line break anywhere, an empty name or key, a name or key
+ * starting or ending with a blank, `]` in a section name, `=` in a key, a
+ * key starting with `[`, `;` or `#`, and a value `ini_value_writable()`
+ * refuses (one starting with `"`, or holding `"` and needing quotes). A
+ * failed write sticks: later calls return its status and write nothing.
+ */
+
+/// @brief Streaming writer (opaque).
+typedef struct ini_writer_s ini_writer_t;
+
+/**
+ * @brief Opens a writer that replaces `filepath` when it is closed.
+ *
+ * The text goes to a temporary file next to `filepath` (see
+ * `ini_replace_begin()`), so the destination keeps its old contents until
+ * `ini_writer_close()` succeeds.
+ *
+ * @param filepath File to write.
+ * @param durability One of `ini_durability_t`.
+ * @param[out] writer Receives the writer.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT, INI_STATUS_FILE_OPEN_FAILED
+ *         or INI_STATUS_MEMORY_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_writer_open_path(char const *filepath, ini_durability_t durability,
+                                                 ini_writer_t **writer);
+
+/**
+ * @brief Opens a writer on a descriptor open for writing (file, pipe or socket).
+ *
+ * The descriptor is neither synced nor closed by the writer.
+ *
+ * @param fd Descriptor to write to.
+ * @param[out] writer Receives the writer.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT or INI_STATUS_MEMORY_ERROR.
+ */
+INI_PUBLIC_API ini_status_t ini_writer_open_fd(int fd, ini_writer_t **writer);
+
+/**
+ * @brief Starts a section; the keys written next belong to it.
+ * @param writer Writer.
+ * @param name Section name.
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT or the sticky error.
+ */
+INI_PUBLIC_API ini_status_t ini_writer_section(ini_writer_t *writer, char const *name);
+
+/**
+ * @brief Writes `key=value` into the current section.
+ * @param writer Writer.
+ * @param key Key name.
+ * @param value Value (quoted when `ini_needs_quotes()` says so).
+ * @return INI_STATUS_SUCCESS, INI_STATUS_INVALID_ARGUMENT or the sticky error.
+ */
+INI_PUBLIC_API ini_status_t ini_writer_kv(ini_writer_t *writer, char const *key, char const *value);
+
+/**
+ * @brief Writes out the buffered text, finishes the output and frees the writer.
+ *
+ * A path writer renames its file into place here, unless an earlier call
+ * failed, in which case the destination is left untouched.
+ *
+ * @param writer Writer (NULL is ignored).
+ * @return INI_STATUS_SUCCESS or the status of the first failed write.
+ */
+INI_PUBLIC_API ini_status_t ini_writer_close(ini_writer_t *writer);
+
+INI_EXTERN_C_END
+
+#endif // !INI_WRITER_H
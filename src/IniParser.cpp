@@ -165,6 +165,14 @@ namespace ini
         invalidateCache();
     }
 
+    void IniParser::loadDirectory(std::string const &dirpath, std::string const &pattern)
+    {
+        ensureContext();
+        auto status = ini_load_dir(m_context.get(), dirpath.c_str(), pattern.c_str());
+        checkStatus(status);
+        invalidateCache();
+    }
+
     ini_status_t IniParser::loadNoThrow(std::string const &filepath) noexcept
     {
         try
@@ -183,6 +191,42 @@ namespace ini
         }
     }
 
+    IniParser::ChangeList IniParser::reload(std::string const &filepath)
+    {
+        ensureContext();
+        ini_change_set_t changes = {};
+        auto status = ini_reload_incremental(m_context.get(), filepath.c_str(), &changes);
+        if (status != INI_STATUS_SUCCESS)
+        {
+            // A failed patch may have applied part of the changes
+            ini_free_changes(&changes);
+            invalidateCache();
+            checkStatus(status);
+        }
+
+        ChangeList result;
+        try
+        {
+            result.reserve(changes.count);
+            for (size_t i = 0; i < changes.count; i++)
+            {
+                auto const &change = changes.items[i];
+                result.push_back(Change{change.kind, change.section,
+                                        change.key ? change.key : "", change.key == nullptr});
+            }
+            patchCache(result);
+        }
+        catch (...)
+        {
+            ini_free_changes(&changes);
+            invalidateCache();
+            throw;
+        }
+
+        ini_free_changes(&changes);
+        return result;
+    }
+
     void IniParser::save(std::string const &filepath) const
     {
         if (!m_context.get())
@@ -193,6 +237,48 @@ namespace ini
         checkStatus(status);
     }
 
+    std::string IniParser::saveToString() const
+    {
+        if (!m_context.get())
+        {
+            throw IniException("No data to save - parser is empty");
+        }
+        char *text = nullptr;
+        size_t size = 0;
+        auto status = ini_save_to_buffer(m_context.get(), &text, &size);
+        checkStatus(status);
+        std::unique_ptr<char, void (*)(void *)> owned(text, free);
+        return std::string(owned.get(), size);
+    }
+
+    void IniParser::saveIncremental(std::string const &filepath)
+    {
+        if (!m_context.get())
+        {
+            throw IniException("No data to save - parser is empty");
+        }
+        auto status = ini_save_incremental(m_context.get(), filepath.c_str());
+        checkStatus(status);
+    }
+
+    void IniParser::saveBinary(std::string const &filepath) const
+    {
+        if (!m_context.get())
+        {
+            throw IniException("No data to save - parser is empty");
+        }
+        auto status = ini_save_binary(m_context.get(), filepath.c_str());
+        checkStatus(status);
+    }
+
+    void IniParser::loadBinary(std::string const &filepath)
+    {
+        ensureContext();
+        auto status = ini_load_binary(m_context.get(), filepath.c_str());
+        checkStatus(status);
+        invalidateCache();
+    }
+
     void IniParser::saveSection(std::string const &filepath, std::string const &section,
                                 const std::string *key) const
     {
@@ -234,6 +320,22 @@ namespace ini
         return result;
     }
 
+    void IniParser::getItems(std::string const &section, std::string const &key, ini_span_t const *&items,
+                             size_t &count) const
+    {
+        if (!m_context.get())
+        {
+            throw KeyNotFoundException(section, key);
+        }
+
+        auto status = ini_get_array(m_context.get(), section.c_str(), key.c_str(), &items, &count);
+        if (status == INI_STATUS_SECTION_NOT_FOUND || status == INI_STATUS_KEY_NOT_FOUND)
+        {
+            throw KeyNotFoundException(section, key);
+        }
+        checkStatus(status);
+    }
+
     bool IniParser::hasKey(std::string const &section, std::string const &key) const noexcept
     {
         try
@@ -254,8 +356,8 @@ namespace ini
             return false;
         }
 
-        // Try to get the section hash table
-        auto *section_ht = ini_get_section_ht(m_context.get()->sections, section.c_str());
+        // Try to get the section hash table (indexes it first after a lazy or binary load)
+        auto *section_ht = ini_get_section(m_context.get(), section.c_str());
         return section_ht != nullptr;
     }
 
@@ -265,28 +367,55 @@ namespace ini
     {
         ensureContext();
 
-        // Get or create section
-        auto *section_ht = ini_get_section_ht(m_context.get()->sections, section.c_str());
-        if (!section_ht)
-        {
-            // Create new section
-            section_ht = ini_ht_create();
-            if (!section_ht)
-            {
-                throw IniException(INI_STATUS_MEMORY_ERROR);
-            }
-            ini_store_section_ht(m_context.get()->sections, section.c_str(), section_ht);
-        }
+        // Creates the section if needed and marks the key for saveIncremental()
+        auto status = ini_set_value(m_context.get(), section.c_str(), key.c_str(), value.c_str());
+        checkStatus(status);
+
+        invalidateCache();
+        return *this;
+    }
+
+    // ==================== Transactions ====================
+
+    IniParser::Transaction &IniParser::Transaction::setString(std::string const &section, std::string const &key,
+                                                              std::string const &value)
+    {
+        m_ops.push_back(Op{section, key, value, false});
+        return *this;
+    }
 
-        // Set the key-value pair
-        auto result = ini_ht_set(section_ht, key.c_str(), value.c_str());
-        if (!result)
+    IniParser::Transaction &IniParser::Transaction::remove(std::string const &section, std::string const &key)
+    {
+        m_ops.push_back(Op{section, key, std::string(), true});
+        return *this;
+    }
+
+    void IniParser::Transaction::commit(std::string const &filepath)
+    {
+        m_parser->ensureContext();
+        std::vector<Op> ops;
+        ops.swap(m_ops);
+
+        // Staged against the context only now, so a parser reassigned meanwhile is still valid
+        ini_txn_t *txn = ini_txn_begin(m_parser->m_context.get());
+        if (!txn)
         {
             throw IniException(INI_STATUS_MEMORY_ERROR);
         }
+        for (auto const &op : ops)
+        {
+            auto status = op.remove ? ini_txn_remove(txn, op.section.c_str(), op.key.c_str())
+                                    : ini_txn_set(txn, op.section.c_str(), op.key.c_str(), op.value.c_str());
+            if (status != INI_STATUS_SUCCESS)
+            {
+                ini_txn_abort(txn);
+                checkStatus(status);
+            }
+        }
 
-        invalidateCache();
-        return *this;
+        auto status = ini_txn_commit(txn, filepath.c_str());
+        m_parser->invalidateCache();
+        checkStatus(status);
     }
 
     // ==================== Container Interface ====================
@@ -301,13 +430,18 @@ namespace ini
         m_data.clear();
 
         // Iterate through all sections
-        ini_ht_iterator_t sections_it = ini_ht_iterator(m_context.get()->sections);
+        auto *sections = ini_get_sections(m_context.get());
+        if (!sections)
+        {
+            throw IniException(INI_STATUS_MEMORY_ERROR);
+        }
+        ini_ht_iterator_t sections_it = ini_ht_iterator(sections);
         char *section_name;
         char *section_ptr_str;
 
         while (ini_ht_next(&sections_it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
         {
-            auto *section_ht = ini_get_section_ht(m_context.get()->sections, section_name);
+            auto *section_ht = ini_get_section_ht(sections, section_name);
             if (section_ht)
             {
                 SectionMap section_map;
@@ -329,6 +463,45 @@ namespace ini
         m_dataCached = true;
     }
 
+    void IniParser::patchCache(ChangeList const &changes) const
+    {
+        if (!m_dataCached)
+        {
+            return;
+        }
+
+        for (auto const &change : changes)
+        {
+            if (change.kind == INI_CHANGE_REMOVED)
+            {
+                if (change.wholeSection)
+                {
+                    m_data.erase(change.section);
+                    continue;
+                }
+                auto section = m_data.find(change.section);
+                if (section != m_data.end())
+                {
+                    section->second.erase(change.key);
+                }
+                continue;
+            }
+
+            auto &section_map = m_data[change.section];
+            if (change.wholeSection)
+            {
+                continue;
+            }
+
+            auto *section_ht = ini_get_section(m_context.get(), change.section.c_str());
+            char const *value = section_ht ? ini_ht_get(section_ht, change.key.c_str()) : nullptr;
+            if (value)
+            {
+                section_map[change.key] = value;
+            }
+        }
+    }
+
     IniParser::DataMap IniParser::getAllData() const
     {
         populateCache();
@@ -444,7 +617,7 @@ namespace ini
         }
 
         // Check if there are any sections
-        ini_ht_iterator_t it = ini_ht_iterator(m_context.get()->sections);
+        ini_ht_iterator_t it = ini_ht_iterator(ini_get_sections(m_context.get()));
         char *section_name;
         char *section_ptr_str;
 
@@ -0,0 +1,502 @@
+#define INI_IMPLEMENTATION
+#include "ini_batch_read.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef INI_HAVE_IO_URING
+#define INI_HAVE_IO_URING 0
+#endif
+
+#if INI_HAVE_IO_URING
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <linux/stat.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+/// @brief Submission and completion rings shared with the kernel.
+typedef struct
+{
+    int fd;                    ///< Ring file descriptor (-1 if none).
+    unsigned *sq_head;         ///< Kernel-owned submission head.
+    unsigned *sq_tail;         ///< Our submission tail.
+    unsigned *sq_mask;         ///< Submission ring index mask.
+    unsigned *sq_array;        ///< Submission slot → SQE index.
+    unsigned *cq_head;         ///< Our completion head.
+    unsigned *cq_tail;         ///< Kernel-owned completion tail.
+    unsigned *cq_mask;         ///< Completion ring index mask.
+    struct io_uring_sqe *sqes; ///< Submission queue entries.
+    struct io_uring_cqe *cqes; ///< Completion queue entries.
+    void *sq_ring;             ///< Mapping of the submission ring.
+    size_t sq_ring_size;       ///< Size of `sq_ring`.
+    void *cq_ring;             ///< Mapping of the completion ring (may alias `sq_ring`).
+    size_t cq_ring_size;       ///< Size of `cq_ring` (0 when it aliases `sq_ring`).
+    size_t sqes_size;          ///< Size of the `sqes` mapping.
+    unsigned prepared;         ///< Entries filled in but not yet published.
+} uring_t;
+
+/// @brief Per-file state of one io_uring round.
+typedef struct
+{
+    char *buffer;        ///< Reused read buffer.
+    size_t capacity;     ///< Usable bytes of `buffer`, excluding the terminator.
+    struct statx stx;    ///< Filled by the statx request.
+    int stat_error;      ///< errno of a failed statx (0 if none).
+    int fd;              ///< Descriptor opened by the openat request (-1 if none).
+    size_t requested;    ///< Bytes asked for by the read request.
+    size_t size;         ///< Bytes read.
+    ini_status_t status; ///< Outcome so far.
+} batch_slot_t;
+#endif
+
+struct ini_batch_reader_s
+{
+    char *buffer;    ///< Buffer of the portable path.
+    size_t capacity; ///< Usable bytes of `buffer`.
+#if INI_HAVE_IO_URING
+    int use_ring;                            ///< Non-zero while `ring` is usable.
+    uring_t ring;                            ///< Ring shared by all rounds.
+    batch_slot_t slots[INI_BATCH_READ_SIZE]; ///< One slot per file of a round.
+#endif
+};
+
+#if INI_HAVE_IO_URING
+// Two requests per file in each stage
+#define INI_BATCH_RING_ENTRIES (2 * INI_BATCH_READ_SIZE)
+
+static void uring_close(uring_t *ring)
+{
+    // Closing the ring first lets the kernel finish with our buffers
+    if (ring->fd >= 0)
+        close(ring->fd);
+    if (ring->sqes)
+        munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring && ring->cq_ring_size)
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring)
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+// Non-zero if the kernel implements every operation a round needs
+static int uring_supports_ops(int fd)
+{
+    unsigned const count = 256;
+    struct io_uring_probe *probe = (struct io_uring_probe *)calloc(
+        1, sizeof(struct io_uring_probe) + count * sizeof(struct io_uring_probe_op));
+    if (!probe)
+        return 0;
+
+    int supported = syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, count) >= 0;
+    static int const ops[] = {IORING_OP_STATX, IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE};
+    for (size_t i = 0; supported && i < sizeof(ops) / sizeof(ops[0]); i++)
+        supported = ops[i] <= probe->last_op && (probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED);
+    free(probe);
+    return supported;
+}
+
+static int uring_open(uring_t *ring, unsigned entries)
+{
+    memset(ring, 0, sizeof(*ring));
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0)
+    {
+        ring->fd = -1;
+        return 0;
+    }
+    if (!uring_supports_ops(ring->fd))
+    {
+        uring_close(ring);
+        return 0;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    int single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && ring->cq_ring_size > ring->sq_ring_size)
+        ring->sq_ring_size = ring->cq_ring_size;
+
+    void *sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+                         IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED)
+    {
+        uring_close(ring);
+        return 0;
+    }
+    ring->sq_ring = sq_ring;
+
+    if (single_mmap)
+    {
+        ring->cq_ring = sq_ring;
+        ring->cq_ring_size = 0;
+    }
+    else
+    {
+        void *cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ring->fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED)
+        {
+            uring_close(ring);
+            return 0;
+        }
+        ring->cq_ring = cq_ring;
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        uring_close(ring);
+        return 0;
+    }
+    ring->sqes = (struct io_uring_sqe *)sqes;
+
+    char *sq = (char *)ring->sq_ring;
+    char *cq = (char *)ring->cq_ring;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return 1;
+}
+
+// Next submission entry, cleared; a stage never prepares more entries than the ring holds
+static struct io_uring_sqe *uring_get_sqe(uring_t *ring, uint64_t user_data)
+{
+    unsigned tail = *ring->sq_tail + ring->prepared;
+    unsigned index = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->user_data = user_data;
+    ring->sq_array[index] = index;
+    ring->prepared++;
+    return sqe;
+}
+
+/**
+ * @brief Publishes the prepared entries and waits for `expected` completions.
+ *
+ * Every completion is handed to `complete`. Returns zero if the kernel
+ * rejected the submission, in which case the ring must not be used again.
+ */
+static int uring_submit_and_wait(uring_t *ring, unsigned expected, void (*complete)(void *, uint64_t, int32_t),
+                                 void *user)
+{
+    unsigned to_submit = ring->prepared;
+    __atomic_store_n(ring->sq_tail, *ring->sq_tail + ring->prepared, __ATOMIC_RELEASE);
+    ring->prepared = 0;
+
+    unsigned reaped = 0;
+    while (reaped < expected)
+    {
+        int submitted = (int)syscall(__NR_io_uring_enter, ring->fd, to_submit, expected - reaped,
+                                     IORING_ENTER_GETEVENTS, NULL, 0);
+        if (submitted < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return 0;
+        }
+        to_submit -= (unsigned)submitted < to_submit ? (unsigned)submitted : to_submit;
+
+        unsigned head = *ring->cq_head;
+        unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++, reaped++)
+        {
+            struct io_uring_cqe const *cqe = &ring->cqes[head & *ring->cq_mask];
+            complete(user, cqe->user_data, cqe->res);
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+    return 1;
+}
+
+// Request tags: slot number in the high bits, request kind in the lowest bit
+#define SLOT_TAG(slot, second) (((uint64_t)(slot) << 1) | (second))
+
+static void complete_open_stage(void *user, uint64_t tag, int32_t res)
+{
+    batch_slot_t *slot = &((batch_slot_t *)user)[tag >> 1];
+    if (tag & 1)
+        slot->fd = res >= 0 ? res : -1;
+    else
+        slot->stat_error = res < 0 ? -res : 0;
+}
+
+static void complete_read_stage(void *user, uint64_t tag, int32_t res)
+{
+    batch_slot_t *slot = &((batch_slot_t *)user)[tag >> 1];
+    if (tag & 1)
+    {
+        // The close is hard-linked to the read; if it never ran, close here
+        if (res == -ECANCELED)
+            close(slot->fd);
+        slot->fd = -1;
+    }
+    else if (res < 0)
+        slot->status = INI_STATUS_FILE_OPEN_FAILED;
+    else
+        slot->size = (size_t)res;
+}
+
+// Maps a statx result like `ini_check_file_status()` maps stat()
+static ini_status_t classify_slot(batch_slot_t const *slot)
+{
+    if (slot->stat_error)
+    {
+        switch (slot->stat_error)
+        {
+        case ENOENT:
+            return INI_STATUS_FILE_NOT_FOUND;
+        case EACCES:
+            return INI_STATUS_FILE_PERMISSION_DENIED;
+        default:
+            return INI_STATUS_UNKNOWN_ERROR;
+        }
+    }
+    if (S_ISDIR(slot->stx.stx_mode))
+        return INI_STATUS_FILE_IS_DIR;
+    if (!S_ISREG(slot->stx.stx_mode))
+        return INI_STATUS_FILE_BAD_FORMAT;
+    if (slot->stx.stx_size == 0)
+        return INI_STATUS_FILE_EMPTY;
+    if (slot->fd < 0)
+        return INI_STATUS_FILE_OPEN_FAILED;
+    return INI_STATUS_SUCCESS;
+}
+
+static void slot_fingerprint(batch_slot_t const *slot, ini_file_fingerprint_t *fingerprint)
+{
+    fingerprint->device = (uint64_t)makedev(slot->stx.stx_dev_major, slot->stx.stx_dev_minor);
+    fingerprint->inode = slot->stx.stx_ino;
+    fingerprint->size = slot->stx.stx_size;
+    fingerprint->mtime_ns = (int64_t)slot->stx.stx_mtime.tv_sec * 1000000000LL + slot->stx.stx_mtime.tv_nsec;
+}
+
+/**
+ * @brief Reads up to `INI_BATCH_READ_SIZE` files through the ring.
+ *
+ * Stage one submits statx and openat for every file at once; stage two sizes
+ * each buffer from statx and submits every read hard-linked to its close.
+ * Each read asks for one byte more than statx reported, so a file that grew
+ * in between is noticed and read again the portable way.
+ * Returns zero if the ring failed; nothing was delivered then.
+ */
+static int read_round_uring(ini_batch_reader_t *reader, char const *const *paths, size_t count,
+                            ini_batch_read_callback_t callback, void *user)
+{
+    uring_t *ring = &reader->ring;
+    batch_slot_t *slots = reader->slots;
+    unsigned expected = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        batch_slot_t *slot = &slots[i];
+        slot->stat_error = 0;
+        slot->fd = -1;
+        slot->size = 0;
+        slot->status = paths[i] && *paths[i] ? INI_STATUS_SUCCESS : INI_STATUS_INVALID_ARGUMENT;
+        if (slot->status != INI_STATUS_SUCCESS)
+            continue;
+
+        struct io_uring_sqe *sqe = uring_get_sqe(ring, SLOT_TAG(i, 0));
+        sqe->opcode = IORING_OP_STATX;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (uint64_t)(uintptr_t)paths[i];
+        sqe->len = STATX_BASIC_STATS;
+        sqe->off = (uint64_t)(uintptr_t)&slot->stx;
+
+        sqe = uring_get_sqe(ring, SLOT_TAG(i, 1));
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = (uint64_t)(uintptr_t)paths[i];
+        sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        expected += 2;
+    }
+    if (!uring_submit_and_wait(ring, expected, complete_open_stage, slots))
+        return 0;
+
+    expected = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        batch_slot_t *slot = &slots[i];
+        if (slot->status == INI_STATUS_SUCCESS)
+            slot->status = classify_slot(slot);
+
+        if (slot->status == INI_STATUS_SUCCESS && slot->capacity < slot->stx.stx_size + 1)
+        {
+            char *grown = (char *)realloc(slot->buffer, slot->stx.stx_size + 2);
+            if (grown)
+            {
+                slot->buffer = grown;
+                slot->capacity = slot->stx.stx_size + 1;
+            }
+            else
+                slot->status = INI_STATUS_MEMORY_ERROR;
+        }
+        if (slot->fd < 0)
+            continue;
+
+        if (slot->status == INI_STATUS_SUCCESS)
+        {
+            slot->requested = slot->stx.stx_size + 1;
+            struct io_uring_sqe *sqe = uring_get_sqe(ring, SLOT_TAG(i, 0));
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = slot->fd;
+            sqe->addr = (uint64_t)(uintptr_t)slot->buffer;
+            sqe->len = (unsigned)slot->requested;
+            sqe->off = 0;
+            sqe->flags = IOSQE_IO_HARDLINK;
+            expected++;
+        }
+
+        struct io_uring_sqe *sqe = uring_get_sqe(ring, SLOT_TAG(i, 1));
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = slot->fd;
+        expected++;
+    }
+    if (!uring_submit_and_wait(ring, expected, complete_read_stage, slots))
+        return 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        batch_slot_t *slot = &slots[i];
+        ini_file_fingerprint_t fingerprint;
+        if (slot->status == INI_STATUS_SUCCESS)
+        {
+            slot_fingerprint(slot, &fingerprint);
+            if (slot->size == slot->requested)
+            {
+                // Grew since statx: take the slow path for this one
+                slot->status = ini_get_file_fingerprint(paths[i], &fingerprint);
+                if (slot->status == INI_STATUS_SUCCESS)
+                    slot->status = ini_read_file_reuse(paths[i], &slot->buffer, &slot->capacity, &slot->size);
+            }
+            else
+                slot->buffer[slot->size] = '\0';
+        }
+
+        int ok = slot->status == INI_STATUS_SUCCESS;
+        callback(user, i, slot->status, ok ? slot->buffer : NULL, ok ? slot->size : 0, ok ? &fingerprint : NULL);
+    }
+    return 1;
+}
+#endif
+
+// Reads one file the portable way and delivers it
+static void read_file_portable(ini_batch_reader_t *reader, char const *filepath, size_t index,
+                               ini_batch_read_callback_t callback, void *user)
+{
+    ini_file_fingerprint_t fingerprint;
+    size_t size = 0;
+    ini_status_t err = filepath && *filepath ? ini_check_file_status(filepath) : INI_STATUS_INVALID_ARGUMENT;
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_get_file_fingerprint(filepath, &fingerprint);
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_read_file_reuse(filepath, &reader->buffer, &reader->capacity, &size);
+
+    int ok = err == INI_STATUS_SUCCESS;
+    callback(user, index, err, ok ? reader->buffer : NULL, size, ok ? &fingerprint : NULL);
+}
+
+INI_PUBLIC_API ini_batch_reader_t *ini_batch_reader_create(unsigned flags)
+{
+    ini_batch_reader_t *reader = (ini_batch_reader_t *)calloc(1, sizeof(ini_batch_reader_t));
+    if (!reader)
+        return NULL;
+
+#if INI_HAVE_IO_URING
+    reader->ring.fd = -1;
+    if (!(flags & INI_BATCH_READ_NO_IO_URING))
+        reader->use_ring = uring_open(&reader->ring, INI_BATCH_RING_ENTRIES);
+#else
+    (void)flags;
+#endif
+    return reader;
+}
+
+INI_PUBLIC_API void ini_batch_reader_destroy(ini_batch_reader_t *reader)
+{
+    if (!reader)
+        return;
+
+#if INI_HAVE_IO_URING
+    uring_close(&reader->ring);
+    for (size_t i = 0; i < INI_BATCH_READ_SIZE; i++)
+        free(reader->slots[i].buffer);
+#endif
+    free(reader->buffer);
+    free(reader);
+}
+
+INI_PUBLIC_API int ini_batch_reader_uses_io_uring(ini_batch_reader_t const *reader)
+{
+#if INI_HAVE_IO_URING
+    return reader && reader->use_ring;
+#else
+    (void)reader;
+    return 0;
+#endif
+}
+
+// Offsets the indexes of one round back into the caller's `paths` array
+typedef struct
+{
+    ini_batch_read_callback_t callback;
+    void *user;
+    size_t offset;
+} batch_round_t;
+
+#if INI_HAVE_IO_URING
+static void deliver_round(void *user, size_t index, ini_status_t status, char *data, size_t size,
+                          ini_file_fingerprint_t const *fingerprint)
+{
+    batch_round_t const *round = (batch_round_t const *)user;
+    round->callback(round->user, round->offset + index, status, data, size, fingerprint);
+}
+#endif
+
+INI_PUBLIC_API ini_status_t ini_batch_reader_read(ini_batch_reader_t *reader, char const *const *paths, size_t count,
+                                                  ini_batch_read_callback_t callback, void *user)
+{
+    if (!reader || (!paths && count) || !callback)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    size_t done = 0;
+#if INI_HAVE_IO_URING
+    while (reader->use_ring && done < count)
+    {
+        batch_round_t round;
+        round.callback = callback;
+        round.user = user;
+        round.offset = done;
+        size_t round_size = count - done < INI_BATCH_READ_SIZE ? count - done : INI_BATCH_READ_SIZE;
+        if (!read_round_uring(reader, paths + done, round_size, deliver_round, &round))
+        {
+            // The kernel gave up on the ring; the rest goes the portable way
+            uring_close(&reader->ring);
+            reader->use_ring = 0;
+            break;
+        }
+        done += round_size;
+    }
+#endif
+
+    for (; done < count; done++)
+        read_file_portable(reader, paths[done], done, callback, user);
+    return INI_STATUS_SUCCESS;
+}
@@ -0,0 +1,340 @@
+#define INI_IMPLEMENTATION
+#include "ini_binary.h"
+#include "ini_parser.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Smallest power of two holding `count` entries at a load factor of at most 1/2
+static uint64_t index_capacity(uint64_t count)
+{
+    uint64_t capacity = 2;
+    while (capacity < count * 2)
+        capacity *= 2;
+    return capacity;
+}
+
+// Inserts record `record` (zero-based) into an open-addressing index
+static void index_insert(uint32_t *slots, uint32_t capacity, char const *name, uint32_t record)
+{
+    uint32_t mask = capacity - 1;
+    uint32_t slot = (uint32_t)(hash_key(name) & mask);
+    while (slots[slot] != 0)
+        slot = (slot + 1) & mask;
+    slots[slot] = record + 1;
+}
+
+// Appends a null-terminated string to the blob and returns its offset
+static uint32_t append_string(char *strings, uint32_t *used, char const *str)
+{
+    uint32_t offset = *used;
+    size_t length = strlen(str) + 1;
+    memcpy(strings + offset, str, length);
+    *used += (uint32_t)length;
+    return offset;
+}
+
+INI_PUBLIC_API ini_status_t ini_binary_build(ini_ht_t *sections, char **image, size_t *size)
+{
+    if (!sections || !image || !size)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    *image = NULL;
+    *size = 0;
+
+    // First pass: sizes of every part
+    uint64_t section_count = 0;
+    uint64_t pair_count = 0;
+    uint64_t key_index_size = 0;
+    uint64_t strings_size = 1; // Offset 0 holds the empty string
+
+    ini_ht_iterator_t it = ini_ht_iterator(sections);
+    char *name;
+    char *ptr_str;
+    while (ini_ht_next(&it, &name, &ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_t *section_ht = ini_get_section_ht(sections, name);
+        if (!section_ht)
+            continue;
+
+        uint64_t length = ini_ht_length(section_ht);
+        section_count++;
+        pair_count += length;
+        key_index_size += index_capacity(length);
+        strings_size += strlen(name) + 1;
+
+        ini_ht_iterator_t pair_it = ini_ht_iterator(section_ht);
+        char *key;
+        char *value;
+        while (ini_ht_next(&pair_it, &key, &value) == INI_STATUS_SUCCESS)
+            strings_size += strlen(key) + strlen(value) + 2;
+    }
+
+    uint64_t section_index_capacity = index_capacity(section_count);
+    uint64_t sections_offset = sizeof(ini_binary_header_t);
+    uint64_t pairs_offset = sections_offset + section_count * sizeof(ini_binary_section_t);
+    uint64_t section_index_offset = pairs_offset + pair_count * sizeof(ini_binary_pair_t);
+    uint64_t key_index_offset = section_index_offset + section_index_capacity * sizeof(uint32_t);
+    uint64_t strings_offset = key_index_offset + key_index_size * sizeof(uint32_t);
+    uint64_t total = strings_offset + strings_size;
+    if (total > UINT32_MAX || total > SIZE_MAX)
+        return INI_STATUS_LACK_OF_MEMORY;
+
+    char *data = calloc(1, (size_t)total);
+    if (!data)
+        return INI_STATUS_MEMORY_ERROR;
+
+    ini_binary_header_t *header = (ini_binary_header_t *)data;
+    ini_binary_section_t *section_records = (ini_binary_section_t *)(data + sections_offset);
+    ini_binary_pair_t *pair_records = (ini_binary_pair_t *)(data + pairs_offset);
+    uint32_t *section_index = (uint32_t *)(data + section_index_offset);
+    uint32_t *key_index = (uint32_t *)(data + key_index_offset);
+    char *strings = data + strings_offset;
+
+    // Second pass: records, indexes and strings
+    uint32_t strings_used = 1;
+    uint32_t section_no = 0;
+    uint32_t pair_no = 0;
+    uint32_t key_slot = 0;
+
+    it = ini_ht_iterator(sections);
+    while (ini_ht_next(&it, &name, &ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_t *section_ht = ini_get_section_ht(sections, name);
+        if (!section_ht)
+            continue;
+
+        ini_binary_section_t *record = &section_records[section_no];
+        record->name = append_string(strings, &strings_used, name);
+        record->first_pair = pair_no;
+        record->index = key_slot;
+        record->index_capacity = (uint32_t)index_capacity(ini_ht_length(section_ht));
+
+        ini_ht_iterator_t pair_it = ini_ht_iterator(section_ht);
+        char *key;
+        char *value;
+        while (ini_ht_next(&pair_it, &key, &value) == INI_STATUS_SUCCESS)
+        {
+            pair_records[pair_no].key = append_string(strings, &strings_used, key);
+            pair_records[pair_no].value = append_string(strings, &strings_used, value);
+            index_insert(key_index + key_slot, record->index_capacity, key, record->pair_count++);
+            pair_no++;
+        }
+
+        index_insert(section_index, (uint32_t)section_index_capacity, name, section_no);
+        key_slot += record->index_capacity;
+        section_no++;
+    }
+
+    memcpy(header->magic, INI_BINARY_MAGIC, sizeof(header->magic));
+    header->version = INI_BINARY_VERSION;
+    header->byte_order = INI_BINARY_BYTE_ORDER;
+    header->size = total;
+    header->section_count = section_no;
+    header->pair_count = pair_no;
+    header->section_index_capacity = (uint32_t)section_index_capacity;
+    header->key_index_size = key_slot;
+    header->sections_offset = (uint32_t)sections_offset;
+    header->pairs_offset = (uint32_t)pairs_offset;
+    header->section_index_offset = (uint32_t)section_index_offset;
+    header->key_index_offset = (uint32_t)key_index_offset;
+    header->strings_offset = (uint32_t)strings_offset;
+    header->strings_size = (uint32_t)strings_size;
+    header->checksum = hash_bytes(data + sizeof(ini_binary_header_t), (size_t)total - sizeof(ini_binary_header_t));
+
+    *image = data;
+    *size = (size_t)total;
+    return INI_STATUS_SUCCESS;
+}
+
+// Non-zero if `count` elements of `element` bytes at `offset` fit in `size`
+static int fits(uint64_t offset, uint64_t count, uint64_t element, uint64_t size)
+{
+    return offset <= size && count <= (size - offset) / element;
+}
+
+static int is_power_of_two(uint32_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+INI_PUBLIC_API ini_status_t ini_binary_validate(void const *image, size_t size)
+{
+    if (!image || ((uintptr_t)image % sizeof(uint64_t)) != 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_binary_header_t const *header = (ini_binary_header_t const *)image;
+    if (size < sizeof(ini_binary_header_t) ||
+        memcmp(header->magic, INI_BINARY_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != INI_BINARY_VERSION ||
+        header->byte_order != INI_BINARY_BYTE_ORDER ||
+        header->size != size)
+        return INI_STATUS_FILE_BAD_FORMAT;
+
+    // Every array is 4-byte aligned and inside the image
+    if ((header->sections_offset | header->pairs_offset | header->section_index_offset |
+         header->key_index_offset) % sizeof(uint32_t) != 0 ||
+        !fits(header->sections_offset, header->section_count, sizeof(ini_binary_section_t), size) ||
+        !fits(header->pairs_offset, header->pair_count, sizeof(ini_binary_pair_t), size) ||
+        !fits(header->section_index_offset, header->section_index_capacity, sizeof(uint32_t), size) ||
+        !fits(header->key_index_offset, header->key_index_size, sizeof(uint32_t), size) ||
+        !fits(header->strings_offset, header->strings_size, 1, size) ||
+        !is_power_of_two(header->section_index_capacity) ||
+        header->strings_size == 0)
+        return INI_STATUS_FILE_BAD_FORMAT;
+
+    char const *data = (char const *)image;
+    if (hash_bytes(data + sizeof(ini_binary_header_t), size - sizeof(ini_binary_header_t)) != header->checksum)
+        return INI_STATUS_FILE_BAD_FORMAT;
+
+    // A final null byte bounds every string that starts inside the blob
+    char const *strings = data + header->strings_offset;
+    if (strings[header->strings_size - 1] != '\0')
+        return INI_STATUS_FILE_BAD_FORMAT;
+
+    ini_binary_section_t const *sections = (ini_binary_section_t const *)(data + header->sections_offset);
+    for (uint32_t i = 0; i < header->section_count; i++)
+    {
+        ini_binary_section_t const *section = &sections[i];
+        if (section->name >= header->strings_size ||
+            section->first_pair > header->pair_count ||
+            section->pair_count > header->pair_count - section->first_pair ||
+            !is_power_of_two(section->index_capacity) ||
+            section->index > header->key_index_size ||
+            section->index_capacity > header->key_index_size - section->index)
+            return INI_STATUS_FILE_BAD_FORMAT;
+    }
+
+    ini_binary_pair_t const *pairs = (ini_binary_pair_t const *)(data + header->pairs_offset);
+    for (uint32_t i = 0; i < header->pair_count; i++)
+    {
+        if (pairs[i].key >= header->strings_size || pairs[i].value >= header->strings_size)
+            return INI_STATUS_FILE_BAD_FORMAT;
+    }
+
+    return INI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Probes an index for `name`.
+ *
+ * `names` receives a record number and returns its name. Probing is bounded by
+ * the capacity and slot values by `count`, so a damaged index cannot loop or
+ * read out of bounds.
+ *
+ * @return Zero-based record number, or UINT32_MAX if absent.
+ */
+static uint32_t index_find(uint32_t const *slots, uint32_t capacity, uint32_t count, char const *name,
+                           char const *(*names)(void const *context, uint32_t record), void const *context)
+{
+    uint32_t mask = capacity - 1;
+    uint32_t slot = (uint32_t)(hash_key(name) & mask);
+    for (uint32_t probes = 0; probes < capacity; probes++, slot = (slot + 1) & mask)
+    {
+        uint32_t record = slots[slot];
+        if (record == 0 || record > count)
+            return UINT32_MAX;
+        if (strcmp(names(context, record - 1), name) == 0)
+            return record - 1;
+    }
+    return UINT32_MAX;
+}
+
+/// @brief Image parts resolved once per lookup.
+typedef struct
+{
+    ini_binary_header_t const *header;
+    ini_binary_section_t const *sections;
+    ini_binary_pair_t const *pairs; ///< Pairs of the section being searched.
+    char const *strings;
+} image_view_t;
+
+static image_view_t image_view(void const *image)
+{
+    char const *data = (char const *)image;
+    image_view_t view;
+    view.header = (ini_binary_header_t const *)image;
+    view.sections = (ini_binary_section_t const *)(data + view.header->sections_offset);
+    view.pairs = (ini_binary_pair_t const *)(data + view.header->pairs_offset);
+    view.strings = data + view.header->strings_offset;
+    return view;
+}
+
+static char const *section_name(void const *context, uint32_t record)
+{
+    image_view_t const *view = (image_view_t const *)context;
+    return view->strings + view->sections[record].name;
+}
+
+static char const *pair_key(void const *context, uint32_t record)
+{
+    image_view_t const *view = (image_view_t const *)context;
+    return view->strings + view->pairs[record].key;
+}
+
+INI_PUBLIC_API ini_status_t ini_binary_lookup(void const *image, char const *section, char const *key,
+                                              char const **value)
+{
+    if (!image || !section || !key || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    image_view_t view = image_view(image);
+    char const *data = (char const *)image;
+    uint32_t const *section_index = (uint32_t const *)(data + view.header->section_index_offset);
+    uint32_t section_no = index_find(section_index, view.header->section_index_capacity,
+                                     view.header->section_count, section, section_name, &view);
+    if (section_no == UINT32_MAX)
+        return INI_STATUS_SECTION_NOT_FOUND;
+
+    ini_binary_section_t const *record = &view.sections[section_no];
+    uint32_t const *key_index = (uint32_t const *)(data + view.header->key_index_offset) + record->index;
+    view.pairs += record->first_pair;
+    uint32_t pair_no = index_find(key_index, record->index_capacity, record->pair_count, key, pair_key, &view);
+    if (pair_no == UINT32_MAX)
+        return INI_STATUS_KEY_NOT_FOUND;
+
+    *value = view.strings + view.pairs[pair_no].value;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_binary_materialize(void const *image, ini_ht_t *sections)
+{
+    if (!image || !sections)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    image_view_t view = image_view(image);
+    unsigned const borrow = INI_HT_BORROW_KEY | INI_HT_BORROW_VALUE;
+
+    for (uint32_t i = 0; i < view.header->section_count; i++)
+    {
+        ini_binary_section_t const *record = &view.sections[i];
+        char *name = (char *)(view.strings + record->name);
+        if (ini_ht_get(sections, name))
+            return INI_STATUS_FILE_BAD_FORMAT; // Never written by ini_binary_build()
+
+        ini_ht_t *section_ht = ini_ht_create();
+        if (!section_ht)
+            return INI_STATUS_MEMORY_ERROR;
+
+        for (uint32_t p = 0; p < record->pair_count; p++)
+        {
+            ini_binary_pair_t const *pair = &view.pairs[record->first_pair + p];
+            if (!ini_ht_set_ex(section_ht, view.strings + pair->key, view.strings + pair->value, borrow))
+            {
+                ini_ht_destroy(section_ht);
+                return INI_STATUS_MEMORY_ERROR;
+            }
+        }
+
+        // Same encoding as ini_store_section_ht(), but the name is borrowed
+        char ptr_str[32];
+        snprintf(ptr_str, sizeof(ptr_str), "%p", (void *)section_ht);
+        if (!ini_ht_set_ex(sections, name, ptr_str, INI_HT_BORROW_KEY))
+        {
+            ini_ht_destroy(section_ht);
+            return INI_STATUS_MEMORY_ERROR;
+        }
+    }
+    return INI_STATUS_SUCCESS;
+}
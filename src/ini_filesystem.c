@@ -1,11 +1,27 @@
 #define INI_IMPLEMENTATION
 #include "ini_filesystem.h"
+#include "ini_string.h"
 
 #include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 
 #if INI_OS_LINUX || INI_OS_APPLE
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#if INI_OS_LINUX
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+#else
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 #endif
 
 INI_PUBLIC_API ini_file_permission_t ini_get_file_permission(char const *filepath)
@@ -288,3 +304,858 @@ INI_PUBLIC_API ini_status_t ini_check_utf8_bom(FILE *file)
     rewind(file);
     return INI_STATUS_HASNT_UTF8_BOM;
 }
+
+INI_PUBLIC_API ini_status_t ini_read_file(char const *filepath, char **data, size_t *size)
+{
+    if (!filepath || !data || !size)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    *data = NULL;
+    *size = 0;
+
+    char *buffer = NULL;
+    size_t capacity = 0;
+    ini_status_t err = ini_read_file_reuse(filepath, &buffer, &capacity, size);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        free(buffer);
+        return err;
+    }
+
+    *data = buffer;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_read_file_reuse(char const *filepath, char **buffer, size_t *capacity, size_t *size)
+{
+    if (!filepath || !buffer || !capacity || !size)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    *size = 0;
+
+    FILE *file = ini_fopen(filepath, "rb");
+    if (!file)
+        return INI_STATUS_FILE_OPEN_FAILED;
+
+    size_t expected = 0;
+    if (ini_get_file_size(filepath, &expected) != INI_STATUS_SUCCESS || expected == 0)
+        expected = INI_BUFFER_SIZE;
+
+    // Only grow: a buffer that already fits the file is reused as-is
+    if (!*buffer || *capacity < expected)
+    {
+        char *grown = (char *)realloc(*buffer, expected + 1);
+        if (!grown)
+        {
+            fclose(file);
+            return INI_STATUS_MEMORY_ERROR;
+        }
+        *buffer = grown;
+        *capacity = expected;
+    }
+
+    // The size from stat() is only a hint: the file may grow or shrink while we read it
+    size_t length = 0;
+    for (;;)
+    {
+        length += fread(*buffer + length, 1, *capacity - length, file);
+        if (length < *capacity)
+            break;
+
+        int next = fgetc(file);
+        if (next == EOF)
+            break;
+
+        size_t new_capacity = *capacity * 2;
+        char *new_buffer = (char *)realloc(*buffer, new_capacity + 1);
+        if (!new_buffer)
+        {
+            fclose(file);
+            return INI_STATUS_MEMORY_ERROR;
+        }
+        *buffer = new_buffer;
+        *capacity = new_capacity;
+        (*buffer)[length++] = (char)next;
+    }
+
+    int read_error = ferror(file);
+    if (fclose(file) != 0 || read_error)
+        return INI_STATUS_FILE_OPEN_FAILED;
+
+    (*buffer)[length] = '\0';
+    *size = length;
+    return INI_STATUS_SUCCESS;
+}
+
+#if !INI_OS_WINDOWS
+static void fingerprint_from_stat(struct stat const *st, ini_file_fingerprint_t *fingerprint)
+{
+#if INI_OS_APPLE
+    fingerprint->mtime_ns = (int64_t)st->st_mtimespec.tv_sec * 1000000000LL + st->st_mtimespec.tv_nsec;
+#else
+    fingerprint->mtime_ns = (int64_t)st->st_mtim.tv_sec * 1000000000LL + st->st_mtim.tv_nsec;
+#endif
+    fingerprint->device = (uint64_t)st->st_dev;
+    fingerprint->inode = (uint64_t)st->st_ino;
+    fingerprint->size = (uint64_t)st->st_size;
+}
+#endif
+
+INI_PUBLIC_API ini_status_t ini_get_file_fingerprint(char const *filepath, ini_file_fingerprint_t *fingerprint)
+{
+    if (!filepath || !fingerprint)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+#if INI_OS_WINDOWS
+    struct _stat64 st;
+    if (_stat64(filepath, &st) != 0)
+        return INI_STATUS_FILE_NOT_FOUND;
+    fingerprint->mtime_ns = (int64_t)st.st_mtime * 1000000000LL;
+    fingerprint->device = (uint64_t)st.st_dev;
+    fingerprint->inode = (uint64_t)st.st_ino;
+    fingerprint->size = (uint64_t)st.st_size;
+#else
+    struct stat st;
+    if (stat(filepath, &st) != 0)
+        return INI_STATUS_FILE_NOT_FOUND;
+    fingerprint_from_stat(&st, fingerprint);
+#endif
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API int ini_file_fingerprint_equal(ini_file_fingerprint_t const *lhs, ini_file_fingerprint_t const *rhs)
+{
+    if (!lhs || !rhs)
+        return 0;
+
+    return lhs->device == rhs->device && lhs->inode == rhs->inode &&
+           lhs->size == rhs->size && lhs->mtime_ns == rhs->mtime_ns;
+}
+
+INI_PUBLIC_API ini_status_t ini_map_file(char const *filepath, void const **data, size_t *size)
+{
+    return ini_map_file_ex(filepath, data, size, NULL);
+}
+
+INI_PUBLIC_API ini_status_t ini_map_file_ex(char const *filepath, void const **data, size_t *size,
+                                            ini_file_fingerprint_t *fingerprint)
+{
+    if (!filepath || !data || !size)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    *data = NULL;
+    *size = 0;
+
+#if INI_OS_WINDOWS
+    HANDLE file = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return INI_STATUS_FILE_OPEN_FAILED;
+    // Best effort: taken by path while the handle is open
+    if (fingerprint && ini_get_file_fingerprint(filepath, fingerprint) != INI_STATUS_SUCCESS)
+    {
+        CloseHandle(file);
+        return INI_STATUS_STAT_ERROR;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+    if (file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return INI_STATUS_FILE_EMPTY;
+    }
+    if ((unsigned long long)file_size.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(file);
+        return INI_STATUS_LACK_OF_MEMORY;
+    }
+
+    // The view keeps the mapping object alive once both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    *data = view;
+    *size = (size_t)file_size.QuadPart;
+#else
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0)
+        return INI_STATUS_FILE_OPEN_FAILED;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+    if (fingerprint)
+        fingerprint_from_stat(&st, fingerprint);
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return INI_STATUS_FILE_EMPTY;
+    }
+    if ((unsigned long long)st.st_size > SIZE_MAX)
+    {
+        close(fd);
+        return INI_STATUS_LACK_OF_MEMORY;
+    }
+
+    // The mapping holds its own reference to the file
+    void *view = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    *data = view;
+    *size = (size_t)st.st_size;
+#endif
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API void ini_unmap_file(void const *data, size_t size)
+{
+    if (!data)
+        return;
+
+#if INI_OS_WINDOWS
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap((void *)data, size);
+#endif
+}
+
+INI_PUBLIC_API ini_status_t ini_write_file_atomic(char const *filepath, void const *data, size_t size)
+{
+    return ini_write_file_atomic_ex(filepath, data, size, INI_DURABILITY_NONE);
+}
+
+#if !INI_OS_WINDOWS
+// Creates a uniquely named file next to `target` the way open() would create `target` itself
+static int create_temp_file(char const *target, mode_t mode, char *temp, size_t temp_size)
+{
+    static unsigned counter = 0;
+    for (int attempt = 0; attempt < 100; attempt++)
+    {
+        unsigned serial = __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+        int length = snprintf(temp, temp_size, "%s.%ld.%u.tmp", target, (long)getpid(), serial);
+        if (length < 0 || (size_t)length >= temp_size)
+        {
+            errno = ENAMETOOLONG;
+            return -1;
+        }
+        int fd = open(temp, O_WRONLY | O_CREAT | O_EXCL, mode);
+        if (fd >= 0 || errno != EEXIST)
+            return fd;
+    }
+    return -1;
+}
+
+// Flushes the directory entry of `path` (the rename that just replaced it)
+static int sync_parent_directory(char const *path)
+{
+    char directory[INI_PATH_MAX];
+    char const *slash = strrchr(path, '/');
+    if (!slash)
+        strcpy(directory, ".");
+    else if (slash == path)
+        strcpy(directory, "/");
+    else
+    {
+        size_t length = (size_t)(slash - path);
+        memcpy(directory, path, length);
+        directory[length] = '\0';
+    }
+
+    int fd = open(directory, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    int result = fsync(fd);
+    close(fd);
+    return result;
+}
+
+/**
+ * @brief Opens the temporary file that will replace `*filepath`.
+ *
+ * A symbolic link is resolved into `resolved` (and `*filepath` pointed at it)
+ * so the link survives. The new file takes over the old one's permissions; a
+ * new one follows the umask.
+ */
+static ini_status_t begin_replace(char const **filepath, char *resolved, char *temp, int *fd)
+{
+    struct stat st;
+    if (lstat(*filepath, &st) == 0 && S_ISLNK(st.st_mode) && realpath(*filepath, resolved))
+        *filepath = resolved;
+
+    int existing = stat(*filepath, &st) == 0;
+    mode_t mode = existing ? (st.st_mode & 07777) : 0666;
+    *fd = create_temp_file(*filepath, mode, temp, INI_PATH_MAX);
+    if (*fd < 0)
+        return errno == ENAMETOOLONG ? INI_STATUS_INVALID_ARGUMENT : INI_STATUS_FILE_OPEN_FAILED;
+    // open() applied the umask to the copied mode as well
+    if (existing)
+        fchmod(*fd, mode);
+    return INI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Flushes and closes the temporary file, then renames it over `filepath`.
+ *
+ * With `failed` set (the contents are incomplete) the temporary file is
+ * removed and INI_STATUS_FILE_OPEN_FAILED returned.
+ */
+static ini_status_t finish_replace(int fd, char const *temp, char const *filepath, ini_durability_t durability,
+                                   int failed)
+{
+#if INI_OS_APPLE
+    int sync_error = !failed && durability >= INI_DURABILITY_FILE && fsync(fd) != 0;
+#else
+    int sync_error = !failed && durability >= INI_DURABILITY_FILE && fdatasync(fd) != 0;
+#endif
+    if (close(fd) != 0 || failed || sync_error)
+    {
+        remove(temp);
+        return failed ? INI_STATUS_FILE_OPEN_FAILED : INI_STATUS_CLOSE_FAILED;
+    }
+
+    if (rename(temp, filepath) != 0)
+    {
+        remove(temp);
+        return INI_STATUS_FILE_OPEN_FAILED;
+    }
+
+    if (durability == INI_DURABILITY_DIRECTORY && sync_parent_directory(filepath) != 0)
+        return INI_STATUS_CLOSE_FAILED;
+    return INI_STATUS_SUCCESS;
+}
+
+// write() that retries short writes and interruptions
+static int write_all(int fd, void const *data, size_t size)
+{
+    char const *bytes = (char const *)data;
+    while (size > 0)
+    {
+        ssize_t written = write(fd, bytes, size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return -1;
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+#define INI_COPY_CHUNK (1 << 30)      ///< Largest request handed to one copy system call.
+#define INI_COPY_BUFFER (1024 * 1024) ///< Buffer of the read/write fallback.
+
+/**
+ * @brief Appends bytes `[offset, offset + length)` of `src` to `dst`.
+ *
+ * The kernel copies the data where it can: `copy_file_range()` (which may
+ * share extents on a reflinking filesystem) and then `sendfile()`; only if
+ * both are unavailable do the bytes pass through a user-space buffer.
+ */
+static int copy_span(int src, int dst, uint64_t offset, uint64_t length, char **buffer)
+{
+#if INI_OS_LINUX
+#ifdef SYS_copy_file_range
+    while (length > 0)
+    {
+        loff_t in = (loff_t)offset;
+        size_t request = length > INI_COPY_CHUNK ? INI_COPY_CHUNK : (size_t)length;
+        long copied = syscall(SYS_copy_file_range, src, &in, dst, NULL, request, 0u);
+        if (copied < 0 && errno == EINTR)
+            continue;
+        if (copied <= 0)
+            break; // Unsupported here (old kernel, cross-device, ...) or past the end
+        offset += (uint64_t)copied;
+        length -= (uint64_t)copied;
+    }
+#endif
+    while (length > 0)
+    {
+        off_t in = (off_t)offset;
+        size_t request = length > INI_COPY_CHUNK ? INI_COPY_CHUNK : (size_t)length;
+        ssize_t copied = sendfile(dst, src, &in, request);
+        if (copied < 0 && errno == EINTR)
+            continue;
+        if (copied <= 0)
+            break;
+        offset += (uint64_t)copied;
+        length -= (uint64_t)copied;
+    }
+#endif
+    if (length > 0 && !*buffer && !(*buffer = (char *)malloc(INI_COPY_BUFFER)))
+        return -1;
+    while (length > 0)
+    {
+        size_t request = length > INI_COPY_BUFFER ? INI_COPY_BUFFER : (size_t)length;
+        ssize_t got = pread(src, *buffer, request, (off_t)offset);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0 || write_all(dst, *buffer, (size_t)got) != 0)
+            return -1;
+        offset += (uint64_t)got;
+        length -= (uint64_t)got;
+    }
+    return 0;
+}
+#endif
+
+INI_PUBLIC_API ini_status_t ini_write_file_atomic_ex(char const *filepath, void const *data, size_t size,
+                                                     ini_durability_t durability)
+{
+    if (!filepath || strlen(filepath) == 0 || (!data && size > 0) || durability < INI_DURABILITY_NONE ||
+        durability > INI_DURABILITY_DIRECTORY)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    char temp[INI_PATH_MAX];
+#if INI_OS_WINDOWS
+    // Process and thread ids keep concurrent writers apart
+    int length = snprintf(temp, sizeof(temp), "%s.%lu.%lu.tmp", filepath,
+                          (unsigned long)GetCurrentProcessId(), (unsigned long)GetCurrentThreadId());
+    if (length < 0 || (size_t)length >= sizeof(temp))
+        return INI_STATUS_INVALID_ARGUMENT;
+    FILE *file = fopen(temp, "wb");
+    if (!file)
+        return INI_STATUS_FILE_OPEN_FAILED;
+
+    size_t written = size > 0 ? fwrite(data, 1, size, file) : 0;
+    int write_error = written != size || fflush(file) != 0;
+    int sync_error = !write_error && durability >= INI_DURABILITY_FILE && _commit(_fileno(file)) != 0;
+    if (fclose(file) != 0 || write_error || sync_error)
+    {
+        remove(temp);
+        return write_error ? INI_STATUS_FILE_OPEN_FAILED : INI_STATUS_CLOSE_FAILED;
+    }
+
+    DWORD move_flags = MOVEFILE_REPLACE_EXISTING;
+    if (durability == INI_DURABILITY_DIRECTORY)
+        move_flags |= MOVEFILE_WRITE_THROUGH;
+    if (!MoveFileExA(temp, filepath, move_flags))
+    {
+        remove(temp);
+        return INI_STATUS_FILE_OPEN_FAILED;
+    }
+    return INI_STATUS_SUCCESS;
+#else
+    char resolved[INI_PATH_MAX];
+    int fd = -1;
+    ini_status_t err = begin_replace(&filepath, resolved, temp, &fd);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    int failed = size > 0 && write_all(fd, data, size) != 0;
+    return finish_replace(fd, temp, filepath, durability, failed);
+#endif
+}
+
+INI_PUBLIC_API ini_status_t ini_patch_file_atomic(char const *filepath, ini_file_edit_t const *edits, size_t count,
+                                                  ini_durability_t durability, ini_file_fingerprint_t const *expected)
+{
+    if (!filepath || strlen(filepath) == 0 || (!edits && count > 0) || durability < INI_DURABILITY_NONE ||
+        durability > INI_DURABILITY_DIRECTORY)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((!edits[i].data && edits[i].size > 0) ||
+            (i > 0 && edits[i].offset < edits[i - 1].offset + edits[i - 1].length))
+            return INI_STATUS_INVALID_ARGUMENT;
+    }
+
+#if INI_OS_WINDOWS
+    // No kernel-side copy to lean on: assemble the new contents in memory
+    char *original = NULL;
+    size_t original_size = 0;
+    ini_file_fingerprint_t actual;
+    if (expected && (ini_get_file_fingerprint(filepath, &actual) != INI_STATUS_SUCCESS ||
+                     !ini_file_fingerprint_equal(&actual, expected)))
+        return INI_STATUS_FILE_CHANGED;
+    ini_status_t err = ini_read_file(filepath, &original, &original_size);
+    if (err == INI_STATUS_FILE_EMPTY)
+        err = INI_STATUS_SUCCESS;
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+    if (expected && original_size != expected->size)
+    {
+        free(original);
+        return INI_STATUS_FILE_CHANGED;
+    }
+
+    size_t total = original_size;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (edits[i].offset + edits[i].length > original_size)
+        {
+            free(original);
+            return INI_STATUS_INVALID_ARGUMENT;
+        }
+        total = total - (size_t)edits[i].length + edits[i].size;
+    }
+
+    char *patched = (char *)malloc(total + 1);
+    if (!patched)
+    {
+        free(original);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+    size_t position = 0;
+    size_t used = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        memcpy(patched + used, original + position, (size_t)edits[i].offset - position);
+        used += (size_t)edits[i].offset - position;
+        if (edits[i].size > 0)
+            memcpy(patched + used, edits[i].data, edits[i].size);
+        used += edits[i].size;
+        position = (size_t)(edits[i].offset + edits[i].length);
+    }
+    memcpy(patched + used, original + position, original_size - position);
+    free(original);
+
+    err = ini_write_file_atomic_ex(filepath, patched, total, durability);
+    free(patched);
+    return err;
+#else
+    int src = open(filepath, O_RDONLY);
+    if (src < 0)
+        return errno == ENOENT ? INI_STATUS_FILE_NOT_FOUND : INI_STATUS_FILE_OPEN_FAILED;
+    struct stat st;
+    if (fstat(src, &st) != 0)
+    {
+        close(src);
+        return INI_STATUS_STAT_ERROR;
+    }
+    // The offsets describe the version the caller read; checked on the descriptor the copy reads from
+    if (expected)
+    {
+        ini_file_fingerprint_t actual;
+        fingerprint_from_stat(&st, &actual);
+        if (!ini_file_fingerprint_equal(&actual, expected))
+        {
+            close(src);
+            return INI_STATUS_FILE_CHANGED;
+        }
+    }
+    uint64_t const original_size = (uint64_t)st.st_size;
+    if (count > 0 && edits[count - 1].offset + edits[count - 1].length > original_size)
+    {
+        close(src);
+        return INI_STATUS_INVALID_ARGUMENT;
+    }
+
+    char temp[INI_PATH_MAX];
+    char resolved[INI_PATH_MAX];
+    int dst = -1;
+    ini_status_t err = begin_replace(&filepath, resolved, temp, &dst);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        close(src);
+        return err;
+    }
+
+    // Unchanged spans are copied by the kernel, the edits written in between
+    char *buffer = NULL;
+    uint64_t position = 0;
+    int failed = 0;
+    for (size_t i = 0; i < count && !failed; i++)
+    {
+        failed = copy_span(src, dst, position, edits[i].offset - position, &buffer) != 0 ||
+                 (edits[i].size > 0 && write_all(dst, edits[i].data, edits[i].size) != 0);
+        position = edits[i].offset + edits[i].length;
+    }
+    if (!failed)
+        failed = copy_span(src, dst, position, original_size - position, &buffer) != 0;
+    free(buffer);
+    close(src);
+
+    return finish_replace(dst, temp, filepath, durability, failed);
+#endif
+}
+
+INI_PUBLIC_API ini_status_t ini_write_fd(int fd, void const *data, size_t size)
+{
+    if (fd < 0 || (!data && size > 0))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+#if INI_OS_WINDOWS
+    char const *bytes = (char const *)data;
+    while (size > 0)
+    {
+        unsigned request = size > INT_MAX ? INT_MAX : (unsigned)size;
+        int written = _write(fd, bytes, request);
+        if (written <= 0)
+            return INI_STATUS_FILE_OPEN_FAILED;
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return INI_STATUS_SUCCESS;
+#else
+    return write_all(fd, data, size) == 0 ? INI_STATUS_SUCCESS : INI_STATUS_FILE_OPEN_FAILED;
+#endif
+}
+
+struct ini_file_replace_s
+{
+    int fd;                      ///< Temporary file the new contents go to.
+    char temp[INI_PATH_MAX];     ///< Path of the temporary file.
+    char path[INI_PATH_MAX];     ///< File to replace (symbolic links resolved).
+    ini_durability_t durability; ///< Flushes done by `ini_replace_commit()`.
+};
+
+INI_PUBLIC_API ini_status_t ini_replace_begin(char const *filepath, ini_durability_t durability,
+                                              ini_file_replace_t **replace)
+{
+    if (!replace)
+        return INI_STATUS_INVALID_ARGUMENT;
+    *replace = NULL;
+    if (!filepath || strlen(filepath) == 0 || strlen(filepath) >= INI_PATH_MAX ||
+        durability < INI_DURABILITY_NONE || durability > INI_DURABILITY_DIRECTORY)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_file_replace_t *result = (ini_file_replace_t *)malloc(sizeof(ini_file_replace_t));
+    if (!result)
+        return INI_STATUS_MEMORY_ERROR;
+    result->fd = -1;
+    result->durability = durability;
+#if INI_OS_WINDOWS
+    strcpy(result->path, filepath);
+    int length = snprintf(result->temp, sizeof(result->temp), "%s.%lu.%lu.tmp", filepath,
+                          (unsigned long)GetCurrentProcessId(), (unsigned long)GetCurrentThreadId());
+    ini_status_t err = INI_STATUS_INVALID_ARGUMENT;
+    if (length >= 0 && (size_t)length < sizeof(result->temp))
+    {
+        result->fd = _open(result->temp, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+        err = result->fd < 0 ? INI_STATUS_FILE_OPEN_FAILED : INI_STATUS_SUCCESS;
+    }
+#else
+    char resolved[INI_PATH_MAX];
+    ini_status_t err = begin_replace(&filepath, resolved, result->temp, &result->fd);
+    if (err == INI_STATUS_SUCCESS)
+        strcpy(result->path, filepath);
+#endif
+    if (err != INI_STATUS_SUCCESS)
+    {
+        free(result);
+        return err;
+    }
+    *replace = result;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API int ini_replace_fd(ini_file_replace_t const *replace)
+{
+    return replace ? replace->fd : -1;
+}
+
+INI_PUBLIC_API ini_status_t ini_replace_commit(ini_file_replace_t *replace)
+{
+    if (!replace)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    int fd = replace->fd;
+    ini_status_t err;
+#if INI_OS_WINDOWS
+    DWORD move_flags = MOVEFILE_REPLACE_EXISTING;
+    if (replace->durability == INI_DURABILITY_DIRECTORY)
+        move_flags |= MOVEFILE_WRITE_THROUGH;
+    int sync_error = replace->durability >= INI_DURABILITY_FILE && _commit(fd) != 0;
+    if (_close(fd) != 0 || sync_error)
+    {
+        remove(replace->temp);
+        err = INI_STATUS_CLOSE_FAILED;
+    }
+    else if (!MoveFileExA(replace->temp, replace->path, move_flags))
+    {
+        remove(replace->temp);
+        err = INI_STATUS_FILE_OPEN_FAILED;
+    }
+    else
+    {
+        err = INI_STATUS_SUCCESS;
+    }
+#else
+    err = finish_replace(fd, replace->temp, replace->path, replace->durability, 0);
+#endif
+    free(replace);
+    return err;
+}
+
+INI_PUBLIC_API void ini_replace_abort(ini_file_replace_t *replace)
+{
+    if (!replace)
+        return;
+
+#if INI_OS_WINDOWS
+    _close(replace->fd);
+#else
+    close(replace->fd);
+#endif
+    remove(replace->temp);
+    free(replace);
+}
+
+// Glob match of `name` against `pattern` (`*` and `?`); a leading dot must match literally
+static int match_pattern(char const *pattern, char const *name)
+{
+    if (name[0] == '.' && pattern[0] != '.')
+        return 0;
+
+    char const *star = NULL;
+    char const *resume = NULL;
+    while (*name)
+    {
+        if (*pattern == '*')
+        {
+            star = pattern++;
+            resume = name;
+        }
+        else if (*pattern == '?' || *pattern == *name)
+        {
+            pattern++;
+            name++;
+        }
+        else if (star)
+        {
+            // Let the last star swallow one more character and retry
+            pattern = star + 1;
+            name = ++resume;
+        }
+        else
+            return 0;
+    }
+    while (*pattern == '*')
+        pattern++;
+    return *pattern == '\0';
+}
+
+// Appends `directory/name` to the list, growing it as needed
+static ini_status_t append_path(char ***paths, size_t *count, size_t *capacity,
+                                char const *directory, size_t dir_len, char const *name)
+{
+    if (*count == *capacity)
+    {
+        size_t new_capacity = *capacity ? *capacity * 2 : 16;
+        char **grown = (char **)realloc(*paths, new_capacity * sizeof(char *));
+        if (!grown)
+            return INI_STATUS_MEMORY_ERROR;
+        *paths = grown;
+        *capacity = new_capacity;
+    }
+
+    size_t name_len = strlen(name);
+    char *path = (char *)malloc(dir_len + name_len + 1);
+    if (!path)
+        return INI_STATUS_MEMORY_ERROR;
+    memcpy(path, directory, dir_len);
+    memcpy(path + dir_len, name, name_len + 1);
+    (*paths)[(*count)++] = path;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_list_files(char const *pattern, char ***paths, size_t *count)
+{
+    if (!pattern || strlen(pattern) == 0 || !paths || !count)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    *paths = NULL;
+    *count = 0;
+
+    char const *name = pattern;
+    for (char const *p = pattern; *p; p++)
+    {
+        if (*p == '/' || *p == '\\')
+            name = p + 1;
+    }
+    if (strpbrk(pattern, "*?") && strpbrk(pattern, "*?") < name)
+        return INI_STATUS_INVALID_ARGUMENT; // Wildcards in directories are not supported
+
+    size_t capacity = 0;
+    size_t dir_len = (size_t)(name - pattern);
+    if (!strpbrk(name, "*?"))
+    {
+        if (ini_file_exists(pattern) != INI_STATUS_SUCCESS || ini_is_file_directory(pattern) == INI_STATUS_FILE_IS_DIR)
+            return INI_STATUS_FILE_NOT_FOUND;
+        return append_path(paths, count, &capacity, pattern, dir_len, name);
+    }
+
+    char directory[INI_PATH_MAX];
+    if (dir_len >= sizeof(directory))
+        return INI_STATUS_INVALID_ARGUMENT;
+    memcpy(directory, pattern, dir_len);
+    directory[dir_len] = '\0';
+
+    ini_status_t err = INI_STATUS_SUCCESS;
+#if INI_OS_WINDOWS
+    char search[INI_PATH_MAX];
+    if (snprintf(search, sizeof(search), "%s*", dir_len ? directory : ".\\") >= (int)sizeof(search))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    WIN32_FIND_DATAA found;
+    HANDLE handle = FindFirstFileA(search, &found);
+    if (handle == INVALID_HANDLE_VALUE)
+        return GetLastError() == ERROR_FILE_NOT_FOUND ? INI_STATUS_SUCCESS : INI_STATUS_FILE_NOT_FOUND;
+    do
+    {
+        if (!(found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && match_pattern(name, found.cFileName))
+            err = append_path(paths, count, &capacity, directory, dir_len, found.cFileName);
+    } while (err == INI_STATUS_SUCCESS && FindNextFileA(handle, &found));
+    FindClose(handle);
+#else
+    DIR *dir = opendir(dir_len ? directory : ".");
+    if (!dir)
+        return INI_STATUS_FILE_NOT_FOUND;
+
+    struct dirent *entry;
+    while (err == INI_STATUS_SUCCESS && (entry = readdir(dir)) != NULL)
+    {
+        if (!match_pattern(name, entry->d_name))
+            continue;
+
+        // Only regular files (following symlinks) count
+        char path[INI_PATH_MAX];
+        struct stat st;
+        if (snprintf(path, sizeof(path), "%s%s", directory, entry->d_name) >= (int)sizeof(path) ||
+            stat(path, &st) != 0 || !S_ISREG(st.st_mode))
+            continue;
+        err = append_path(paths, count, &capacity, directory, dir_len, entry->d_name);
+    }
+    closedir(dir);
+#endif
+
+    if (err != INI_STATUS_SUCCESS)
+    {
+        ini_free_file_list(*paths, *count);
+        *paths = NULL;
+        *count = 0;
+        return err;
+    }
+
+    if (*count > 1)
+        qsort(*paths, *count, sizeof(char *), ini_compare_strings);
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API void ini_free_file_list(char **paths, size_t count)
+{
+    if (!paths)
+        return;
+    for (size_t i = 0; i < count; i++)
+        free(paths[i]);
+    free(paths);
+}
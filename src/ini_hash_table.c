@@ -6,7 +6,8 @@
 #include <string.h>
 
 ini_status_t __ini_details_ht_set_entry(ini_ht_key_value_t *entries, size_t capacity,
-                                        char const *key, char const *value, size_t *plength);
+                                        char const *key, char const *value, unsigned flags,
+                                        size_t *plength);
 ini_status_t __ini_details_ht_expand(ini_ht_t *table);
 ini_ht_key_value_t *__ini_details_ht_get_entry(ini_ht_key_value_t *entries,
                                                size_t capacity,
@@ -29,9 +30,32 @@ INI_PUBLIC_API uint64_t hash_key(char const *key)
     return hash;
 }
 
+INI_PUBLIC_API uint64_t hash_bytes(void const *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    unsigned char const *p = (unsigned char const *)data;
+
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), p += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word)); // Unaligned-safe load
+        hash ^= word;
+        hash *= 1099511628211ULL;
+        hash ^= hash >> 32; // Mix the high bits back down; a word-wide xor only spreads upwards
+    }
+
+    for (; size > 0; size--, p++)
+    {
+        hash ^= (uint64_t)*p;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
 INI_PUBLIC_API ini_ht_t *ini_ht_create(void)
 {
-    ini_ht_t *table = malloc(sizeof(ini_ht_t));
+    // Zeroed so the mutex never looks initialized from recycled memory
+    ini_ht_t *table = calloc(1, sizeof(ini_ht_t));
     if (!table)
         return NULL;
 
@@ -64,10 +88,11 @@ INI_PUBLIC_API ini_status_t ini_ht_destroy(ini_ht_t *table)
 
     for (size_t i = 0; i < table->capacity; i++)
     {
-        if (table->entries[i].key)
+        if (table->entries[i].key && !(table->entries[i].flags & INI_HT_BORROW_KEY))
             free(table->entries[i].key);
-        if (table->entries[i].value)
+        if (table->entries[i].value && !(table->entries[i].flags & INI_HT_BORROW_VALUE))
             free(table->entries[i].value);
+        free(table->entries[i].items);
     }
 
     if (table->entries)
@@ -95,7 +120,27 @@ INI_PUBLIC_API char const *ini_ht_get(ini_ht_t *table, char const *key)
     return entry ? entry->value : NULL;
 }
 
+INI_PUBLIC_API ini_ht_key_value_t *ini_ht_find(ini_ht_t *table, char const *key)
+{
+    if (!table || !key)
+        return NULL;
+
+    if (ini_mutex_lock(&table->mutex) != INI_STATUS_SUCCESS)
+        return NULL;
+
+    ini_ht_key_value_t *entry = __ini_details_ht_get_entry(table->entries, table->capacity, key);
+    if (ini_mutex_unlock(&table->mutex) != INI_STATUS_SUCCESS)
+        return NULL;
+
+    return entry;
+}
+
 INI_PUBLIC_API char const *ini_ht_set(ini_ht_t *table, char const *key, char const *value)
+{
+    return ini_ht_set_ex(table, key, value, INI_HT_BORROW_NONE);
+}
+
+INI_PUBLIC_API char const *ini_ht_set_ex(ini_ht_t *table, char const *key, char const *value, unsigned flags)
 {
     if (!table || !key)
         return NULL;
@@ -112,7 +157,8 @@ INI_PUBLIC_API char const *ini_ht_set(ini_ht_t *table, char const *key, char con
         }
     }
 
-    if (__ini_details_ht_set_entry(table->entries, table->capacity, key, value, &table->length) != INI_STATUS_SUCCESS)
+    if (__ini_details_ht_set_entry(table->entries, table->capacity, key, value, flags,
+                                   &table->length) != INI_STATUS_SUCCESS)
     {
         ini_mutex_unlock(&table->mutex);
         return NULL;
@@ -122,6 +168,50 @@ INI_PUBLIC_API char const *ini_ht_set(ini_ht_t *table, char const *key, char con
     return value;
 }
 
+INI_PUBLIC_API ini_status_t ini_ht_remove(ini_ht_t *table, char const *key)
+{
+    if (!table || !key)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock(&table->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_MUTEX_ERROR;
+
+    ini_ht_key_value_t *entry = __ini_details_ht_get_entry(table->entries, table->capacity, key);
+    if (!entry)
+    {
+        ini_mutex_unlock(&table->mutex);
+        return INI_STATUS_KEY_NOT_FOUND;
+    }
+
+    if (!(entry->flags & INI_HT_BORROW_KEY))
+        free(entry->key);
+    if (entry->value && !(entry->flags & INI_HT_BORROW_VALUE))
+        free(entry->value);
+    free(entry->items);
+
+    // Pull later entries of the probe run back into the hole, unless that
+    // would move one in front of its home slot
+    size_t mask = table->capacity - 1;
+    size_t hole = (size_t)(entry - table->entries);
+    size_t next = (hole + 1) & mask;
+    while (table->entries[next].key != NULL)
+    {
+        size_t home = (size_t)(hash_key(table->entries[next].key) & (uint64_t)mask);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            table->entries[hole] = table->entries[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    memset(&table->entries[hole], 0, sizeof(table->entries[hole]));
+    table->length--;
+
+    ini_mutex_unlock(&table->mutex);
+    return INI_STATUS_SUCCESS;
+}
+
 INI_PUBLIC_API size_t ini_ht_length(ini_ht_t *table)
 {
     if (!table)
@@ -176,7 +266,8 @@ INI_PUBLIC_API ini_status_t ini_ht_next(ini_ht_iterator_t *it, char **key, char
 }
 
 ini_status_t __ini_details_ht_set_entry(ini_ht_key_value_t *entries, size_t capacity,
-                                        char const *key, char const *value, size_t *plength)
+                                        char const *key, char const *value, unsigned flags,
+                                        size_t *plength)
 {
     uint64_t hash = hash_key(key);
     size_t index = (size_t)(hash & (uint64_t)(capacity - 1));
@@ -185,33 +276,43 @@ ini_status_t __ini_details_ht_set_entry(ini_ht_key_value_t *entries, size_t capa
     {
         if (strcmp(key, entries[index].key) == 0)
         {
-            char *new_value = ini_strdup(value);
+            char *new_value = (flags & INI_HT_BORROW_VALUE) ? (char *)value : ini_strdup(value);
             if (!new_value)
                 return INI_STATUS_MEMORY_ERROR;
 
             // Free the old value before replacing it
-            if (entries[index].value)
+            if (entries[index].value && !(entries[index].flags & INI_HT_BORROW_VALUE))
                 free(entries[index].value);
 
             entries[index].value = new_value;
+            entries[index].flags = (entries[index].flags & ~INI_HT_BORROW_VALUE) | (flags & INI_HT_BORROW_VALUE);
+            entries[index].typed = 0;
+            free(entries[index].items);
+            entries[index].items = NULL;
+            entries[index].item_count = 0;
             return INI_STATUS_SUCCESS;
         }
         index = (index + 1) % capacity;
     }
 
-    char *new_key = ini_strdup(key);
+    char *new_key = (flags & INI_HT_BORROW_KEY) ? (char *)key : ini_strdup(key);
     if (!new_key)
         return INI_STATUS_MEMORY_ERROR;
 
-    char *new_value = ini_strdup(value);
+    char *new_value = (flags & INI_HT_BORROW_VALUE) ? (char *)value : ini_strdup(value);
     if (!new_value)
     {
-        free(new_key);
+        if (!(flags & INI_HT_BORROW_KEY))
+            free(new_key);
         return INI_STATUS_MEMORY_ERROR;
     }
 
     entries[index].key = new_key;
     entries[index].value = new_value;
+    entries[index].flags = flags & (INI_HT_BORROW_KEY | INI_HT_BORROW_VALUE);
+    entries[index].typed = 0;
+    entries[index].items = NULL;
+    entries[index].item_count = 0;
     if (plength)
         (*plength)++;
 
@@ -228,32 +329,15 @@ ini_status_t __ini_details_ht_expand(ini_ht_t *table)
     if (!new_entries)
         return INI_STATUS_MEMORY_ERROR;
 
+    // Move entries into their new slots: keys are unique, so nothing is copied or compared
     for (size_t i = 0; i < table->capacity; i++)
     {
         if (table->entries[i].key)
         {
-            if (__ini_details_ht_set_entry(new_entries, new_capacity, table->entries[i].key,
-                                           table->entries[i].value, NULL) != INI_STATUS_SUCCESS)
-            {
-                for (size_t j = 0; j < new_capacity; j++)
-                {
-                    if (new_entries[j].key)
-                        free(new_entries[j].key);
-                    if (new_entries[j].value)
-                        free(new_entries[j].value);
-                }
-                free(new_entries);
-                return INI_STATUS_MEMORY_ERROR;
-            }
-        }
-    }
-
-    for (size_t i = 0; i < table->capacity; i++)
-    {
-        if (table->entries[i].key)
-        {
-            free(table->entries[i].key);
-            free(table->entries[i].value);
+            size_t index = (size_t)(hash_key(table->entries[i].key) & (uint64_t)(new_capacity - 1));
+            while (new_entries[index].key != NULL)
+                index = (index + 1) % new_capacity;
+            new_entries[index] = table->entries[i];
         }
     }
 
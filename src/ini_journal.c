@@ -0,0 +1,469 @@
+#define INI_IMPLEMENTATION
+#include "ini_journal.h"
+#include "ini_filesystem.h"
+#include "ini_hash_table.h"
+#include "ini_string.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if INI_OS_WINDOWS
+#include <fcntl.h>
+#include <io.h>
+#include <limits.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+struct ini_journal_s
+{
+    char *path;             ///< Journal file.
+    int fd;                 ///< Descriptor opened for appending (-1 after a failed drop).
+    uint64_t size;          ///< Bytes in the file.
+    unsigned sync_interval; ///< Records between two syncs (0 = never).
+    unsigned unsynced;      ///< Records written since the last sync.
+    char *buffer;           ///< Encoding buffer reused across appends.
+    size_t capacity;        ///< Allocated bytes in `buffer`.
+};
+
+static int open_append(char const *path)
+{
+#if INI_OS_WINDOWS
+    return _open(path, _O_RDWR | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return open(path, O_RDWR | O_CREAT | O_APPEND, 0666);
+#endif
+}
+
+static int close_fd(int fd)
+{
+#if INI_OS_WINDOWS
+    return _close(fd);
+#else
+    return close(fd);
+#endif
+}
+
+static int sync_fd(int fd)
+{
+#if INI_OS_WINDOWS
+    return _commit(fd);
+#elif INI_OS_APPLE
+    return fsync(fd);
+#else
+    return fdatasync(fd);
+#endif
+}
+
+static int truncate_fd(int fd, uint64_t size)
+{
+#if INI_OS_WINDOWS
+    return _chsize_s(fd, (__int64)size) == 0 ? 0 : -1;
+#else
+    return ftruncate(fd, (off_t)size);
+#endif
+}
+
+// write() that retries short writes and interruptions
+static int write_all(int fd, void const *data, size_t size)
+{
+    char const *bytes = (char const *)data;
+    while (size > 0)
+    {
+#if INI_OS_WINDOWS
+        int written = _write(fd, bytes, size > INT_MAX ? INT_MAX : (unsigned)size);
+#else
+        ssize_t written = write(fd, bytes, size);
+#endif
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return -1;
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+// Reads `size` bytes at `offset`
+static int read_at(int fd, void *data, size_t size, uint64_t offset)
+{
+    char *bytes = (char *)data;
+#if INI_OS_WINDOWS
+    if (_lseeki64(fd, (__int64)offset, SEEK_SET) < 0)
+        return -1;
+#endif
+    while (size > 0)
+    {
+#if INI_OS_WINDOWS
+        int got = _read(fd, bytes, size > INT_MAX ? INT_MAX : (unsigned)size);
+#else
+        ssize_t got = pread(fd, bytes, size, (off_t)offset);
+#endif
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            return -1;
+        bytes += got;
+        offset += (uint64_t)got;
+        size -= (size_t)got;
+    }
+    return 0;
+}
+
+static void fill_header(ini_journal_header_t *header)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, INI_JOURNAL_MAGIC, sizeof(header->magic));
+    header->version = INI_JOURNAL_VERSION;
+    header->byte_order = INI_JOURNAL_BYTE_ORDER;
+}
+
+static int header_valid(void const *data, size_t size)
+{
+    ini_journal_header_t expected;
+    fill_header(&expected);
+    return size >= sizeof(expected) && memcmp(data, &expected, sizeof(expected)) == 0;
+}
+
+// Returns the size of the well-formed record at `data`, 0 otherwise
+static size_t check_record(char const *data, size_t size, ini_journal_record_t *record)
+{
+    if (size < sizeof(*record))
+        return 0;
+    memcpy(record, data, sizeof(*record));
+
+    int removed = record->value_size == INI_JOURNAL_REMOVED;
+    uint64_t payload = (uint64_t)record->section_size + 1 + (uint64_t)record->key_size + 1 +
+                       (removed ? 0 : (uint64_t)record->value_size + 1);
+    if (payload > size - sizeof(*record))
+        return 0;
+
+    char const *section = data + sizeof(*record);
+    char const *key = section + record->section_size + 1;
+    if (section[record->section_size] != '\0' || key[record->key_size] != '\0' ||
+        (!removed && key[record->key_size + 1 + record->value_size] != '\0'))
+        return 0;
+    return sizeof(*record) + (size_t)payload;
+}
+
+// Returns the size of the batch at `data` if it is intact and its records fill it exactly, 0 otherwise
+static size_t check_batch(char const *data, size_t size, ini_journal_batch_t *batch)
+{
+    if (size < sizeof(*batch))
+        return 0;
+    memcpy(batch, data, sizeof(*batch));
+    if (batch->size > size - sizeof(*batch))
+        return 0;
+
+    size_t total = sizeof(*batch) + (size_t)batch->size;
+    if ((uint32_t)hash_bytes(data + sizeof(uint32_t), total - sizeof(uint32_t)) != batch->checksum)
+        return 0;
+
+    size_t offset = sizeof(*batch);
+    for (uint32_t i = 0; i < batch->count; i++)
+    {
+        ini_journal_record_t record;
+        size_t length = check_record(data + offset, total - offset, &record);
+        if (length == 0)
+            return 0;
+        offset += length;
+    }
+    return offset == total ? total : 0;
+}
+
+// Walks the intact batches of a journal image; `*end` receives where they stop
+static ini_status_t walk_records(char const *data, size_t size, ini_journal_apply_t apply, void *user,
+                                 size_t *count, size_t *end)
+{
+    size_t offset = sizeof(ini_journal_header_t);
+    size_t applied = 0;
+    ini_status_t err = INI_STATUS_SUCCESS;
+    while (offset < size && err == INI_STATUS_SUCCESS)
+    {
+        // A batch is checked whole before any of its records is applied
+        ini_journal_batch_t batch;
+        size_t length = check_batch(data + offset, size - offset, &batch);
+        if (length == 0)
+            break;
+
+        char const *cursor = data + offset + sizeof(batch);
+        for (uint32_t i = 0; i < batch.count && apply; i++)
+        {
+            ini_journal_record_t record;
+            memcpy(&record, cursor, sizeof(record));
+            char const *section = cursor + sizeof(record);
+            char const *key = section + record.section_size + 1;
+            char const *value = record.value_size == INI_JOURNAL_REMOVED ? NULL : key + record.key_size + 1;
+            if ((err = apply(user, section, key, value)) != INI_STATUS_SUCCESS)
+                break;
+            applied++;
+            cursor = (value ? value + record.value_size : key + record.key_size) + 1;
+        }
+        if (!apply)
+            applied += batch.count;
+        offset += length;
+    }
+
+    if (count)
+        *count = applied;
+    if (end)
+        *end = offset;
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_journal_open(char const *path, unsigned sync_interval, ini_journal_t **journal)
+{
+    if (!path || strlen(path) == 0 || !journal)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    *journal = NULL;
+    ini_journal_t *result = (ini_journal_t *)calloc(1, sizeof(ini_journal_t));
+    if (!result)
+        return INI_STATUS_MEMORY_ERROR;
+    result->path = ini_strdup(path);
+    result->sync_interval = sync_interval;
+    if (!result->path)
+    {
+        free(result);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+
+    result->fd = open_append(path);
+    if (result->fd < 0)
+    {
+        free(result->path);
+        free(result);
+        return INI_STATUS_FILE_OPEN_FAILED;
+    }
+
+    void const *data = NULL;
+    size_t size = 0;
+    ini_status_t err = ini_map_file(path, &data, &size);
+    if (err == INI_STATUS_SUCCESS && size >= sizeof(ini_journal_header_t))
+    {
+        // Keep the intact batches and cut off a torn tail
+        size_t end = 0;
+        if (!header_valid(data, size))
+            err = INI_STATUS_FILE_BAD_FORMAT;
+        else
+        {
+            walk_records((char const *)data, size, NULL, NULL, NULL, &end);
+            if (end < size && truncate_fd(result->fd, end) != 0)
+                err = INI_STATUS_FILE_OPEN_FAILED;
+        }
+        result->size = end;
+    }
+    else if (err == INI_STATUS_SUCCESS || err == INI_STATUS_FILE_EMPTY)
+    {
+        // New, or created by a run that stopped before the header was complete
+        ini_journal_header_t header;
+        fill_header(&header);
+        err = truncate_fd(result->fd, 0) == 0 && write_all(result->fd, &header, sizeof(header)) == 0
+                  ? INI_STATUS_SUCCESS
+                  : INI_STATUS_FILE_OPEN_FAILED;
+        result->size = sizeof(header);
+    }
+    if (data)
+        ini_unmap_file(data, size);
+
+    if (err != INI_STATUS_SUCCESS)
+    {
+        ini_journal_close(result);
+        return err;
+    }
+    *journal = result;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_journal_append(ini_journal_t *journal, ini_journal_entry_t const *entries,
+                                               size_t count)
+{
+    if (!journal || (!entries && count > 0))
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (journal->fd < 0)
+        return INI_STATUS_FILE_OPEN_FAILED;
+
+    if (count > UINT32_MAX)
+        return INI_STATUS_INVALID_ARGUMENT;
+    size_t needed = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!entries[i].section || !entries[i].key)
+            return INI_STATUS_INVALID_ARGUMENT;
+        size_t section_size = strlen(entries[i].section);
+        size_t key_size = strlen(entries[i].key);
+        size_t value_size = entries[i].value ? strlen(entries[i].value) : 0;
+        if (section_size >= INI_JOURNAL_REMOVED || key_size >= INI_JOURNAL_REMOVED ||
+            value_size >= INI_JOURNAL_REMOVED)
+            return INI_STATUS_INVALID_ARGUMENT;
+        needed += sizeof(ini_journal_record_t) + section_size + key_size + 2 + (entries[i].value ? value_size + 1 : 0);
+    }
+    if (needed == 0)
+        return INI_STATUS_SUCCESS;
+    needed += sizeof(ini_journal_batch_t);
+
+    if (needed > journal->capacity)
+    {
+        char *buffer = (char *)realloc(journal->buffer, needed);
+        if (!buffer)
+            return INI_STATUS_MEMORY_ERROR;
+        journal->buffer = buffer;
+        journal->capacity = needed;
+    }
+
+    // The whole batch goes out in one write
+    char *cursor = journal->buffer + sizeof(ini_journal_batch_t);
+    for (size_t i = 0; i < count; i++)
+    {
+        ini_journal_record_t record;
+        record.section_size = (uint32_t)strlen(entries[i].section);
+        record.key_size = (uint32_t)strlen(entries[i].key);
+        record.value_size = entries[i].value ? (uint32_t)strlen(entries[i].value) : INI_JOURNAL_REMOVED;
+        memcpy(cursor, &record, sizeof(record));
+
+        char *payload = cursor + sizeof(record);
+        memcpy(payload, entries[i].section, record.section_size + 1);
+        payload += record.section_size + 1;
+        memcpy(payload, entries[i].key, record.key_size + 1);
+        payload += record.key_size + 1;
+        if (entries[i].value)
+        {
+            memcpy(payload, entries[i].value, record.value_size + 1);
+            payload += record.value_size + 1;
+        }
+        cursor = payload;
+    }
+
+    // The checksum covers the count, the size and every record, so it is filled in last
+    ini_journal_batch_t batch;
+    batch.checksum = 0;
+    batch.count = (uint32_t)count;
+    batch.size = needed - sizeof(batch);
+    memcpy(journal->buffer, &batch, sizeof(batch));
+    batch.checksum = (uint32_t)hash_bytes(journal->buffer + sizeof(uint32_t), needed - sizeof(uint32_t));
+    memcpy(journal->buffer, &batch.checksum, sizeof(batch.checksum));
+
+    if (write_all(journal->fd, journal->buffer, needed) != 0)
+    {
+        truncate_fd(journal->fd, journal->size);
+        return INI_STATUS_FILE_OPEN_FAILED;
+    }
+    journal->size += needed;
+    journal->unsynced += (unsigned)count;
+
+    if (journal->sync_interval > 0 && journal->unsynced >= journal->sync_interval)
+        return ini_journal_sync(journal);
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_journal_sync(ini_journal_t *journal)
+{
+    if (!journal)
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (journal->unsynced == 0)
+        return INI_STATUS_SUCCESS;
+    if (journal->fd < 0 || sync_fd(journal->fd) != 0)
+        return INI_STATUS_CLOSE_FAILED;
+
+    journal->unsynced = 0;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API uint64_t ini_journal_size(ini_journal_t const *journal)
+{
+    return journal ? journal->size : 0;
+}
+
+INI_PUBLIC_API ini_status_t ini_journal_drop(ini_journal_t *journal, uint64_t end)
+{
+    if (!journal || end > journal->size)
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (journal->fd < 0)
+        return INI_STATUS_FILE_OPEN_FAILED;
+
+    size_t const header_size = sizeof(ini_journal_header_t);
+    if (end <= header_size)
+        return INI_STATUS_SUCCESS;
+
+    // Dropped batches that come back after a crash are replayed harmlessly
+    if (end == journal->size)
+    {
+        if (truncate_fd(journal->fd, header_size) != 0)
+            return INI_STATUS_FILE_OPEN_FAILED;
+        journal->size = header_size;
+        journal->unsynced = 0;
+        return INI_STATUS_SUCCESS;
+    }
+
+    // Records appended since `end` move to a fresh file
+    size_t tail = (size_t)(journal->size - end);
+    char *copy = (char *)malloc(header_size + tail);
+    if (!copy)
+        return INI_STATUS_MEMORY_ERROR;
+    fill_header((ini_journal_header_t *)copy);
+
+    ini_status_t err = read_at(journal->fd, copy + header_size, tail, end) == 0
+                           ? ini_write_file_atomic_ex(journal->path, copy, header_size + tail, INI_DURABILITY_FILE)
+                           : INI_STATUS_FILE_OPEN_FAILED;
+    free(copy);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    close_fd(journal->fd);
+    journal->fd = open_append(journal->path);
+    if (journal->fd < 0)
+        return INI_STATUS_FILE_OPEN_FAILED;
+    journal->size = header_size + tail;
+    journal->unsynced = 0;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API void ini_journal_close(ini_journal_t *journal)
+{
+    if (!journal)
+        return;
+
+    if (journal->fd >= 0)
+    {
+        ini_journal_sync(journal);
+        close_fd(journal->fd);
+    }
+    free(journal->buffer);
+    free(journal->path);
+    free(journal);
+}
+
+INI_PUBLIC_API ini_status_t ini_journal_replay(char const *path, ini_journal_apply_t apply, void *user,
+                                               size_t *count)
+{
+    if (!path || strlen(path) == 0 || !apply)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (count)
+        *count = 0;
+    if (ini_file_exists(path) != INI_STATUS_SUCCESS)
+        return INI_STATUS_SUCCESS;
+
+    void const *data = NULL;
+    size_t size = 0;
+    ini_status_t err = ini_map_file(path, &data, &size);
+    if (err == INI_STATUS_FILE_EMPTY)
+        return INI_STATUS_SUCCESS;
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    // A header cut short by a crash holds no records yet
+    if (size < sizeof(ini_journal_header_t))
+        err = INI_STATUS_SUCCESS;
+    else if (!header_valid(data, size))
+        err = INI_STATUS_FILE_BAD_FORMAT;
+    else
+        err = walk_records((char const *)data, size, apply, user, count, NULL);
+
+    ini_unmap_file(data, size);
+    return err;
+}
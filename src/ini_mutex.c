@@ -2,6 +2,18 @@
 
 #include "ini_mutex.h"
 
+// Whether the calling thread is the one holding `mutex`
+static int held_by_current_thread(ini_mutex_t const *mutex)
+{
+    if (mutex->locked != INI_MUTEX_LOCKED)
+        return 0;
+#if INI_OS_WINDOWS
+    return mutex->owner == GetCurrentThreadId();
+#else
+    return pthread_equal(mutex->owner, pthread_self());
+#endif
+}
+
 ini_status_t ini_mutex_init(ini_mutex_t *mutex)
 {
     if (!mutex)
@@ -57,16 +69,22 @@ ini_status_t ini_mutex_lock(ini_mutex_t *mutex)
     if (!mutex || !mutex->initialized)
         return INI_STATUS_INVALID_ARGUMENT;
 
-    if (mutex->locked == INI_MUTEX_LOCKED)
-        return INI_STATUS_SUCCESS; // already locked
+    if (held_by_current_thread(mutex))
+    {
+        mutex->depth++; // already locked by this thread
+        return INI_STATUS_SUCCESS;
+    }
 
 #if INI_OS_WINDOWS
-    EnterCriticalSection(&mutex->base); // Will deadlock if already locked by same thread
+    EnterCriticalSection(&mutex->base);
+    mutex->owner = GetCurrentThreadId();
 #else
     if (pthread_mutex_lock(&mutex->base))
         return INI_STATUS_MUTEX_ERROR;
+    mutex->owner = pthread_self();
 #endif
 
+    mutex->depth = 1;
     mutex->locked = INI_MUTEX_LOCKED;
     return INI_STATUS_SUCCESS;
 }
@@ -78,12 +96,96 @@ ini_status_t ini_mutex_unlock(ini_mutex_t *mutex)
 
     if (mutex->locked == INI_MUTEX_UNLOCKED)
         return INI_STATUS_SUCCESS; // already unlocked
+
+    // An inner unlock of the owner leaves the mutex held for the outer frames
+    if (mutex->depth > 1 && held_by_current_thread(mutex))
+    {
+        mutex->depth--;
+        return INI_STATUS_SUCCESS;
+    }
+
+    // Cleared while still held: a thread that takes the mutex right after the
+    // release must not have its `locked` overwritten
+    mutex->locked = INI_MUTEX_UNLOCKED;
+    mutex->depth = 0;
 #if INI_OS_WINDOWS
     LeaveCriticalSection(&mutex->base);
 #else
     if (pthread_mutex_unlock(&mutex->base))
+    {
+        mutex->locked = INI_MUTEX_LOCKED;
+        mutex->depth = 1;
+        return INI_STATUS_MUTEX_ERROR;
+    }
+#endif
+    return INI_STATUS_SUCCESS;
+}
+
+ini_status_t ini_cond_init(ini_cond_t *cond)
+{
+    if (!cond)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (cond->initialized == INI_MUTEX_INITIALIZED)
+        return INI_STATUS_MUTEX_ALREADY_INITIALIZED;
+
+#if INI_OS_WINDOWS
+    InitializeConditionVariable(&cond->base);
+#else
+    if (pthread_cond_init(&cond->base, NULL))
+        return INI_STATUS_MUTEX_ERROR;
+#endif
+
+    cond->initialized = INI_MUTEX_INITIALIZED;
+    return INI_STATUS_SUCCESS;
+}
+
+ini_status_t ini_cond_destroy(ini_cond_t *cond)
+{
+    if (!cond || !cond->initialized)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+#if !INI_OS_WINDOWS
+    if (pthread_cond_destroy(&cond->base))
         return INI_STATUS_MUTEX_ERROR;
 #endif
+
+    cond->initialized = INI_MUTEX_NOT_INITIALIZED;
+    return INI_STATUS_SUCCESS;
+}
+
+ini_status_t ini_cond_wait(ini_cond_t *cond, ini_mutex_t *mutex)
+{
+    if (!cond || !cond->initialized || !mutex || !mutex->initialized || !held_by_current_thread(mutex))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    // The wait releases the mutex as a whole, so the nesting is put aside meanwhile
+    unsigned depth = mutex->depth;
     mutex->locked = INI_MUTEX_UNLOCKED;
+    mutex->depth = 0;
+
+#if INI_OS_WINDOWS
+    int failed = !SleepConditionVariableCS(&cond->base, &mutex->base, INFINITE);
+    mutex->owner = GetCurrentThreadId();
+#else
+    int failed = pthread_cond_wait(&cond->base, &mutex->base) != 0;
+    mutex->owner = pthread_self();
+#endif
+
+    mutex->depth = depth;
+    mutex->locked = INI_MUTEX_LOCKED;
+    return failed ? INI_STATUS_MUTEX_ERROR : INI_STATUS_SUCCESS;
+}
+
+ini_status_t ini_cond_broadcast(ini_cond_t *cond)
+{
+    if (!cond || !cond->initialized)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+#if INI_OS_WINDOWS
+    WakeAllConditionVariable(&cond->base);
+#else
+    pthread_cond_broadcast(&cond->base);
+#endif
     return INI_STATUS_SUCCESS;
 }
@@ -0,0 +1,542 @@
+#define INI_IMPLEMENTATION
+#include "ini_number.h"
+
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ASCII-only case folding; `tolower()` would depend on the locale
+static char lower_ascii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+static int equals_ignore_case(char const *str, char const *word)
+{
+    for (; *word; str++, word++)
+    {
+        if (lower_ascii(*str) != *word)
+            return 0;
+    }
+    return *str == '\0';
+}
+
+static int hex_digit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c = lower_ascii(c);
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+INI_PUBLIC_API ini_status_t ini_parse_int64(char const *str, int64_t *value)
+{
+    if (!str || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    char const *p = str;
+    int negative = *p == '-';
+    if (*p == '-' || *p == '+')
+        p++;
+
+    // Accumulate the magnitude unsigned; the negative range is one larger
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t magnitude = 0;
+    if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    {
+        p += 2;
+        if (hex_digit(*p) < 0)
+            return INI_STATUS_TYPE_MISMATCH;
+        for (int digit; (digit = hex_digit(*p)) >= 0; p++)
+        {
+            if (magnitude > (limit - (uint64_t)digit) / 16)
+                return INI_STATUS_TYPE_MISMATCH;
+            magnitude = magnitude * 16 + (uint64_t)digit;
+        }
+    }
+    else
+    {
+        if (*p < '0' || *p > '9')
+            return INI_STATUS_TYPE_MISMATCH;
+        for (; *p >= '0' && *p <= '9'; p++)
+        {
+            uint64_t digit = (uint64_t)(*p - '0');
+            if (magnitude > (limit - digit) / 10)
+                return INI_STATUS_TYPE_MISMATCH;
+            magnitude = magnitude * 10 + digit;
+        }
+    }
+    if (*p != '\0')
+        return INI_STATUS_TYPE_MISMATCH;
+
+    // -(INT64_MAX + 1) without signed overflow
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return INI_STATUS_SUCCESS;
+}
+
+/// @brief Powers of ten that doubles represent exactly.
+static double const exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// Correctly rounded conversion of a validated decimal through the C library
+static ini_status_t parse_double_slow(char const *str, double *value)
+{
+    // strtod() expects the locale's separator, which is not always '.'
+    char buffer[128];
+    size_t length = strlen(str);
+    char *copy = length < sizeof(buffer) ? buffer : (char *)malloc(length + 1);
+    if (!copy)
+        return INI_STATUS_MEMORY_ERROR;
+    memcpy(copy, str, length + 1);
+
+    char const *point = localeconv()->decimal_point;
+    char *dot = strchr(copy, '.');
+    if (dot && point && point[0] && !point[1])
+        *dot = point[0];
+
+    errno = 0;
+    char *end = NULL;
+    double result = strtod(copy, &end);
+    int overflow = errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL);
+    int complete = end && *end == '\0';
+    if (copy != buffer)
+        free(copy);
+
+    if (!complete || overflow)
+        return INI_STATUS_TYPE_MISMATCH;
+    *value = result;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_parse_double(char const *str, double *value)
+{
+    if (!str || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    char const *p = str;
+    int negative = *p == '-';
+    if (*p == '-' || *p == '+')
+        p++;
+
+    if (equals_ignore_case(p, "inf") || equals_ignore_case(p, "infinity"))
+    {
+        *value = negative ? -HUGE_VAL : HUGE_VAL;
+        return INI_STATUS_SUCCESS;
+    }
+    if (equals_ignore_case(p, "nan"))
+    {
+        *value = NAN;
+        return INI_STATUS_SUCCESS;
+    }
+
+    // Validate the syntax and gather up to 19 significant digits on the way
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int digits = 0;
+    int exponent = 0;
+    for (; *p >= '0' && *p <= '9'; p++, digits++)
+    {
+        if (significant < 19)
+        {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            significant += mantissa != 0;
+        }
+        else
+        {
+            significant++;
+            exponent++;
+        }
+    }
+    if (*p == '.')
+    {
+        for (p++; *p >= '0' && *p <= '9'; p++, digits++)
+        {
+            if (significant < 19)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                significant += mantissa != 0;
+                exponent--;
+            }
+            else
+                significant++;
+        }
+    }
+    if (digits == 0)
+        return INI_STATUS_TYPE_MISMATCH;
+
+    if (*p == 'e' || *p == 'E')
+    {
+        p++;
+        int exponent_negative = *p == '-';
+        if (*p == '-' || *p == '+')
+            p++;
+        if (*p < '0' || *p > '9')
+            return INI_STATUS_TYPE_MISMATCH;
+        int written = 0;
+        for (; *p >= '0' && *p <= '9'; p++)
+        {
+            if (written < 100000) // Far beyond any double; only avoids overflow
+                written = written * 10 + (*p - '0');
+        }
+        exponent += exponent_negative ? -written : written;
+    }
+    if (*p != '\0')
+        return INI_STATUS_TYPE_MISMATCH;
+
+    // Exact when both the digits and the power of ten are exact doubles (Clinger's fast path)
+    if (significant <= 19 && mantissa <= ((uint64_t)1 << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double result = (double)mantissa;
+        result = exponent < 0 ? result / exact_powers_of_ten[-exponent] : result * exact_powers_of_ten[exponent];
+        *value = negative ? -result : result;
+        return INI_STATUS_SUCCESS;
+    }
+    return parse_double_slow(str, value);
+}
+
+INI_PUBLIC_API ini_status_t ini_parse_bool(char const *str, int *value)
+{
+    if (!str || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (strcmp(str, "1") == 0 || equals_ignore_case(str, "true") || equals_ignore_case(str, "yes") ||
+        equals_ignore_case(str, "on"))
+    {
+        *value = 1;
+        return INI_STATUS_SUCCESS;
+    }
+    if (strcmp(str, "0") == 0 || equals_ignore_case(str, "false") || equals_ignore_case(str, "no") ||
+        equals_ignore_case(str, "off"))
+    {
+        *value = 0;
+        return INI_STATUS_SUCCESS;
+    }
+    return INI_STATUS_TYPE_MISMATCH;
+}
+
+// ---------------------------------------------------------------------------
+// Shortest round-trip formatting: Grisu2 (Loitsch, "Printing Floating-Point
+// Numbers Quickly and Accurately with Integers", PLDI 2010). Digits are
+// generated in 64-bit fixed point and always lie strictly between the value's
+// neighbours, so the output reads back to the same value; it is the shortest
+// such string for all but a tiny fraction of inputs.
+// ---------------------------------------------------------------------------
+
+/// @brief Floating-point number `f * 2^e` with a 64-bit significand.
+typedef struct
+{
+    uint64_t f;
+    int e;
+} diy_fp_t;
+
+/// @brief Normalized 10^(-348 + 8 * i), i = 0..86.
+static diy_fp_t const cached_powers[] = {
+    {0xfa8fd5a0081c0288, -1220}, {0xbaaee17fa23ebf76, -1193},
+    {0x8b16fb203055ac76, -1166}, {0xcf42894a5dce35ea, -1140},
+    {0x9a6bb0aa55653b2d, -1113}, {0xe61acf033d1a45df, -1087},
+    {0xab70fe17c79ac6ca, -1060}, {0xff77b1fcbebcdc4f, -1034},
+    {0xbe5691ef416bd60c, -1007}, {0x8dd01fad907ffc3c, -980},
+    {0xd3515c2831559a83, -954}, {0x9d71ac8fada6c9b5, -927},
+    {0xea9c227723ee8bcb, -901}, {0xaecc49914078536d, -874},
+    {0x823c12795db6ce57, -847}, {0xc21094364dfb5637, -821},
+    {0x9096ea6f3848984f, -794}, {0xd77485cb25823ac7, -768},
+    {0xa086cfcd97bf97f4, -741}, {0xef340a98172aace5, -715},
+    {0xb23867fb2a35b28e, -688}, {0x84c8d4dfd2c63f3b, -661},
+    {0xc5dd44271ad3cdba, -635}, {0x936b9fcebb25c996, -608},
+    {0xdbac6c247d62a584, -582}, {0xa3ab66580d5fdaf6, -555},
+    {0xf3e2f893dec3f126, -529}, {0xb5b5ada8aaff80b8, -502},
+    {0x87625f056c7c4a8b, -475}, {0xc9bcff6034c13053, -449},
+    {0x964e858c91ba2655, -422}, {0xdff9772470297ebd, -396},
+    {0xa6dfbd9fb8e5b88f, -369}, {0xf8a95fcf88747d94, -343},
+    {0xb94470938fa89bcf, -316}, {0x8a08f0f8bf0f156b, -289},
+    {0xcdb02555653131b6, -263}, {0x993fe2c6d07b7fac, -236},
+    {0xe45c10c42a2b3b06, -210}, {0xaa242499697392d3, -183},
+    {0xfd87b5f28300ca0e, -157}, {0xbce5086492111aeb, -130},
+    {0x8cbccc096f5088cc, -103}, {0xd1b71758e219652c, -77},
+    {0x9c40000000000000, -50}, {0xe8d4a51000000000, -24},
+    {0xad78ebc5ac620000, 3}, {0x813f3978f8940984, 30},
+    {0xc097ce7bc90715b3, 56}, {0x8f7e32ce7bea5c70, 83},
+    {0xd5d238a4abe98068, 109}, {0x9f4f2726179a2245, 136},
+    {0xed63a231d4c4fb27, 162}, {0xb0de65388cc8ada8, 189},
+    {0x83c7088e1aab65db, 216}, {0xc45d1df942711d9a, 242},
+    {0x924d692ca61be758, 269}, {0xda01ee641a708dea, 295},
+    {0xa26da3999aef774a, 322}, {0xf209787bb47d6b85, 348},
+    {0xb454e4a179dd1877, 375}, {0x865b86925b9bc5c2, 402},
+    {0xc83553c5c8965d3d, 428}, {0x952ab45cfa97a0b3, 455},
+    {0xde469fbd99a05fe3, 481}, {0xa59bc234db398c25, 508},
+    {0xf6c69a72a3989f5c, 534}, {0xb7dcbf5354e9bece, 561},
+    {0x88fcf317f22241e2, 588}, {0xcc20ce9bd35c78a5, 614},
+    {0x98165af37b2153df, 641}, {0xe2a0b5dc971f303a, 667},
+    {0xa8d9d1535ce3b396, 694}, {0xfb9b7cd9a4a7443c, 720},
+    {0xbb764c4ca7a44410, 747}, {0x8bab8eefb6409c1a, 774},
+    {0xd01fef10a657842c, 800}, {0x9b10a4e5e9913129, 827},
+    {0xe7109bfba19c0c9d, 853}, {0xac2820d9623bf429, 880},
+    {0x80444b5e7aa7cf85, 907}, {0xbf21e44003acdd2d, 933},
+    {0x8e679c2f5e44ff8f, 960}, {0xd433179d9c8cb841, 986},
+    {0x9e19db92b4e31ba9, 1013}, {0xeb96bf6ebadf77d9, 1039},
+    {0xaf87023b9bf0ee6b, 1066},
+};
+
+static diy_fp_t diy_fp_normalize(diy_fp_t x)
+{
+    while (!(x.f & ((uint64_t)1 << 63)))
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+// Product rounded to the upper 64 bits
+static diy_fp_t diy_fp_multiply(diy_fp_t x, diy_fp_t y)
+{
+    uint64_t const mask = 0xFFFFFFFFu;
+    uint64_t a = x.f >> 32, b = x.f & mask, c = y.f >> 32, d = y.f & mask;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask) + ((uint64_t)1 << 31);
+    diy_fp_t product = {ac + (ad >> 32) + (bc >> 32) + (middle >> 32), x.e + y.e + 64};
+    return product;
+}
+
+// Power of ten that brings a number with binary exponent `e` into [2^-60, 2^-32)
+static diy_fp_t cached_power(int e, int *decimal_exponent)
+{
+    double dk = (-61 - e) * 0.30102999566398114 + 347; // log10(2)
+    int k = (int)dk;
+    if (dk - k > 0.0)
+        k++;
+    unsigned index = (unsigned)((k >> 3) + 1);
+    *decimal_exponent = -(-348 + (int)index * 8);
+    return cached_powers[index];
+}
+
+static uint64_t const powers_of_ten[] = {
+    1u,
+    10u,
+    100u,
+    1000u,
+    10000u,
+    100000u,
+    1000000u,
+    10000000u,
+    100000000u,
+    1000000000u,
+    10000000000u,
+    100000000000u,
+    1000000000000u,
+    10000000000000u,
+    100000000000000u,
+    1000000000000000u,
+    10000000000000000u,
+    100000000000000000u,
+    1000000000000000000u,
+    10000000000000000000u,
+};
+
+// Moves the last digit towards the exact value while staying inside the interval
+static void grisu_round(char *digits, int length, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t distance)
+{
+    while (rest < distance && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < distance || distance - rest > rest + ten_kappa - distance))
+    {
+        digits[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+static int count_digits32(uint32_t n)
+{
+    int count = 1;
+    while (count < 10 && n >= powers_of_ten[count])
+        count++;
+    return count;
+}
+
+static int generate_digits(diy_fp_t w, diy_fp_t upper, uint64_t delta, char *digits, int *decimal_exponent)
+{
+    diy_fp_t one = {(uint64_t)1 << -upper.e, upper.e};
+    uint64_t distance = upper.f - w.f;
+    uint32_t integral = (uint32_t)(upper.f >> -one.e);
+    uint64_t fraction = upper.f & (one.f - 1);
+    int length = 0;
+
+    for (int kappa = count_digits32(integral); kappa > 0;)
+    {
+        uint32_t divisor = (uint32_t)powers_of_ten[kappa - 1];
+        uint32_t digit = integral / divisor;
+        integral %= divisor;
+        if (digit || length)
+            digits[length++] = (char)('0' + digit);
+        kappa--;
+
+        uint64_t rest = ((uint64_t)integral << -one.e) + fraction;
+        if (rest <= delta)
+        {
+            *decimal_exponent += kappa;
+            grisu_round(digits, length, delta, rest, powers_of_ten[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    for (int kappa = 0;;)
+    {
+        fraction *= 10;
+        delta *= 10;
+        char digit = (char)(fraction >> -one.e);
+        if (digit || length)
+            digits[length++] = (char)('0' + digit);
+        fraction &= one.f - 1;
+        kappa--;
+        if (fraction < delta)
+        {
+            *decimal_exponent += kappa;
+            int index = -kappa;
+            grisu_round(digits, length, delta, fraction, one.f, distance * (index < 20 ? powers_of_ten[index] : 0));
+            return length;
+        }
+    }
+}
+
+// Shortest digits of the positive value `significand * 2^exponent` whose
+// neighbours lie half a unit away (a quarter below for the smallest
+// significand of a binade, `lower_closer`); value = digits * 10^exponent
+static int grisu2(uint64_t significand, int exponent, int lower_closer, char *digits, int *decimal_exponent)
+{
+    diy_fp_t v = {significand, exponent};
+    diy_fp_t upper = {(significand << 1) + 1, exponent - 1};
+    diy_fp_t lower = lower_closer ? (diy_fp_t){(significand << 2) - 1, exponent - 2}
+                                  : (diy_fp_t){(significand << 1) - 1, exponent - 1};
+    upper = diy_fp_normalize(upper);
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    diy_fp_t power = cached_power(upper.e, decimal_exponent);
+    diy_fp_t w = diy_fp_multiply(diy_fp_normalize(v), power);
+    diy_fp_t w_upper = diy_fp_multiply(upper, power);
+    diy_fp_t w_lower = diy_fp_multiply(lower, power);
+    w_lower.f++;
+    w_upper.f--;
+    return generate_digits(w, w_upper, w_upper.f - w_lower.f, digits, decimal_exponent);
+}
+
+// Lays out `digits * 10^exponent` like ECMAScript's Number::toString
+static size_t layout_digits(char *out, char const *digits, int length, int exponent)
+{
+    char *p = out;
+    int point = length + exponent; // Position of the decimal point
+
+    if (length <= point && point <= 21)
+    {
+        memcpy(p, digits, (size_t)length);
+        p += length;
+        for (int i = length; i < point; i++)
+            *p++ = '0';
+    }
+    else if (0 < point && point <= 21)
+    {
+        memcpy(p, digits, (size_t)point);
+        p += point;
+        *p++ = '.';
+        memcpy(p, digits + point, (size_t)(length - point));
+        p += length - point;
+    }
+    else if (-6 < point && point <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        for (int i = point; i < 0; i++)
+            *p++ = '0';
+        memcpy(p, digits, (size_t)length);
+        p += length;
+    }
+    else
+    {
+        *p++ = digits[0];
+        if (length > 1)
+        {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t)(length - 1));
+            p += length - 1;
+        }
+        int e = point - 1;
+        *p++ = 'e';
+        *p++ = e < 0 ? '-' : '+';
+        e = e < 0 ? -e : e;
+        if (e >= 100)
+            *p++ = (char)('0' + e / 100);
+        if (e >= 10)
+            *p++ = (char)('0' + e / 10 % 10);
+        *p++ = (char)('0' + e % 10);
+    }
+    *p = '\0';
+    return (size_t)(p - out);
+}
+
+// Shared by the double and float formatters once the bits are split up
+static size_t format_binary(char *buffer, int negative, uint64_t significand, int exponent, int lower_closer)
+{
+    char *p = buffer;
+    if (negative)
+        *p++ = '-';
+    if (significand == 0)
+    {
+        *p++ = '0';
+        *p = '\0';
+        return (size_t)(p - buffer);
+    }
+
+    char digits[24];
+    int decimal_exponent = 0;
+    int length = grisu2(significand, exponent, lower_closer, digits, &decimal_exponent);
+    return (size_t)(p - buffer) + layout_digits(p, digits, length, decimal_exponent);
+}
+
+static size_t format_special(char *buffer, int negative, int is_nan)
+{
+    char const *text = is_nan ? "nan" : (negative ? "-inf" : "inf");
+    size_t length = strlen(text);
+    memcpy(buffer, text, length + 1);
+    return length;
+}
+
+INI_PUBLIC_API size_t ini_format_double(double value, char *buffer)
+{
+    if (!buffer)
+        return 0;
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int negative = (int)(bits >> 63);
+    int biased = (int)((bits >> 52) & 0x7FF);
+    uint64_t fraction = bits & (((uint64_t)1 << 52) - 1);
+
+    if (biased == 0x7FF)
+        return format_special(buffer, negative, fraction != 0);
+    if (biased == 0) // Subnormal
+        return format_binary(buffer, negative, fraction, 1 - 1075, 0);
+    return format_binary(buffer, negative, fraction | ((uint64_t)1 << 52), biased - 1075, fraction == 0 && biased > 1);
+}
+
+INI_PUBLIC_API size_t ini_format_float(float value, char *buffer)
+{
+    if (!buffer)
+        return 0;
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int negative = (int)(bits >> 31);
+    int biased = (int)((bits >> 23) & 0xFF);
+    uint32_t fraction = bits & ((1u << 23) - 1);
+
+    if (biased == 0xFF)
+        return format_special(buffer, negative, fraction != 0);
+    if (biased == 0)
+        return format_binary(buffer, negative, fraction, 1 - 150, 0);
+    return format_binary(buffer, negative, fraction | (1u << 23), biased - 150, fraction == 0 && biased > 1);
+}
@@ -1,7 +1,13 @@
 #define INI_IMPLEMENTATION
 #include "ini_parser.h"
+#include "ini_batch_read.h"
+#include "ini_binary.h"
 #include "ini_filesystem.h"
+#include "ini_journal.h"
+#include "ini_number.h"
+#include "ini_stream.h"
 #include "ini_string.h"
+#include "ini_thread.h"
 
 #include <stdint.h>
 #include <stdio.h>
@@ -44,9 +50,86 @@ INI_PUBLIC_API ini_ht_t *ini_get_section_ht(ini_ht_t *sections, char const *sect
     return str_to_ptr(str_ptr);
 }
 
+// Forward declarations for the lazy section index
+static ini_status_t materialize_section(ini_context_t *ctx, char const *name, size_t name_len);
+static ini_status_t materialize_all(ini_context_t *ctx);
+
+// Forward declarations for the change journal
+static ini_status_t replay_journal(ini_context_t *ctx, char const *filepath);
+static ini_status_t replay_journal_into(ini_ht_t *sections, char const *filepath, ini_ht_t **touched);
+static ini_status_t journal_changes(ini_context_t *ctx, ini_journal_entry_t const *entries, size_t count);
+
+// Forward declarations for saves of a format-preserving context
+static ini_status_t render_document(ini_context_t *ctx, char **text, size_t *size);
+static ini_status_t save_document(ini_context_t *ctx, char const *filepath);
+
+INI_PUBLIC_API ini_ht_t *ini_get_section(ini_context_t *ctx, char const *section_name)
+{
+    if (!ctx || !section_name)
+        return NULL;
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return NULL;
+
+    ini_ht_t *section_ht = NULL;
+    if (materialize_section(ctx, section_name, strlen(section_name)) == INI_STATUS_SUCCESS)
+        section_ht = ini_get_section_ht(ctx->sections, section_name);
+
+    ini_mutex_unlock(&ctx->mutex);
+    return section_ht;
+}
+
+INI_PUBLIC_API ini_ht_t *ini_get_sections(ini_context_t *ctx)
+{
+    if (!ctx)
+        return NULL;
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return NULL;
+
+    ini_ht_t *sections = materialize_all(ctx) == INI_STATUS_SUCCESS ? ctx->sections : NULL;
+
+    ini_mutex_unlock(&ctx->mutex);
+    return sections;
+}
+
+// Stores a section table under `section_name`, optionally borrowing the name
+static ini_status_t store_section_ht(ini_ht_t *sections, char const *section_name,
+                                     ini_ht_t *section_ht, unsigned flags)
+{
+    char *str_ptr = ptr_to_str(section_ht);
+    if (!str_ptr)
+        return INI_STATUS_MEMORY_ERROR;
+
+    char const *stored = ini_ht_set_ex(sections, section_name, str_ptr, flags & INI_HT_BORROW_KEY);
+    free(str_ptr);
+    return stored ? INI_STATUS_SUCCESS : INI_STATUS_MEMORY_ERROR;
+}
+
+// Destroys every section table and the top-level table itself
+static void destroy_sections(ini_ht_t *sections)
+{
+    if (!sections)
+        return;
+
+    ini_ht_iterator_t it = ini_ht_iterator(sections);
+    char *section_name;
+    char *section_ptr_str;
+
+    while (ini_ht_next(&it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_t *section_ht = str_to_ptr(section_ptr_str);
+        if (section_ht)
+        {
+            ini_ht_destroy(section_ht);
+        }
+    }
+    ini_ht_destroy(sections);
+}
+
 INI_PUBLIC_API ini_context_t *ini_create_context()
 {
-    ini_context_t *ctx = (ini_context_t *)malloc(sizeof(ini_context_t));
+    ini_context_t *ctx = (ini_context_t *)calloc(1, sizeof(ini_context_t));
     if (!ctx)
         return NULL;
 
@@ -64,6 +147,14 @@ INI_PUBLIC_API ini_context_t *ini_create_context()
         return NULL;
     }
 
+    if (ini_mutex_init(&ctx->compact_mutex) != INI_STATUS_SUCCESS)
+    {
+        ini_mutex_destroy(&ctx->mutex);
+        ini_ht_destroy(ctx->sections);
+        free(ctx);
+        return NULL;
+    }
+
     return ctx;
 }
 
@@ -75,26 +166,32 @@ INI_PUBLIC_API ini_status_t ini_free(ini_context_t *ctx)
     if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
         return INI_STATUS_PLATFORM_ERROR;
 
-    // Iterate over the sections
-    if (ctx->sections)
+    // A background compaction needs the lock to finish
+    if (ctx->compactor_state != 0)
     {
-        ini_ht_iterator_t it = ini_ht_iterator(ctx->sections);
-        char *section_name;
-        char *section_ptr_str;
-
-        while (ini_ht_next(&it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
-        {
-            ini_ht_t *section_ht = str_to_ptr(section_ptr_str);
-            if (section_ht)
-            {
-                ini_ht_destroy(section_ht);
-            }
-        }
-        ini_ht_destroy(ctx->sections);
+        ini_mutex_unlock(&ctx->mutex);
+        ini_thread_join(&ctx->compactor);
+        if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+            return INI_STATUS_PLATFORM_ERROR;
     }
 
+    // Section tables may borrow from the buffer or the image, so they go first
+    destroy_sections(ctx->sections);
+    destroy_sections(ctx->dirty);
+    destroy_sections(ctx->document_edits);
+    free(ctx->document);
+    ini_journal_close(ctx->journal);
+    free(ctx->journal_base);
+    if (ctx->buffer)
+        free(ctx->buffer);
+    free(ctx->spans);
+    ini_unmap_file(ctx->image, ctx->image_size);
+    free(ctx->cache_dir);
+
     ini_status_t unlock_err = ini_mutex_unlock(&ctx->mutex);
     ini_status_t destroy_err = ini_mutex_destroy(&ctx->mutex);
+    if (ini_mutex_destroy(&ctx->compact_mutex) != INI_STATUS_SUCCESS)
+        destroy_err = INI_STATUS_PLATFORM_ERROR;
 
     if (ctx)
         free(ctx);
@@ -105,6 +202,77 @@ INI_PUBLIC_API ini_status_t ini_free(ini_context_t *ctx)
     return INI_STATUS_SUCCESS;
 }
 
+INI_PUBLIC_API ini_status_t ini_set_load_flags(ini_context_t *ctx, unsigned flags)
+{
+    if (!ctx || (flags & ~(unsigned)(INI_LOAD_INSITU | INI_LOAD_PARALLEL | INI_LOAD_LAZY | INI_LOAD_CONTENT_HASH |
+                                      INI_LOAD_INCLUDES | INI_LOAD_JOURNAL | INI_LOAD_PRESERVE_FORMAT)))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    ctx->load_flags = flags;
+
+    ini_mutex_unlock(&ctx->mutex);
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_set_load_threads(ini_context_t *ctx, unsigned threads)
+{
+    if (!ctx)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    ctx->load_threads = threads;
+
+    ini_mutex_unlock(&ctx->mutex);
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_set_durability(ini_context_t *ctx, ini_durability_t durability)
+{
+    if (!ctx || durability < INI_DURABILITY_NONE || durability > INI_DURABILITY_DIRECTORY)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    ctx->durability = durability;
+
+    ini_mutex_unlock(&ctx->mutex);
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_set_cache_dir(ini_context_t *ctx, char const *cache_dir)
+{
+    if (!ctx || (cache_dir && strlen(cache_dir) == 0))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    char *copy = NULL;
+    if (cache_dir)
+    {
+        if (ini_is_file_directory(cache_dir) != INI_STATUS_FILE_IS_DIR)
+            return INI_STATUS_FILE_NOT_FOUND;
+        copy = ini_strdup(cache_dir);
+        if (!copy)
+            return INI_STATUS_MEMORY_ERROR;
+    }
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+    {
+        free(copy);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+
+    free(ctx->cache_dir);
+    ctx->cache_dir = copy;
+
+    ini_mutex_unlock(&ctx->mutex);
+    return INI_STATUS_SUCCESS;
+}
+
 INI_PUBLIC_API ini_status_t ini_good(char const *filepath)
 {
     if (!filepath || !*filepath)
@@ -120,354 +288,3158 @@ INI_PUBLIC_API ini_status_t ini_good(char const *filepath)
     if (ini_get_file_size(filepath, &file_size) == INI_STATUS_SUCCESS && file_size == 0)
         return INI_STATUS_FILE_EMPTY;
 
-    FILE *file = ini_fopen(filepath, "r");
+    FILE *file = ini_fopen(filepath, "rb");
     if (!file)
         return INI_STATUS_FILE_OPEN_FAILED;
 
-    // Check for UTF-8 BOM
-    ini_check_utf8_bom(file);
+    // Validate INI syntax (the tokenizer skips a UTF-8 BOM itself)
+    ini_status_t error = ini_parse_stream(file, NULL, NULL);
 
-    size_t fileSize;
-    fs_err = ini_get_file_size(filepath, &fileSize);
-    if (fs_err != INI_STATUS_SUCCESS)
-        return fs_err;
-    if (fileSize == 0)
-        return INI_STATUS_FILE_EMPTY;
+    if (fclose(file) != 0 && error == INI_STATUS_SUCCESS)
+        error = INI_STATUS_CLOSE_FAILED;
 
-    // Validate INI syntax
-    char line[INI_LINE_MAX];
-    unsigned line_num = 0;
-    int in_section = -1;
-    ini_status_t error = INI_STATUS_SUCCESS;
+    return error;
+}
 
-    while (fgets(line, sizeof(line), file))
-    {
-        line_num++;
-        char *trimmed = line;
+/// @brief Selects the sections a filtered load keeps.
+typedef struct
+{
+    char const *const *names; ///< Section names, or name prefixes when `prefix` is set.
+    size_t count;             ///< Number of entries in `names`.
+    int prefix;               ///< Match names by prefix instead of exactly.
+} section_filter_t;
 
-        // Trim leading whitespace
-        while (*trimmed == ' ' || *trimmed == '\t')
-        {
-            trimmed++;
-        }
+static int section_filter_match(section_filter_t const *filter, char const *name, size_t name_len)
+{
+    if (!filter)
+        return 1;
 
-        // Skip empty lines and comments
-        if (*trimmed == '\0' || *trimmed == '\n' || *trimmed == ';' || *trimmed == '#')
-        {
+    for (size_t i = 0; i < filter->count; i++)
+    {
+        char const *wanted = filter->names[i];
+        if (!wanted)
             continue;
-        }
+        size_t wanted_len = strlen(wanted);
+        if ((filter->prefix ? wanted_len <= name_len : wanted_len == name_len) &&
+            memcmp(name, wanted, wanted_len) == 0)
+            return 1;
+    }
+    return 0;
+}
 
-        // Check line length
-        if (strlen(trimmed) >= INI_LINE_MAX - 1 && trimmed[INI_LINE_MAX - 2] != '\n')
-        {
-            error = INI_STATUS_FILE_BAD_FORMAT;
-            break;
-        }
+/// @brief Growable text buffer.
+typedef struct
+{
+    char *data;      ///< Text so far (not null-terminated).
+    size_t size;     ///< Bytes used in `data`.
+    size_t capacity; ///< Bytes allocated for `data`.
+    int failed;      ///< Non-zero once an allocation failed; later appends are ignored.
+} text_out_t;
 
-        // Check for section
-        if (*trimmed == '[')
-        {
-            char *end = strchr(trimmed, ']');
-            if (!end)
-            {
-                error = INI_STATUS_FILE_BAD_FORMAT;
-                break;
-            }
-            in_section = 0;
-        }
+static void out_append(text_out_t *out, char const *bytes, size_t length)
+{
+    if (out->failed)
+        return;
 
-        // Check for key-value pair
-        else if (in_section == 0)
+    if (out->size + length > out->capacity)
+    {
+        size_t capacity = out->capacity ? out->capacity * 2 : INI_LINE_MAX;
+        while (capacity < out->size + length)
+            capacity *= 2;
+        char *grown = (char *)realloc(out->data, capacity);
+        if (!grown)
         {
-            char *eq = strchr(trimmed, '=');
-            if (!eq || eq == trimmed)
-            {
-                error = INI_STATUS_FILE_BAD_FORMAT;
-                break;
-            }
+            out->failed = 1;
+            return;
+        }
+        out->data = grown;
+        out->capacity = capacity;
+    }
+    memcpy(out->data + out->size, bytes, length);
+    out->size += length;
+}
 
-            // Validate value (basic checks)
-            char *value = eq + 1;
-            while (*value == ' ' || *value == '\t')
-            {
-                value++;
-            }
+/// @brief A `key[]=` list of the section being read, joined once the section ends.
+typedef struct
+{
+    char const *key; ///< Key as stored in the section table.
+    text_out_t text; ///< Items so far, joined with commas.
+} pending_list_t;
 
-            // Check for quoted strings
-            if (*value == '"')
-            {
-                char *end_quote = strchr(value + 1, '"');
-                if (!end_quote || (end_quote[1] != '\0' && end_quote[1] != '\n' &&
-                                   end_quote[1] != ';' && end_quote[1] != '#'))
-                {
-                    error = INI_STATUS_FILE_BAD_FORMAT;
-                    break;
-                }
-            }
-            // Reject arrays (comma-separated values)
-            else if (strchr(value, ','))
-            {
-                error = INI_STATUS_FILE_BAD_FORMAT;
-                break;
-            }
-        }
-        else
-        {
-            error = INI_STATUS_FILE_BAD_FORMAT;
+// Appends a list item, escaping `,` and `\` so `ini_get_array()` gives it back whole
+static void out_list_item(text_out_t *out, char const *item, size_t length)
+{
+    char const *end = item + length;
+    while (item < end)
+    {
+        char const *special = item;
+        while (special < end && *special != ',' && *special != '\\')
+            special++;
+        out_append(out, item, (size_t)(special - item));
+        if (special == end)
             break;
-        }
+        out_append(out, "\\", 1);
+        out_append(out, special, 1);
+        item = special + 1;
     }
+}
 
-    if (fclose(file) != 0 && error == INI_STATUS_SUCCESS)
-        error = INI_STATUS_CLOSE_FAILED;
+/// @brief State of the tokenizer handler that builds section tables.
+typedef struct
+{
+    ini_ht_t *sections;             ///< Table being populated.
+    section_filter_t const *filter; ///< Sections to keep (NULL keeps all).
+    ini_ht_t *current_section_ht;   ///< Table of the section being read.
+    unsigned borrow;                ///< INI_HT_BORROW_* flags for stored strings.
+    ini_ht_t *lists;                ///< Key → `pending_list_t` of the current section (NULL if none).
+    ini_ht_t *appends;              ///< Section → keys whose first line was `key[]=` (NULL skips tracking).
+    ini_ht_t *current_appends;      ///< Entry of `appends` for the current section (NULL if none yet).
+    char const *current_section;    ///< Name of the section being read.
+    ini_status_t status;            ///< First failure while building.
+} table_builder_t;
+
+// Stores the lists collected for the current section, one copy per list
+static void flush_lists(table_builder_t *builder)
+{
+    if (!builder->lists)
+        return;
 
-    return error;
+    ini_ht_iterator_t it = ini_ht_iterator(builder->lists);
+    char *key;
+    char *list_ptr_str;
+    while (ini_ht_next(&it, &key, &list_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        pending_list_t *list = (pending_list_t *)str_to_ptr(list_ptr_str);
+        out_append(&list->text, "", 1);
+        if (builder->status == INI_STATUS_SUCCESS &&
+            (list->text.failed || !ini_ht_set_ex(builder->current_section_ht, list->key, list->text.data,
+                                                 builder->borrow & ~INI_HT_BORROW_VALUE)))
+            builder->status = INI_STATUS_MEMORY_ERROR;
+        free(list->text.data);
+        free(list);
+    }
+    ini_ht_destroy(builder->lists);
+    builder->lists = NULL;
 }
 
-INI_PUBLIC_API ini_status_t ini_load(ini_context_t *ctx, char const *filepath)
+// Returns the pending list of `key`, or NULL if the key has none
+static pending_list_t *find_list(table_builder_t *builder, char const *key)
 {
-    if (!filepath || strlen(filepath) == 0)
-        return INI_STATUS_INVALID_ARGUMENT;
-
-    // Validate file first
-    ini_status_t err = ini_good(filepath);
-    if (err != INI_STATUS_SUCCESS)
-        return err;
+    char const *list_ptr_str = builder->lists ? ini_ht_get(builder->lists, key) : NULL;
+    return list_ptr_str ? (pending_list_t *)str_to_ptr(list_ptr_str) : NULL;
+}
 
-    // Create context if NULL
-    ini_context_t *ctx_to_use = ctx;
-    int need_to_free_on_error = 0;
+// Starts a pending list for `key` that continues `existing` (NULL if the key is new)
+static pending_list_t *start_list(table_builder_t *builder, char const *key, char const *existing)
+{
+    if (!builder->lists && !(builder->lists = ini_ht_create()))
+        return NULL;
 
-    if (!ctx_to_use)
+    pending_list_t *list = (pending_list_t *)calloc(1, sizeof(pending_list_t));
+    char *list_ptr_str = list ? ptr_to_str(list) : NULL;
+    if (!list_ptr_str || !ini_ht_set(builder->lists, key, list_ptr_str))
     {
-        ctx_to_use = ini_create_context();
-        if (!ctx_to_use)
-        {
-            return INI_STATUS_MEMORY_ERROR;
-        }
-        need_to_free_on_error = 1;
+        free(list_ptr_str);
+        free(list);
+        return NULL;
     }
-    else
-    {
-        // Clear existing context by freeing all section hash tables
-        if (ini_mutex_lock(&ctx_to_use->mutex) != 0)
-        {
-            return INI_STATUS_PLATFORM_ERROR;
-        }
+    free(list_ptr_str);
 
-        ini_ht_iterator_t it = ini_ht_iterator(ctx_to_use->sections);
-        char *section_name;
-        char *section_ptr_str;
+    list->key = key;
+    if (existing)
+    {
+        out_append(&list->text, existing, strlen(existing));
+        out_append(&list->text, ",", 1);
+    }
+    return list;
+}
 
-        while (ini_ht_next(&it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
-        {
-            ini_ht_t *section_ht = str_to_ptr(section_ptr_str);
-            if (section_ht)
-            {
-                ini_ht_destroy(section_ht);
-            }
-        }
+// The loader owns the buffer it tokenizes, so slices are terminated in place
+static ini_parse_action_t build_section(void *user, char const *name, size_t name_len, unsigned line)
+{
+    table_builder_t *builder = (table_builder_t *)user;
+    (void)line;
 
-        // Reset the top-level hash table
-        ini_ht_destroy(ctx_to_use->sections);
-        ctx_to_use->sections = ini_ht_create();
+    flush_lists(builder);
+    if (builder->status != INI_STATUS_SUCCESS)
+        return INI_PARSE_STOP;
 
-        if (!ctx_to_use->sections)
-        {
-            ini_mutex_unlock(&ctx_to_use->mutex);
-            return INI_STATUS_MEMORY_ERROR;
-        }
+    ((char *)name)[name_len] = '\0';
 
-        ini_mutex_unlock(&ctx_to_use->mutex);
+    // Unwanted sections are skipped by the tokenizer without touching their keys
+    if (!section_filter_match(builder->filter, name, name_len))
+    {
+        builder->current_section_ht = NULL;
+        return INI_PARSE_SKIP_SECTION;
     }
 
-    FILE *file = ini_fopen(filepath, "r");
-    if (!file)
+    builder->current_section = name;
+    builder->current_appends = builder->appends ? ini_get_section_ht(builder->appends, name) : NULL;
+    builder->current_section_ht = ini_get_section_ht(builder->sections, name);
+    if (builder->current_section_ht)
+        return INI_PARSE_CONTINUE;
+
+    ini_ht_t *section_ht = ini_ht_create();
+    if (!section_ht)
     {
-        if (need_to_free_on_error)
-            ini_free(ctx_to_use);
-        return INI_STATUS_FILE_OPEN_FAILED;
+        builder->status = INI_STATUS_MEMORY_ERROR;
+        return INI_PARSE_STOP;
     }
 
-    // Check for UTF-8 BOM
-    ini_check_utf8_bom(file);
-
-    // Lock context for thread safety
-    if (ini_mutex_lock(&ctx_to_use->mutex) != 0)
+    if (store_section_ht(builder->sections, name, section_ht, builder->borrow) != INI_STATUS_SUCCESS)
     {
-        fclose(file);
-        if (need_to_free_on_error)
-        {
-            ini_free(ctx_to_use);
-        }
-        return INI_STATUS_PLATFORM_ERROR;
+        ini_ht_destroy(section_ht);
+        builder->status = INI_STATUS_MEMORY_ERROR;
+        return INI_PARSE_STOP;
     }
 
-    // Parse the INI file
-    char line[INI_LINE_MAX];
-    char current_section[INI_LINE_MAX] = ""; // Empty string means global section
-    ini_ht_t *current_section_ht = NULL;
-    int line_num = 0;
+    builder->current_section_ht = section_ht;
+    return INI_PARSE_CONTINUE;
+}
 
-    while (fgets(line, sizeof(line), file))
+/**
+ * @brief Tracks which keys of the current section continue a list of an earlier chunk.
+ *
+ * A parallel chunk cannot see what came before it, so `key[]=` on a key it has
+ * not seen yet starts a fresh list; `merge_sections()` then joins it to the
+ * earlier value. A plain assignment restarts the list and clears the mark.
+ */
+static int track_append(table_builder_t *builder, char const *key, int append)
+{
+    if (!append)
     {
-        line_num++;
-        char *trimmed = line;
+        if (builder->current_appends && ini_ht_get(builder->current_appends, key))
+            ini_ht_remove(builder->current_appends, key);
+        return 1;
+    }
 
-        // Trim leading whitespace
-        while (*trimmed && (*trimmed == ' ' || *trimmed == '\t'))
+    if (!builder->current_appends)
+    {
+        ini_ht_t *keys = ini_ht_create();
+        if (!keys)
+            return 0;
+        if (store_section_ht(builder->appends, builder->current_section, keys, INI_HT_BORROW_NONE) !=
+            INI_STATUS_SUCCESS)
         {
-            trimmed++;
+            ini_ht_destroy(keys);
+            return 0;
         }
+        builder->current_appends = keys;
+    }
+    return ini_ht_set(builder->current_appends, key, "") != NULL;
+}
 
-        // Skip empty lines and comments
-        if (*trimmed == '\0' || *trimmed == '\n' || *trimmed == '\r' ||
-            *trimmed == ';' || *trimmed == '#')
+static ini_parse_action_t build_key_value(void *user,
+                                          char const *section, size_t section_len,
+                                          char const *key, size_t key_len,
+                                          char const *value, size_t value_len,
+                                          unsigned line)
+{
+    table_builder_t *builder = (table_builder_t *)user;
+    (void)section;
+    (void)section_len;
+    (void)line;
+
+    // `key[]=item` appends to the list stored under `key`
+    int append = key_len > 2 && key[key_len - 2] == '[' && key[key_len - 1] == ']';
+    if (append)
+        key_len -= 2;
+
+    ((char *)key)[key_len] = '\0';
+    ((char *)value)[value_len] = '\0';
+
+    // Items are collected until the section ends, so a long list is joined once
+    pending_list_t *list = find_list(builder, key);
+    if (builder->appends)
+    {
+        int first = !list && !ini_ht_get(builder->current_section_ht, key);
+        if ((first ? append : !append) && !track_append(builder, key, append))
         {
-            continue;
+            builder->status = INI_STATUS_MEMORY_ERROR;
+            return INI_PARSE_STOP;
         }
-
-        // Handle section header
-        if (*trimmed == '[')
+    }
+    if (list && !append)
+    {
+        list->text.size = 0;
+        out_append(&list->text, value, value_len);
+    }
+    else if (append && (list || ini_ht_get(builder->current_section_ht, key) || strpbrk(value, ",\\")))
+    {
+        if (list)
+            out_append(&list->text, ",", 1);
+        else
+            list = start_list(builder, key, ini_ht_get(builder->current_section_ht, key));
+        if (list)
+            out_list_item(&list->text, value, value_len);
+        if (!list || list->text.failed)
         {
-            char *end = strchr(trimmed, ']');
-            if (!end)
-            {
-                fclose(file);
-                ini_mutex_unlock(&ctx_to_use->mutex);
-                if (need_to_free_on_error)
-                {
-                    ini_free(ctx_to_use);
-                }
-                return INI_STATUS_FILE_BAD_FORMAT;
-            }
+            builder->status = INI_STATUS_MEMORY_ERROR;
+            return INI_PARSE_STOP;
+        }
+    }
+    else if (!ini_ht_set_ex(builder->current_section_ht, key, value, builder->borrow))
+    {
+        builder->status = INI_STATUS_MEMORY_ERROR;
+        return INI_PARSE_STOP;
+    }
+    return INI_PARSE_CONTINUE;
+}
 
-            *end = '\0';
-            strncpy(current_section, trimmed + 1, INI_LINE_MAX - 1);
-            current_section[INI_LINE_MAX - 1] = '\0';
+static ini_handler_t const table_builder_handler = {build_section, build_key_value, NULL, NULL};
 
-            // Get or create section hash table
-            current_section_ht = (ini_ht_t *)ini_ht_get(ctx_to_use->sections, current_section);
+/**
+ * @brief Parses an in-memory INI buffer into `sections`.
+ *
+ * The tokenizer applies the same rules as `ini_good()`, so a file is validated
+ * and indexed in a single pass. Section names, keys and values are terminated
+ * in place; with `insitu` set the tables borrow them from `data`, which must
+ * then outlive `sections`. Sections rejected by `filter` are skipped unparsed.
+ * A non-NULL `appends` receives the lists a parallel chunk continues (see
+ * `track_append()`).
+ */
+static ini_status_t parse_buffer_tracked(ini_ht_t *sections, char *data, size_t size, int insitu,
+                                         section_filter_t const *filter, ini_ht_t *appends)
+{
+    table_builder_t builder;
+    builder.sections = sections;
+    builder.filter = filter;
+    builder.current_section_ht = NULL;
+    builder.borrow = insitu ? (INI_HT_BORROW_KEY | INI_HT_BORROW_VALUE) : INI_HT_BORROW_NONE;
+    builder.lists = NULL;
+    builder.appends = appends;
+    builder.current_appends = NULL;
+    builder.current_section = "";
+    builder.status = INI_STATUS_SUCCESS;
+
+    ini_status_t status = ini_parse_buffer(data, size, &table_builder_handler, &builder);
+    flush_lists(&builder);
+    return builder.status != INI_STATUS_SUCCESS ? builder.status : status;
+}
 
-            if (!current_section_ht)
-            {
-                // Create new section hash table
-                current_section_ht = ini_ht_create();
-                if (!current_section_ht)
-                {
-                    fclose(file);
-                    ini_mutex_unlock(&ctx_to_use->mutex);
-                    if (need_to_free_on_error)
-                    {
-                        ini_free(ctx_to_use);
-                    }
-                    return INI_STATUS_MEMORY_ERROR;
-                }
+static ini_status_t parse_buffer(ini_ht_t *sections, char *data, size_t size, int insitu,
+                                 section_filter_t const *filter)
+{
+    return parse_buffer_tracked(sections, data, size, insitu, filter, NULL);
+}
 
-                // Add it to the sections hash table
-                ini_store_section_ht(ctx_to_use->sections, current_section, current_section_ht);
-            }
-        }
-        // Handle key-value pair
-        else if (strchr(trimmed, '='))
-        {
-            char *eq = strchr(trimmed, '=');
-            if (!eq)
-            {
-                continue; // Shouldn't happen due to the check above
-            }
+/// @brief One slice of the input parsed by a parallel load worker.
+typedef struct
+{
+    ini_ht_t *sections; ///< Private section tables for this slice.
+    char *data;         ///< Start of the slice (always a line start).
+    size_t size;        ///< Slice length in bytes.
+    int insitu;         ///< Borrow strings from `data` instead of copying them.
+    section_filter_t const *filter; ///< Sections to keep (NULL keeps all).
+    ini_ht_t *appends;  ///< Lists this slice continues (see `track_append()`), NULL for the first slice.
+    ini_status_t status;
+} parse_chunk_t;
+
+static void parse_chunk_worker(void *arg)
+{
+    parse_chunk_t *chunk = (parse_chunk_t *)arg;
+    chunk->status = parse_buffer_tracked(chunk->sections, chunk->data, chunk->size, chunk->insitu, chunk->filter,
+                                         chunk->appends);
+}
 
-            // Split key and value
-            *eq = '\0';
-            char *key = trimmed;
-            char *value = eq + 1;
+// Returns the first line start at or after `from` that opens a section, or `end`
+static char *find_section_boundary(char *from, char *end)
+{
+    while (from < end)
+    {
+        char *newline = (char *)memchr(from, '\n', (size_t)(end - from));
+        if (!newline)
+            break;
+        if (newline + 1 < end && newline[1] == '[')
+            return newline + 1;
+        from = newline + 1;
+    }
+    return end;
+}
 
-            // Trim key
-            char *key_end = eq - 1;
-            while (key_end >= key && (*key_end == ' ' || *key_end == '\t'))
-            {
-                *key_end-- = '\0';
-            }
+// Stores `earlier,items` under `key`, as `key[]=` lines continuing `earlier` would
+static ini_status_t join_list(ini_ht_t *section_ht, char const *key, char const *earlier, char const *items)
+{
+    text_out_t text;
+    memset(&text, 0, sizeof(text));
+    out_append(&text, earlier, strlen(earlier));
+    out_append(&text, ",", 1);
+    out_append(&text, items, strlen(items) + 1);
+    ini_status_t status = !text.failed && ini_ht_set(section_ht, key, text.data) ? INI_STATUS_SUCCESS
+                                                                                   : INI_STATUS_MEMORY_ERROR;
+    free(text.data);
+    return status;
+}
 
-            // Trim value
-            while (*value && (*value == ' ' || *value == '\t'))
+/**
+ * @brief Moves the section tables of a later chunk into `into`.
+ *
+ * Sections seen for the first time are adopted as-is; keys of repeated sections
+ * overwrite the earlier ones, except the lists named in `appends` (may be
+ * NULL), whose items are added to the earlier value. `from` and `appends` are
+ * consumed in all cases. Only strings `from` borrowed itself are borrowed.
+ */
+static ini_status_t merge_sections(ini_ht_t *into, ini_ht_t *from, unsigned borrow, ini_ht_t *appends)
+{
+    ini_status_t status = INI_STATUS_SUCCESS;
+    ini_ht_iterator_t it = ini_ht_iterator(from);
+    char *section_name;
+    char *section_ptr_str;
+
+    while (ini_ht_next(&it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_t *section_ht = str_to_ptr(section_ptr_str);
+        ini_ht_t *existing_ht = status == INI_STATUS_SUCCESS ? ini_get_section_ht(into, section_name) : NULL;
+
+        if (status == INI_STATUS_SUCCESS && !existing_ht)
+        {
+            status = store_section_ht(into, section_name, section_ht, borrow);
+            if (status == INI_STATUS_SUCCESS)
+                continue;
+        }
+        else if (status == INI_STATUS_SUCCESS)
+        {
+            ini_ht_t *continued = appends ? ini_get_section_ht(appends, section_name) : NULL;
+            ini_ht_iterator_t pairs_it = ini_ht_iterator(section_ht);
+            char *key;
+            char *value;
+
+            while (status == INI_STATUS_SUCCESS && ini_ht_next(&pairs_it, &key, &value) == INI_STATUS_SUCCESS)
+            {
+                char const *earlier = continued && ini_ht_get(continued, key) ? ini_ht_get(existing_ht, key) : NULL;
+                if (earlier)
+                    status = join_list(existing_ht, key, earlier, value);
+                // Lists `section_ht` joined itself are copies it owns, and it goes away below
+                else if (!ini_ht_set_ex(existing_ht, key, value, borrow & ini_ht_find(section_ht, key)->flags))
+                    status = INI_STATUS_MEMORY_ERROR;
+            }
+        }
+        ini_ht_destroy(section_ht);
+    }
+
+    ini_ht_destroy(from);
+    destroy_sections(appends);
+    return status;
+}
+
+/**
+ * @brief Parses `data` on up to `threads` workers.
+ *
+ * The buffer is cut only where a line starts with `[`, so every chunk but the
+ * first begins with a section header and parses exactly as it would serially.
+ * Chunks are merged in file order, which keeps last-wins semantics, and the
+ * error reported is the one of the earliest failing chunk.
+ */
+static ini_status_t parse_buffer_parallel(ini_ht_t *sections, char *data, size_t size,
+                                          int insitu, section_filter_t const *filter, unsigned threads)
+{
+    size_t max_chunks = size / INI_PARALLEL_MIN_CHUNK_SIZE;
+    if (threads > max_chunks)
+        threads = (unsigned)max_chunks;
+    if (threads < 2)
+        return parse_buffer(sections, data, size, insitu, filter);
+
+    parse_chunk_t *chunks = (parse_chunk_t *)calloc(threads, sizeof(parse_chunk_t));
+    ini_thread_t *workers = (ini_thread_t *)calloc(threads, sizeof(ini_thread_t));
+    int *started = (int *)calloc(threads, sizeof(int));
+    if (!chunks || !workers || !started)
+    {
+        free(chunks);
+        free(workers);
+        free(started);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+
+    // Cut the buffer at section headers near evenly spaced offsets
+    char *end = data + size;
+    char *chunk_start = data;
+    unsigned count = 0;
+    for (unsigned i = 1; i <= threads && chunk_start < end; i++)
+    {
+        char *chunk_end = end;
+        if (i < threads)
+        {
+            char *probe = data + (size / threads) * i;
+            chunk_end = find_section_boundary(probe > chunk_start ? probe : chunk_start, end);
+        }
+
+        chunks[count].sections = count == 0 ? sections : ini_ht_create();
+        chunks[count].data = chunk_start;
+        chunks[count].size = (size_t)(chunk_end - chunk_start);
+        chunks[count].insitu = insitu;
+        chunks[count].filter = filter;
+        chunks[count].appends = count == 0 ? NULL : ini_ht_create();
+        chunks[count].status = chunks[count].sections && (count == 0 || chunks[count].appends)
+                                   ? INI_STATUS_SUCCESS
+                                   : INI_STATUS_MEMORY_ERROR;
+        count++;
+        chunk_start = chunk_end;
+    }
+
+    // The calling thread takes the first chunk; a worker that fails to start runs inline
+    for (unsigned i = 1; i < count; i++)
+    {
+        if (chunks[i].status != INI_STATUS_SUCCESS)
+            continue;
+        started[i] = ini_thread_create(&workers[i], parse_chunk_worker, &chunks[i]) == INI_STATUS_SUCCESS;
+        if (!started[i])
+            parse_chunk_worker(&chunks[i]);
+    }
+    parse_chunk_worker(&chunks[0]);
+
+    ini_status_t status = INI_STATUS_SUCCESS;
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (started[i] && ini_thread_join(&workers[i]) != INI_STATUS_SUCCESS && status == INI_STATUS_SUCCESS)
+            status = INI_STATUS_PLATFORM_ERROR;
+        if (status == INI_STATUS_SUCCESS)
+            status = chunks[i].status;
+    }
+
+    // Merge in file order; on error the remaining chunks are only released
+    unsigned borrow = insitu ? (INI_HT_BORROW_KEY | INI_HT_BORROW_VALUE) : INI_HT_BORROW_NONE;
+    for (unsigned i = 1; i < count; i++)
+    {
+        if (!chunks[i].sections)
+        {
+            destroy_sections(chunks[i].appends);
+            continue;
+        }
+        if (status == INI_STATUS_SUCCESS)
+            status = merge_sections(sections, chunks[i].sections, borrow, chunks[i].appends);
+        else
+        {
+            destroy_sections(chunks[i].sections);
+            destroy_sections(chunks[i].appends);
+        }
+    }
+
+    free(chunks);
+    free(workers);
+    free(started);
+    return status;
+}
+
+/// @brief State of the tokenizer handler that indexes sections for a lazy load.
+typedef struct
+{
+    char const *data;               ///< Buffer being scanned.
+    size_t size;                    ///< Size of `data` in bytes.
+    section_filter_t const *filter; ///< Sections to index (NULL indexes all).
+    ini_section_span_t *spans;      ///< Recorded ranges, in file order.
+    size_t count;                   ///< Number of recorded ranges.
+    size_t capacity;                ///< Allocated entries in `spans`.
+    int open;                       ///< The last range still extends to the next header.
+    ini_status_t status;            ///< First failure while indexing.
+} section_scanner_t;
+
+static ini_parse_action_t scan_section(void *user, char const *name, size_t name_len, unsigned line)
+{
+    section_scanner_t *scanner = (section_scanner_t *)user;
+    (void)line;
+
+    // The header line starts at the blanks before its '['
+    char const *header = name - 1;
+    while (header > scanner->data && (header[-1] == ' ' || header[-1] == '\t'))
+        header--;
+    size_t offset = (size_t)(header - scanner->data);
+
+    if (scanner->open)
+    {
+        scanner->spans[scanner->count - 1].end = offset;
+        scanner->open = 0;
+    }
+
+    if (!section_filter_match(scanner->filter, name, name_len))
+        return INI_PARSE_SKIP_SECTION;
+
+    if (scanner->count == scanner->capacity)
+    {
+        size_t capacity = scanner->capacity ? scanner->capacity * 2 : 64;
+        ini_section_span_t *spans = (ini_section_span_t *)realloc(scanner->spans, capacity * sizeof(ini_section_span_t));
+        if (!spans)
+        {
+            scanner->status = INI_STATUS_MEMORY_ERROR;
+            return INI_PARSE_STOP;
+        }
+        scanner->spans = spans;
+        scanner->capacity = capacity;
+    }
+
+    ini_section_span_t *span = &scanner->spans[scanner->count++];
+    span->name = name;
+    span->name_len = name_len;
+    span->begin = offset;
+    span->end = scanner->size;
+    span->materialized = 0;
+    scanner->open = 1;
+    return INI_PARSE_CONTINUE;
+}
+
+static ini_handler_t const section_scanner_handler = {scan_section, NULL, NULL, NULL};
+
+static int compare_spans(void const *lhs, void const *rhs)
+{
+    ini_section_span_t const *a = (ini_section_span_t const *)lhs;
+    ini_section_span_t const *b = (ini_section_span_t const *)rhs;
+
+    int order = memcmp(a->name, b->name, a->name_len < b->name_len ? a->name_len : b->name_len);
+    if (order != 0)
+        return order;
+    if (a->name_len != b->name_len)
+        return a->name_len < b->name_len ? -1 : 1;
+    return a->begin < b->begin ? -1 : (a->begin > b->begin ? 1 : 0);
+}
+
+/**
+ * @brief Validates `data` and records the byte range of every section.
+ *
+ * Key lines are checked but not stored, so the only allocation is the span
+ * array. The spans are sorted by name and then by offset, which keeps repeated
+ * sections adjacent and in file order for `materialize_section()`.
+ */
+static ini_status_t scan_sections(char const *data, size_t size, section_filter_t const *filter,
+                                  ini_section_span_t **spans, size_t *count)
+{
+    section_scanner_t scanner;
+    memset(&scanner, 0, sizeof(scanner));
+    scanner.data = data;
+    scanner.size = size;
+    scanner.filter = filter;
+
+    ini_status_t status = ini_parse_buffer(data, size, &section_scanner_handler, &scanner);
+    if (scanner.status != INI_STATUS_SUCCESS)
+        status = scanner.status;
+    if (status != INI_STATUS_SUCCESS)
+    {
+        free(scanner.spans);
+        return status;
+    }
+
+    if (scanner.count > 1)
+        qsort(scanner.spans, scanner.count, sizeof(ini_section_span_t), compare_spans);
+
+    *spans = scanner.spans;
+    *count = scanner.count;
+    return INI_STATUS_SUCCESS;
+}
+
+// Indexes a binary image into tables the first time they are needed; the caller holds the lock
+static ini_status_t materialize_image(ini_context_t *ctx)
+{
+    if (!ctx->image || ctx->image_materialized)
+        return INI_STATUS_SUCCESS;
+
+    ini_ht_t *sections = ini_ht_create();
+    if (!sections)
+        return INI_STATUS_MEMORY_ERROR;
+
+    ini_status_t status = ini_binary_materialize(ctx->image, sections);
+    if (status != INI_STATUS_SUCCESS)
+    {
+        destroy_sections(sections);
+        return status;
+    }
+
+    destroy_sections(ctx->sections);
+    ctx->sections = sections;
+    ctx->image_materialized = 1;
+    return INI_STATUS_SUCCESS;
+}
+
+// Parses every pending range of `name` into the context; the caller holds the lock
+static ini_status_t materialize_section(ini_context_t *ctx, char const *name, size_t name_len)
+{
+    if (ctx->image)
+        return materialize_image(ctx);
+
+    // Lower bound of `name` in the sorted spans
+    size_t low = 0;
+    size_t high = ctx->span_count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        ini_section_span_t const *span = &ctx->spans[mid];
+        int order = memcmp(span->name, name, span->name_len < name_len ? span->name_len : name_len);
+        if (order < 0 || (order == 0 && span->name_len < name_len))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    for (size_t i = low; i < ctx->span_count; i++)
+    {
+        ini_section_span_t *span = &ctx->spans[i];
+        if (span->name_len != name_len || memcmp(span->name, name, name_len) != 0)
+            break;
+        if (span->materialized)
+            continue;
+
+        ini_status_t status = parse_buffer(ctx->sections, ctx->buffer + span->begin,
+                                           span->end - span->begin, 1, NULL);
+        if (status != INI_STATUS_SUCCESS)
+            return status;
+        span->materialized = 1;
+    }
+    return INI_STATUS_SUCCESS;
+}
+
+// Parses every pending range and drops the index; the caller holds the lock
+static ini_status_t materialize_all(ini_context_t *ctx)
+{
+    if (ctx->image)
+        return materialize_image(ctx);
+
+    for (size_t i = 0; i < ctx->span_count; i++)
+    {
+        ini_section_span_t *span = &ctx->spans[i];
+        if (span->materialized)
+            continue;
+
+        ini_status_t status = parse_buffer(ctx->sections, ctx->buffer + span->begin,
+                                           span->end - span->begin, 1, NULL);
+        if (status != INI_STATUS_SUCCESS)
+            return status;
+        span->materialized = 1;
+    }
+
+    free(ctx->spans);
+    ctx->spans = NULL;
+    ctx->span_count = 0;
+    return INI_STATUS_SUCCESS;
+}
+
+/// @brief Everything a load installs into a context.
+typedef struct
+{
+    ini_ht_t *sections;                        ///< Parsed section tables.
+    char *buffer;                              ///< Buffer the tables borrow from (NULL if none).
+    size_t buffer_size;                        ///< Size of `buffer`.
+    ini_section_span_t *spans;                 ///< Pending lazy sections (NULL if none).
+    size_t span_count;                         ///< Number of entries in `spans`.
+    void const *image;                         ///< Mapped binary image (NULL if none).
+    size_t image_size;                         ///< Size of `image`.
+    ini_file_fingerprint_t const *fingerprint; ///< Source file version (NULL if unknown).
+    uint64_t content_hash;                     ///< `hash_bytes()` of the source file.
+    char *document;                            ///< Unparsed copy of the file (`INI_LOAD_PRESERVE_FORMAT`).
+    size_t document_size;                      ///< Size of `document`.
+} loaded_contents_t;
+
+// Releases contents that were not (or are no longer) installed
+static void release_contents(loaded_contents_t const *contents)
+{
+    // Section tables may borrow from the buffer or the image, so they go first
+    destroy_sections(contents->sections);
+    if (contents->buffer)
+        free(contents->buffer);
+    free(contents->spans);
+    ini_unmap_file(contents->image, contents->image_size);
+    free(contents->document);
+}
+
+/**
+ * @brief Replaces the contents of `ctx`, which takes ownership of `contents`.
+ *
+ * Only the pointer swap happens under the lock; the previous contents are
+ * released after it. On failure `contents` is released instead.
+ */
+static ini_status_t swap_contents(ini_context_t *ctx, loaded_contents_t const *contents)
+{
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+    {
+        release_contents(contents);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+
+    loaded_contents_t old;
+    memset(&old, 0, sizeof(old));
+    old.sections = ctx->sections;
+    old.buffer = ctx->buffer;
+    old.spans = ctx->spans;
+    old.image = ctx->image;
+    old.image_size = ctx->image_size;
+    old.document = ctx->document;
+
+    ctx->sections = contents->sections;
+    ctx->buffer = contents->buffer;
+    ctx->buffer_size = contents->buffer_size;
+    ctx->spans = contents->spans;
+    ctx->span_count = contents->span_count;
+    ctx->image = contents->image;
+    ctx->image_size = contents->image_size;
+    ctx->image_materialized = 0;
+    ctx->has_fingerprint = contents->fingerprint != NULL;
+    if (contents->fingerprint)
+        ctx->fingerprint = *contents->fingerprint;
+    ctx->content_hash = contents->content_hash;
+    ctx->document = contents->document;
+    ctx->document_size = contents->document_size;
+    ctx->document_version++;
+    // The context matches the file again
+    ini_ht_t *dirty = ctx->dirty;
+    ini_ht_t *edits = ctx->document_edits;
+    ctx->dirty = NULL;
+    ctx->document_edits = NULL;
+
+    ini_mutex_unlock(&ctx->mutex);
+
+    release_contents(&old);
+    destroy_sections(dirty);
+    destroy_sections(edits);
+    return INI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Parses `data` and swaps the result into `ctx`, keeping only the sections `filter` accepts.
+ *
+ * Takes ownership of `data`. `fingerprint` (may be NULL) describes the file the
+ * data came from and `content_hash` (may be NULL) its precomputed `hash_bytes()`;
+ * both are recorded for `ini_reload_if_changed()`.
+ */
+static ini_status_t load_data(ini_context_t *ctx, char *data, size_t size, section_filter_t const *filter,
+                              ini_file_fingerprint_t const *fingerprint, uint64_t const *content_hash)
+{
+    ini_status_t err = INI_STATUS_SUCCESS;
+    if (size == 0)
+    {
+        free(data);
+        return INI_STATUS_FILE_EMPTY;
+    }
+
+    // A NULL context only validates the file
+    unsigned load_flags = INI_LOAD_DEFAULT;
+    unsigned threads = 1;
+    if (ctx)
+    {
+        if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        {
+            free(data);
+            return INI_STATUS_PLATFORM_ERROR;
+        }
+        load_flags = ctx->load_flags;
+        threads = ctx->load_threads;
+        ini_mutex_unlock(&ctx->mutex);
+    }
+    int lazy = (load_flags & INI_LOAD_LAZY) != 0;
+    int insitu = lazy || (load_flags & INI_LOAD_INSITU) != 0;
+
+    // Hashed before parsing, which terminates strings in place
+    uint64_t hash = 0;
+    if (content_hash)
+        hash = *content_hash;
+    else if (load_flags & INI_LOAD_CONTENT_HASH)
+        hash = hash_bytes(data, size);
+
+    // Copied for the same reason; a validating load (no context) needs no copy
+    char *document = NULL;
+    size_t document_size = 0;
+    if (ctx && (load_flags & INI_LOAD_PRESERVE_FORMAT))
+    {
+        document = (char *)malloc(size);
+        if (!document)
+        {
+            free(data);
+            return INI_STATUS_MEMORY_ERROR;
+        }
+        memcpy(document, data, size);
+        document_size = size;
+    }
+
+    // Parse into fresh tables so a bad file leaves the context untouched
+    ini_ht_t *sections = ini_ht_create();
+    if (!sections)
+    {
+        free(document);
+        free(data);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+
+    ini_section_span_t *spans = NULL;
+    size_t span_count = 0;
+    if (lazy)
+        err = scan_sections(data, size, filter, &spans, &span_count);
+    else if (load_flags & INI_LOAD_PARALLEL)
+        err = parse_buffer_parallel(sections, data, size, insitu, filter,
+                                    threads ? threads : ini_thread_hardware_concurrency());
+    else
+        err = parse_buffer(sections, data, size, insitu, filter);
+
+    if (err != INI_STATUS_SUCCESS || !ctx)
+    {
+        destroy_sections(sections);
+        free(spans);
+        free(data);
+        free(document);
+        return err;
+    }
+
+    if (!insitu)
+    {
+        free(data);
+        data = NULL;
+        size = 0;
+    }
+
+    loaded_contents_t contents;
+    memset(&contents, 0, sizeof(contents));
+    contents.sections = sections;
+    contents.buffer = data;
+    contents.buffer_size = size;
+    contents.spans = spans;
+    contents.span_count = span_count;
+    contents.fingerprint = fingerprint;
+    contents.content_hash = hash;
+    contents.document = document;
+    contents.document_size = document_size;
+    return swap_contents(ctx, &contents);
+}
+
+/**
+ * @brief Swaps a validated, mapped image into `ctx`, which takes ownership of it.
+ *
+ * `fingerprint` (may be NULL) and `content_hash` describe the INI file the
+ * image was compiled from, for `ini_reload_if_changed()`.
+ */
+static ini_status_t install_image(ini_context_t *ctx, void const *image, size_t size,
+                                  ini_file_fingerprint_t const *fingerprint, uint64_t content_hash)
+{
+    // Lookups go to the image; the tables stay empty until something needs them
+    ini_ht_t *sections = ini_ht_create();
+    if (!sections)
+    {
+        ini_unmap_file(image, size);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+
+    loaded_contents_t contents;
+    memset(&contents, 0, sizeof(contents));
+    contents.sections = sections;
+    contents.image = image;
+    contents.image_size = size;
+    contents.fingerprint = fingerprint;
+    contents.content_hash = content_hash;
+    return swap_contents(ctx, &contents);
+}
+
+// Path of the cached image of `filepath` inside `cache_dir` (caller frees)
+static char *cache_image_path(char const *cache_dir, char const *filepath)
+{
+    // Keyed by the canonical path so every spelling of a file shares one image
+    char canonical[INI_PATH_MAX];
+#if INI_OS_WINDOWS
+    char const *key = _fullpath(canonical, filepath, sizeof(canonical)) ? canonical : filepath;
+#else
+    char const *key = realpath(filepath, canonical) ? canonical : filepath;
+#endif
+
+    char path[INI_PATH_MAX];
+    int length = snprintf(path, sizeof(path), "%s/%016llx.inic", cache_dir,
+                          (unsigned long long)hash_key(key));
+    if (length < 0 || (size_t)length >= sizeof(path))
+        return NULL;
+    return ini_strdup(path);
+}
+
+// Non-zero if `image` was compiled from the file version described by `fingerprint`
+static int image_matches_source(void const *image, ini_file_fingerprint_t const *fingerprint)
+{
+    ini_binary_header_t const *header = (ini_binary_header_t const *)image;
+    return header->source_device == fingerprint->device && header->source_inode == fingerprint->inode &&
+           header->source_size == fingerprint->size && header->source_mtime_ns == fingerprint->mtime_ns;
+}
+
+static void stamp_image_source(void *image, ini_file_fingerprint_t const *fingerprint, uint64_t content_hash)
+{
+    ini_binary_header_t *header = (ini_binary_header_t *)image;
+    header->source_device = fingerprint->device;
+    header->source_inode = fingerprint->inode;
+    header->source_size = fingerprint->size;
+    header->source_mtime_ns = fingerprint->mtime_ns;
+    header->source_hash = content_hash;
+}
+
+// Compiles the freshly loaded `ctx` into the cache; failures only cost the next run a parse
+static void write_cache_image(ini_context_t *ctx, char const *image_path,
+                              ini_file_fingerprint_t const *fingerprint, uint64_t content_hash)
+{
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return;
+
+    char *image = NULL;
+    size_t size = 0;
+    ini_status_t err = materialize_all(ctx);
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_binary_build(ctx->sections, &image, &size);
+    ini_mutex_unlock(&ctx->mutex);
+    if (err != INI_STATUS_SUCCESS)
+        return;
+
+    stamp_image_source(image, fingerprint, content_hash);
+    ini_write_file_atomic(image_path, image, size);
+    free(image);
+}
+
+/**
+ * @brief `ini_load()` through the cache directory (see `ini_set_cache_dir()`).
+ *
+ * Serves the cached image when it was compiled from this version of the file,
+ * or from identical bytes; otherwise parses the text and refreshes the image.
+ */
+static ini_status_t load_file_cached(ini_context_t *ctx, char const *filepath, char const *cache_dir)
+{
+    ini_file_fingerprint_t fingerprint;
+    ini_status_t err = ini_get_file_fingerprint(filepath, &fingerprint);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    char *image_path = cache_image_path(cache_dir, filepath);
+    void const *image = NULL;
+    size_t image_size = 0;
+    if (image_path && ini_map_file(image_path, &image, &image_size) == INI_STATUS_SUCCESS &&
+        ini_binary_validate(image, image_size) != INI_STATUS_SUCCESS)
+    {
+        ini_unmap_file(image, image_size);
+        image = NULL;
+    }
+
+    // Same file version: the text is not even read
+    if (image && image_matches_source(image, &fingerprint))
+    {
+        free(image_path);
+        uint64_t source_hash = ((ini_binary_header_t const *)image)->source_hash;
+        return install_image(ctx, image, image_size, &fingerprint, source_hash);
+    }
+
+    char *data = NULL;
+    size_t size = 0;
+    err = ini_read_file(filepath, &data, &size);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        ini_unmap_file(image, image_size);
+        free(image_path);
+        return err;
+    }
+    uint64_t hash = hash_bytes(data, size);
+
+    // Touched but identical (checkout, copy): reuse the image and re-stamp it
+    if (image && ((ini_binary_header_t const *)image)->source_hash == hash &&
+        ((ini_binary_header_t const *)image)->source_size == size)
+    {
+        free(data);
+        char *stamped = malloc(image_size);
+        if (stamped)
+        {
+            memcpy(stamped, image, image_size);
+            stamp_image_source(stamped, &fingerprint, hash);
+            ini_write_file_atomic(image_path, stamped, image_size);
+            free(stamped);
+        }
+        free(image_path);
+        return install_image(ctx, image, image_size, &fingerprint, hash);
+    }
+    ini_unmap_file(image, image_size);
+
+    err = load_data(ctx, data, size, NULL, &fingerprint, &hash);
+    if (err == INI_STATUS_SUCCESS && image_path)
+        write_cache_image(ctx, image_path, &fingerprint, hash);
+    free(image_path);
+    return err;
+}
+
+// Reads, parses and swaps in `filepath`, keeping only the sections `filter` accepts
+static ini_status_t load_file(ini_context_t *ctx, char const *filepath, section_filter_t const *filter)
+{
+    ini_status_t err = ini_check_file_status(filepath);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    // Only whole files are cached, and an image has no text to preserve
+    char *cache_dir = NULL;
+    if (ctx && !filter)
+    {
+        if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+            return INI_STATUS_PLATFORM_ERROR;
+        if (ctx->cache_dir && !(ctx->load_flags & INI_LOAD_PRESERVE_FORMAT))
+            cache_dir = ini_strdup(ctx->cache_dir);
+        ini_mutex_unlock(&ctx->mutex);
+    }
+    if (cache_dir)
+    {
+        err = load_file_cached(ctx, filepath, cache_dir);
+        free(cache_dir);
+        return err;
+    }
+
+    // Taken before reading: a change racing the read then shows up on the next check
+    ini_file_fingerprint_t fingerprint;
+    int has_fingerprint = ini_get_file_fingerprint(filepath, &fingerprint) == INI_STATUS_SUCCESS;
+
+    char *data = NULL;
+    size_t size = 0;
+    err = ini_read_file(filepath, &data, &size);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    return load_data(ctx, data, size, filter, has_fingerprint ? &fingerprint : NULL, NULL);
+}
+
+/// @brief Shared cursor of a `run_parallel()` batch.
+typedef struct
+{
+    void (*job)(void *user, size_t index, unsigned worker); ///< Work item callback.
+    void *user;                                             ///< Passed to `job`.
+    size_t count;                                           ///< Number of items.
+    size_t next;                                            ///< Next unclaimed item.
+    ini_mutex_t mutex;                                      ///< Guards `next`.
+} parallel_batch_t;
+
+/// @brief Start argument of one `run_parallel()` thread.
+typedef struct
+{
+    parallel_batch_t *batch; ///< Shared batch.
+    unsigned worker;         ///< Worker number (0 is the calling thread).
+} parallel_worker_t;
+
+static void parallel_batch_worker(void *arg)
+{
+    parallel_worker_t *self = (parallel_worker_t *)arg;
+    parallel_batch_t *batch = self->batch;
+    for (;;)
+    {
+        ini_mutex_lock(&batch->mutex);
+        size_t index = batch->next++;
+        ini_mutex_unlock(&batch->mutex);
+        if (index >= batch->count)
+            break;
+        batch->job(batch->user, index, self->worker);
+    }
+}
+
+/**
+ * @brief Runs `job` for every index below `count` on up to `threads` threads.
+ *
+ * Workers claim the next index from a shared cursor, so a slow item only
+ * delays the thread that took it. The calling thread works too, as worker 0;
+ * `job` also gets the worker number so it can keep per-thread scratch state
+ * in a `threads`-sized array. If no worker can be started everything runs inline.
+ */
+static ini_status_t run_parallel(size_t count, unsigned threads, void (*job)(void *, size_t, unsigned), void *user)
+{
+    if (threads > count)
+        threads = (unsigned)count;
+    if (threads < 2)
+    {
+        for (size_t i = 0; i < count; i++)
+            job(user, i, 0);
+        return INI_STATUS_SUCCESS;
+    }
+
+    parallel_batch_t batch;
+    batch.job = job;
+    batch.user = user;
+    batch.count = count;
+    batch.next = 0;
+    if (ini_mutex_init(&batch.mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    ini_thread_t *threads_started = (ini_thread_t *)calloc(threads, sizeof(ini_thread_t));
+    parallel_worker_t *workers = (parallel_worker_t *)calloc(threads, sizeof(parallel_worker_t));
+    unsigned started = 1;
+    while (threads_started && workers && started < threads)
+    {
+        workers[started].batch = &batch;
+        workers[started].worker = started;
+        if (ini_thread_create(&threads_started[started], parallel_batch_worker, &workers[started]) != INI_STATUS_SUCCESS)
+            break;
+        started++;
+    }
+
+    parallel_worker_t self;
+    self.batch = &batch;
+    self.worker = 0;
+    parallel_batch_worker(&self);
+
+    ini_status_t status = INI_STATUS_SUCCESS;
+    for (unsigned i = 1; i < started; i++)
+    {
+        if (ini_thread_join(&threads_started[i]) != INI_STATUS_SUCCESS)
+            status = INI_STATUS_PLATFORM_ERROR;
+    }
+    free(threads_started);
+    free(workers);
+    ini_mutex_destroy(&batch.mutex);
+    return status;
+}
+
+/// @brief One file of a multi-file load (see `load_tree()`).
+typedef struct
+{
+    char *path;          ///< File path.
+    unsigned depth;      ///< Include nesting (0 for the files asked for).
+    ini_ht_t *sections;  ///< Private tables parsed from the file.
+    size_t first_child;  ///< Index of the first file it includes.
+    size_t child_count;  ///< Number of files it includes.
+    ini_status_t status; ///< Outcome of reading and parsing the file.
+} load_node_t;
+
+/// @brief Files of a multi-file load; the includes of a file are contiguous.
+typedef struct
+{
+    load_node_t *nodes; ///< Files in breadth-first order.
+    size_t count;       ///< Number of files.
+    size_t capacity;    ///< Allocated entries in `nodes`.
+    size_t wave;        ///< First file of the batch being parsed.
+} load_tree_t;
+
+static void parse_node_job(void *user, size_t index, unsigned worker)
+{
+    (void)worker;
+    load_tree_t *tree = (load_tree_t *)user;
+    load_node_t *node = &tree->nodes[tree->wave + index];
+
+    char *data = NULL;
+    size_t size = 0;
+    node->sections = ini_ht_create();
+    node->status = node->sections ? ini_read_file(node->path, &data, &size) : INI_STATUS_MEMORY_ERROR;
+    // An empty fragment contributes nothing rather than failing the load
+    if (node->status == INI_STATUS_SUCCESS && size > 0)
+        node->status = parse_buffer(node->sections, data, size, 0, NULL);
+    free(data);
+}
+
+// Queues the files matching `pattern` (the caller records whose includes they are)
+static ini_status_t add_tree_files(load_tree_t *tree, char const *pattern, unsigned depth)
+{
+    char **paths = NULL;
+    size_t count = 0;
+    ini_status_t err = ini_list_files(pattern, &paths, &count);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    if (tree->count + count > tree->capacity)
+    {
+        size_t capacity = tree->capacity ? tree->capacity : 16;
+        while (capacity < tree->count + count)
+            capacity *= 2;
+        load_node_t *grown = (load_node_t *)realloc(tree->nodes, capacity * sizeof(load_node_t));
+        if (!grown)
+        {
+            ini_free_file_list(paths, count);
+            return INI_STATUS_MEMORY_ERROR;
+        }
+        tree->nodes = grown;
+        tree->capacity = capacity;
+    }
+
+    // The node takes over each path string
+    for (size_t i = 0; i < count; i++)
+    {
+        load_node_t *node = &tree->nodes[tree->count++];
+        memset(node, 0, sizeof(*node));
+        node->path = paths[i];
+        node->depth = depth;
+    }
+    free(paths);
+    return INI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Queues the files named by the `[include]` section of `tree->nodes[index]`.
+ *
+ * Keys are taken in lexical order; each value is a path or wildcard pattern
+ * relative to the including file's directory. The section itself is dropped.
+ */
+static ini_status_t expand_includes(load_tree_t *tree, size_t index)
+{
+    ini_ht_t *include_ht = ini_get_section_ht(tree->nodes[index].sections, INI_INCLUDE_SECTION);
+    tree->nodes[index].first_child = tree->count;
+    if (!include_ht)
+        return INI_STATUS_SUCCESS;
+    if (tree->nodes[index].depth >= INI_INCLUDE_MAX_DEPTH)
+        return INI_STATUS_FILE_BAD_FORMAT;
+
+    size_t key_count = ini_ht_length(include_ht);
+    char **keys = (char **)malloc((key_count ? key_count : 1) * sizeof(char *));
+    if (!keys)
+        return INI_STATUS_MEMORY_ERROR;
+    ini_ht_iterator_t it = ini_ht_iterator(include_ht);
+    char *key;
+    char *value;
+    size_t n = 0;
+    while (n < key_count && ini_ht_next(&it, &key, &value) == INI_STATUS_SUCCESS)
+        keys[n++] = key;
+    qsort(keys, n, sizeof(char *), ini_compare_strings);
+
+    // Relative includes resolve against the directory of the including file
+    char const *path = tree->nodes[index].path;
+    size_t dir_len = 0;
+    for (size_t i = 0; path[i]; i++)
+    {
+        if (path[i] == '/' || path[i] == '\\')
+            dir_len = i + 1;
+    }
+
+    ini_status_t err = INI_STATUS_SUCCESS;
+    unsigned depth = tree->nodes[index].depth + 1;
+    for (size_t i = 0; i < n && err == INI_STATUS_SUCCESS; i++)
+    {
+        char const *target = ini_ht_get(include_ht, keys[i]);
+        int absolute = target[0] == '/' || target[0] == '\\' || (target[0] && target[1] == ':');
+        char resolved[INI_PATH_MAX];
+        int length = absolute ? snprintf(resolved, sizeof(resolved), "%s", target)
+                              : snprintf(resolved, sizeof(resolved), "%.*s%s", (int)dir_len, path, target);
+        if (length < 0 || (size_t)length >= sizeof(resolved))
+            err = INI_STATUS_INVALID_ARGUMENT;
+        else
+            err = add_tree_files(tree, resolved, depth);
+    }
+    free(keys);
+
+    // `tree->nodes` may have moved
+    tree->nodes[index].child_count = tree->count - tree->nodes[index].first_child;
+    ini_ht_destroy(include_ht);
+    ini_ht_remove(tree->nodes[index].sections, INI_INCLUDE_SECTION);
+    return err;
+}
+
+// Merges a file and then, recursively, the files it includes into `into`
+static ini_status_t merge_tree_node(ini_ht_t *into, load_tree_t *tree, size_t index)
+{
+    load_node_t *node = &tree->nodes[index];
+    ini_status_t err = merge_sections(into, node->sections, INI_HT_BORROW_NONE, NULL);
+    node->sections = NULL;
+
+    for (size_t i = 0; i < node->child_count && err == INI_STATUS_SUCCESS; i++)
+        err = merge_tree_node(into, tree, node->first_child + i);
+    return err;
+}
+
+static void free_tree(load_tree_t *tree)
+{
+    for (size_t i = 0; i < tree->count; i++)
+    {
+        free(tree->nodes[i].path);
+        destroy_sections(tree->nodes[i].sections);
+    }
+    free(tree->nodes);
+}
+
+/**
+ * @brief Loads the files already queued in `tree` (and their includes) into `ctx`.
+ *
+ * Every batch of files is parsed concurrently into private tables; with
+ * `includes` set, the files named by their `[include]` sections form the next
+ * batch. The tables are then merged in order, each file followed by its
+ * includes, so later files override earlier ones key by key. Nothing in `ctx`
+ * changes unless every file loads. Consumes `tree`.
+ */
+static ini_status_t load_tree(ini_context_t *ctx, load_tree_t *tree, int includes, unsigned threads)
+{
+    size_t root_count = tree->count;
+    ini_status_t err = INI_STATUS_SUCCESS;
+
+    for (tree->wave = 0; tree->wave < tree->count && err == INI_STATUS_SUCCESS;)
+    {
+        size_t wave_end = tree->count;
+        err = run_parallel(wave_end - tree->wave, threads, parse_node_job, tree);
+
+        for (size_t i = tree->wave; i < wave_end && err == INI_STATUS_SUCCESS; i++)
+        {
+            err = tree->nodes[i].status;
+            if (err == INI_STATUS_SUCCESS && includes)
+                err = expand_includes(tree, i);
+        }
+        tree->wave = wave_end;
+    }
+
+    ini_ht_t *sections = err == INI_STATUS_SUCCESS ? ini_ht_create() : NULL;
+    if (err == INI_STATUS_SUCCESS && !sections)
+        err = INI_STATUS_MEMORY_ERROR;
+    for (size_t i = 0; i < root_count && err == INI_STATUS_SUCCESS; i++)
+        err = merge_tree_node(sections, tree, i);
+    free_tree(tree);
+
+    if (err != INI_STATUS_SUCCESS)
+    {
+        destroy_sections(sections);
+        return err;
+    }
+
+    // Several files make up the contents, so there is no single fingerprint
+    loaded_contents_t contents;
+    memset(&contents, 0, sizeof(contents));
+    contents.sections = sections;
+    return swap_contents(ctx, &contents);
+}
+
+// Reads the load settings of `ctx` that matter for a multi-file load
+static ini_status_t get_tree_settings(ini_context_t *ctx, int *includes, unsigned *threads)
+{
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+    *includes = (ctx->load_flags & INI_LOAD_INCLUDES) != 0;
+    *threads = ctx->load_threads ? ctx->load_threads : ini_thread_hardware_concurrency();
+    ini_mutex_unlock(&ctx->mutex);
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_load(ini_context_t *ctx, char const *filepath)
+{
+    if (!filepath || strlen(filepath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    int includes = 0;
+    unsigned threads = 1;
+    if (ctx)
+    {
+        ini_status_t err = get_tree_settings(ctx, &includes, &threads);
+        if (err != INI_STATUS_SUCCESS)
+            return err;
+    }
+    if (!includes)
+    {
+        ini_status_t err = load_file(ctx, filepath, NULL);
+        return err == INI_STATUS_SUCCESS && ctx ? replay_journal(ctx, filepath) : err;
+    }
+
+    ini_status_t err = ini_check_file_status(filepath);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    // A literal path names exactly one file (wildcards are only meant for includes)
+    load_tree_t tree;
+    memset(&tree, 0, sizeof(tree));
+    tree.nodes = (load_node_t *)calloc(1, sizeof(load_node_t));
+    if (tree.nodes)
+        tree.nodes[0].path = ini_strdup(filepath);
+    if (!tree.nodes || !tree.nodes[0].path)
+    {
+        free(tree.nodes);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+    tree.count = 1;
+    tree.capacity = 1;
+    err = load_tree(ctx, &tree, 1, threads);
+    return err == INI_STATUS_SUCCESS ? replay_journal(ctx, filepath) : err;
+}
+
+INI_PUBLIC_API ini_status_t ini_load_dir(ini_context_t *ctx, char const *dirpath, char const *pattern)
+{
+    if (!ctx || !dirpath || strlen(dirpath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (!pattern)
+        pattern = "*.ini";
+    if (strlen(pattern) == 0 || strpbrk(pattern, "/\\"))
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (ini_is_file_directory(dirpath) != INI_STATUS_FILE_IS_DIR)
+        return INI_STATUS_FILE_NOT_FOUND;
+
+    int includes = 0;
+    unsigned threads = 1;
+    ini_status_t err = get_tree_settings(ctx, &includes, &threads);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    char full_pattern[INI_PATH_MAX];
+    size_t dir_len = strlen(dirpath);
+    int separated = dirpath[dir_len - 1] == '/' || dirpath[dir_len - 1] == '\\';
+    int length = snprintf(full_pattern, sizeof(full_pattern), "%s%s%s", dirpath, separated ? "" : "/", pattern);
+    if (length < 0 || (size_t)length >= sizeof(full_pattern))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    load_tree_t tree;
+    memset(&tree, 0, sizeof(tree));
+    err = add_tree_files(&tree, full_pattern, 0);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        free_tree(&tree);
+        return err;
+    }
+    return load_tree(ctx, &tree, includes, threads);
+}
+
+/// @brief State shared by the workers of `ini_load_many()`.
+typedef struct
+{
+    char const *const *paths;     ///< Files to load.
+    size_t count;                 ///< Number of entries in `paths`.
+    size_t chunk;                 ///< Files handed to a worker at a time.
+    ini_context_t **out;          ///< Receives one context per file (NULL only validates).
+    ini_status_t *statuses;       ///< Receives one status per file.
+    ini_batch_reader_t **readers; ///< One reader per worker, created on first use.
+} load_many_t;
+
+/// @brief One chunk of `ini_load_many()` being read by a worker.
+typedef struct
+{
+    load_many_t *batch; ///< Whole batch.
+    size_t first;       ///< Index of the chunk's first file.
+} load_many_chunk_t;
+
+// Parses one file delivered by a batch reader into its own context
+static void load_many_file(void *user, size_t index, ini_status_t status, char *data, size_t size,
+                           ini_file_fingerprint_t const *fingerprint)
+{
+    load_many_chunk_t *chunk = (load_many_chunk_t *)user;
+    load_many_t *batch = chunk->batch;
+    index += chunk->first;
+
+    ini_status_t err = status;
+    if (err == INI_STATUS_SUCCESS && size == 0)
+        err = INI_STATUS_FILE_EMPTY;
+
+    // The reader reuses its buffers, so the tables get their own copies
+    ini_ht_t *sections = NULL;
+    if (err == INI_STATUS_SUCCESS)
+    {
+        sections = ini_ht_create();
+        err = sections ? parse_buffer(sections, data, size, 0, NULL) : INI_STATUS_MEMORY_ERROR;
+    }
+
+    ini_context_t *ctx = NULL;
+    if (err == INI_STATUS_SUCCESS && batch->out)
+    {
+        ctx = ini_create_context();
+        if (!ctx)
+            err = INI_STATUS_MEMORY_ERROR;
+    }
+    if (err == INI_STATUS_SUCCESS && ctx)
+    {
+        loaded_contents_t contents;
+        memset(&contents, 0, sizeof(contents));
+        contents.sections = sections;
+        contents.fingerprint = fingerprint;
+        sections = NULL;
+        err = swap_contents(ctx, &contents);
+    }
+    destroy_sections(sections);
+
+    if (err != INI_STATUS_SUCCESS && ctx)
+    {
+        ini_free(ctx);
+        ctx = NULL;
+    }
+    if (batch->out)
+        batch->out[index] = ctx;
+    batch->statuses[index] = err;
+}
+
+static void load_many_job(void *user, size_t index, unsigned worker)
+{
+    load_many_t *batch = (load_many_t *)user;
+    load_many_chunk_t chunk;
+    chunk.batch = batch;
+    chunk.first = index * batch->chunk;
+    size_t count = batch->count - chunk.first < batch->chunk ? batch->count - chunk.first : batch->chunk;
+
+    if (!batch->readers[worker])
+        batch->readers[worker] = ini_batch_reader_create(INI_BATCH_READ_DEFAULT);
+    if (!batch->readers[worker])
+    {
+        for (size_t i = 0; i < count; i++)
+            batch->statuses[chunk.first + i] = INI_STATUS_MEMORY_ERROR;
+        return;
+    }
+    ini_batch_reader_read(batch->readers[worker], batch->paths + chunk.first, count, load_many_file, &chunk);
+}
+
+INI_PUBLIC_API ini_status_t ini_load_many(char const *const *paths, size_t count, ini_context_t **out,
+                                          ini_status_t *statuses, unsigned threads)
+{
+    if (count == 0)
+        return INI_STATUS_SUCCESS;
+    if (!paths)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (threads == 0)
+        threads = ini_thread_hardware_concurrency();
+    if (threads == 0)
+        threads = 1;
+    if (threads > count)
+        threads = (unsigned)count;
+
+    // Full reader rounds where the batch is large enough, yet a few chunks per worker
+    load_many_t batch;
+    batch.paths = paths;
+    batch.count = count;
+    batch.chunk = count / ((size_t)threads * 4);
+    if (batch.chunk > INI_BATCH_READ_SIZE)
+        batch.chunk = INI_BATCH_READ_SIZE;
+    if (batch.chunk == 0)
+        batch.chunk = 1;
+    batch.out = out;
+    batch.statuses = statuses ? statuses : (ini_status_t *)malloc(count * sizeof(ini_status_t));
+    batch.readers = (ini_batch_reader_t **)calloc(threads, sizeof(ini_batch_reader_t *));
+    ini_status_t err = INI_STATUS_SUCCESS;
+    if (!batch.statuses || !batch.readers)
+        err = INI_STATUS_MEMORY_ERROR;
+    else
+    {
+        // Defined results even for files a failed pool never got to
+        for (size_t i = 0; i < count; i++)
+        {
+            batch.statuses[i] = INI_STATUS_PLATFORM_ERROR;
+            if (out)
+                out[i] = NULL;
+        }
+        err = run_parallel((count + batch.chunk - 1) / batch.chunk, threads, load_many_job, &batch);
+    }
+
+    // Report the first failing file, in input order
+    for (size_t i = 0; i < count && err == INI_STATUS_SUCCESS; i++)
+        err = batch.statuses[i];
+
+    if (batch.readers)
+    {
+        for (unsigned i = 0; i < threads; i++)
+            ini_batch_reader_destroy(batch.readers[i]);
+    }
+    free(batch.readers);
+    if (!statuses)
+        free(batch.statuses);
+    return err;
+}
+
+/**
+ * @brief Reads `filepath` if it changed since `ctx` was last loaded.
+ *
+ * Leaves `*data` NULL when the fingerprint (or, with `INI_LOAD_CONTENT_HASH`,
+ * the content hash) shows nothing changed; a touched but identical file only
+ * gets its recorded fingerprint refreshed. `*hash` is valid if `*has_hash` is set.
+ */
+static ini_status_t read_if_changed(ini_context_t *ctx, char const *filepath, ini_file_fingerprint_t *current,
+                                    char **data, size_t *size, uint64_t *hash, int *has_hash)
+{
+    *data = NULL;
+    *size = 0;
+    *hash = 0;
+    *has_hash = 0;
+
+    ini_status_t err = ini_check_file_status(filepath);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    err = ini_get_file_fingerprint(filepath, current);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+    int has_fingerprint = ctx->has_fingerprint;
+    ini_file_fingerprint_t loaded = ctx->fingerprint;
+    uint64_t loaded_hash = ctx->content_hash;
+    int check_content = (ctx->load_flags & INI_LOAD_CONTENT_HASH) != 0;
+    ini_mutex_unlock(&ctx->mutex);
+
+    // Same file, same size, same mtime: nothing to do, not even a read
+    if (has_fingerprint && ini_file_fingerprint_equal(&loaded, current))
+        return INI_STATUS_SUCCESS;
+
+    err = ini_read_file(filepath, data, size);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    if (!check_content)
+        return INI_STATUS_SUCCESS;
+
+    // The metadata changed but the bytes did not (touch, identical rewrite)
+    *hash = hash_bytes(*data, *size);
+    *has_hash = 1;
+    if (has_fingerprint && *hash == loaded_hash)
+    {
+        free(*data);
+        *data = NULL;
+        *size = 0;
+        if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+            return INI_STATUS_PLATFORM_ERROR;
+        ctx->fingerprint = *current;
+        ini_mutex_unlock(&ctx->mutex);
+    }
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_reload_if_changed(ini_context_t *ctx, char const *filepath, int *reloaded)
+{
+    if (reloaded)
+        *reloaded = 0;
+    if (!ctx || !filepath || strlen(filepath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_file_fingerprint_t current;
+    char *data = NULL;
+    size_t size = 0;
+    uint64_t hash = 0;
+    int has_hash = 0;
+    ini_status_t err = read_if_changed(ctx, filepath, &current, &data, &size, &hash, &has_hash);
+    if (err != INI_STATUS_SUCCESS || !data)
+        return err;
+
+    // The included files are not fingerprinted, so such a load always starts over
+    int includes = 0;
+    unsigned threads = 1;
+    err = get_tree_settings(ctx, &includes, &threads);
+    if (err != INI_STATUS_SUCCESS || includes)
+    {
+        free(data);
+        if (err == INI_STATUS_SUCCESS)
+            err = ini_load(ctx, filepath);
+    }
+    else
+    {
+        err = load_data(ctx, data, size, NULL, &current, has_hash ? &hash : NULL);
+        if (err == INI_STATUS_SUCCESS)
+            err = replay_journal(ctx, filepath);
+    }
+    if (err == INI_STATUS_SUCCESS && reloaded)
+        *reloaded = 1;
+    return err;
+}
+
+// Appends a change; `changes` may be NULL when the caller does not want them
+static ini_status_t record_change(ini_change_set_t *changes, ini_change_kind_t kind,
+                                  char const *section, char const *key)
+{
+    if (!changes)
+        return INI_STATUS_SUCCESS;
+
+    if (changes->count == changes->capacity)
+    {
+        size_t capacity = changes->capacity ? changes->capacity * 2 : 16;
+        ini_change_t *items = realloc(changes->items, capacity * sizeof(ini_change_t));
+        if (!items)
+            return INI_STATUS_MEMORY_ERROR;
+        changes->items = items;
+        changes->capacity = capacity;
+    }
+
+    ini_change_t *change = &changes->items[changes->count];
+    change->kind = kind;
+    change->section = ini_strdup(section);
+    change->key = key ? ini_strdup(key) : NULL;
+    if (!change->section || (key && !change->key))
+    {
+        free(change->section);
+        free(change->key);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+    changes->count++;
+    return INI_STATUS_SUCCESS;
+}
+
+// Order-independent digest of a section's pairs: equal sections give equal digests
+static uint64_t section_digest(ini_ht_t *section_ht)
+{
+    uint64_t digest = ini_ht_length(section_ht);
+    ini_ht_iterator_t it = ini_ht_iterator(section_ht);
+    char *key;
+    char *value;
+
+    while (ini_ht_next(&it, &key, &value) == INI_STATUS_SUCCESS)
+    {
+        uint64_t pair = hash_key(key) * 31 + hash_key(value);
+        pair ^= pair >> 29;
+        pair *= 0xbf58476d1ce4e5b9ULL;
+        pair ^= pair >> 32;
+        digest += pair; // Commutative, so the slot order does not matter
+    }
+    return digest;
+}
+
+// Lists the keys of `table` missing from `other` (borrowed from `table`; caller frees the array)
+static ini_status_t collect_missing_keys(ini_ht_t *table, ini_ht_t *other, char ***keys, size_t *count)
+{
+    *keys = NULL;
+    *count = 0;
+
+    size_t length = ini_ht_length(table);
+    if (length == 0)
+        return INI_STATUS_SUCCESS;
+
+    *keys = malloc(length * sizeof(char *));
+    if (!*keys)
+        return INI_STATUS_MEMORY_ERROR;
+
+    ini_ht_iterator_t it = ini_ht_iterator(table);
+    char *key;
+    char *value;
+    while (ini_ht_next(&it, &key, &value) == INI_STATUS_SUCCESS)
+    {
+        if (!ini_ht_get(other, key))
+            (*keys)[(*count)++] = key;
+    }
+    return INI_STATUS_SUCCESS;
+}
+
+// Records every key of a section that was added or removed as a whole
+static ini_status_t record_section_keys(ini_change_set_t *changes, ini_change_kind_t kind,
+                                        char const *section, ini_ht_t *section_ht)
+{
+    ini_status_t err = record_change(changes, kind, section, NULL);
+    ini_ht_iterator_t it = ini_ht_iterator(section_ht);
+    char *key;
+    char *value;
+
+    while (err == INI_STATUS_SUCCESS && ini_ht_next(&it, &key, &value) == INI_STATUS_SUCCESS)
+        err = record_change(changes, kind, section, key);
+    return err;
+}
+
+// Makes `section_ht` hold exactly the pairs of `fresh_ht`, touching only the differences
+static ini_status_t patch_section(char const *section, ini_ht_t *section_ht, ini_ht_t *fresh_ht,
+                                  ini_change_set_t *changes)
+{
+    ini_ht_iterator_t it = ini_ht_iterator(fresh_ht);
+    char *key;
+    char *value;
+
+    while (ini_ht_next(&it, &key, &value) == INI_STATUS_SUCCESS)
+    {
+        char const *current = ini_ht_get(section_ht, key);
+        if (current && strcmp(current, value) == 0)
+            continue;
+
+        if (!ini_ht_set(section_ht, key, value))
+            return INI_STATUS_MEMORY_ERROR;
+
+        ini_status_t err = record_change(changes, current ? INI_CHANGE_MODIFIED : INI_CHANGE_ADDED, section, key);
+        if (err != INI_STATUS_SUCCESS)
+            return err;
+    }
+
+    char **removed = NULL;
+    size_t removed_count = 0;
+    ini_status_t err = collect_missing_keys(section_ht, fresh_ht, &removed, &removed_count);
+    for (size_t i = 0; err == INI_STATUS_SUCCESS && i < removed_count; i++)
+    {
+        // Recorded first: removing the entry frees the key
+        err = record_change(changes, INI_CHANGE_REMOVED, section, removed[i]);
+        if (err == INI_STATUS_SUCCESS)
+            err = ini_ht_remove(section_ht, removed[i]);
+    }
+    free(removed);
+    return err;
+}
+
+// Makes `sections` match `fresh`, leaving sections with equal digests alone; the caller holds the lock
+static ini_status_t apply_sections(ini_ht_t *sections, ini_ht_t *fresh, ini_change_set_t *changes)
+{
+    char **removed = NULL;
+    size_t removed_count = 0;
+    ini_status_t err = collect_missing_keys(sections, fresh, &removed, &removed_count);
+    for (size_t i = 0; err == INI_STATUS_SUCCESS && i < removed_count; i++)
+    {
+        ini_ht_t *section_ht = ini_get_section_ht(sections, removed[i]);
+        err = record_section_keys(changes, INI_CHANGE_REMOVED, removed[i], section_ht);
+        if (err != INI_STATUS_SUCCESS)
+            break;
+        ini_ht_destroy(section_ht);
+        err = ini_ht_remove(sections, removed[i]);
+    }
+    free(removed);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    ini_ht_iterator_t it = ini_ht_iterator(fresh);
+    char *section;
+    char *fresh_ptr_str;
+
+    while (ini_ht_next(&it, &section, &fresh_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_t *fresh_ht = str_to_ptr(fresh_ptr_str);
+        ini_ht_t *section_ht = ini_get_section_ht(sections, section);
+
+        if (!section_ht)
+        {
+            section_ht = ini_ht_create();
+            if (!section_ht)
+                return INI_STATUS_MEMORY_ERROR;
+            err = store_section_ht(sections, section, section_ht, INI_HT_BORROW_NONE);
+            if (err != INI_STATUS_SUCCESS)
+            {
+                ini_ht_destroy(section_ht);
+                return err;
+            }
+            err = record_change(changes, INI_CHANGE_ADDED, section, NULL);
+        }
+        else if (section_digest(section_ht) == section_digest(fresh_ht))
+        {
+            continue;
+        }
+
+        if (err == INI_STATUS_SUCCESS)
+            err = patch_section(section, section_ht, fresh_ht, changes);
+        if (err != INI_STATUS_SUCCESS)
+            return err;
+    }
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_reload_incremental(ini_context_t *ctx, char const *filepath,
+                                                   ini_change_set_t *changes)
+{
+    ini_free_changes(changes);
+    if (!ctx || !filepath || strlen(filepath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_file_fingerprint_t current;
+    char *data = NULL;
+    size_t size = 0;
+    uint64_t hash = 0;
+    int has_hash = 0;
+    ini_status_t err = read_if_changed(ctx, filepath, &current, &data, &size, &hash, &has_hash);
+    if (err != INI_STATUS_SUCCESS || !data)
+        return err;
+
+    if (size == 0)
+    {
+        free(data);
+        return INI_STATUS_FILE_EMPTY;
+    }
+
+    // A format-preserving context keeps the new text, copied before parsing terminates it
+    char *document = NULL;
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+    {
+        free(data);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+    int preserve = (ctx->load_flags & INI_LOAD_PRESERVE_FORMAT) != 0;
+    ini_mutex_unlock(&ctx->mutex);
+    if (preserve)
+    {
+        document = (char *)malloc(size);
+        if (!document)
+        {
+            free(data);
+            return INI_STATUS_MEMORY_ERROR;
+        }
+        memcpy(document, data, size);
+    }
+
+    // Parsed into scratch tables first so a bad file leaves the context untouched
+    ini_ht_t *fresh = ini_ht_create();
+    if (!fresh)
+    {
+        free(document);
+        free(data);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+
+    err = parse_buffer(fresh, data, size, 1, NULL);
+    if (err == INI_STATUS_SUCCESS)
+    {
+        if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        {
+            err = INI_STATUS_PLATFORM_ERROR;
+        }
+        else
+        {
+            // Journaled changes are not in the file yet; applied to `fresh`, they are no change
+            ini_ht_t *replayed = NULL;
+            err = materialize_all(ctx);
+            if (err == INI_STATUS_SUCCESS && (ctx->load_flags & INI_LOAD_JOURNAL))
+                err = replay_journal_into(fresh, filepath, &replayed);
+            if (err == INI_STATUS_SUCCESS)
+                err = apply_sections(ctx->sections, fresh, changes);
+            if (err == INI_STATUS_SUCCESS)
+            {
+                ctx->fingerprint = current;
+                ctx->has_fingerprint = 1;
+                ctx->content_hash = hash;
+                destroy_sections(ctx->dirty);
+                ctx->dirty = NULL;
+                // Swapped so the old text is freed below
+                char *old_document = ctx->document;
+                ctx->document = document;
+                ctx->document_size = document ? size : 0;
+                ctx->document_version++;
+                document = old_document;
+                destroy_sections(ctx->document_edits);
+                // The new text lacks the replayed values, so they count as edits of it
+                ctx->document_edits = ctx->document ? replayed : NULL;
+                if (ctx->document)
+                    replayed = NULL;
+            }
+            destroy_sections(replayed);
+            ini_mutex_unlock(&ctx->mutex);
+        }
+    }
+
+    // Everything kept was copied out of `fresh`, which borrows from `data`
+    destroy_sections(fresh);
+    free(data);
+    free(document);
+    return err;
+}
+
+INI_PUBLIC_API void ini_free_changes(ini_change_set_t *changes)
+{
+    if (!changes)
+        return;
+
+    for (size_t i = 0; i < changes->count; i++)
+    {
+        free(changes->items[i].section);
+        free(changes->items[i].key);
+    }
+    free(changes->items);
+    changes->items = NULL;
+    changes->count = 0;
+    changes->capacity = 0;
+}
+
+INI_PUBLIC_API ini_status_t ini_load_sections(ini_context_t *ctx, char const *filepath,
+                                              char const *const *sections, size_t count)
+{
+    if (!filepath || strlen(filepath) == 0 || (!sections && count > 0))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    section_filter_t filter = {sections, count, 0};
+    return load_file(ctx, filepath, &filter);
+}
+
+INI_PUBLIC_API ini_status_t ini_load_sections_prefix(ini_context_t *ctx, char const *filepath,
+                                                     char const *const *prefixes, size_t count)
+{
+    if (!filepath || strlen(filepath) == 0 || (!prefixes && count > 0))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    section_filter_t filter = {prefixes, count, 1};
+    return load_file(ctx, filepath, &filter);
+}
+
+INI_PUBLIC_API ini_status_t ini_save_binary(ini_context_t const *ctx, char const *filepath)
+{
+    if (!ctx || !filepath || strlen(filepath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_file_permission_t perms = ini_get_file_permission(filepath);
+    if (perms.write == 0)
+        return INI_STATUS_FILE_PERMISSION_DENIED;
+
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    char *image = NULL;
+    size_t size = 0;
+    ini_durability_t durability = ctx->durability;
+    ini_status_t err = materialize_all((ini_context_t *)ctx);
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_binary_build(ctx->sections, &image, &size);
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    // Readers map images, so the old one is replaced by a rename instead of being rewritten in place
+    err = ini_write_file_atomic_ex(filepath, image, size, durability);
+    free(image);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_load_binary(ini_context_t *ctx, char const *filepath)
+{
+    if (!ctx || !filepath || strlen(filepath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_status_t err = ini_check_file_status(filepath);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    void const *image = NULL;
+    size_t size = 0;
+    err = ini_map_file(filepath, &image, &size);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    err = ini_binary_validate(image, size);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        ini_unmap_file(image, size);
+        return err == INI_STATUS_INVALID_ARGUMENT ? INI_STATUS_FILE_BAD_FORMAT : err;
+    }
+
+    return install_image(ctx, image, size, NULL, 0);
+}
+
+/**
+ * @brief Gets a value from a section in the INI context.
+ *
+ * @param ctx Context to query
+ * @param section Section name (empty string for global keys)
+ * @param key Key name to retrieve
+ * @param[out] value Output value (caller must free)
+ * @return ini_status_t Error code
+ */
+INI_PUBLIC_API ini_status_t ini_get_value(ini_context_t const *ctx,
+                                          char const *section,
+                                          char const *key,
+                                          char **value)
+{
+    if (!ctx || !section || !key || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    // Lock context for thread safety
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    // A binary image answers straight from the mapping until tables are needed
+    if (ctx->image && !ctx->image_materialized)
+    {
+        char const *found_value = NULL;
+        ini_status_t err = ini_binary_lookup(ctx->image, section, key, &found_value);
+        if (err == INI_STATUS_SUCCESS)
+        {
+            *value = ini_strdup(found_value);
+            if (!*value)
+                err = INI_STATUS_MEMORY_ERROR;
+        }
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return err;
+    }
+
+    // Parse the section first if a lazy load has not touched it yet
+    ini_status_t err = materialize_section((ini_context_t *)ctx, section, strlen(section));
+    if (err != INI_STATUS_SUCCESS)
+    {
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return err;
+    }
+
+    // Get the section hash table
+    ini_ht_t *section_ht = ini_get_section_ht(ctx->sections, section);
+    if (!section_ht)
+    {
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return INI_STATUS_SECTION_NOT_FOUND;
+    }
+
+    // Get the value from the section
+    char const *found_value = ini_ht_get(section_ht, key);
+    if (!found_value)
+    {
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return INI_STATUS_KEY_NOT_FOUND;
+    }
+
+    // Make a copy for the caller
+    *value = ini_strdup(found_value);
+    if (!*value)
+    {
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    return INI_STATUS_SUCCESS;
+}
+
+/// @brief Where a typed accessor found its value.
+typedef struct
+{
+    ini_ht_key_value_t *entry; ///< Table entry carrying the cache, or NULL ...
+    char const *text;          ///< ... for a value read straight from a mapped image.
+} typed_lookup_t;
+
+// Finds `key` for a typed accessor; the caller holds the context lock
+static ini_status_t lookup_typed(ini_context_t *ctx, char const *section, char const *key, typed_lookup_t *found)
+{
+    found->entry = NULL;
+    found->text = NULL;
+    if (ctx->image && !ctx->image_materialized)
+        return ini_binary_lookup(ctx->image, section, key, &found->text);
+
+    ini_status_t err = materialize_section(ctx, section, strlen(section));
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    ini_ht_t *section_ht = ini_get_section_ht(ctx->sections, section);
+    if (!section_ht)
+        return INI_STATUS_SECTION_NOT_FOUND;
+
+    found->entry = ini_ht_find(section_ht, key);
+    if (!found->entry)
+        return INI_STATUS_KEY_NOT_FOUND;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_get_int64(ini_context_t const *ctx, char const *section, char const *key,
+                                          int64_t *value)
+{
+    if (!ctx || !section || !key || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    typed_lookup_t found;
+    ini_status_t err = lookup_typed((ini_context_t *)ctx, section, key, &found);
+    if (err == INI_STATUS_SUCCESS && !found.entry)
+        err = ini_parse_int64(found.text, value);
+    else if (err == INI_STATUS_SUCCESS)
+    {
+        ini_ht_key_value_t *entry = found.entry;
+        if (!(entry->typed & INI_HT_TYPED_INT_CHECKED))
+        {
+            entry->typed |= INI_HT_TYPED_INT_CHECKED;
+            if (ini_parse_int64(entry->value, &entry->int_value) == INI_STATUS_SUCCESS)
+                entry->typed |= INI_HT_TYPED_INT;
+        }
+        if (entry->typed & INI_HT_TYPED_INT)
+            *value = entry->int_value;
+        else
+            err = INI_STATUS_TYPE_MISMATCH;
+    }
+
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_get_double(ini_context_t const *ctx, char const *section, char const *key,
+                                           double *value)
+{
+    if (!ctx || !section || !key || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    typed_lookup_t found;
+    ini_status_t err = lookup_typed((ini_context_t *)ctx, section, key, &found);
+    if (err == INI_STATUS_SUCCESS && !found.entry)
+        err = ini_parse_double(found.text, value);
+    else if (err == INI_STATUS_SUCCESS)
+    {
+        ini_ht_key_value_t *entry = found.entry;
+        if (!(entry->typed & INI_HT_TYPED_DOUBLE_CHECKED))
+        {
+            entry->typed |= INI_HT_TYPED_DOUBLE_CHECKED;
+            if (ini_parse_double(entry->value, &entry->double_value) == INI_STATUS_SUCCESS)
+                entry->typed |= INI_HT_TYPED_DOUBLE;
+        }
+        if (entry->typed & INI_HT_TYPED_DOUBLE)
+            *value = entry->double_value;
+        else
+            err = INI_STATUS_TYPE_MISMATCH;
+    }
+
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_get_bool(ini_context_t const *ctx, char const *section, char const *key, int *value)
+{
+    if (!ctx || !section || !key || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    typed_lookup_t found;
+    ini_status_t err = lookup_typed((ini_context_t *)ctx, section, key, &found);
+    if (err == INI_STATUS_SUCCESS && !found.entry)
+        err = ini_parse_bool(found.text, value);
+    else if (err == INI_STATUS_SUCCESS)
+    {
+        ini_ht_key_value_t *entry = found.entry;
+        if (!(entry->typed & INI_HT_TYPED_BOOL_CHECKED))
+        {
+            int truth = 0;
+            entry->typed |= INI_HT_TYPED_BOOL_CHECKED;
+            if (ini_parse_bool(entry->value, &truth) == INI_STATUS_SUCCESS)
+                entry->typed |= INI_HT_TYPED_BOOL | (truth ? INI_HT_TYPED_BOOL_TRUE : 0);
+        }
+        if (entry->typed & INI_HT_TYPED_BOOL)
+            *value = (entry->typed & INI_HT_TYPED_BOOL_TRUE) ? 1 : 0;
+        else
+            err = INI_STATUS_TYPE_MISMATCH;
+    }
+
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    return err;
+}
+
+// Returns the end of the item starting at `item`: the next comma not escaped by `\`, or the terminator
+static char const *item_end(char const *item, int *escaped)
+{
+    for (; *item && *item != ','; item++)
+    {
+        if (*item == '\\' && (item[1] == ',' || item[1] == '\\'))
+        {
+            *escaped = 1;
+            item++;
+        }
+    }
+    return item;
+}
+
+/**
+ * @brief Splits `value` into trimmed items at every comma not escaped as `\,`.
+ *
+ * Items point into `value` unless an item holds `\,` or `\\`; then all items
+ * are unescaped into text allocated behind the spans, which `free(*items)`
+ * releases together with them.
+ */
+static ini_status_t split_items(char const *value, ini_span_t **items, size_t *count)
+{
+    *items = NULL;
+    *count = 0;
+    if (*value == '\0')
+        return INI_STATUS_SUCCESS;
+
+    size_t n = 1;
+    int escaped = 0;
+    for (char const *end = item_end(value, &escaped); *end; end = item_end(end + 1, &escaped))
+        n++;
+
+    size_t text_size = escaped ? strlen(value) + 1 : 0;
+    ini_span_t *spans = (ini_span_t *)malloc(n * sizeof(ini_span_t) + text_size);
+    if (!spans)
+        return INI_STATUS_MEMORY_ERROR;
+    char *text = (char *)(spans + n);
+
+    char const *item = value;
+    for (size_t i = 0; i < n; i++)
+    {
+        char const *end = item_end(item, &escaped);
+        char const *next = *end ? end + 1 : end;
+
+        while (item < end && (*item == ' ' || *item == '\t'))
+            item++;
+        while (end > item && (end[-1] == ' ' || end[-1] == '\t'))
+            end--;
+
+        if (!text_size)
+        {
+            spans[i].ptr = item;
+            spans[i].len = (size_t)(end - item);
+        }
+        else
+        {
+            spans[i].ptr = text;
+            for (; item < end; item++)
             {
-                value++;
+                if (*item == '\\' && item + 1 < end && (item[1] == ',' || item[1] == '\\'))
+                    item++;
+                *text++ = *item;
             }
+            spans[i].len = (size_t)(text - spans[i].ptr);
+        }
+        item = next;
+    }
+
+    *items = spans;
+    *count = n;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_get_array(ini_context_t const *ctx, char const *section, char const *key,
+                                          ini_span_t const **items, size_t *count)
+{
+    if (!ctx || !section || !key || !items || !count)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    // The items live in table entries, so a mapped image is indexed first
+    ini_status_t err = materialize_image((ini_context_t *)ctx);
+    typed_lookup_t found;
+    if (err == INI_STATUS_SUCCESS)
+        err = lookup_typed((ini_context_t *)ctx, section, key, &found);
+    if (err == INI_STATUS_SUCCESS)
+    {
+        ini_ht_key_value_t *entry = found.entry;
+        if (!(entry->typed & INI_HT_TYPED_ARRAY))
+        {
+            err = split_items(entry->value, &entry->items, &entry->item_count);
+            if (err == INI_STATUS_SUCCESS)
+                entry->typed |= INI_HT_TYPED_ARRAY;
+        }
+        if (err == INI_STATUS_SUCCESS)
+        {
+            *items = entry->items;
+            *count = entry->item_count;
+        }
+    }
+
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    return err;
+}
+
+// Adds `key` to the set of `section` in `sets` (section → key set, created on demand)
+static ini_status_t add_to_key_sets(ini_ht_t **sets, char const *section, char const *key)
+{
+    if (!*sets && !(*sets = ini_ht_create()))
+        return INI_STATUS_MEMORY_ERROR;
+
+    ini_ht_t *keys = ini_get_section_ht(*sets, section);
+    if (!keys)
+    {
+        keys = ini_ht_create();
+        if (!keys)
+            return INI_STATUS_MEMORY_ERROR;
+        ini_status_t err = store_section_ht(*sets, section, keys, INI_HT_BORROW_NONE);
+        if (err != INI_STATUS_SUCCESS)
+        {
+            ini_ht_destroy(keys);
+            return err;
+        }
+    }
+    return ini_ht_set(keys, key, "") ? INI_STATUS_SUCCESS : INI_STATUS_MEMORY_ERROR;
+}
+
+// Records that `key` of `section` differs from the preserved text, if any; the caller holds the lock
+static ini_status_t mark_edited(ini_context_t *ctx, char const *section, char const *key)
+{
+    return ctx->document ? add_to_key_sets(&ctx->document_edits, section, key) : INI_STATUS_SUCCESS;
+}
+
+// Records that `key` of `section` changed since the last load or save; the caller holds the lock
+static ini_status_t mark_dirty(ini_context_t *ctx, char const *section, char const *key)
+{
+    ini_status_t err = add_to_key_sets(&ctx->dirty, section, key);
+    return err == INI_STATUS_SUCCESS ? mark_edited(ctx, section, key) : err;
+}
+
+// Puts back a dirty set taken by a save that failed; the caller holds the lock
+static void restore_dirty(ini_context_t *ctx, ini_ht_t *saved)
+{
+    if (!saved)
+        return;
+
+    ini_ht_iterator_t sections_it = ini_ht_iterator(saved);
+    char *section;
+    char *keys_ptr_str;
+    while (ini_ht_next(&sections_it, &section, &keys_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_iterator_t keys_it = ini_ht_iterator((ini_ht_t *)str_to_ptr(keys_ptr_str));
+        char *key;
+        char *unused;
+        while (ini_ht_next(&keys_it, &key, &unused) == INI_STATUS_SUCCESS)
+            mark_dirty(ctx, section, key);
+    }
+    destroy_sections(saved);
+}
+
+INI_PUBLIC_API ini_status_t ini_set_value(ini_context_t *ctx, char const *section, char const *key, char const *value)
+{
+    if (!ctx || !key || !*key || !value)
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (!section)
+        section = "";
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    // Edits go to the tables, so a mapped image or pending lazy ranges are indexed first
+    ini_status_t err = materialize_image(ctx);
+    if (err == INI_STATUS_SUCCESS)
+        err = materialize_section(ctx, section, strlen(section));
+
+    // With a journal the change is recorded before it is made
+    ini_journal_entry_t const entry = {section, key, value};
+    if (err == INI_STATUS_SUCCESS)
+        err = journal_changes(ctx, &entry, 1);
+
+    ini_ht_t *section_ht = err == INI_STATUS_SUCCESS ? ini_get_section_ht(ctx->sections, section) : NULL;
+    if (err == INI_STATUS_SUCCESS && !section_ht)
+    {
+        section_ht = ini_ht_create();
+        if (!section_ht)
+            err = INI_STATUS_MEMORY_ERROR;
+        else if ((err = store_section_ht(ctx->sections, section, section_ht, INI_HT_BORROW_NONE)) !=
+                 INI_STATUS_SUCCESS)
+            ini_ht_destroy(section_ht);
+    }
+    if (err == INI_STATUS_SUCCESS && !ini_ht_set(section_ht, key, value))
+        err = INI_STATUS_MEMORY_ERROR;
+    if (err == INI_STATUS_SUCCESS)
+        err = mark_dirty(ctx, section, key);
+
+    ini_mutex_unlock(&ctx->mutex);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_remove_value(ini_context_t *ctx, char const *section, char const *key)
+{
+    if (!ctx || !key)
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (!section)
+        section = "";
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    ini_status_t err = materialize_image(ctx);
+    if (err == INI_STATUS_SUCCESS)
+        err = materialize_section(ctx, section, strlen(section));
+
+    ini_ht_t *section_ht = err == INI_STATUS_SUCCESS ? ini_get_section_ht(ctx->sections, section) : NULL;
+    if (err == INI_STATUS_SUCCESS && !section_ht)
+        err = INI_STATUS_SECTION_NOT_FOUND;
+    if (err == INI_STATUS_SUCCESS && !ini_ht_get(section_ht, key))
+        err = INI_STATUS_KEY_NOT_FOUND;
+    ini_journal_entry_t const entry = {section, key, NULL};
+    if (err == INI_STATUS_SUCCESS)
+        err = journal_changes(ctx, &entry, 1);
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_ht_remove(section_ht, key);
+    if (err == INI_STATUS_SUCCESS)
+        err = mark_dirty(ctx, section, key);
+
+    ini_mutex_unlock(&ctx->mutex);
+    return err;
+}
+
+INI_PUBLIC_API int ini_is_dirty(ini_context_t const *ctx)
+{
+    if (!ctx || ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != INI_STATUS_SUCCESS)
+        return 0;
+
+    int dirty = ctx->dirty && ini_ht_length(ctx->dirty) > 0;
+
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    return dirty;
+}
+
+// Appends `length` bytes at `*cursor`
+static void append_bytes(char **cursor, char const *bytes, size_t length)
+{
+    memcpy(*cursor, bytes, length);
+    *cursor += length;
+}
+
+/**
+ * @brief Renders every section as INI text into one exact-fit buffer.
+ *
+ * A first pass adds up the lengths (counting quotes for every value, so it
+ * is an upper bound); the second copies the strings with `memcpy()` and
+ * decides quoting once per value. The caller holds the lock and frees `*text`.
+ */
+static ini_status_t serialize_sections(ini_ht_t *sections, char **text, size_t *size)
+{
+    ini_ht_iterator_t sections_it = ini_ht_iterator(sections);
+    char *section_name;
+    char *section_ptr_str;
+    size_t bound = 0;
+    while (ini_ht_next(&sections_it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_t *section_ht = str_to_ptr(section_ptr_str);
+        bound += strlen(section_name) + 4; // Blank line, brackets, newline
+
+        ini_ht_iterator_t pairs_it = ini_ht_iterator(section_ht);
+        char *key;
+        char *value;
+        while (ini_ht_next(&pairs_it, &key, &value) == INI_STATUS_SUCCESS)
+        {
+            // A value the parser would give back differently is refused before anything is written
+            size_t value_len = strlen(value);
+            if (!ini_value_writable(value, value_len))
+                return INI_STATUS_INVALID_ARGUMENT;
+            bound += strlen(key) + value_len + 4; // '=', quotes, newline
+        }
+    }
+
+    char *buffer = (char *)malloc(bound + 1);
+    if (!buffer)
+        return INI_STATUS_MEMORY_ERROR;
+
+    char *cursor = buffer;
+    int first_section = 1;
+    sections_it = ini_ht_iterator(sections);
+    while (ini_ht_next(&sections_it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        ini_ht_t *section_ht = str_to_ptr(section_ptr_str);
+        // Skip empty global section if it has no keys
+        if (*section_name == '\0' && ini_ht_length(section_ht) == 0)
+            continue;
+
+        // Add newline between sections (except first)
+        if (!first_section)
+            *cursor++ = '\n';
+        first_section = 0;
+
+        // Write section header (except for global section)
+        if (*section_name != '\0')
+        {
+            *cursor++ = '[';
+            append_bytes(&cursor, section_name, strlen(section_name));
+            *cursor++ = ']';
+            *cursor++ = '\n';
+        }
+
+        ini_ht_iterator_t pairs_it = ini_ht_iterator(section_ht);
+        char *key;
+        char *value;
+        while (ini_ht_next(&pairs_it, &key, &value) == INI_STATUS_SUCCESS)
+        {
+            size_t value_len = strlen(value);
+            int need_quotes = ini_needs_quotes(value, value_len);
+
+            append_bytes(&cursor, key, strlen(key));
+            *cursor++ = '=';
+            if (need_quotes)
+                *cursor++ = '"';
+            append_bytes(&cursor, value, value_len);
+            if (need_quotes)
+                *cursor++ = '"';
+            *cursor++ = '\n';
+        }
+    }
+
+    *cursor = '\0';
+    *text = buffer;
+    *size = (size_t)(cursor - buffer);
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_save(ini_context_t const *ctx, char const *filepath)
+{
+    if (!ctx || !filepath || strlen(filepath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    // Check if file has write permission
+    ini_file_permission_t perms = ini_get_file_permission(filepath);
+    if (perms.write == 0)
+        return INI_STATUS_FILE_PERMISSION_DENIED;
+
+    // Lock context for thread safety
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    // The preserved text is patched, under the lock that keeps it in step with the file
+    if (ctx->document)
+    {
+        ini_status_t err = save_document((ini_context_t *)ctx, filepath);
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return err;
+    }
+
+    // Sections a lazy load has not parsed yet must be written too
+    char *text = NULL;
+    size_t size = 0;
+    ini_durability_t durability = ctx->durability;
+    ini_status_t err = materialize_all((ini_context_t *)ctx);
+    if (err == INI_STATUS_SUCCESS)
+        err = serialize_sections(ctx->sections, &text, &size);
+    // Changes made while the file is written stay dirty
+    ini_ht_t *saved_dirty = NULL;
+    if (err == INI_STATUS_SUCCESS)
+    {
+        saved_dirty = ctx->dirty;
+        ((ini_context_t *)ctx)->dirty = NULL;
+    }
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    // One write into a temporary file, renamed over the original
+    err = ini_write_file_atomic_ex(filepath, text, size, durability);
+    free(text);
+    if (err == INI_STATUS_SUCCESS)
+    {
+        destroy_sections(saved_dirty);
+    }
+    else if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) == INI_STATUS_SUCCESS)
+    {
+        restore_dirty((ini_context_t *)ctx, saved_dirty);
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    }
+    else
+    {
+        destroy_sections(saved_dirty);
+    }
+    return err;
+}
+
+// Renders the text ini_save() would write; the caller holds the lock and frees `*text`
+static ini_status_t render_context(ini_context_t *ctx, char **text, size_t *size)
+{
+    if (ctx->document)
+        return render_document(ctx, text, size);
+
+    ini_status_t err = materialize_all(ctx);
+    return err == INI_STATUS_SUCCESS ? serialize_sections(ctx->sections, text, size) : err;
+}
+
+INI_PUBLIC_API ini_status_t ini_save_to_buffer(ini_context_t const *ctx, char **text, size_t *size)
+{
+    if (!ctx || !text || !size)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    char *rendered = NULL;
+    size_t rendered_size = 0;
+    ini_status_t err = render_context((ini_context_t *)ctx, &rendered, &rendered_size);
+
+    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    *text = rendered;
+    *size = rendered_size;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_save_fd(ini_context_t const *ctx, int fd)
+{
+    if (!ctx || fd < 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    char *text = NULL;
+    size_t size = 0;
+    ini_status_t err = ini_save_to_buffer(ctx, &text, &size);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    // A slow pipe or socket does not hold up other users of the context
+    err = ini_write_fd(fd, text, size);
+    free(text);
+    return err;
+}
+
+static void out_string(text_out_t *out, char const *str)
+{
+    out_append(out, str, strlen(str));
+}
+
+// Appends `key=value` ended by `newline`, quoting the value when needed
+static void out_pair_line(text_out_t *out, char const *key, char const *value, char const *newline)
+{
+    size_t value_len = strlen(value);
+    int need_quotes = ini_needs_quotes(value, value_len);
+
+    out_string(out, key);
+    out_append(out, need_quotes ? "=\"" : "=", need_quotes ? 2 : 1);
+    out_append(out, value, value_len);
+    if (need_quotes)
+        out_append(out, "\"", 1);
+    out_string(out, newline);
+}
+
+// Appends `key=value`, quoting the value when needed
+static void out_pair(text_out_t *out, char const *key, char const *value)
+{
+    out_pair_line(out, key, value, "\n");
+}
 
-            // Remove trailing whitespace and newlines from value
-            char *value_end = value + strlen(value) - 1;
-            while (value_end >= value &&
-                   (*value_end == ' ' || *value_end == '\t' ||
-                    *value_end == '\n' || *value_end == '\r'))
-            {
-                *value_end-- = '\0';
-            }
+// Appends every pair of a section
+static void out_section_pairs(text_out_t *out, ini_ht_t *section_ht)
+{
+    ini_ht_iterator_t it = ini_ht_iterator(section_ht);
+    char *k, *v;
 
-            // Handle quoted values
-            if (*value == '"' && value_end >= value && *value_end == '"')
-            {
-                value++;
-                *value_end = '\0';
-            }
+    while (ini_ht_next(&it, &k, &v) == INI_STATUS_SUCCESS)
+        out_pair(out, k, v);
+}
+
+// Appends `[section]` and the pairs to write (one key, or all of them)
+static void out_new_section(text_out_t *out, char const *section, char const *key, ini_ht_t *section_ht)
+{
+    out_string(out, "[");
+    out_string(out, section);
+    out_string(out, "]\n");
+
+    if (key)
+        out_pair(out, key, ini_ht_get(section_ht, key));
+    else
+        out_section_pairs(out, section_ht);
+}
+
+/// @brief A replaced line range whose new text lives in `section_patch_t::text`.
+typedef struct
+{
+    size_t begin;       ///< First replaced byte of the file.
+    size_t end;         ///< One past the last replaced byte (`begin` to insert).
+    size_t text_begin;  ///< Offset of the new text in `section_patch_t::text`.
+    size_t text_length; ///< Length of the new text.
+} section_edit_t;
+
+/// @brief Changes `ini_save_section_value()` makes to an existing file.
+typedef struct
+{
+    section_edit_t *edits; ///< Edits in file order.
+    size_t count;          ///< Number of entries in `edits`.
+    size_t capacity;       ///< Allocated entries in `edits`.
+    text_out_t text;       ///< New text of every edit, back to back.
+} section_patch_t;
+
+// Starts an edit replacing `[begin, end)`; the caller appends its text to `patch->text`
+static ini_status_t begin_edit(section_patch_t *patch, size_t begin, size_t end)
+{
+    if (patch->count == patch->capacity)
+    {
+        size_t capacity = patch->capacity ? patch->capacity * 2 : 8;
+        section_edit_t *grown = (section_edit_t *)realloc(patch->edits, capacity * sizeof(section_edit_t));
+        if (!grown)
+            return INI_STATUS_MEMORY_ERROR;
+        patch->edits = grown;
+        patch->capacity = capacity;
+    }
+    section_edit_t *edit = &patch->edits[patch->count++];
+    edit->begin = begin;
+    edit->end = end;
+    edit->text_begin = patch->text.size;
+    edit->text_length = 0;
+    return INI_STATUS_SUCCESS;
+}
+
+// Closes the edit started last
+static void end_edit(section_patch_t *patch)
+{
+    section_edit_t *edit = &patch->edits[patch->count - 1];
+    edit->text_length = patch->text.size - edit->text_begin;
+}
+
+/// @brief A section whose lines a save rewrites in an existing file.
+typedef struct
+{
+    char const *name; ///< Section name.
+    size_t name_len;  ///< Length of `name`.
+    ini_ht_t *values; ///< Current pairs of the section (NULL if it no longer exists).
+    ini_ht_t *keys;   ///< Keys to write, or NULL for every key in `values`.
+    ini_ht_t *seen;   ///< Keys already found in the file.
+    int found;           ///< Non-zero once a header of the section was seen.
+    size_t insert_at;    ///< End of the last header or key line of the section.
+    char const *newline; ///< Line ending of that line ("\n" or "\r\n"; NULL means "\n").
+} section_target_t;
+
+static int compare_targets(void const *lhs, void const *rhs)
+{
+    section_target_t const *a = (section_target_t const *)lhs;
+    section_target_t const *b = (section_target_t const *)rhs;
+    size_t len = a->name_len < b->name_len ? a->name_len : b->name_len;
+    int order = memcmp(a->name, b->name, len);
+    if (order != 0)
+        return order;
+    return a->name_len < b->name_len ? -1 : a->name_len > b->name_len;
+}
+
+static int compare_edits(void const *lhs, void const *rhs)
+{
+    section_edit_t const *a = (section_edit_t const *)lhs;
+    section_edit_t const *b = (section_edit_t const *)rhs;
+    if (a->begin != b->begin)
+        return a->begin < b->begin ? -1 : 1;
+    return a->end < b->end ? -1 : a->end > b->end;
+}
+
+// Value to write for `key` of `target`, or NULL if the key is not written
+static char const *target_value(section_target_t const *target, char const *key)
+{
+    if (target->keys && !ini_ht_get(target->keys, key))
+        return NULL;
+    return target->values ? ini_ht_get(target->values, key) : NULL;
+}
+
+// Appends the pairs of `target` the file does not have yet; returns how many
+static size_t out_missing_pairs(text_out_t *out, section_target_t const *target)
+{
+    if (!target->values)
+        return 0;
+
+    size_t written = 0;
+    ini_ht_iterator_t it = ini_ht_iterator(target->keys ? target->keys : target->values);
+    char *k, *v;
+    while (ini_ht_next(&it, &k, &v) == INI_STATUS_SUCCESS)
+    {
+        char const *value = target_value(target, k);
+        if (value && !ini_ht_get(target->seen, k))
+        {
+            out_pair_line(out, k, value, target->newline ? target->newline : "\n");
+            written++;
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Finds the lines of `text` that saving `targets` changes.
+ *
+ * Lines are read like the parser does, past a UTF-8 BOM and indentation,
+ * with comments skipped: the first line of a key being saved in a target
+ * section is replaced by the current pair, or deleted if the key is gone;
+ * its later lines, `key[]=` list items included, are deleted. Saved keys
+ * the file lacks are inserted after the last key line of the section;
+ * missing sections are appended. New lines end like the line they replace
+ * or follow, appended sections like the last line of the file. Everything
+ * else is left byte for byte as it was. Sorts `targets` by name.
+ */
+static ini_status_t collect_section_edits(section_patch_t *patch, char const *text, size_t size,
+                                          section_target_t *targets, size_t count)
+{
+    // A value the parser would give back differently is refused before any edit is made
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!targets[i].values)
+            continue;
+        ini_ht_iterator_t it = ini_ht_iterator(targets[i].keys ? targets[i].keys : targets[i].values);
+        char *k, *v;
+        while (ini_ht_next(&it, &k, &v) == INI_STATUS_SUCCESS)
+        {
+            char const *value = target_value(&targets[i], k);
+            if (value && !ini_value_writable(value, strlen(value)))
+                return INI_STATUS_INVALID_ARGUMENT;
+        }
+    }
+
+    qsort(targets, count, sizeof(section_target_t), compare_targets);
 
-            // Skip empty keys
-            if (*key == '\0')
+    ini_status_t err = INI_STATUS_SUCCESS;
+    section_target_t *current = NULL; // Target section the scan is in
+    size_t pos = ini_utf8_bom_length(text, size);
+    char const *file_newline = NULL; // Ending of the last ended line, used for appended sections
+
+    // Global keys come before the first header, as ini_save() writes them
+    section_target_t global = {0};
+    global.name = "";
+    current = (section_target_t *)bsearch(&global, targets, count, sizeof(section_target_t), compare_targets);
+    if (current)
+    {
+        current->found = 1;
+        current->insert_at = pos;
+    }
+    while (pos < size && err == INI_STATUS_SUCCESS)
+    {
+        char const *line = text + pos;
+        char const *newline = (char const *)memchr(line, '\n', size - pos);
+        size_t line_len = newline ? (size_t)(newline - line) + 1 : size - pos;
+        size_t next = pos + line_len;
+
+        // Indentation does not change what a line is, as in the tokenizer
+        char const *trimmed = line;
+        while (trimmed < line + line_len && (*trimmed == ' ' || *trimmed == '\t'))
+            trimmed++;
+        size_t trimmed_len = line_len - (size_t)(trimmed - line);
+        // Rewritten lines keep the ending of the line they replace or follow
+        char const *ending = "\n";
+        if (newline && line_len >= 2 && line[line_len - 2] == '\r')
+            ending = "\r\n";
+        else if (!newline && file_newline)
+            ending = file_newline; // The last line, not ended yet
+        if (newline)
+            file_newline = ending;
+        int comment = trimmed_len == 0 || *trimmed == ';' || *trimmed == '#'; // May hold '=' but is no key
+
+        if (!comment && *trimmed == '[')
+        {
+            char const *close = (char const *)memchr(trimmed, ']', trimmed_len);
+            if (close)
             {
-                continue;
+                section_target_t header = {0};
+                header.name = trimmed + 1;
+                header.name_len = (size_t)(close - trimmed) - 1;
+                current = (section_target_t *)bsearch(&header, targets, count, sizeof(section_target_t),
+                                                      compare_targets);
+                if (current)
+                {
+                    current->found = 1;
+                    current->insert_at = next;
+                    current->newline = ending;
+                }
             }
-
-            // If we have no current section, create the default/global section
-            if (!current_section_ht)
+        }
+        else if (current && !comment)
+        {
+            char const *eq = (char const *)memchr(trimmed, '=', trimmed_len);
+            if (eq)
             {
-                current_section_ht = ini_ht_create();
-                if (!current_section_ht)
+                // Trim the key
+                char const *key_begin = trimmed;
+                char const *key_end = eq;
+                while (key_end > key_begin && (key_end[-1] == ' ' || key_end[-1] == '\t'))
+                    key_end--;
+
+                char line_key[INI_LINE_MAX];
+                size_t key_len = (size_t)(key_end - key_begin);
+                // `key[]=item` lines hold the items of `key`, as in build_key_value()
+                if (key_len > 2 && key_end[-2] == '[' && key_end[-1] == ']')
+                    key_len -= 2;
+                current->insert_at = next;
+                current->newline = ending;
+                if (key_len < sizeof(line_key))
                 {
-                    fclose(file);
-                    ini_mutex_unlock(&ctx_to_use->mutex);
-                    if (need_to_free_on_error)
+                    memcpy(line_key, key_begin, key_len);
+                    line_key[key_len] = '\0';
+
+                    // Saved keys are rewritten; dirty keys that no longer exist are dropped
+                    int saved = current->keys ? ini_ht_get(current->keys, line_key) != NULL
+                                              : current->values && ini_ht_get(current->values, line_key) != NULL;
+                    if (saved)
                     {
-                        ini_free(ctx_to_use);
+                        // The first line of the key takes the whole value; later lines and list items go
+                        char const *value = target_value(current, line_key);
+                        int repeated = ini_ht_get(current->seen, line_key) != NULL;
+                        err = begin_edit(patch, pos, next);
+                        if (err == INI_STATUS_SUCCESS)
+                        {
+                            if (value && !repeated)
+                                out_pair_line(&patch->text, line_key, value, ending);
+                            end_edit(patch);
+                            if (!repeated && !ini_ht_set(current->seen, line_key, ""))
+                                err = INI_STATUS_MEMORY_ERROR;
+                        }
                     }
-                    return INI_STATUS_MEMORY_ERROR;
                 }
-
-                // Add it to the sections hash table with empty string key
-                ini_store_section_ht(ctx_to_use->sections, "", current_section_ht);
             }
-
-            // Add/update key-value pair in current section
-            ini_ht_set(current_section_ht, key, value);
         }
+        pos = next;
     }
+    if (!file_newline)
+        file_newline = "\n";
 
-    fclose(file);
-    ini_mutex_unlock(&ctx_to_use->mutex);
-    return INI_STATUS_SUCCESS;
+    // Saved keys a section does not have yet go after its last key line
+    for (size_t i = 0; i < count && err == INI_STATUS_SUCCESS; i++)
+    {
+        section_target_t *target = &targets[i];
+        if (!target->found)
+            continue;
+        err = begin_edit(patch, target->insert_at, target->insert_at);
+        if (err != INI_STATUS_SUCCESS)
+            break;
+        if (!target->newline)
+            target->newline = file_newline;
+        if (target->insert_at > 0 && text[target->insert_at - 1] != '\n')
+            out_string(&patch->text, target->newline);
+        if (out_missing_pairs(&patch->text, target) == 0)
+            patch->text.size = patch->edits[patch->count - 1].text_begin; // Nothing was missing
+        end_edit(patch);
+    }
+
+    // Sections the file lacks are appended
+    if (err == INI_STATUS_SUCCESS)
+        err = begin_edit(patch, size, size);
+    for (size_t i = 0; i < count && err == INI_STATUS_SUCCESS; i++)
+    {
+        section_target_t *target = &targets[i];
+        if (target->found || !target->values)
+            continue;
+
+        size_t section_begin = patch->text.size;
+        // Add newline before section if needed
+        if (size > 0 || section_begin > patch->edits[patch->count - 1].text_begin)
+            out_string(&patch->text, file_newline);
+        out_string(&patch->text, "[");
+        out_append(&patch->text, target->name, target->name_len);
+        out_string(&patch->text, "]");
+        out_string(&patch->text, file_newline);
+        target->newline = file_newline;
+        if (out_missing_pairs(&patch->text, target) == 0 && target->keys)
+            patch->text.size = section_begin; // Nothing to write
+    }
+    if (err == INI_STATUS_SUCCESS)
+        end_edit(patch);
+
+    if (err == INI_STATUS_SUCCESS && patch->text.failed)
+        err = INI_STATUS_MEMORY_ERROR;
+    if (err == INI_STATUS_SUCCESS)
+        qsort(patch->edits, patch->count, sizeof(section_edit_t), compare_edits);
+    return err;
+}
+
+// Writes the patched file, copying the untouched bytes between the edits
+static ini_status_t apply_section_patch(section_patch_t const *patch, char const *filepath,
+                                        ini_durability_t durability, ini_file_fingerprint_t const *fingerprint)
+{
+    ini_file_edit_t *edits = (ini_file_edit_t *)malloc((patch->count ? patch->count : 1) * sizeof(ini_file_edit_t));
+    if (!edits)
+        return INI_STATUS_MEMORY_ERROR;
+
+    size_t count = 0;
+    for (size_t i = 0; i < patch->count; i++)
+    {
+        section_edit_t const *edit = &patch->edits[i];
+        if (edit->begin == edit->end && edit->text_length == 0)
+            continue;
+        edits[count].offset = edit->begin;
+        edits[count].length = edit->end - edit->begin;
+        edits[count].data = patch->text.data + edit->text_begin;
+        edits[count].size = edit->text_length;
+        count++;
+    }
+
+    ini_status_t err = ini_patch_file_atomic(filepath, edits, count, durability, fingerprint);
+    free(edits);
+    return err;
+}
+
+// Runs `collect_section_edits()` with the scratch tables of `targets` set up and torn down around it
+static ini_status_t collect_target_edits(section_patch_t *patch, char const *text, size_t size,
+                                         section_target_t *targets, size_t count)
+{
+    ini_status_t err = INI_STATUS_SUCCESS;
+    for (size_t i = 0; i < count && err == INI_STATUS_SUCCESS; i++)
+    {
+        targets[i].seen = ini_ht_create();
+        if (!targets[i].seen)
+            err = INI_STATUS_MEMORY_ERROR;
+    }
+
+    if (err == INI_STATUS_SUCCESS)
+        err = collect_section_edits(patch, text, size, targets, count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (targets[i].seen)
+            ini_ht_destroy(targets[i].seen);
+        targets[i].seen = NULL;
+    }
+    return err;
 }
 
 /**
- * @brief Gets a value from a section in the INI context.
+ * @brief Rewrites the lines of `targets` in the existing file `filepath`.
  *
- * @param ctx Context to query
- * @param section Section name (empty string for global keys)
- * @param key Key name to retrieve
- * @param[out] value Output value (caller must free)
- * @return ini_status_t Error code
+ * The caller holds the lock, which keeps saves through the same context in
+ * step. Anyone else replacing the file between the mapping and the patch
+ * makes it fail with INI_STATUS_FILE_CHANGED instead of applying offsets
+ * taken from the old version.
  */
-INI_PUBLIC_API ini_status_t ini_get_value(ini_context_t const *ctx,
-                                          char const *section,
-                                          char const *key,
-                                          char **value)
+static ini_status_t patch_sections(char const *filepath, section_target_t *targets, size_t count,
+                                   ini_durability_t durability)
 {
-    if (!ctx || !section || !key || !value)
+    void const *view = NULL;
+    size_t size = 0;
+    ini_file_fingerprint_t fingerprint;
+    ini_status_t err = ini_map_file_ex(filepath, &view, &size, &fingerprint);
+    if (err == INI_STATUS_FILE_EMPTY)
+        err = INI_STATUS_SUCCESS;
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    section_patch_t patch = {0};
+    err = collect_target_edits(&patch, (char const *)view, size, targets, count);
+    if (err == INI_STATUS_SUCCESS)
+        err = apply_section_patch(&patch, filepath, durability, &fingerprint);
+
+    free(patch.edits);
+    free(patch.text.data);
+    ini_unmap_file(view, size);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_save_section_value(ini_context_t const *ctx,
+                                                   char const *filepath,
+                                                   char const *section,
+                                                   char const *key)
+{
+    if (!ctx || !filepath || !section)
         return INI_STATUS_INVALID_ARGUMENT;
 
     // Lock context for thread safety
     if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
         return INI_STATUS_PLATFORM_ERROR;
 
-    // Get the section hash table
+    ini_status_t lazy_err = materialize_section((ini_context_t *)ctx, section, strlen(section));
+    if (lazy_err != INI_STATUS_SUCCESS)
+    {
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return lazy_err;
+    }
+
+    // Find section
     ini_ht_t *section_ht = ini_get_section_ht(ctx->sections, section);
     if (!section_ht)
     {
@@ -475,27 +3447,191 @@ INI_PUBLIC_API ini_status_t ini_get_value(ini_context_t const *ctx,
         return INI_STATUS_SECTION_NOT_FOUND;
     }
 
-    // Get the value from the section
-    char const *found_value = ini_ht_get(section_ht, key);
-    if (!found_value)
+    // If key specified, check if it exists
+    if (key)
     {
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_KEY_NOT_FOUND;
+        char const *value = ini_ht_get(section_ht, key);
+        if (!value)
+        {
+            ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+            return INI_STATUS_KEY_NOT_FOUND;
+        }
     }
 
-    // Make a copy for the caller
-    *value = ini_strdup(found_value);
-    if (!*value)
+    ini_durability_t durability = ctx->durability;
+    ini_status_t err;
+    if (ini_file_exists(filepath) == INI_STATUS_SUCCESS)
     {
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_MEMORY_ERROR;
+        // Only the affected lines are rewritten
+        section_target_t target = {0};
+        target.name = section;
+        target.name_len = strlen(section);
+        target.values = section_ht;
+        err = INI_STATUS_SUCCESS;
+        if (key)
+        {
+            target.keys = ini_ht_create();
+            if (!target.keys || !ini_ht_set(target.keys, key, ""))
+                err = INI_STATUS_MEMORY_ERROR;
+        }
+        if (err == INI_STATUS_SUCCESS)
+            err = patch_sections(filepath, &target, 1, durability);
+        if (target.keys)
+            ini_ht_destroy(target.keys);
+    }
+    else
+    {
+        // File doesn't exist, create it with just this section
+        text_out_t out = {0};
+        out_new_section(&out, section, key, section_ht);
+        err = out.failed ? INI_STATUS_MEMORY_ERROR : ini_write_file_atomic_ex(filepath, out.data, out.size, durability);
+        free(out.data);
     }
 
     ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    return err;
+}
+
+// Builds one target per section of `sets` (section → key set, may be NULL); the caller holds the lock and frees the array
+static section_target_t *key_set_targets(ini_context_t *ctx, ini_ht_t *sets, size_t *count)
+{
+    size_t capacity = sets ? ini_ht_length(sets) : 0;
+    section_target_t *targets = (section_target_t *)calloc(capacity ? capacity : 1, sizeof(section_target_t));
+    *count = 0;
+    if (!targets || !sets)
+        return targets;
+
+    ini_ht_iterator_t it = ini_ht_iterator(sets);
+    char *section;
+    char *keys_ptr_str;
+    while (*count < capacity && ini_ht_next(&it, &section, &keys_ptr_str) == INI_STATUS_SUCCESS)
+    {
+        section_target_t *target = &targets[(*count)++];
+        target->name = section;
+        target->name_len = strlen(section);
+        target->values = ini_get_section_ht(ctx->sections, section);
+        target->keys = (ini_ht_t *)str_to_ptr(keys_ptr_str);
+    }
+    return targets;
+}
+
+/**
+ * @brief Rewrites the lines of every key in `sets` (section → key set) in the existing file.
+ *
+ * Values come from the context; keys it no longer has lose their line. The
+ * caller holds the lock.
+ */
+static ini_status_t patch_key_sets(ini_context_t *ctx, char const *filepath, ini_ht_t *sets)
+{
+    size_t count = 0;
+    section_target_t *targets = key_set_targets(ctx, sets, &count);
+    if (!targets)
+        return INI_STATUS_MEMORY_ERROR;
+
+    ini_status_t err = patch_sections(filepath, targets, count, ctx->durability);
+    free(targets);
+    return err;
+}
+
+/**
+ * @brief Renders the preserved text of `ctx` with the lines of edited keys rewritten.
+ *
+ * Runs the same line scan as `ini_save_section_value()`, but over the text
+ * kept in memory, so the unchanged bytes between two edits are copied with a
+ * single `memcpy()`. The caller holds the lock and frees `*text`, which is
+ * null-terminated.
+ */
+static ini_status_t render_document(ini_context_t *ctx, char **text, size_t *size)
+{
+    // Edited keys of sections a lazy load has not parsed yet still need their values
+    ini_status_t err = materialize_all(ctx);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    size_t count = 0;
+    section_target_t *targets = key_set_targets(ctx, ctx->document_edits, &count);
+    if (!targets)
+        return INI_STATUS_MEMORY_ERROR;
+
+    section_patch_t patch = {0};
+    err = collect_target_edits(&patch, ctx->document, ctx->document_size, targets, count);
+
+    text_out_t out = {0};
+    size_t pos = 0;
+    for (size_t i = 0; i < patch.count && err == INI_STATUS_SUCCESS; i++)
+    {
+        section_edit_t const *edit = &patch.edits[i];
+        out_append(&out, ctx->document + pos, edit->begin - pos);
+        out_append(&out, patch.text.data + edit->text_begin, edit->text_length);
+        pos = edit->end;
+    }
+    if (err == INI_STATUS_SUCCESS)
+    {
+        out_append(&out, ctx->document + pos, ctx->document_size - pos);
+        out_append(&out, "", 1);
+        if (out.failed)
+            err = INI_STATUS_MEMORY_ERROR;
+    }
+
+    if (err == INI_STATUS_SUCCESS)
+    {
+        *text = out.data;
+        *size = out.size - 1;
+    }
+    else
+    {
+        free(out.data);
+    }
+    free(patch.edits);
+    free(patch.text.data);
+    free(targets);
+    return err;
+}
+
+/**
+ * @brief Writes the rendered preserved text to `filepath` and keeps it for the next save.
+ *
+ * The caller holds the lock.
+ */
+static ini_status_t save_document(ini_context_t *ctx, char const *filepath)
+{
+    char *text = NULL;
+    size_t size = 0;
+    ini_status_t err = render_document(ctx, &text, &size);
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_write_file_atomic_ex(filepath, text, size, ctx->durability);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        free(text);
+        return err;
+    }
+
+    free(ctx->document);
+    ctx->document = text;
+    ctx->document_size = size;
+    ctx->document_version++;
+    destroy_sections(ctx->document_edits);
+    destroy_sections(ctx->dirty);
+    ctx->document_edits = NULL;
+    ctx->dirty = NULL;
     return INI_STATUS_SUCCESS;
 }
 
-INI_PUBLIC_API ini_status_t ini_save(ini_context_t const *ctx, char const *filepath)
+// Writes the whole context to `filepath`; the caller holds the lock
+static ini_status_t write_all_sections(ini_context_t *ctx, char const *filepath)
+{
+    char *text = NULL;
+    size_t size = 0;
+    ini_status_t err = materialize_all(ctx);
+    if (err == INI_STATUS_SUCCESS)
+        err = serialize_sections(ctx->sections, &text, &size);
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_write_file_atomic_ex(filepath, text, size, ctx->durability);
+    free(text);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_save_incremental(ini_context_t *ctx, char const *filepath)
 {
     if (!ctx || !filepath || strlen(filepath) == 0)
         return INI_STATUS_INVALID_ARGUMENT;
@@ -505,443 +3641,544 @@ INI_PUBLIC_API ini_status_t ini_save(ini_context_t const *ctx, char const *filep
     if (perms.write == 0)
         return INI_STATUS_FILE_PERMISSION_DENIED;
 
-    // Open file for writing
-    FILE *file = ini_fopen(filepath, "w");
-    if (!file)
-        return INI_STATUS_FILE_OPEN_FAILED;
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
 
-    // Lock context for thread safety
-    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
+    size_t count = ctx->dirty ? ini_ht_length(ctx->dirty) : 0;
+    if (count == 0)
     {
-        fclose(file);
-        return INI_STATUS_PLATFORM_ERROR;
+        ini_mutex_unlock(&ctx->mutex);
+        return INI_STATUS_SUCCESS;
     }
 
-    // Iterate through all sections
-    ini_ht_iterator_t sections_it = ini_ht_iterator((ini_ht_t *)ctx->sections);
-    char *section_name;
-    char *section_ptr_str;
-    int first_section = 1;
+    ini_status_t err;
+    if (ini_file_exists(filepath) != INI_STATUS_SUCCESS)
+    {
+        // Nothing to patch: write everything
+        err = write_all_sections(ctx, filepath);
+    }
+    else
+    {
+        err = patch_key_sets(ctx, filepath, ctx->dirty);
+    }
 
-    while (ini_ht_next(&sections_it, &section_name, &section_ptr_str) == INI_STATUS_SUCCESS)
+    if (err == INI_STATUS_SUCCESS)
     {
-        ini_ht_t *section_ht = str_to_ptr(section_ptr_str);
-        // Skip empty global section if it has no keys
-        if (*section_name == '\0' && ini_ht_length(section_ht) == 0)
-        {
-            continue;
-        }
+        destroy_sections(ctx->dirty);
+        ctx->dirty = NULL;
+    }
 
-        // Add newline between sections (except first)
-        if (!first_section)
-        {
-            fprintf(file, "\n");
-        }
-        first_section = 0;
+    ini_mutex_unlock(&ctx->mutex);
+    return err;
+}
 
-        // Write section header (except for global section)
-        if (*section_name != '\0')
-        {
-            fprintf(file, "[%s]\n", section_name);
-        }
+/// @brief One change staged by a transaction.
+typedef struct
+{
+    char *section; ///< Section name ("" for global keys).
+    char *key;     ///< Key name.
+    char *value;   ///< New value, or NULL to remove the key.
+} txn_op_t;
 
-        // Write key-value pairs
-        ini_ht_iterator_t pairs_it = ini_ht_iterator(section_ht);
-        char *key;
-        char *value;
+/// @brief What a committed change replaced, to put back if the commit fails.
+typedef struct
+{
+    ini_ht_t *section_ht; ///< Table the change went to.
+    char *old_value;      ///< Previous value (NULL if the key was absent).
+    int created;          ///< Non-zero if the change created `section_ht`.
+} txn_undo_t;
 
-        while (ini_ht_next(&pairs_it, &key, &value) == INI_STATUS_SUCCESS)
-        {
-            // Determine if value needs quotes
-            int need_quotes = 0;
-            if (strchr(value, ' ') || strchr(value, '\t') ||
-                strchr(value, ';') || strchr(value, '#'))
-            {
-                need_quotes = 1;
-            }
+struct ini_txn_s
+{
+    ini_context_t *ctx; ///< Context the changes go to.
+    txn_op_t *ops;      ///< Staged changes, in call order.
+    size_t count;       ///< Number of entries in `ops`.
+    size_t capacity;    ///< Allocated entries in `ops`.
+};
 
-            if (need_quotes)
-            {
-                fprintf(file, "%s=\"%s\"\n", key, value);
-            }
-            else
-            {
-                fprintf(file, "%s=%s\n", key, value);
-            }
-        }
-    }
+INI_PUBLIC_API ini_txn_t *ini_txn_begin(ini_context_t *ctx)
+{
+    if (!ctx)
+        return NULL;
 
-    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-    if (fclose(file) != 0)
-        return INI_STATUS_CLOSE_FAILED;
+    ini_txn_t *txn = (ini_txn_t *)calloc(1, sizeof(ini_txn_t));
+    if (txn)
+        txn->ctx = ctx;
+    return txn;
+}
+
+static ini_status_t txn_stage(ini_txn_t *txn, char const *section, char const *key, char const *value)
+{
+    if (txn->count == txn->capacity)
+    {
+        size_t capacity = txn->capacity ? txn->capacity * 2 : 16;
+        txn_op_t *ops = (txn_op_t *)realloc(txn->ops, capacity * sizeof(txn_op_t));
+        if (!ops)
+            return INI_STATUS_MEMORY_ERROR;
+        txn->ops = ops;
+        txn->capacity = capacity;
+    }
 
+    txn_op_t op = {ini_strdup(section ? section : ""), ini_strdup(key), value ? ini_strdup(value) : NULL};
+    if (!op.section || !op.key || (value && !op.value))
+    {
+        free(op.section);
+        free(op.key);
+        free(op.value);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+    txn->ops[txn->count++] = op;
     return INI_STATUS_SUCCESS;
 }
 
-INI_PUBLIC_API ini_status_t ini_save_section_value(ini_context_t const *ctx,
-                                                   char const *filepath,
-                                                   char const *section,
-                                                   char const *key)
+INI_PUBLIC_API ini_status_t ini_txn_set(ini_txn_t *txn, char const *section, char const *key, char const *value)
 {
-    if (!ctx || !filepath || !section)
+    if (!txn || !key || !*key || !value)
         return INI_STATUS_INVALID_ARGUMENT;
+    return txn_stage(txn, section, key, value);
+}
 
-    // Lock context for thread safety
-    if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
-        return INI_STATUS_PLATFORM_ERROR;
+INI_PUBLIC_API ini_status_t ini_txn_remove(ini_txn_t *txn, char const *section, char const *key)
+{
+    if (!txn || !key || !*key)
+        return INI_STATUS_INVALID_ARGUMENT;
+    return txn_stage(txn, section, key, NULL);
+}
 
-    // Find section
-    ini_ht_t *section_ht = ini_get_section_ht(ctx->sections, section);
-    if (!section_ht)
+INI_PUBLIC_API size_t ini_txn_size(ini_txn_t const *txn)
+{
+    return txn ? txn->count : 0;
+}
+
+INI_PUBLIC_API void ini_txn_abort(ini_txn_t *txn)
+{
+    if (!txn)
+        return;
+
+    for (size_t i = 0; i < txn->count; i++)
     {
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_SECTION_NOT_FOUND;
+        free(txn->ops[i].section);
+        free(txn->ops[i].key);
+        free(txn->ops[i].value);
     }
+    free(txn->ops);
+    free(txn);
+}
 
-    // If key specified, check if it exists
-    if (key)
+// Sets `key` (or removes it if `value` is NULL), filling `undo` if given; the caller holds the lock
+static ini_status_t apply_change(ini_context_t *ctx, char const *section, char const *key, char const *value,
+                                 txn_undo_t *undo)
+{
+    ini_status_t err = materialize_section(ctx, section, strlen(section));
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    ini_ht_t *section_ht = ini_get_section_ht(ctx->sections, section);
+    if (!section_ht)
     {
-        char const *value = ini_ht_get(section_ht, key);
+        // Removing from a missing section changes nothing
         if (!value)
+            return INI_STATUS_SUCCESS;
+        section_ht = ini_ht_create();
+        if (!section_ht)
+            return INI_STATUS_MEMORY_ERROR;
+        if ((err = store_section_ht(ctx->sections, section, section_ht, INI_HT_BORROW_NONE)) != INI_STATUS_SUCCESS)
         {
-            ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-            return INI_STATUS_KEY_NOT_FOUND;
+            ini_ht_destroy(section_ht);
+            return err;
         }
+        if (undo)
+            undo->created = 1;
     }
 
-    // Check if file exists
-    FILE *existing_file = NULL;
-    int file_exists = 0;
-
-#if INI_OS_WINDOWS
-    if (_access(filepath, F_OK) == 0)
-    {
-        file_exists = 1;
-    }
-#else
-    if (access(filepath, F_OK) == 0)
+    // A new table has no old value, so the undo entry is complete before the copy
+    char const *old_value = ini_ht_get(section_ht, key);
+    if (undo)
     {
-        file_exists = 1;
+        if (old_value && !(undo->old_value = ini_strdup(old_value)))
+            return INI_STATUS_MEMORY_ERROR;
+        undo->section_ht = section_ht;
     }
-#endif
+    // A rolled back change only costs its line a rewrite to the same value
+    if ((err = mark_edited(ctx, section, key)) != INI_STATUS_SUCCESS)
+        return err;
 
-    // Create a temporary file for output
-    char temp_path[1024];
-    FILE *temp_file;
+    if (value)
+        return ini_ht_set(section_ht, key, value) ? INI_STATUS_SUCCESS : INI_STATUS_MEMORY_ERROR;
+    if (old_value)
+        ini_ht_remove(section_ht, key);
+    return INI_STATUS_SUCCESS;
+}
 
-#if INI_OS_WINDOWS
-    // Create temporary file path
-    if (tmpnam_s(temp_path, sizeof(temp_path)) != 0)
+// Puts back what the first `count` changes replaced, newest first; the caller holds the lock
+static void txn_rollback(ini_context_t *ctx, txn_op_t const *ops, txn_undo_t *undo, size_t count)
+{
+    while (count-- > 0)
     {
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_FILE_OPEN_FAILED;
+        if (!undo[count].section_ht)
+            continue;
+        if (undo[count].created)
+        {
+            ini_ht_remove(ctx->sections, ops[count].section);
+            ini_ht_destroy(undo[count].section_ht);
+        }
+        else if (undo[count].old_value)
+            ini_ht_set(undo[count].section_ht, ops[count].key, undo[count].old_value);
+        else
+            ini_ht_remove(undo[count].section_ht, ops[count].key);
     }
+}
 
-    temp_file = ini_fopen(temp_path, "w");
-    if (!temp_file)
-    {
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_FILE_OPEN_FAILED;
-    }
-#else
-    // On Unix, use tmpfile() which automatically handles cleanup
-    temp_file = tmpfile();
-    if (!temp_file)
+// Records every change of a transaction with one write and syncs them; the caller holds the lock
+static ini_status_t journal_txn(ini_context_t *ctx, ini_txn_t const *txn)
+{
+    ini_journal_entry_t *entries = (ini_journal_entry_t *)malloc(txn->count * sizeof(ini_journal_entry_t));
+    if (!entries)
+        return INI_STATUS_MEMORY_ERROR;
+
+    for (size_t i = 0; i < txn->count; i++)
     {
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_FILE_OPEN_FAILED;
+        entries[i].section = txn->ops[i].section;
+        entries[i].key = txn->ops[i].key;
+        entries[i].value = txn->ops[i].value;
     }
-#endif
+    ini_status_t err = journal_changes(ctx, entries, txn->count);
+    free(entries);
+    return err == INI_STATUS_SUCCESS ? ini_journal_sync(ctx->journal) : err;
+}
+
+INI_PUBLIC_API ini_status_t ini_txn_commit(ini_txn_t *txn, char const *filepath)
+{
+    if (!txn)
+        return INI_STATUS_INVALID_ARGUMENT;
 
-    // If file exists, read it and update the specific section
-    if (file_exists)
+    ini_context_t *ctx = txn->ctx;
+    ini_status_t err = INI_STATUS_SUCCESS;
+    if (!filepath || strlen(filepath) == 0)
+        err = INI_STATUS_INVALID_ARGUMENT;
+    else if (ini_get_file_permission(filepath).write == 0)
+        err = INI_STATUS_FILE_PERMISSION_DENIED;
+    else if (txn->count == 0)
+        err = INI_STATUS_SUCCESS;
+    else if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        err = INI_STATUS_PLATFORM_ERROR;
+    else
     {
-        if (ini_fopen(filepath, "r") != 0 || !existing_file)
+        txn_undo_t *undo = (txn_undo_t *)calloc(txn->count, sizeof(txn_undo_t));
+        ini_ht_t *touched = NULL;
+        size_t applied = 0;
+
+        err = undo ? materialize_image(ctx) : INI_STATUS_MEMORY_ERROR;
+        while (err == INI_STATUS_SUCCESS && applied < txn->count)
         {
-            fclose(temp_file);
-            ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-            return INI_STATUS_FILE_OPEN_FAILED;
+            txn_op_t const *op = &txn->ops[applied];
+            // Counted even when it fails: its undo entry may hold a created section
+            err = apply_change(ctx, op->section, op->key, op->value, &undo[applied++]);
+            if (err == INI_STATUS_SUCCESS)
+                err = add_to_key_sets(&touched, op->section, op->key);
         }
 
-        char line[INI_LINE_MAX];
-        char current_section[INI_LINE_MAX] = "";
-        int in_target_section = 0;
-        int target_section_written = 0;
-
-        while (fgets(line, sizeof(line), existing_file))
+        // One merge pass and one atomic replace for every change, or one journal append
+        if (err == INI_STATUS_SUCCESS)
         {
-            // Check if line is a section
-            if (line[0] == '[')
-            {
-                char *end = strchr(line, ']');
-                if (end)
-                {
-                    *end = '\0';
-                    strcpy(current_section, line + 1);
-                    *end = ']';
-
-                    // Check if entering the target section
-                    if (strcmp(current_section, section) == 0)
-                    {
-                        in_target_section = 1;
-                        target_section_written = 1;
-
-                        // Write section header
-                        fprintf(temp_file, "%s", line);
+            if (ctx->journal && strcmp(filepath, ctx->journal_base) == 0)
+                err = journal_txn(ctx, txn);
+            else if (ini_file_exists(filepath) != INI_STATUS_SUCCESS)
+                err = write_all_sections(ctx, filepath);
+            else
+                err = patch_key_sets(ctx, filepath, touched);
+        }
 
-                        // If key is NULL, write all keys from the section
-                        if (!key)
-                        {
-                            ini_ht_iterator_t it = ini_ht_iterator(section_ht);
-                            char *k, *v;
-
-                            while (ini_ht_next(&it, &k, &v) == INI_STATUS_SUCCESS)
-                            {
-                                int need_quotes = 0;
-                                if (strchr(v, ' ') || strchr(v, '\t') ||
-                                    strchr(v, ';') || strchr(v, '#'))
-                                {
-                                    need_quotes = 1;
-                                }
-
-                                if (need_quotes)
-                                {
-                                    fprintf(temp_file, "%s=\"%s\"\n", k, v);
-                                }
-                                else
-                                {
-                                    fprintf(temp_file, "%s=%s\n", k, v);
-                                }
-                            }
-
-                            // Skip processing until next section
-                            in_target_section = 0;
-                        }
-                        continue;
-                    }
-                    else
-                    {
-                        // Exiting the target section
-                        in_target_section = 0;
-                    }
-                }
-            }
-            // Handle key-value pairs in target section
-            else if (in_target_section && key && strchr(line, '='))
-            {
-                char *eq = strchr(line, '=');
-                if (eq)
-                {
-                    *eq = '\0';
-                    char *line_key = line;
+        if (err != INI_STATUS_SUCCESS && undo)
+            txn_rollback(ctx, txn->ops, undo, applied);
 
-                    // Trim key
-                    while (*line_key && (*line_key == ' ' || *line_key == '\t'))
-                    {
-                        line_key++;
-                    }
+        ini_mutex_unlock(&ctx->mutex);
+        if (undo)
+            for (size_t i = 0; i < txn->count; i++)
+                free(undo[i].old_value);
+        free(undo);
+        destroy_sections(touched);
+    }
 
-                    char *end = eq - 1;
-                    while (end > line_key && (*end == ' ' || *end == '\t'))
-                    {
-                        *end-- = '\0';
-                    }
+    ini_txn_abort(txn);
+    return err;
+}
 
-                    // If this is our target key, replace it
-                    if (strcmp(line_key, key) == 0)
-                    {
-                        // Get value from context
-                        char const *value = ini_ht_get(section_ht, key);
+// Builds the journal path of an INI file (caller frees)
+static char *journal_path(char const *filepath)
+{
+    size_t length = strlen(filepath);
+    char *path = (char *)malloc(length + sizeof(INI_JOURNAL_SUFFIX));
+    if (path)
+    {
+        memcpy(path, filepath, length);
+        memcpy(path + length, INI_JOURNAL_SUFFIX, sizeof(INI_JOURNAL_SUFFIX));
+    }
+    return path;
+}
 
-                        // Determine if quotes needed
-                        int need_quotes = 0;
-                        if (strchr(value, ' ') || strchr(value, '\t') ||
-                            strchr(value, ';') || strchr(value, '#'))
-                        {
-                            need_quotes = 1;
-                        }
+// Applies one journal record; `user` is the context, whose lock the caller holds
+static ini_status_t replay_record(void *user, char const *section, char const *key, char const *value)
+{
+    ini_context_t *ctx = (ini_context_t *)user;
+    ini_status_t err = materialize_image(ctx);
+    return err == INI_STATUS_SUCCESS ? apply_change(ctx, section, key, value, NULL) : err;
+}
 
-                        if (need_quotes)
-                        {
-                            fprintf(temp_file, "%s=\"%s\"\n", key, value);
-                        }
-                        else
-                        {
-                            fprintf(temp_file, "%s=%s\n", key, value);
-                        }
-                        continue;
-                    }
+/**
+ * @brief Replays the journal of `filepath` over a context just loaded from it.
+ *
+ * Does nothing without `INI_LOAD_JOURNAL`. The replayed changes are not
+ * marked dirty: they are on disk already.
+ */
+static ini_status_t replay_journal(ini_context_t *ctx, char const *filepath)
+{
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
 
-                    // Restore the equals sign for other keys
-                    *eq = '=';
-                }
-            }
+    ini_status_t err = INI_STATUS_SUCCESS;
+    if (ctx->load_flags & INI_LOAD_JOURNAL)
+    {
+        char *path = journal_path(filepath);
+        err = path ? ini_journal_replay(path, replay_record, ctx, NULL) : INI_STATUS_MEMORY_ERROR;
+        free(path);
+    }
 
-            // Write unmodified line
-            fprintf(temp_file, "%s", line);
-        }
+    ini_mutex_unlock(&ctx->mutex);
+    return err;
+}
 
-        fclose(existing_file);
+/// @brief Receives the records of `replay_journal_into()`.
+typedef struct
+{
+    ini_ht_t *sections; ///< Tables the records are applied to.
+    ini_ht_t *touched;  ///< Keys the records set or removed (section → key set).
+} table_replay_t;
 
-        // If section wasn't found in file, append it
-        if (!target_section_written)
+static ini_status_t replay_table_record(void *user, char const *section, char const *key, char const *value)
+{
+    table_replay_t *replay = (table_replay_t *)user;
+    ini_ht_t *section_ht = ini_get_section_ht(replay->sections, section);
+    if (!section_ht && value)
+    {
+        section_ht = ini_ht_create();
+        if (!section_ht)
+            return INI_STATUS_MEMORY_ERROR;
+        ini_status_t err = store_section_ht(replay->sections, section, section_ht, INI_HT_BORROW_NONE);
+        if (err != INI_STATUS_SUCCESS)
         {
-            // Add newline before section if needed
-            if (ftell(temp_file) > 0)
-            {
-                fprintf(temp_file, "\n");
-            }
-
-            // Write section header
-            fprintf(temp_file, "[%s]\n", section);
-
-            // Write keys
-            if (key)
-            {
-                // Write specific key
-                char const *value = ini_ht_get(section_ht, key);
-                int need_quotes = 0;
-                if (strchr(value, ' ') || strchr(value, '\t') ||
-                    strchr(value, ';') || strchr(value, '#'))
-                {
-                    need_quotes = 1;
-                }
+            ini_ht_destroy(section_ht);
+            return err;
+        }
+    }
 
-                if (need_quotes)
-                {
-                    fprintf(temp_file, "%s=\"%s\"\n", key, value);
-                }
-                else
-                {
-                    fprintf(temp_file, "%s=%s\n", key, value);
-                }
-            }
-            else
-            {
-                // Write all keys
-                ini_ht_iterator_t it = ini_ht_iterator(section_ht);
-                char *k, *v;
+    if (value && !ini_ht_set(section_ht, key, value))
+        return INI_STATUS_MEMORY_ERROR;
+    if (!value && section_ht && ini_ht_get(section_ht, key))
+        ini_ht_remove(section_ht, key);
+    return add_to_key_sets(&replay->touched, section, key);
+}
 
-                while (ini_ht_next(&it, &k, &v) == INI_STATUS_SUCCESS)
-                {
-                    int need_quotes = 0;
-                    if (strchr(v, ' ') || strchr(v, '\t') ||
-                        strchr(v, ';') || strchr(v, '#'))
-                    {
-                        need_quotes = 1;
-                    }
+/**
+ * @brief Replays the journal of `filepath` over tables parsed from it.
+ *
+ * Used by reloads, which parse into scratch tables before they touch the
+ * context. `*touched` receives the keys the records set or removed (caller
+ * frees it with `destroy_sections()`, also on failure).
+ */
+static ini_status_t replay_journal_into(ini_ht_t *sections, char const *filepath, ini_ht_t **touched)
+{
+    table_replay_t replay = {sections, NULL};
+    char *path = journal_path(filepath);
+    ini_status_t err = path ? ini_journal_replay(path, replay_table_record, &replay, NULL) : INI_STATUS_MEMORY_ERROR;
+    free(path);
+    *touched = replay.touched;
+    return err;
+}
 
-                    if (need_quotes)
-                    {
-                        fprintf(temp_file, "%s=\"%s\"\n", k, v);
-                    }
-                    else
-                    {
-                        fprintf(temp_file, "%s=%s\n", k, v);
-                    }
-                }
-            }
-        }
-    }
-    else
+/**
+ * @brief Folds the journal into its INI file, then drops the records it contains.
+ *
+ * The file is rendered as `ini_save()` would write it, so a context loaded
+ * with `INI_LOAD_PRESERVE_FORMAT` keeps its layout and adopts the written
+ * text as its preserved copy. Only the rendering holds the context lock; the
+ * file is written without it. Records appended meanwhile lie past `end` and
+ * are kept.
+ */
+static ini_status_t compact_journal(ini_context_t *ctx)
+{
+    if (ini_mutex_lock(&ctx->compact_mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
     {
-        // File doesn't exist, create it with just this section
-        fprintf(temp_file, "[%s]\n", section);
-
-        // Write keys
-        if (key)
-        {
-            // Write specific key
-            char const *value = ini_ht_get(section_ht, key);
-            int need_quotes = 0;
-            if (strchr(value, ' ') || strchr(value, '\t') ||
-                strchr(value, ';') || strchr(value, '#'))
-            {
-                need_quotes = 1;
-            }
+        ini_mutex_unlock(&ctx->compact_mutex);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
 
-            if (need_quotes)
-            {
-                fprintf(temp_file, "%s=\"%s\"\n", key, value);
-            }
-            else
-            {
-                fprintf(temp_file, "%s=%s\n", key, value);
-            }
-        }
+    char *text = NULL;
+    size_t size = 0;
+    char *base = NULL;
+    ini_status_t err = ctx->journal ? render_context(ctx, &text, &size) : INI_STATUS_INVALID_ARGUMENT;
+    if (err == INI_STATUS_SUCCESS && !(base = ini_strdup(ctx->journal_base)))
+        err = INI_STATUS_MEMORY_ERROR;
+    int preserved = ctx->document != NULL;
+    unsigned version = ctx->document_version; // A load or save while the file is written replaces the text
+    uint64_t end = ini_journal_size(ctx->journal);
+    ini_mutex_unlock(&ctx->mutex);
+
+    // The new file must be on the device before the records it replaces go away
+    if (err == INI_STATUS_SUCCESS)
+        err = ini_write_file_atomic_ex(base, text, size, INI_DURABILITY_DIRECTORY);
+
+    // ini_set_journal() waits for compact_mutex, so this is still the same journal
+    if (err == INI_STATUS_SUCCESS)
+    {
+        if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+            err = INI_STATUS_PLATFORM_ERROR;
         else
         {
-            // Write all keys
-            ini_ht_iterator_t it = ini_ht_iterator(section_ht);
-            char *k, *v;
-
-            while (ini_ht_next(&it, &k, &v) == INI_STATUS_SUCCESS)
+            // Edits stay recorded: changes made since the rendering are not in `text`,
+            // and rewriting a line that already holds its value changes nothing
+            if (preserved && ctx->document_version == version)
             {
-                int need_quotes = 0;
-                if (strchr(v, ' ') || strchr(v, '\t') ||
-                    strchr(v, ';') || strchr(v, '#'))
-                {
-                    need_quotes = 1;
-                }
-
-                if (need_quotes)
-                {
-                    fprintf(temp_file, "%s=\"%s\"\n", k, v);
-                }
-                else
-                {
-                    fprintf(temp_file, "%s=%s\n", k, v);
-                }
+                free(ctx->document);
+                ctx->document = text;
+                ctx->document_size = size;
+                ctx->document_version++;
+                text = NULL;
             }
+            err = ini_journal_drop(ctx->journal, end);
+            ini_mutex_unlock(&ctx->mutex);
         }
     }
 
-    // Close temporary file and flush to disk
-    fflush(temp_file);
+    ini_mutex_unlock(&ctx->compact_mutex);
+    free(text);
+    free(base);
+    return err;
+}
 
-#if INI_OS_WINDOWS
-    fclose(temp_file);
+static void compact_worker(void *arg)
+{
+    ini_context_t *ctx = (ini_context_t *)arg;
+    // A failed compaction is retried when the next change finds the journal still too large
+    compact_journal(ctx);
 
-    // Remove existing file and rename temp file
-    if (file_exists && remove(filepath) != 0)
+    if (ini_mutex_lock(&ctx->mutex) == INI_STATUS_SUCCESS)
     {
-        remove(temp_path);
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_FILE_OPEN_FAILED;
+        ctx->compactor_state = 2;
+        ini_mutex_unlock(&ctx->mutex);
     }
+}
 
-    if (rename(temp_path, filepath) != 0)
+// Starts a background compaction unless one is running; the caller holds the lock
+static void start_compaction(ini_context_t *ctx)
+{
+    if (ctx->compactor_state == 1)
+        return;
+    // The last worker has released the lock for good, so it can be joined here
+    if (ctx->compactor_state == 2)
     {
-        remove(temp_path);
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_FILE_OPEN_FAILED;
+        ini_thread_join(&ctx->compactor);
+        ctx->compactor_state = 0;
     }
-#else
-    // On Unix, rewind the temp file and copy to real file
-    rewind(temp_file);
+    if (ini_thread_create(&ctx->compactor, compact_worker, ctx) == INI_STATUS_SUCCESS)
+        ctx->compactor_state = 1;
+}
+
+// Records changes in the journal, if there is one; the caller holds the lock
+static ini_status_t journal_changes(ini_context_t *ctx, ini_journal_entry_t const *entries, size_t count)
+{
+    if (!ctx->journal)
+        return INI_STATUS_SUCCESS;
+
+    ini_status_t err = ini_journal_append(ctx->journal, entries, count);
+    if (err == INI_STATUS_SUCCESS && ctx->journal_threshold > 0 &&
+        ini_journal_size(ctx->journal) >= ctx->journal_threshold)
+        start_compaction(ctx);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_set_journal(ini_context_t *ctx, char const *filepath,
+                                            ini_journal_options_t const *options)
+{
+    if (!ctx || (filepath && strlen(filepath) == 0))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_journal_options_t const defaults = {INI_JOURNAL_COMPACT_THRESHOLD, INI_JOURNAL_SYNC_INTERVAL};
+    if (!options)
+        options = &defaults;
 
-    FILE *dest_file = ini_fopen(filepath, "w");
-    if (!dest_file)
+    ini_journal_t *journal = NULL;
+    char *base = NULL;
+    if (filepath)
     {
-        fclose(temp_file);
-        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
-        return INI_STATUS_FILE_OPEN_FAILED;
+        char *path = journal_path(filepath);
+        base = ini_strdup(filepath);
+        ini_status_t err = path && base ? ini_journal_open(path, options->sync_interval, &journal)
+                                        : INI_STATUS_MEMORY_ERROR;
+        free(path);
+        if (err != INI_STATUS_SUCCESS)
+        {
+            free(base);
+            return err;
+        }
     }
 
-    char buffer[INI_LINE_MAX];
-    while (fgets(buffer, sizeof(buffer), temp_file))
+    // A running compaction finishes with the journal it started on
+    if (ini_mutex_lock(&ctx->compact_mutex) != INI_STATUS_SUCCESS)
+    {
+        ini_journal_close(journal);
+        free(base);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
     {
-        fputs(buffer, dest_file);
+        ini_mutex_unlock(&ctx->compact_mutex);
+        ini_journal_close(journal);
+        free(base);
+        return INI_STATUS_PLATFORM_ERROR;
     }
 
-    fclose(temp_file);
-    fclose(dest_file);
-#endif
+    ini_journal_t *old_journal = ctx->journal;
+    char *old_base = ctx->journal_base;
+    ctx->journal = journal;
+    ctx->journal_base = base;
+    ctx->journal_threshold = journal ? options->compact_threshold : 0;
+    if (journal)
+        ctx->load_flags |= INI_LOAD_JOURNAL;
+    else
+        ctx->load_flags &= ~(unsigned)INI_LOAD_JOURNAL;
 
-    ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+    ini_mutex_unlock(&ctx->mutex);
+    ini_mutex_unlock(&ctx->compact_mutex);
+
+    ini_journal_close(old_journal);
+    free(old_base);
     return INI_STATUS_SUCCESS;
 }
 
+INI_PUBLIC_API ini_status_t ini_sync_journal(ini_context_t *ctx)
+{
+    if (!ctx)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (ini_mutex_lock(&ctx->mutex) != INI_STATUS_SUCCESS)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    ini_status_t err = ctx->journal ? ini_journal_sync(ctx->journal) : INI_STATUS_INVALID_ARGUMENT;
+
+    ini_mutex_unlock(&ctx->mutex);
+    return err;
+}
+
+INI_PUBLIC_API ini_status_t ini_compact_journal(ini_context_t *ctx)
+{
+    if (!ctx)
+        return INI_STATUS_INVALID_ARGUMENT;
+    return compact_journal(ctx);
+}
+
 INI_PUBLIC_API ini_status_t ini_print(FILE *stream, ini_context_t const *ctx)
 {
     if (!stream || !ctx)
@@ -951,6 +4188,13 @@ INI_PUBLIC_API ini_status_t ini_print(FILE *stream, ini_context_t const *ctx)
     if (ini_mutex_lock((ini_mutex_t *)&ctx->mutex) != 0)
         return INI_STATUS_PLATFORM_ERROR;
 
+    ini_status_t err = materialize_all((ini_context_t *)ctx);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        ini_mutex_unlock((ini_mutex_t *)&ctx->mutex);
+        return err;
+    }
+
     // Iterate through all sections
     ini_ht_iterator_t sections_it = ini_ht_iterator((ini_ht_t *)ctx->sections);
     char *section_name;
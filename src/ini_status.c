@@ -41,6 +41,10 @@ INI_PUBLIC_API char const *ini_status_to_string(ini_status_t status)
         return "Mutex already initialized";
     case INI_STATUS_ITERATOR_END:
         return "Iterator has reached the end of the table";
+    case INI_STATUS_TYPE_MISMATCH:
+        return "Value cannot be read as the requested type";
+    case INI_STATUS_FILE_CHANGED:
+        return "File changed since it was read";
     case INI_STATUS_UNKNOWN_ERROR:
         return "Unknown error";
     default:
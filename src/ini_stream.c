@@ -0,0 +1,280 @@
+#define INI_IMPLEMENTATION
+#include "ini_stream.h"
+#include "ini_string.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Tokenizer state shared by the stream and buffer front ends.
+typedef struct
+{
+    ini_handler_t const *handler;
+    void *user;
+    char const *section;  ///< Current section name (points into `section_copy` for streams).
+    size_t section_len;   ///< Length of the current section name.
+    int in_section;       ///< Non-zero once a section header was seen.
+    int copy_section;     ///< Copy section names because the read buffer is reused.
+    int skip_section;     ///< Discard lines until the next section header.
+    unsigned line;        ///< Number of the line being parsed (1-based).
+    ini_status_t status;  ///< First error encountered.
+    char section_copy[INI_LINE_MAX];
+} ini_tokenizer_t;
+
+static ini_parse_action_t report_error(ini_tokenizer_t *tok, ini_status_t status)
+{
+    if (tok->status == INI_STATUS_SUCCESS)
+        tok->status = status;
+    if (tok->handler && tok->handler->on_error)
+        return tok->handler->on_error(tok->user, status, tok->line);
+    return INI_PARSE_STOP;
+}
+
+/**
+ * @brief Classifies one line (without its '\n') and reports it to the handler.
+ *
+ * These are the rules `ini_good()` enforces: sections need a closing bracket,
+ * keys must be non-empty and belong to a section, and quoted values must
+ * close before the end of the line or a comment. Commas are plain text here;
+ * `ini_get_array()` gives them meaning.
+ */
+static ini_parse_action_t parse_line(ini_tokenizer_t *tok, char const *line, char const *line_end)
+{
+    ini_handler_t const *handler = tok->handler;
+    tok->line++;
+
+    // While skipping, only a line opening a section is looked at
+    if (tok->skip_section)
+    {
+        while (line < line_end && (*line == ' ' || *line == '\t'))
+            line++;
+        if (line == line_end || *line != '[')
+            return INI_PARSE_CONTINUE;
+        tok->skip_section = 0;
+    }
+
+    // Same limit as a line read with fgets() into an INI_LINE_MAX buffer
+    if (line_end - line >= INI_LINE_MAX - 1)
+        return report_error(tok, INI_STATUS_FILE_BAD_FORMAT);
+
+    if (line_end > line && line_end[-1] == '\r')
+        line_end--;
+
+    // Trim leading whitespace
+    char const *trimmed = line;
+    while (trimmed < line_end && (*trimmed == ' ' || *trimmed == '\t'))
+        trimmed++;
+
+    // Skip empty lines, report comments
+    if (trimmed == line_end)
+        return INI_PARSE_CONTINUE;
+
+    if (*trimmed == ';' || *trimmed == '#')
+    {
+        if (handler && handler->on_comment)
+            return handler->on_comment(tok->user, trimmed + 1, (size_t)(line_end - trimmed - 1), tok->line);
+        return INI_PARSE_CONTINUE;
+    }
+
+    // Handle section header
+    if (*trimmed == '[')
+    {
+        char const *close = (char const *)memchr(trimmed, ']', (size_t)(line_end - trimmed));
+        if (!close)
+            return report_error(tok, INI_STATUS_FILE_BAD_FORMAT);
+
+        char const *name = trimmed + 1;
+        size_t name_len = (size_t)(close - name);
+        if (tok->copy_section)
+        {
+            memcpy(tok->section_copy, name, name_len);
+            tok->section_copy[name_len] = '\0';
+            name = tok->section_copy;
+        }
+        tok->section = name;
+        tok->section_len = name_len;
+        tok->in_section = 1;
+
+        if (handler && handler->on_section)
+            return handler->on_section(tok->user, name, name_len, tok->line);
+        return INI_PARSE_CONTINUE;
+    }
+
+    // Keys must belong to a section
+    if (!tok->in_section)
+        return report_error(tok, INI_STATUS_FILE_BAD_FORMAT);
+
+    char const *eq = (char const *)memchr(trimmed, '=', (size_t)(line_end - trimmed));
+    if (!eq || eq == trimmed)
+        return report_error(tok, INI_STATUS_FILE_BAD_FORMAT);
+
+    char const *value = eq + 1;
+    while (value < line_end && (*value == ' ' || *value == '\t'))
+        value++;
+
+    if (value < line_end && *value == '"')
+    {
+        char const *end_quote = (char const *)memchr(value + 1, '"', (size_t)(line_end - value - 1));
+        if (!end_quote || (end_quote + 1 != line_end && end_quote[1] != ';' && end_quote[1] != '#'))
+            return report_error(tok, INI_STATUS_FILE_BAD_FORMAT);
+    }
+
+    if (!handler || !handler->on_key_value)
+        return INI_PARSE_CONTINUE;
+
+    // Trim key
+    char const *key_end = eq;
+    while (key_end > trimmed && (key_end[-1] == ' ' || key_end[-1] == '\t'))
+        key_end--;
+
+    // Trim value
+    char const *value_end = line_end;
+    while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t'))
+        value_end--;
+
+    // Handle quoted values
+    if (value_end - value >= 2 && *value == '"' && value_end[-1] == '"')
+    {
+        value++;
+        value_end--;
+    }
+
+    return handler->on_key_value(tok->user, tok->section, tok->section_len,
+                                 trimmed, (size_t)(key_end - trimmed),
+                                 value, (size_t)(value_end - value), tok->line);
+}
+
+// Parses one line and turns a skip request into tokenizer state
+static ini_parse_action_t tokenize_line(ini_tokenizer_t *tok, char const *line, char const *line_end)
+{
+    ini_parse_action_t action = parse_line(tok, line, line_end);
+    if (action == INI_PARSE_SKIP_SECTION)
+    {
+        tok->skip_section = 1;
+        action = INI_PARSE_CONTINUE;
+    }
+    return action;
+}
+
+static void tokenizer_init(ini_tokenizer_t *tok, ini_handler_t const *handler, void *user, int copy_section)
+{
+    tok->handler = handler;
+    tok->user = user;
+    tok->section = NULL;
+    tok->section_len = 0;
+    tok->in_section = 0;
+    tok->copy_section = copy_section;
+    tok->skip_section = 0;
+    tok->line = 0;
+    tok->status = INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_parse_buffer(char const *data, size_t size, ini_handler_t const *handler, void *user)
+{
+    if (!data && size > 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_tokenizer_t tok;
+    tokenizer_init(&tok, handler, user, 0);
+
+    char const *end = data + size;
+    char const *line = data + ini_utf8_bom_length(data, size);
+
+    while (line < end)
+    {
+        char const *newline = (char const *)memchr(line, '\n', (size_t)(end - line));
+        char const *line_end = newline ? newline : end;
+        char const *next_line = newline ? newline + 1 : end;
+
+        // The next line start is computed first: handlers may write over the '\n'
+        if (tokenize_line(&tok, line, line_end) == INI_PARSE_STOP)
+            break;
+        line = next_line;
+    }
+
+    return tok.status;
+}
+
+INI_PUBLIC_API ini_status_t ini_parse_stream(FILE *source, ini_handler_t const *handler, void *user)
+{
+    if (!source)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    char *buffer = (char *)malloc(INI_STREAM_BUFFER_SIZE);
+    if (!buffer)
+        return INI_STATUS_MEMORY_ERROR;
+
+    ini_tokenizer_t tok;
+    tokenizer_init(&tok, handler, user, 1);
+
+    size_t length = 0;
+    int first_block = 1;
+    int eof = 0;
+    int skipping = 0; // Discarding the tail of a line longer than the buffer
+
+    while (!eof)
+    {
+        size_t requested = INI_STREAM_BUFFER_SIZE - length;
+        size_t received = fread(buffer + length, 1, requested, source);
+        length += received;
+        if (received < requested)
+        {
+            eof = 1;
+            if (ferror(source))
+            {
+                tok.status = INI_STATUS_FILE_OPEN_FAILED;
+                break;
+            }
+        }
+
+        char const *line = buffer;
+        char const *end = buffer + length;
+        if (first_block)
+        {
+            line += ini_utf8_bom_length(buffer, length);
+            first_block = 0;
+        }
+
+        ini_parse_action_t action = INI_PARSE_CONTINUE;
+        char const *newline;
+        while (action == INI_PARSE_CONTINUE &&
+               (newline = (char const *)memchr(line, '\n', (size_t)(end - line))) != NULL)
+        {
+            if (skipping)
+                skipping = 0;
+            else
+                action = tokenize_line(&tok, line, newline);
+            line = newline + 1;
+        }
+
+        if (action == INI_PARSE_STOP)
+            break;
+
+        if (eof)
+        {
+            // Last line without a trailing newline
+            if (line < end && !skipping)
+                tokenize_line(&tok, line, end);
+            break;
+        }
+
+        size_t remaining = (size_t)(end - line);
+        if (remaining == INI_STREAM_BUFFER_SIZE)
+        {
+            // No newline in a full buffer: report the line once and drop it
+            if (!skipping)
+            {
+                tok.line++;
+                if (!tok.skip_section && report_error(&tok, INI_STATUS_FILE_BAD_FORMAT) == INI_PARSE_STOP)
+                    break;
+            }
+            skipping = 1;
+            remaining = 0;
+        }
+
+        memmove(buffer, line, remaining);
+        length = remaining;
+    }
+
+    free(buffer);
+    return tok.status;
+}
@@ -1,8 +1,10 @@
 #define INI_IMPLEMENTATION
 #include "ini_string.h"
+#include "ini_constants.h"
 
 #include <ctype.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -43,3 +45,57 @@ INI_PUBLIC_API unsigned ini_strstrip(char *s)
     memmove(dest, s, last - s + 1);
     return last - s;
 }
+
+/// @brief Non-zero in the high bit of every byte of `word` that equals `byte`.
+static uint64_t match_byte(uint64_t word, unsigned char byte)
+{
+    uint64_t const ones = 0x0101010101010101u;
+    uint64_t x = word ^ (ones * byte);
+    return (x - ones) & ~x & (ones << 7);
+}
+
+INI_PUBLIC_API int ini_needs_quotes(char const *value, size_t length)
+{
+    if (!value)
+        return 0;
+
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, value + i, sizeof(word)); // Unaligned-safe load
+        if (match_byte(word, ' ') | match_byte(word, '\t') | match_byte(word, ';') | match_byte(word, '#'))
+            return 1;
+    }
+    for (; i < length; i++)
+    {
+        char c = value[i];
+        if (c == ' ' || c == '\t' || c == ';' || c == '#')
+            return 1;
+    }
+    return 0;
+}
+
+INI_PUBLIC_API int ini_value_writable(char const *value, size_t length)
+{
+    if (length > 0 && value[0] == '"')
+        return 0;
+    if (memchr(value, '\n', length) || memchr(value, '\r', length))
+        return 0;
+    return !memchr(value, '"', length) || !ini_needs_quotes(value, length);
+}
+
+INI_PUBLIC_API int ini_compare_strings(void const *lhs, void const *rhs)
+{
+    return strcmp(*(char *const *)lhs, *(char *const *)rhs);
+}
+
+INI_PUBLIC_API size_t ini_utf8_bom_length(char const *data, size_t size)
+{
+    if (size >= INI_UTF8_BOM_SIZE &&
+        (unsigned char)data[0] == INI_UTF8_BOM_VALUE_0 &&
+        (unsigned char)data[1] == INI_UTF8_BOM_VALUE_1 &&
+        (unsigned char)data[2] == INI_UTF8_BOM_VALUE_2)
+        return INI_UTF8_BOM_SIZE;
+    return 0;
+}
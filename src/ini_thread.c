@@ -0,0 +1,115 @@
+#define INI_IMPLEMENTATION
+#include "ini_thread.h"
+
+#include <stdlib.h>
+
+#if !INI_OS_WINDOWS
+#include <time.h>
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+    ini_thread_func_t func;
+    void *arg;
+} ini_thread_start_t;
+
+#if INI_OS_WINDOWS
+static DWORD WINAPI thread_trampoline(LPVOID param)
+#else
+static void *thread_trampoline(void *param)
+#endif
+{
+    ini_thread_start_t start = *(ini_thread_start_t *)param;
+    free(param);
+    start.func(start.arg);
+#if INI_OS_WINDOWS
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+INI_PUBLIC_API ini_status_t ini_thread_create(ini_thread_t *thread, ini_thread_func_t func, void *arg)
+{
+    if (!thread || !func)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_thread_start_t *start = (ini_thread_start_t *)malloc(sizeof(ini_thread_start_t));
+    if (!start)
+        return INI_STATUS_MEMORY_ERROR;
+
+    start->func = func;
+    start->arg = arg;
+
+#if INI_OS_WINDOWS
+    thread->base = CreateThread(NULL, 0, thread_trampoline, start, 0, NULL);
+    if (!thread->base)
+    {
+        free(start);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+#else
+    if (pthread_create(&thread->base, NULL, thread_trampoline, start) != 0)
+    {
+        free(start);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+#endif
+
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_thread_join(ini_thread_t *thread)
+{
+    if (!thread)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+#if INI_OS_WINDOWS
+    if (WaitForSingleObject(thread->base, INFINITE) != WAIT_OBJECT_0)
+        return INI_STATUS_PLATFORM_ERROR;
+    CloseHandle(thread->base);
+#else
+    if (pthread_join(thread->base, NULL) != 0)
+        return INI_STATUS_PLATFORM_ERROR;
+#endif
+
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API int ini_thread_is_current(ini_thread_t const *thread)
+{
+    if (!thread)
+        return 0;
+
+#if INI_OS_WINDOWS
+    return GetThreadId(thread->base) == GetCurrentThreadId();
+#else
+    return pthread_equal(thread->base, pthread_self()) != 0;
+#endif
+}
+
+INI_PUBLIC_API void ini_thread_sleep(unsigned milliseconds)
+{
+#if INI_OS_WINDOWS
+    Sleep(milliseconds);
+#else
+    struct timespec delay;
+    delay.tv_sec = (time_t)(milliseconds / 1000);
+    delay.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+    while (nanosleep(&delay, &delay) != 0)
+        ; // Resume after signals
+#endif
+}
+
+INI_PUBLIC_API unsigned ini_thread_hardware_concurrency(void)
+{
+#if INI_OS_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned)count : 1;
+#endif
+}
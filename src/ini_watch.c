@@ -0,0 +1,493 @@
+#define INI_IMPLEMENTATION
+#include "ini_watch.h"
+#include "ini_filesystem.h"
+#include "ini_string.h"
+#include "ini_thread.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !INI_OS_WINDOWS
+#include <time.h>
+#endif
+
+#if INI_OS_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define INI_WATCH_EVENT_MASK (IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)
+#endif
+
+/// @brief One watched (context, file) pair.
+typedef struct ini_watch_entry_s
+{
+    struct ini_watch_entry_s *next;
+    ini_context_t *ctx;
+    char *filepath;
+    char const *name;                ///< Base name inside `filepath`, matched against inotify events.
+    ini_watch_callback_t callback;
+    void *user;
+#if !INI_OS_LINUX
+    ini_file_fingerprint_t observed; ///< File state at the last poll.
+#endif
+    uint64_t deadline_ms;            ///< When a pending reload is due.
+    int pending;                     ///< A change event arrived and the reload is not done yet.
+    int busy;                        ///< The watcher thread is reloading this entry right now.
+    int removed;                     ///< `ini_unwatch()` was called; the entry is never reloaded again.
+    int orphaned;                    ///< Unwatched from its own callback; the watcher thread frees it.
+#if INI_OS_LINUX
+    int wd;                          ///< inotify watch on the parent directory.
+#endif
+} ini_watch_entry_t;
+
+/// @brief State of the shared watcher thread, guarded by `registry_mutex`.
+static struct
+{
+    ini_watch_entry_t *entries;
+    ini_thread_t thread;
+    int running; ///< The thread was started and not joined yet.
+    int stop;    ///< Asks the thread to exit.
+#if INI_OS_LINUX
+    int inotify_fd;
+    int wake_fd[2]; ///< Pipe that interrupts poll() when entries change or the thread must stop.
+#endif
+} watcher;
+
+static ini_mutex_t registry_mutex;
+static ini_cond_t registry_changed; ///< Broadcast when an entry stops being busy or the watcher has stopped.
+
+#if INI_OS_WINDOWS
+static INIT_ONCE registry_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK init_registry(PINIT_ONCE once, PVOID param, PVOID *context)
+{
+    (void)once;
+    (void)param;
+    (void)context;
+    return ini_mutex_init(&registry_mutex) == INI_STATUS_SUCCESS &&
+           ini_cond_init(&registry_changed) == INI_STATUS_SUCCESS;
+}
+
+static int lock_registry(void)
+{
+    if (!InitOnceExecuteOnce(&registry_once, init_registry, NULL, NULL))
+        return 0;
+    return ini_mutex_lock(&registry_mutex) == INI_STATUS_SUCCESS;
+}
+#else
+static pthread_once_t registry_once = PTHREAD_ONCE_INIT;
+
+static void init_registry(void)
+{
+    ini_mutex_init(&registry_mutex);
+    ini_cond_init(&registry_changed);
+}
+
+static int lock_registry(void)
+{
+    if (pthread_once(&registry_once, init_registry) != 0)
+        return 0;
+    return ini_mutex_lock(&registry_mutex) == INI_STATUS_SUCCESS;
+}
+#endif
+
+static void unlock_registry(void)
+{
+    ini_mutex_unlock(&registry_mutex);
+}
+
+static uint64_t now_ms(void)
+{
+#if INI_OS_WINDOWS
+    return (uint64_t)GetTickCount64();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000u + (uint64_t)(now.tv_nsec / 1000000);
+#endif
+}
+
+static ini_watch_entry_t *find_entry(ini_context_t const *ctx, char const *filepath)
+{
+    for (ini_watch_entry_t *entry = watcher.entries; entry; entry = entry->next)
+    {
+        if (entry->ctx == ctx && !entry->removed && strcmp(entry->filepath, filepath) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+// Unlinks and frees `entry`, dropping its directory watch if no other entry shares it
+static void release_entry(ini_watch_entry_t *entry)
+{
+    ini_watch_entry_t **link = &watcher.entries;
+    while (*link && *link != entry)
+        link = &(*link)->next;
+    if (*link)
+        *link = entry->next;
+
+#if INI_OS_LINUX
+    int shared = 0;
+    for (ini_watch_entry_t *other = watcher.entries; other; other = other->next)
+        shared |= other->wd == entry->wd;
+    if (!shared && entry->wd >= 0)
+        inotify_rm_watch(watcher.inotify_fd, entry->wd);
+#endif
+
+    free(entry->filepath);
+    free(entry);
+}
+
+static void wake_watcher(void)
+{
+#if INI_OS_LINUX
+    char byte = 1;
+    ssize_t written = write(watcher.wake_fd[1], &byte, 1);
+    (void)written; // A full pipe already guarantees a wake-up
+#endif
+}
+
+// Schedules a reload of `entry`; called with the registry locked
+static void mark_pending(ini_watch_entry_t *entry, uint64_t now)
+{
+    // A busy entry is marked too: the change may have raced the running reload
+    if (entry->removed)
+        return;
+    entry->pending = 1;
+    entry->deadline_ms = now + INI_WATCH_DEBOUNCE_MS;
+}
+
+#if INI_OS_LINUX
+static void handle_events(char const *buffer, ssize_t length, uint64_t now)
+{
+    char const *cursor = buffer;
+    while (cursor < buffer + length)
+    {
+        struct inotify_event const *event = (struct inotify_event const *)cursor;
+        for (ini_watch_entry_t *entry = watcher.entries; entry; entry = entry->next)
+        {
+            // After a queue overflow every file may have changed
+            if ((event->mask & IN_Q_OVERFLOW) ||
+                (event->wd == entry->wd && event->len > 0 && strcmp(event->name, entry->name) == 0))
+                mark_pending(entry, now);
+        }
+        cursor += sizeof(struct inotify_event) + event->len;
+    }
+}
+#else
+static void poll_fingerprints(uint64_t now)
+{
+    for (ini_watch_entry_t *entry = watcher.entries; entry; entry = entry->next)
+    {
+        ini_file_fingerprint_t fingerprint;
+        if (ini_get_file_fingerprint(entry->filepath, &fingerprint) == INI_STATUS_SUCCESS &&
+            !ini_file_fingerprint_equal(&fingerprint, &entry->observed))
+        {
+            entry->observed = fingerprint;
+            mark_pending(entry, now);
+        }
+    }
+}
+#endif
+
+// Milliseconds until the earliest pending reload, or -1 if none is pending
+static int next_timeout(uint64_t now)
+{
+    int timeout = -1;
+    for (ini_watch_entry_t *entry = watcher.entries; entry; entry = entry->next)
+    {
+        if (!entry->pending)
+            continue;
+        int remaining = entry->deadline_ms > now ? (int)(entry->deadline_ms - now) : 0;
+        if (timeout < 0 || remaining < timeout)
+            timeout = remaining;
+    }
+    return timeout;
+}
+
+/**
+ * @brief Reloads every entry whose debounce period elapsed.
+ *
+ * Called with the registry locked; the lock is released around `ini_load()`
+ * and the callback, so the list is rescanned after each reload.
+ */
+static void dispatch_due(void)
+{
+    int rescan = 1;
+    while (rescan)
+    {
+        rescan = 0;
+        uint64_t now = now_ms();
+
+        for (ini_watch_entry_t *entry = watcher.entries; entry; entry = entry->next)
+        {
+            if (entry->orphaned)
+            {
+                release_entry(entry);
+                rescan = 1;
+                break;
+            }
+            if (!entry->pending || entry->deadline_ms > now)
+                continue;
+
+            entry->pending = 0;
+            entry->busy = 1;
+            unlock_registry();
+
+            // Only a real change is reported; a vanished file is waiting for its replacement
+            int reloaded = 0;
+            ini_status_t status = ini_reload_if_changed(entry->ctx, entry->filepath, &reloaded);
+            if (entry->callback && (reloaded || (status != INI_STATUS_SUCCESS && status != INI_STATUS_FILE_NOT_FOUND)))
+                entry->callback(entry->ctx, entry->filepath, status, entry->user);
+
+            lock_registry();
+            entry->busy = 0;
+            ini_cond_broadcast(&registry_changed);
+            rescan = 1;
+            break;
+        }
+    }
+}
+
+static void watcher_main(void *arg)
+{
+    (void)arg;
+
+#if INI_OS_LINUX
+    union
+    {
+        struct inotify_event event; // Aligns the buffer for the records
+        char bytes[4096];
+    } events;
+#endif
+
+    lock_registry();
+    while (!watcher.stop)
+    {
+        int timeout = next_timeout(now_ms());
+#if INI_OS_LINUX
+        struct pollfd fds[2];
+        fds[0].fd = watcher.inotify_fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = watcher.wake_fd[0];
+        fds[1].events = POLLIN;
+        unlock_registry();
+
+        // Sleeps until an event arrives when nothing is pending
+        int ready = poll(fds, 2, timeout);
+        ssize_t length = 0;
+        if (ready > 0 && (fds[0].revents & POLLIN))
+            length = read(watcher.inotify_fd, events.bytes, sizeof(events.bytes));
+        if (ready > 0 && (fds[1].revents & POLLIN))
+        {
+            char drain[64];
+            while (read(watcher.wake_fd[0], drain, sizeof(drain)) > 0)
+                ;
+        }
+
+        lock_registry();
+        if (length > 0)
+            handle_events(events.bytes, length, now_ms());
+#else
+        unlock_registry();
+        ini_thread_sleep(timeout >= 0 && timeout < INI_WATCH_POLL_INTERVAL_MS ? (unsigned)timeout
+                                                                             : INI_WATCH_POLL_INTERVAL_MS);
+        lock_registry();
+        poll_fingerprints(now_ms());
+#endif
+        dispatch_due();
+    }
+    unlock_registry();
+}
+
+// Starts the watcher thread; called with the registry locked
+static ini_status_t start_watcher(void)
+{
+#if INI_OS_LINUX
+    watcher.inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher.inotify_fd < 0)
+        return INI_STATUS_PLATFORM_ERROR;
+
+    if (pipe(watcher.wake_fd) != 0)
+    {
+        close(watcher.inotify_fd);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        fcntl(watcher.wake_fd[i], F_SETFL, fcntl(watcher.wake_fd[i], F_GETFL) | O_NONBLOCK);
+        fcntl(watcher.wake_fd[i], F_SETFD, FD_CLOEXEC);
+    }
+#endif
+
+    watcher.stop = 0;
+    if (ini_thread_create(&watcher.thread, watcher_main, NULL) != INI_STATUS_SUCCESS)
+    {
+#if INI_OS_LINUX
+        close(watcher.inotify_fd);
+        close(watcher.wake_fd[0]);
+        close(watcher.wake_fd[1]);
+#endif
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+
+    watcher.running = 1;
+    return INI_STATUS_SUCCESS;
+}
+
+// Stops and joins the watcher thread; called with the registry locked, which is released meanwhile
+static void stop_watcher(void)
+{
+    watcher.stop = 1;
+    wake_watcher();
+    unlock_registry();
+
+    ini_thread_join(&watcher.thread);
+
+    lock_registry();
+#if INI_OS_LINUX
+    close(watcher.inotify_fd);
+    close(watcher.wake_fd[0]);
+    close(watcher.wake_fd[1]);
+#endif
+    watcher.running = 0;
+    watcher.stop = 0;
+    ini_cond_broadcast(&registry_changed);
+}
+
+INI_PUBLIC_API ini_status_t ini_watch(ini_context_t *ctx, char const *filepath,
+                                      ini_watch_callback_t callback, void *user)
+{
+    if (!ctx || !filepath || strlen(filepath) == 0)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    ini_status_t err = ini_check_file_status(filepath);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    ini_watch_entry_t *entry = (ini_watch_entry_t *)calloc(1, sizeof(ini_watch_entry_t));
+    if (!entry)
+        return INI_STATUS_MEMORY_ERROR;
+
+    entry->filepath = ini_strdup(filepath);
+    if (!entry->filepath)
+    {
+        free(entry);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+
+    char const *slash = strrchr(entry->filepath, '/');
+#if INI_OS_WINDOWS
+    char const *backslash = strrchr(entry->filepath, '\\');
+    if (backslash > slash)
+        slash = backslash;
+#endif
+    entry->name = slash ? slash + 1 : entry->filepath;
+    entry->ctx = ctx;
+    entry->callback = callback;
+    entry->user = user;
+#if !INI_OS_LINUX
+    ini_get_file_fingerprint(filepath, &entry->observed);
+#endif
+
+    if (!lock_registry())
+    {
+        free(entry->filepath);
+        free(entry);
+        return INI_STATUS_PLATFORM_ERROR;
+    }
+
+    // Another thread may be shutting the watcher down right now
+    while (watcher.stop)
+        ini_cond_wait(&registry_changed, &registry_mutex);
+
+    err = find_entry(ctx, filepath) ? INI_STATUS_INVALID_ARGUMENT : INI_STATUS_SUCCESS;
+    if (err == INI_STATUS_SUCCESS && !watcher.running)
+        err = start_watcher();
+
+#if INI_OS_LINUX
+    if (err == INI_STATUS_SUCCESS)
+    {
+        // Watch the directory: editors often save by renaming a new file over the old one
+        char directory[INI_PATH_MAX];
+        size_t dir_len = (size_t)(entry->name - entry->filepath);
+        if (dir_len == 0)
+            strcpy(directory, ".");
+        else if (dir_len >= sizeof(directory))
+            err = INI_STATUS_INVALID_ARGUMENT;
+        else
+        {
+            memcpy(directory, entry->filepath, dir_len);
+            directory[dir_len > 1 ? dir_len - 1 : dir_len] = '\0';
+        }
+
+        if (err == INI_STATUS_SUCCESS)
+        {
+            entry->wd = inotify_add_watch(watcher.inotify_fd, directory, INI_WATCH_EVENT_MASK);
+            if (entry->wd < 0)
+                err = errno == EACCES ? INI_STATUS_FILE_PERMISSION_DENIED : INI_STATUS_PLATFORM_ERROR;
+        }
+    }
+#endif
+
+    if (err != INI_STATUS_SUCCESS)
+    {
+        int idle = watcher.running && !watcher.entries;
+        if (idle && !ini_thread_is_current(&watcher.thread))
+            stop_watcher();
+        unlock_registry();
+        free(entry->filepath);
+        free(entry);
+        return err;
+    }
+
+    entry->next = watcher.entries;
+    watcher.entries = entry;
+    wake_watcher();
+
+    unlock_registry();
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_unwatch(ini_context_t *ctx, char const *filepath)
+{
+    if (!ctx || !filepath)
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    if (!lock_registry())
+        return INI_STATUS_PLATFORM_ERROR;
+
+    ini_watch_entry_t *entry = find_entry(ctx, filepath);
+    if (!entry)
+    {
+        unlock_registry();
+        return INI_STATUS_INVALID_ARGUMENT;
+    }
+
+    entry->removed = 1;
+    entry->pending = 0;
+
+    // From inside the callback the watcher thread frees the entry once it returns
+    int on_watcher_thread = watcher.running && ini_thread_is_current(&watcher.thread);
+    if (on_watcher_thread && entry->busy)
+    {
+        entry->orphaned = 1;
+        unlock_registry();
+        return INI_STATUS_SUCCESS;
+    }
+
+    // Otherwise wait for a reload in progress so the callback never outlives this call
+    while (entry->busy)
+        ini_cond_wait(&registry_changed, &registry_mutex);
+    release_entry(entry);
+
+    if (!watcher.entries && watcher.running && !on_watcher_thread)
+        stop_watcher();
+
+    unlock_registry();
+    return INI_STATUS_SUCCESS;
+}
@@ -0,0 +1,160 @@
+#define INI_IMPLEMENTATION
+#include "ini_writer.h"
+#include "ini_string.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct ini_writer_s
+{
+    int fd;                      ///< Descriptor the text goes to.
+    ini_file_replace_t *replace; ///< Temporary file of a path writer, which owns `fd` (NULL otherwise).
+    char *buffer;                ///< Text not written yet.
+    size_t size;                 ///< Bytes used in `buffer`.
+    int started;                 ///< Non-zero once a section or key was written.
+    ini_status_t status;         ///< First error; later calls return it.
+};
+
+static ini_status_t create_writer(int fd, ini_writer_t **writer)
+{
+    ini_writer_t *result = (ini_writer_t *)calloc(1, sizeof(ini_writer_t));
+    if (!result)
+        return INI_STATUS_MEMORY_ERROR;
+    result->buffer = (char *)malloc(INI_WRITER_BUFFER_SIZE);
+    if (!result->buffer)
+    {
+        free(result);
+        return INI_STATUS_MEMORY_ERROR;
+    }
+    result->fd = fd;
+    result->status = INI_STATUS_SUCCESS;
+    *writer = result;
+    return INI_STATUS_SUCCESS;
+}
+
+static void flush_buffer(ini_writer_t *writer)
+{
+    if (writer->status == INI_STATUS_SUCCESS && writer->size > 0)
+        writer->status = ini_write_fd(writer->fd, writer->buffer, writer->size);
+    writer->size = 0;
+}
+
+// Buffers `length` bytes; a piece larger than the buffer is written straight through
+static void put(ini_writer_t *writer, char const *bytes, size_t length)
+{
+    if (writer->status != INI_STATUS_SUCCESS)
+        return;
+
+    if (length > INI_WRITER_BUFFER_SIZE - writer->size)
+    {
+        flush_buffer(writer);
+        if (length >= INI_WRITER_BUFFER_SIZE)
+        {
+            if (writer->status == INI_STATUS_SUCCESS)
+                writer->status = ini_write_fd(writer->fd, bytes, length);
+            return;
+        }
+    }
+    memcpy(writer->buffer + writer->size, bytes, length);
+    writer->size += length;
+}
+
+// Non-zero if `name` would not read back as it is: empty, blank at either end, a line break or one of `forbidden`
+static int bad_name(char const *name, char const *forbidden)
+{
+    size_t length = strlen(name);
+    return length == 0 || name[0] == ' ' || name[0] == '\t' || name[length - 1] == ' ' ||
+           name[length - 1] == '\t' || strpbrk(name, "\r\n") != NULL || strpbrk(name, forbidden) != NULL;
+}
+
+INI_PUBLIC_API ini_status_t ini_writer_open_path(char const *filepath, ini_durability_t durability,
+                                                 ini_writer_t **writer)
+{
+    if (!writer)
+        return INI_STATUS_INVALID_ARGUMENT;
+    *writer = NULL;
+
+    ini_file_replace_t *replace = NULL;
+    ini_status_t err = ini_replace_begin(filepath, durability, &replace);
+    if (err != INI_STATUS_SUCCESS)
+        return err;
+
+    err = create_writer(ini_replace_fd(replace), writer);
+    if (err != INI_STATUS_SUCCESS)
+    {
+        ini_replace_abort(replace);
+        return err;
+    }
+    (*writer)->replace = replace;
+    return INI_STATUS_SUCCESS;
+}
+
+INI_PUBLIC_API ini_status_t ini_writer_open_fd(int fd, ini_writer_t **writer)
+{
+    if (fd < 0 || !writer)
+        return INI_STATUS_INVALID_ARGUMENT;
+    *writer = NULL;
+    return create_writer(fd, writer);
+}
+
+INI_PUBLIC_API ini_status_t ini_writer_section(ini_writer_t *writer, char const *name)
+{
+    if (!writer)
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (writer->status != INI_STATUS_SUCCESS)
+        return writer->status;
+    if (!name || bad_name(name, "]"))
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    // A blank line between sections, as ini_save() writes them
+    if (writer->started)
+        put(writer, "\n", 1);
+    writer->started = 1;
+    put(writer, "[", 1);
+    put(writer, name, strlen(name));
+    put(writer, "]\n", 2);
+    return writer->status;
+}
+
+INI_PUBLIC_API ini_status_t ini_writer_kv(ini_writer_t *writer, char const *key, char const *value)
+{
+    if (!writer)
+        return INI_STATUS_INVALID_ARGUMENT;
+    if (writer->status != INI_STATUS_SUCCESS)
+        return writer->status;
+    // A key must not read back as a header or a comment either
+    if (!key || !value || bad_name(key, "=") || *key == '[' || *key == ';' || *key == '#')
+        return INI_STATUS_INVALID_ARGUMENT;
+
+    size_t value_len = strlen(value);
+    if (!ini_value_writable(value, value_len))
+        return INI_STATUS_INVALID_ARGUMENT;
+    int need_quotes = ini_needs_quotes(value, value_len);
+
+    writer->started = 1;
+    put(writer, key, strlen(key));
+    put(writer, need_quotes ? "=\"" : "=", need_quotes ? 2 : 1);
+    put(writer, value, value_len);
+    put(writer, need_quotes ? "\"\n" : "\n", need_quotes ? 2 : 1);
+    return writer->status;
+}
+
+INI_PUBLIC_API ini_status_t ini_writer_close(ini_writer_t *writer)
+{
+    if (!writer)
+        return INI_STATUS_SUCCESS;
+
+    flush_buffer(writer);
+    ini_status_t err = writer->status;
+    if (writer->replace)
+    {
+        if (err == INI_STATUS_SUCCESS)
+            err = ini_replace_commit(writer->replace);
+        else
+            ini_replace_abort(writer->replace);
+    }
+
+    free(writer->buffer);
+    free(writer);
+    return err;
+}
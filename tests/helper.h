@@ -1,12 +1,15 @@
 #ifndef HELPER_H
 #define HELPER_H
 
+#include "ini_filesystem.h"
 #include "ini_os_check.h"
+#include "ini_parser.h"
 
 #include <assert.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if INI_OS_WINDOWS
 #include <shlobj.h>
@@ -133,6 +136,30 @@ static void create_test_file(const char *filename, const char *content)
     assert(fclose(file) == 0);
 }
 
+// Asserts that `filename` holds exactly `expected`
+static void expect_file_text(const char *filename, const char *expected)
+{
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(filename, &data, &size) == INI_STATUS_SUCCESS);
+    assert(size == strlen(expected) && memcmp(data, expected, size) == 0);
+    free(data);
+}
+
+// Asserts that `section`/`key` reads back as `expected`, or is missing when `expected` is NULL
+static void expect_value(ini_context_t *ctx, const char *section, const char *key, const char *expected)
+{
+    char *value = NULL;
+    if (!expected)
+    {
+        assert(ini_get_value(ctx, section, key, &value) != INI_STATUS_SUCCESS);
+        return;
+    }
+    assert(ini_get_value(ctx, section, key, &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, expected) == 0);
+    free(value);
+}
+
 static void remove_test_file(const char *filename)
 {
     if (!filename)
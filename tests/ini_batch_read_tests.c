@@ -0,0 +1,162 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helper.h"
+
+#include "ini_batch_read.h"
+
+#define TEST_FILE_COUNT 150
+#define TEST_DIR "test_batch_read_dir"
+
+/// @brief What a reader delivered for each file.
+typedef struct
+{
+    ini_status_t statuses[TEST_FILE_COUNT];
+    char *contents[TEST_FILE_COUNT];
+    ini_file_fingerprint_t fingerprints[TEST_FILE_COUNT];
+    size_t calls;
+    size_t last_index;
+} batch_log_t;
+
+static void record_file(void *user, size_t index, ini_status_t status, char *data, size_t size,
+                        ini_file_fingerprint_t const *fingerprint)
+{
+    batch_log_t *log = (batch_log_t *)user;
+    // Files arrive in order, once each
+    assert(log->calls == 0 || index == log->last_index + 1);
+    log->last_index = index;
+    log->calls++;
+
+    log->statuses[index] = status;
+    if (status != INI_STATUS_SUCCESS)
+    {
+        assert(data == NULL && fingerprint == NULL);
+        return;
+    }
+    assert(data != NULL && data[size] == '\0' && strlen(data) == size);
+    log->contents[index] = strdup(data);
+    log->fingerprints[index] = *fingerprint;
+}
+
+static void clear_log(batch_log_t *log)
+{
+    for (size_t i = 0; i < TEST_FILE_COUNT; i++)
+        free(log->contents[i]);
+    memset(log, 0, sizeof(*log));
+}
+
+static void file_name(char *name, size_t size, int i)
+{
+    snprintf(name, size, "test_batch_read_%d.ini", i);
+}
+
+// Clean test: Both backends deliver the same contents and fingerprints across several rounds
+void test_batch_read_matches_portable_path()
+{
+    char names[TEST_FILE_COUNT][64];
+    char const *paths[TEST_FILE_COUNT];
+    for (int i = 0; i < TEST_FILE_COUNT; i++)
+    {
+        file_name(names[i], sizeof(names[i]), i);
+        char content[256];
+        // Sizes vary so slot buffers grow and get reused
+        snprintf(content, sizeof(content), "[file]\nindex=%d\n%.*s", i, (i * 7) % 120,
+                 "padpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpadpad"
+                 "padpadpadpadpadpadpadpadpadpadpadpadpadpadpad");
+        create_test_file(names[i], content);
+        paths[i] = names[i];
+    }
+
+    static batch_log_t logs[2];
+    unsigned const flags[2] = {INI_BATCH_READ_DEFAULT, INI_BATCH_READ_NO_IO_URING};
+    for (int r = 0; r < 2; r++)
+    {
+        ini_batch_reader_t *reader = ini_batch_reader_create(flags[r]);
+        assert(reader != NULL);
+        if (flags[r] == INI_BATCH_READ_NO_IO_URING)
+            assert(!ini_batch_reader_uses_io_uring(reader));
+
+        // Twice through the same reader: buffers are reused
+        for (int pass = 0; pass < 2; pass++)
+        {
+            clear_log(&logs[r]);
+            assert(ini_batch_reader_read(reader, paths, TEST_FILE_COUNT, record_file, &logs[r]) ==
+                   INI_STATUS_SUCCESS);
+            assert(logs[r].calls == TEST_FILE_COUNT);
+        }
+        ini_batch_reader_destroy(reader);
+    }
+
+    for (int i = 0; i < TEST_FILE_COUNT; i++)
+    {
+        ini_file_fingerprint_t expected;
+        assert(ini_get_file_fingerprint(paths[i], &expected) == INI_STATUS_SUCCESS);
+        for (int r = 0; r < 2; r++)
+        {
+            assert(logs[r].statuses[i] == INI_STATUS_SUCCESS);
+            assert(ini_file_fingerprint_equal(&logs[r].fingerprints[i], &expected));
+        }
+        assert(strcmp(logs[0].contents[i], logs[1].contents[i]) == 0);
+        remove_test_file(paths[i]);
+    }
+    clear_log(&logs[0]);
+    clear_log(&logs[1]);
+    print_success("test_batch_read_matches_portable_path passed\n");
+}
+
+// Dirty test: Problem files get the statuses ini_check_file_status() reports, on both backends
+void test_batch_read_reports_problems()
+{
+    create_test_file("test_batch_read_good.ini", "[app]\nmode=good\n");
+    create_test_file("test_batch_read_empty.ini", "");
+    create_test_dir(TEST_DIR);
+    char const *paths[] = {"test_batch_read_good.ini", "test_batch_read_missing.ini", TEST_DIR,
+                           "test_batch_read_empty.ini", NULL, ""};
+    size_t const count = sizeof(paths) / sizeof(paths[0]);
+
+    static batch_log_t log;
+    unsigned const flags[2] = {INI_BATCH_READ_DEFAULT, INI_BATCH_READ_NO_IO_URING};
+    for (int r = 0; r < 2; r++)
+    {
+        ini_batch_reader_t *reader = ini_batch_reader_create(flags[r]);
+        assert(reader != NULL);
+        clear_log(&log);
+        assert(ini_batch_reader_read(reader, paths, count, record_file, &log) == INI_STATUS_SUCCESS);
+        assert(log.calls == count);
+        assert(log.statuses[0] == INI_STATUS_SUCCESS && strcmp(log.contents[0], "[app]\nmode=good\n") == 0);
+        assert(log.statuses[1] == INI_STATUS_FILE_NOT_FOUND);
+        assert(log.statuses[2] == INI_STATUS_FILE_IS_DIR);
+        assert(log.statuses[3] == INI_STATUS_FILE_EMPTY);
+        assert(log.statuses[4] == INI_STATUS_INVALID_ARGUMENT);
+        assert(log.statuses[5] == INI_STATUS_INVALID_ARGUMENT);
+
+        assert(ini_batch_reader_read(reader, NULL, 0, record_file, &log) == INI_STATUS_SUCCESS);
+        assert(ini_batch_reader_read(reader, NULL, 1, record_file, &log) == INI_STATUS_INVALID_ARGUMENT);
+        assert(ini_batch_reader_read(reader, paths, 1, NULL, &log) == INI_STATUS_INVALID_ARGUMENT);
+        ini_batch_reader_destroy(reader);
+    }
+    clear_log(&log);
+
+    assert(ini_batch_reader_read(NULL, paths, 1, record_file, &log) == INI_STATUS_INVALID_ARGUMENT);
+    assert(!ini_batch_reader_uses_io_uring(NULL));
+    ini_batch_reader_destroy(NULL);
+
+    remove_test_file("test_batch_read_good.ini");
+    remove_test_file("test_batch_read_empty.ini");
+    remove_test_dir(TEST_DIR);
+    print_success("test_batch_read_reports_problems passed\n");
+}
+
+int main()
+{
+    __helper_init_log_file();
+
+    test_batch_read_matches_portable_path();
+    test_batch_read_reports_problems();
+
+    print_success("All ini_batch_read tests passed!\n\n");
+    __helper_close_log_file();
+    return EXIT_SUCCESS;
+}
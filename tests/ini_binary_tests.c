@@ -0,0 +1,241 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helper.h"
+
+#include "ini_binary.h"
+#include "ini_parser.h"
+
+#define TEST_FILE "test_binary.ini"
+#define TEST_IMAGE "test_binary.bin"
+
+static ini_context_t *load_text(char const *content)
+{
+    create_test_file(TEST_FILE, content);
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    return ctx;
+}
+
+// Rewrites one byte of a file in place
+static void patch_byte(char const *filepath, long offset, char byte)
+{
+    FILE *file = fopen(filepath, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, offset, SEEK_SET) == 0);
+    assert(fputc(byte, file) == byte);
+    fclose(file);
+}
+
+// Clean test: Values survive a save/load round trip and are served without tables
+void test_binary_round_trip()
+{
+    ini_context_t *ctx = load_text("[server]\nhost=localhost\nport=8080\n[empty]\n[paths]\nroot=\"/var/www data\"\n");
+    assert(ini_save_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+
+    expect_value(ctx, "server", "host", "localhost");
+    expect_value(ctx, "server", "port", "8080");
+    expect_value(ctx, "paths", "root", "/var/www data");
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "server", "missing", &value) == INI_STATUS_KEY_NOT_FOUND);
+    assert(ini_get_value(ctx, "missing", "host", &value) == INI_STATUS_SECTION_NOT_FOUND);
+
+    // Lookups so far went to the mapping; tables are only built on demand
+    assert(!ctx->image_materialized);
+    assert(ini_ht_length(ctx->sections) == 0);
+
+    ini_ht_t *server = ini_get_section(ctx, "server");
+    assert(server != NULL && ini_ht_length(server) == 2);
+    assert(ctx->image_materialized);
+    assert(ini_get_section(ctx, "empty") != NULL);
+    expect_value(ctx, "server", "host", "localhost");
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    remove_test_file(TEST_IMAGE);
+    print_success("test_binary_round_trip passed\n");
+}
+
+// Clean test: A context loaded from an image can be edited and saved as text again
+void test_binary_edit_and_save_text()
+{
+    ini_context_t *ctx = load_text("[app]\nname=demo\nmode=fast\n");
+    assert(ini_save_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+    assert(ini_load_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+
+    ini_ht_t *app = ini_get_section(ctx, "app");
+    assert(app != NULL);
+    assert(ini_ht_set(app, "mode", "safe") != NULL);
+    assert(ini_save(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    // Loading text replaces the image
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ctx->image == NULL);
+    expect_value(ctx, "app", "name", "demo");
+    expect_value(ctx, "app", "mode", "safe");
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    remove_test_file(TEST_IMAGE);
+    print_success("test_binary_edit_and_save_text passed\n");
+}
+
+// Clean test: Saving over an image another context has mapped leaves that mapping intact
+void test_binary_save_over_mapped_image()
+{
+    ini_context_t *writer = load_text("[app]\nname=first\n");
+    assert(ini_save_binary(writer, TEST_IMAGE) == INI_STATUS_SUCCESS);
+
+    ini_context_t *reader = ini_create_context();
+    assert(reader != NULL);
+    assert(ini_load_binary(reader, TEST_IMAGE) == INI_STATUS_SUCCESS);
+
+    // A larger image, so an in-place rewrite would also move every offset
+    assert(ini_free(writer) == INI_STATUS_SUCCESS);
+    writer = load_text("[app]\nname=second version\nextra=1\n[more]\nkey=value\n");
+    assert(ini_save_binary(writer, TEST_IMAGE) == INI_STATUS_SUCCESS);
+
+    expect_value(reader, "app", "name", "first");
+    assert(ini_load_binary(reader, TEST_IMAGE) == INI_STATUS_SUCCESS);
+    expect_value(reader, "app", "name", "second version");
+    expect_value(reader, "more", "key", "value");
+
+    assert(ini_free(writer) == INI_STATUS_SUCCESS);
+    assert(ini_free(reader) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    remove_test_file(TEST_IMAGE);
+    print_success("test_binary_save_over_mapped_image passed\n");
+}
+
+// Clean test: Many sections and keys exercise the prebuilt indexes
+void test_binary_many_entries()
+{
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    ini_ht_t *sections = ini_get_sections(ctx);
+    for (int s = 0; s < 50; s++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "section%d", s);
+        ini_ht_t *section_ht = ini_ht_create();
+        assert(section_ht != NULL);
+        for (int k = 0; k < 40; k++)
+        {
+            char key[32];
+            char value[32];
+            snprintf(key, sizeof(key), "key%d", k);
+            snprintf(value, sizeof(value), "%d", s * 100 + k);
+            assert(ini_ht_set(section_ht, key, value) != NULL);
+        }
+        ini_store_section_ht(sections, name, section_ht);
+    }
+    assert(ini_save_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+    for (int s = 0; s < 50; s++)
+    {
+        for (int k = 0; k < 40; k++)
+        {
+            char name[32];
+            char key[32];
+            char expected[32];
+            snprintf(name, sizeof(name), "section%d", s);
+            snprintf(key, sizeof(key), "key%d", k);
+            snprintf(expected, sizeof(expected), "%d", s * 100 + k);
+            expect_value(ctx, name, key, expected);
+        }
+    }
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_IMAGE);
+    print_success("test_binary_many_entries passed\n");
+}
+
+// Dirty test: Damaged, truncated and foreign files are rejected and the context is kept
+void test_binary_rejects_damaged_images()
+{
+    ini_context_t *ctx = load_text("[app]\nname=demo\n");
+    assert(ini_save_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+
+    // A flipped byte in the string blob fails the checksum
+    FILE *file = fopen(TEST_IMAGE, "rb");
+    assert(file != NULL);
+    assert(fseek(file, 0, SEEK_END) == 0);
+    long size = ftell(file);
+    fclose(file);
+    patch_byte(TEST_IMAGE, size - 2, 'X');
+    assert(ini_load_binary(ctx, TEST_IMAGE) == INI_STATUS_FILE_BAD_FORMAT);
+    expect_value(ctx, "app", "name", "demo");
+
+    // Wrong magic
+    assert(ini_save_binary(ctx, TEST_IMAGE) == INI_STATUS_SUCCESS);
+    patch_byte(TEST_IMAGE, 0, 'X');
+    assert(ini_load_binary(ctx, TEST_IMAGE) == INI_STATUS_FILE_BAD_FORMAT);
+
+    // A text file is not an image
+    assert(ini_load_binary(ctx, TEST_FILE) == INI_STATUS_FILE_BAD_FORMAT);
+    expect_value(ctx, "app", "name", "demo");
+
+    create_test_file(TEST_IMAGE, "");
+    assert(ini_load_binary(ctx, TEST_IMAGE) == INI_STATUS_FILE_EMPTY);
+    assert(ini_load_binary(ctx, "missing_image.bin") == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_load_binary(NULL, TEST_IMAGE) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_save_binary(NULL, TEST_IMAGE) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_save_binary(ctx, "") == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    remove_test_file(TEST_IMAGE);
+    print_success("test_binary_rejects_damaged_images passed\n");
+}
+
+// Dirty test: Validation catches offsets that point outside the image
+void test_binary_validate_bounds()
+{
+    ini_context_t *ctx = load_text("[app]\nname=demo\n");
+    char *image = NULL;
+    size_t size = 0;
+    assert(ini_binary_build(ini_get_sections(ctx), &image, &size) == INI_STATUS_SUCCESS);
+    assert(ini_binary_validate(image, size) == INI_STATUS_SUCCESS);
+    assert(ini_binary_validate(image, size - 1) == INI_STATUS_FILE_BAD_FORMAT);
+
+    // An out-of-range offset with a matching checksum is still rejected
+    ini_binary_header_t *header = (ini_binary_header_t *)image;
+    ini_binary_pair_t *pair = (ini_binary_pair_t *)(image + header->pairs_offset);
+    pair->value = header->strings_size + 100;
+    header->checksum = hash_bytes(image + sizeof(ini_binary_header_t), size - sizeof(ini_binary_header_t));
+    assert(ini_binary_validate(image, size) == INI_STATUS_FILE_BAD_FORMAT);
+
+    free(image);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_binary_validate_bounds passed\n");
+}
+
+int main()
+{
+    __helper_init_log_file();
+
+    test_binary_round_trip();
+    test_binary_edit_and_save_text();
+    test_binary_save_over_mapped_image();
+    test_binary_many_entries();
+    test_binary_rejects_damaged_images();
+    test_binary_validate_bounds();
+
+    print_success("All ini_binary tests passed!\n\n");
+    __helper_close_log_file();
+    return EXIT_SUCCESS;
+}
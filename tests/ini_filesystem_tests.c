@@ -863,6 +863,301 @@ void test_ini_filesystem_get_file_size_symlink()
 
 // ==================== Integration and Edge Case Tests ====================
 
+// Clean test: Fingerprints change with the content and with a rename over the file
+void test_ini_filesystem_file_fingerprint()
+{
+    char const *test_file = "test_ini_filesystem_file_fingerprint.txt";
+    char const *replacement = "test_ini_filesystem_file_fingerprint.tmp";
+    create_test_file(test_file, "first");
+
+    ini_file_fingerprint_t before;
+    ini_file_fingerprint_t after;
+    assert(ini_get_file_fingerprint(test_file, &before) == INI_STATUS_SUCCESS);
+    assert(before.size == 5);
+    assert(ini_get_file_fingerprint(test_file, &after) == INI_STATUS_SUCCESS);
+    assert(ini_file_fingerprint_equal(&before, &after));
+
+    create_test_file(test_file, "second");
+    assert(ini_get_file_fingerprint(test_file, &after) == INI_STATUS_SUCCESS);
+    assert(!ini_file_fingerprint_equal(&before, &after));
+
+    // Same size, new inode
+    before = after;
+    create_test_file(replacement, "SECOND");
+    assert(rename(replacement, test_file) == 0);
+    assert(ini_get_file_fingerprint(test_file, &after) == INI_STATUS_SUCCESS);
+    assert(before.size == after.size);
+    assert(!ini_file_fingerprint_equal(&before, &after));
+
+    assert(ini_get_file_fingerprint(NULL, &after) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_get_file_fingerprint(test_file, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_get_file_fingerprint("test_ini_filesystem_file_fingerprint_missing.txt", &after) == INI_STATUS_FILE_NOT_FOUND);
+    assert(!ini_file_fingerprint_equal(NULL, &after));
+
+    remove_test_file(test_file);
+    print_success("test_ini_filesystem_file_fingerprint passed\n");
+}
+
+void test_ini_filesystem_map_file()
+{
+    char const *test_file = "test_ini_filesystem_map_file.txt";
+    create_test_file(test_file, "mapped contents");
+
+    void const *data = NULL;
+    size_t size = 0;
+    assert(ini_map_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(size == 15);
+    assert(memcmp(data, "mapped contents", size) == 0);
+
+    // The mapping outlives the name
+    remove_test_file(test_file);
+    assert(memcmp(data, "mapped contents", size) == 0);
+    ini_unmap_file(data, size);
+    ini_unmap_file(NULL, 0);
+
+    create_test_file(test_file, "");
+    assert(ini_map_file(test_file, &data, &size) == INI_STATUS_FILE_EMPTY);
+    assert(data == NULL && size == 0);
+    assert(ini_map_file("test_ini_filesystem_map_file_missing.txt", &data, &size) == INI_STATUS_FILE_OPEN_FAILED);
+    assert(ini_map_file(NULL, &data, &size) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_map_file(test_file, NULL, &size) == INI_STATUS_INVALID_ARGUMENT);
+
+    remove_test_file(test_file);
+    print_success("test_ini_filesystem_map_file passed\n");
+}
+
+void test_ini_filesystem_write_file_atomic()
+{
+    char const *test_file = "test_ini_filesystem_write_file_atomic.txt";
+    create_test_file(test_file, "old contents");
+
+    assert(ini_write_file_atomic(test_file, "new", 3) == INI_STATUS_SUCCESS);
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(size == 3 && memcmp(data, "new", 3) == 0);
+    free(data);
+
+    // A missing directory fails without touching anything
+    assert(ini_write_file_atomic("test_ini_filesystem_missing_dir/file.txt", "x", 1) == INI_STATUS_FILE_OPEN_FAILED);
+    assert(ini_write_file_atomic(NULL, "x", 1) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_write_file_atomic(test_file, NULL, 1) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_write_file_atomic(test_file, NULL, 0) == INI_STATUS_SUCCESS);
+    assert(ini_get_file_size(test_file, &size) == INI_STATUS_SUCCESS);
+    assert(size == 0);
+
+    remove_test_file(test_file);
+    print_success("test_ini_filesystem_write_file_atomic passed\n");
+}
+
+// Clean test: Every durability level replaces the contents; mode bits and symbolic links survive
+void test_ini_filesystem_write_file_atomic_ex()
+{
+    char const *test_file = "test_ini_filesystem_write_file_atomic_ex.txt";
+    create_test_file(test_file, "old contents");
+
+    ini_durability_t const levels[] = {INI_DURABILITY_NONE, INI_DURABILITY_FILE, INI_DURABILITY_DIRECTORY};
+    char const *texts[] = {"none", "file", "directory"};
+    for (size_t i = 0; i < 3; i++)
+    {
+        assert(ini_write_file_atomic_ex(test_file, texts[i], strlen(texts[i]), levels[i]) == INI_STATUS_SUCCESS);
+        char *data = NULL;
+        size_t size = 0;
+        assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+        assert(size == strlen(texts[i]) && memcmp(data, texts[i], size) == 0);
+        free(data);
+    }
+    assert(ini_write_file_atomic_ex(test_file, "x", 1, (ini_durability_t)42) == INI_STATUS_INVALID_ARGUMENT);
+
+#if INI_OS_LINUX
+    // The replacement keeps the original's permission bits
+    assert(chmod(test_file, 0640) == 0);
+    assert(ini_write_file_atomic_ex(test_file, "mode", 4, INI_DURABILITY_NONE) == INI_STATUS_SUCCESS);
+    struct stat st;
+    assert(stat(test_file, &st) == 0 && (st.st_mode & 07777) == 0640);
+
+    // Writing through a link updates its target and leaves the link in place
+    char const *link_file = "test_ini_filesystem_write_file_atomic_ex.lnk";
+    unlink(link_file);
+    assert(symlink(test_file, link_file) == 0);
+    assert(ini_write_file_atomic_ex(link_file, "linked", 6, INI_DURABILITY_FILE) == INI_STATUS_SUCCESS);
+    assert(lstat(link_file, &st) == 0 && S_ISLNK(st.st_mode));
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(size == 6 && memcmp(data, "linked", 6) == 0);
+    free(data);
+    unlink(link_file);
+#endif
+
+    remove_test_file(test_file);
+    print_success("test_ini_filesystem_write_file_atomic_ex passed\n");
+}
+
+// Clean test: Edits replace, insert and delete ranges; the untouched bytes are copied as they were
+void test_ini_filesystem_patch_file_atomic()
+{
+    char const *test_file = "test_ini_filesystem_patch_file_atomic.txt";
+    create_test_file(test_file, "0123456789abcdef");
+
+    ini_file_edit_t const edits[] = {
+        {0, 0, "<", 1},     // Insert at the start
+        {2, 3, "two", 3},   // Replace "234"
+        {8, 2, NULL, 0},    // Delete "89"
+        {16, 0, ">\n", 2}, // Append
+    };
+    assert(ini_patch_file_atomic(test_file, edits, 4, INI_DURABILITY_FILE, NULL) == INI_STATUS_SUCCESS);
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "<01two567abcdef>\n") == 0);
+    free(data);
+
+    // No edits: same contents
+    assert(ini_patch_file_atomic(test_file, NULL, 0, INI_DURABILITY_NONE, NULL) == INI_STATUS_SUCCESS);
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "<01two567abcdef>\n") == 0);
+    free(data);
+
+    // Overlapping, unsorted or out-of-range edits are refused and leave the file alone
+    ini_file_edit_t const overlapping[] = {{0, 4, "x", 1}, {2, 1, "y", 1}};
+    ini_file_edit_t const beyond[] = {{10, 50, "x", 1}};
+    ini_file_edit_t const no_data[] = {{0, 1, NULL, 3}};
+    assert(ini_patch_file_atomic(test_file, overlapping, 2, INI_DURABILITY_NONE, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_patch_file_atomic(test_file, beyond, 1, INI_DURABILITY_NONE, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_patch_file_atomic(test_file, no_data, 1, INI_DURABILITY_NONE, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_patch_file_atomic(test_file, NULL, 1, INI_DURABILITY_NONE, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_patch_file_atomic(NULL, edits, 1, INI_DURABILITY_NONE, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_patch_file_atomic("test_ini_filesystem_patch_missing.txt", NULL, 0, INI_DURABILITY_NONE, NULL) ==
+           INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "<01two567abcdef>\n") == 0);
+    free(data);
+
+    // Spans larger than the copy buffer survive intact
+    size_t const big = 3 * 1024 * 1024 + 17;
+    char *original = (char *)malloc(big);
+    assert(original != NULL);
+    for (size_t i = 0; i < big; i++)
+        original[i] = (char)('a' + (i * 7) % 26);
+    assert(ini_write_file_atomic(test_file, original, big) == INI_STATUS_SUCCESS);
+    ini_file_edit_t const middle[] = {{big / 2, 4, "PATCH", 5}};
+    assert(ini_patch_file_atomic(test_file, middle, 1, INI_DURABILITY_NONE, NULL) == INI_STATUS_SUCCESS);
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(size == big + 1);
+    assert(memcmp(data, original, big / 2) == 0);
+    assert(memcmp(data + big / 2, "PATCH", 5) == 0);
+    assert(memcmp(data + big / 2 + 5, original + big / 2 + 4, big - big / 2 - 4) == 0);
+    free(data);
+    free(original);
+
+    // Edits computed against a mapping are refused once the file was replaced
+    create_test_file(test_file, "key=old\n");
+    void const *view = NULL;
+    ini_file_fingerprint_t fingerprint;
+    assert(ini_map_file_ex(test_file, &view, &size, &fingerprint) == INI_STATUS_SUCCESS);
+    ini_file_edit_t const value[] = {{4, 3, "new", 3}};
+    assert(ini_write_file_atomic(test_file, "other=1\nkey=old\n", 16) == INI_STATUS_SUCCESS);
+    assert(ini_patch_file_atomic(test_file, value, 1, INI_DURABILITY_NONE, &fingerprint) == INI_STATUS_FILE_CHANGED);
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "other=1\nkey=old\n") == 0);
+    free(data);
+    ini_unmap_file(view, 8);
+
+    // A fresh fingerprint lets the same edit through
+    create_test_file(test_file, "key=old\n");
+    assert(ini_map_file_ex(test_file, &view, &size, &fingerprint) == INI_STATUS_SUCCESS);
+    assert(ini_patch_file_atomic(test_file, value, 1, INI_DURABILITY_NONE, &fingerprint) == INI_STATUS_SUCCESS);
+    ini_unmap_file(view, size);
+    assert(ini_read_file(test_file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "key=new\n") == 0);
+    free(data);
+
+    remove_test_file(test_file);
+    print_success("test_ini_filesystem_patch_file_atomic passed\n");
+}
+
+void test_ini_filesystem_read_file_reuse()
+{
+    char const *small_file = "test_ini_filesystem_read_file_reuse_small.txt";
+    char const *large_file = "test_ini_filesystem_read_file_reuse_large.txt";
+    create_test_file(small_file, "abc");
+    create_test_file(large_file, "0123456789abcdef");
+
+    char *buffer = NULL;
+    size_t capacity = 0;
+    size_t size = 0;
+    assert(ini_read_file_reuse(large_file, &buffer, &capacity, &size) == INI_STATUS_SUCCESS);
+    assert(size == 16 && capacity >= 16 && strcmp(buffer, "0123456789abcdef") == 0);
+
+    // A smaller file fits the existing buffer, which is kept
+    char *first = buffer;
+    assert(ini_read_file_reuse(small_file, &buffer, &capacity, &size) == INI_STATUS_SUCCESS);
+    assert(buffer == first && size == 3 && strcmp(buffer, "abc") == 0);
+
+    // The buffer survives a failed read
+    assert(ini_read_file_reuse("test_ini_filesystem_read_file_reuse_missing.txt", &buffer, &capacity, &size) ==
+           INI_STATUS_FILE_OPEN_FAILED);
+    assert(buffer == first);
+    assert(ini_read_file_reuse(small_file, NULL, &capacity, &size) == INI_STATUS_INVALID_ARGUMENT);
+    free(buffer);
+
+    remove_test_file(small_file);
+    remove_test_file(large_file);
+    print_success("test_ini_filesystem_read_file_reuse passed\n");
+}
+
+void test_ini_filesystem_list_files()
+{
+    char const *dir = "test_ini_filesystem_list_files";
+    create_test_dir(dir);
+    create_test_file("test_ini_filesystem_list_files/b.ini", "x");
+    create_test_file("test_ini_filesystem_list_files/a.ini", "x");
+    create_test_file("test_ini_filesystem_list_files/c.conf", "x");
+    create_test_file("test_ini_filesystem_list_files/.hidden.ini", "x");
+    create_test_dir("test_ini_filesystem_list_files/d.ini");
+
+    // Only regular, visible files match, in lexical order
+    char **paths = NULL;
+    size_t count = 0;
+    assert(ini_list_files("test_ini_filesystem_list_files/*.ini", &paths, &count) == INI_STATUS_SUCCESS);
+    assert(count == 2);
+    assert(strcmp(paths[0], "test_ini_filesystem_list_files/a.ini") == 0);
+    assert(strcmp(paths[1], "test_ini_filesystem_list_files/b.ini") == 0);
+    ini_free_file_list(paths, count);
+
+    assert(ini_list_files("test_ini_filesystem_list_files/?.*", &paths, &count) == INI_STATUS_SUCCESS);
+    assert(count == 3);
+    ini_free_file_list(paths, count);
+
+    assert(ini_list_files("test_ini_filesystem_list_files/.*", &paths, &count) == INI_STATUS_SUCCESS);
+    assert(count == 1 && strcmp(paths[0], "test_ini_filesystem_list_files/.hidden.ini") == 0);
+    ini_free_file_list(paths, count);
+
+    assert(ini_list_files("test_ini_filesystem_list_files/*.txt", &paths, &count) == INI_STATUS_SUCCESS);
+    assert(count == 0 && paths == NULL);
+
+    // A literal path must name an existing file
+    assert(ini_list_files("test_ini_filesystem_list_files/c.conf", &paths, &count) == INI_STATUS_SUCCESS);
+    assert(count == 1);
+    ini_free_file_list(paths, count);
+    assert(ini_list_files("test_ini_filesystem_list_files/e.ini", &paths, &count) == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_list_files("test_ini_filesystem_list_files/d.ini", &paths, &count) == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_list_files("test_ini_filesystem_missing_dir/*.ini", &paths, &count) == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_list_files("test_*/a.ini", &paths, &count) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_list_files(NULL, &paths, &count) == INI_STATUS_INVALID_ARGUMENT);
+    ini_free_file_list(NULL, 0);
+
+    remove_test_file("test_ini_filesystem_list_files/a.ini");
+    remove_test_file("test_ini_filesystem_list_files/b.ini");
+    remove_test_file("test_ini_filesystem_list_files/c.conf");
+    remove_test_file("test_ini_filesystem_list_files/.hidden.ini");
+    remove_test_dir("test_ini_filesystem_list_files/d.ini");
+    remove_test_dir(dir);
+    print_success("test_ini_filesystem_list_files passed\n");
+}
+
 // Dirty test: Unicode filename
 void test_ini_filesystem_unicode_filename()
 {
@@ -1129,6 +1424,13 @@ int main()
     test_ini_filesystem_get_file_size_directory();
     test_ini_filesystem_get_file_size_binary();
     test_ini_filesystem_get_file_size_symlink();
+    test_ini_filesystem_file_fingerprint();
+    test_ini_filesystem_map_file();
+    test_ini_filesystem_write_file_atomic();
+    test_ini_filesystem_write_file_atomic_ex();
+    test_ini_filesystem_patch_file_atomic();
+    test_ini_filesystem_read_file_reuse();
+    test_ini_filesystem_list_files();
     test_ini_filesystem_unicode_filename();
     test_ini_filesystem_path_traversal();
     test_ini_filesystem_boundary_conditions();
@@ -114,6 +114,33 @@ void test_hash_key_repeated_chars()
     print_success("test_hash_key_repeated_chars passed\n");
 }
 
+// Test hash_bytes() on word-sized blocks and tails
+void test_hash_bytes()
+{
+    char data[] = "0123456789abcdefXYZ";
+    assert(hash_bytes(NULL, 0) == hash_bytes(data, 0));
+    assert(hash_bytes(data, sizeof(data) - 1) == hash_bytes(data, sizeof(data) - 1));
+
+    // Every prefix length hashes differently, and so does a flipped byte in each position
+    for (size_t length = 1; length < sizeof(data); length++)
+    {
+        assert(hash_bytes(data, length) != hash_bytes(data, length - 1));
+        for (size_t i = 0; i < length; i++)
+        {
+            char copy[sizeof(data)];
+            memcpy(copy, data, sizeof(data));
+            copy[i] ^= 0x20;
+            assert(hash_bytes(copy, length) != hash_bytes(data, length));
+        }
+    }
+
+    // Unaligned input hashes like aligned input
+    char shifted[sizeof(data) + 1];
+    memcpy(shifted + 1, data, sizeof(data));
+    assert(hash_bytes(shifted + 1, sizeof(data) - 1) == hash_bytes(data, sizeof(data) - 1));
+    print_success("test_hash_bytes passed\n");
+}
+
 // Clean test: Successful table creation
 void test_ht_create_success()
 {
@@ -632,6 +659,78 @@ void test_ht_set_overwrite_null()
     print_success("test_ht_set_overwrite_null passed\n");
 }
 
+void test_ht_set_ex_borrowed()
+{
+    ini_ht_t *table = ini_ht_create();
+    assert(table != NULL);
+
+    // Borrowed strings are stored by pointer
+    char key[] = "key";
+    char value[] = "value";
+    assert(ini_ht_set_ex(table, key, value, INI_HT_BORROW_KEY | INI_HT_BORROW_VALUE) != NULL);
+    assert(ini_ht_get(table, "key") == value);
+
+    // Overwriting a borrowed value with a copied one must not free the borrowed buffer
+    assert(ini_ht_set(table, "key", "copied") != NULL);
+    assert(strcmp(ini_ht_get(table, "key"), "copied") == 0);
+    assert(strcmp(value, "value") == 0);
+
+    // Borrowed entries survive expansion without being copied
+    char keys[64][16];
+    for (int i = 0; i < 64; i++)
+    {
+        snprintf(keys[i], sizeof(keys[i]), "k%d", i);
+        assert(ini_ht_set_ex(table, keys[i], keys[i], INI_HT_BORROW_KEY | INI_HT_BORROW_VALUE) != NULL);
+    }
+    assert(ini_ht_length(table) == 65);
+    assert(ini_ht_get(table, "k42") == keys[42]);
+
+    assert(ini_ht_destroy(table) == INI_STATUS_SUCCESS);
+    print_success("test_ht_set_ex_borrowed passed\n");
+}
+
+void test_ht_remove()
+{
+    ini_ht_t *table = ini_ht_create();
+    assert(table != NULL);
+
+    // Enough keys to force collisions and an expansion
+    char keys[200][16];
+    for (int i = 0; i < 200; i++)
+    {
+        snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+        assert(ini_ht_set(table, keys[i], keys[i]) != NULL);
+    }
+
+    // Every other key goes; the rest must stay reachable across the shifted runs
+    for (int i = 0; i < 200; i += 2)
+        assert(ini_ht_remove(table, keys[i]) == INI_STATUS_SUCCESS);
+    assert(ini_ht_length(table) == 100);
+    for (int i = 0; i < 200; i++)
+    {
+        char const *value = ini_ht_get(table, keys[i]);
+        if (i % 2)
+            assert(value && strcmp(value, keys[i]) == 0);
+        else
+            assert(value == NULL);
+    }
+
+    assert(ini_ht_remove(table, "key0") == INI_STATUS_KEY_NOT_FOUND);
+    assert(ini_ht_remove(table, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_ht_remove(NULL, "key1") == INI_STATUS_INVALID_ARGUMENT);
+
+    // Borrowed strings are left alone and removed keys can come back
+    char borrowed[] = "borrowed";
+    assert(ini_ht_set_ex(table, borrowed, borrowed, INI_HT_BORROW_KEY | INI_HT_BORROW_VALUE) != NULL);
+    assert(ini_ht_remove(table, "borrowed") == INI_STATUS_SUCCESS);
+    assert(strcmp(borrowed, "borrowed") == 0);
+    assert(ini_ht_set(table, "key0", "again") != NULL);
+    assert(strcmp(ini_ht_get(table, "key0"), "again") == 0);
+
+    assert(ini_ht_destroy(table) == INI_STATUS_SUCCESS);
+    print_success("test_ht_remove passed\n");
+}
+
 void test_ht_comprehensive_workflow()
 {
     // 1. Create table
@@ -717,6 +816,7 @@ int main()
     test_hash_key_special_chars();
     test_hash_key_repeated_chars();
     test_hash_key_special_utf8();
+    test_hash_bytes();
 
     /* Test for ini_ht_create() function */
     test_ht_create_success();
@@ -739,6 +839,10 @@ int main()
     test_ht_set_null_args();
     // test_ht_set_expand();
     test_ht_set_overwrite_null();
+    test_ht_set_ex_borrowed();
+
+    /* Test for ini_ht_remove() function */
+    test_ht_remove();
 
     /* Test for ini_ht_length() function */
     test_ht_length_success();
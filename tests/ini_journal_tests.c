@@ -0,0 +1,482 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helper.h"
+
+#include "ini_journal.h"
+#include "ini_parser.h"
+
+#define TEST_JOURNAL "test_journal.ini.journal"
+#define MAX_RECORDS 16
+
+/// @brief Records delivered by a replay, as "section/key=value" ("section/key-" for removals).
+typedef struct
+{
+    char lines[MAX_RECORDS][64];
+    size_t count;
+} replay_log_t;
+
+static ini_status_t record_line(void *user, char const *section, char const *key, char const *value)
+{
+    replay_log_t *log = (replay_log_t *)user;
+    assert(log->count < MAX_RECORDS);
+    if (value)
+        snprintf(log->lines[log->count++], sizeof(log->lines[0]), "%s/%s=%s", section, key, value);
+    else
+        snprintf(log->lines[log->count++], sizeof(log->lines[0]), "%s/%s-", section, key);
+    return INI_STATUS_SUCCESS;
+}
+
+static void replay_into(char const *path, replay_log_t *log)
+{
+    size_t count = 0;
+    memset(log, 0, sizeof(*log));
+    assert(ini_journal_replay(path, record_line, log, &count) == INI_STATUS_SUCCESS);
+    assert(count == log->count);
+}
+
+static size_t file_size(char const *path)
+{
+    size_t size = 0;
+    assert(ini_get_file_size(path, &size) == INI_STATUS_SUCCESS);
+    return size;
+}
+
+// Writes `size` bytes, which may contain null bytes
+static void write_bytes(char const *path, void const *data, size_t size)
+{
+    FILE *file = fopen(path, "wb");
+    assert(file != NULL);
+    assert(fwrite(data, 1, size, file) == size);
+    fclose(file);
+}
+
+// Clean test: Records come back in order, across batches and reopenings
+void test_journal_append_and_replay()
+{
+    remove(TEST_JOURNAL);
+    ini_journal_t *journal = NULL;
+    assert(ini_journal_open(TEST_JOURNAL, 1, &journal) == INI_STATUS_SUCCESS);
+    assert(ini_journal_size(journal) == sizeof(ini_journal_header_t));
+
+    ini_journal_entry_t const first[] = {{"app", "mode", "fast"}, {"app", "name", "two words"}, {"", "g", ""}};
+    assert(ini_journal_append(journal, first, 3) == INI_STATUS_SUCCESS);
+    ini_journal_entry_t const second = {"app", "name", NULL};
+    assert(ini_journal_append(journal, &second, 1) == INI_STATUS_SUCCESS);
+    assert(ini_journal_append(journal, NULL, 0) == INI_STATUS_SUCCESS);
+    uint64_t size = ini_journal_size(journal);
+    assert(size == file_size(TEST_JOURNAL));
+    ini_journal_close(journal);
+
+    replay_log_t log;
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 4);
+    assert(strcmp(log.lines[0], "app/mode=fast") == 0);
+    assert(strcmp(log.lines[1], "app/name=two words") == 0);
+    assert(strcmp(log.lines[2], "/g=") == 0);
+    assert(strcmp(log.lines[3], "app/name-") == 0);
+
+    // Reopening appends after the existing records
+    assert(ini_journal_open(TEST_JOURNAL, 0, &journal) == INI_STATUS_SUCCESS);
+    assert(ini_journal_size(journal) == size);
+    ini_journal_entry_t const third = {"app", "mode", "slow"};
+    assert(ini_journal_append(journal, &third, 1) == INI_STATUS_SUCCESS);
+    assert(ini_journal_sync(journal) == INI_STATUS_SUCCESS);
+    ini_journal_close(journal);
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 5 && strcmp(log.lines[4], "app/mode=slow") == 0);
+
+    assert(ini_journal_open(NULL, 1, &journal) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_journal_open(TEST_JOURNAL, 1, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    ini_journal_entry_t const bad = {NULL, "k", "v"};
+    assert(ini_journal_append(NULL, &third, 1) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_journal_open(TEST_JOURNAL, 1, &journal) == INI_STATUS_SUCCESS);
+    assert(ini_journal_append(journal, &bad, 1) == INI_STATUS_INVALID_ARGUMENT);
+    ini_journal_close(journal);
+    ini_journal_close(NULL);
+    assert(ini_journal_replay(TEST_JOURNAL, NULL, NULL, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_journal_size(NULL) == 0);
+
+    remove_test_file(TEST_JOURNAL);
+    print_success("test_journal_append_and_replay passed\n");
+}
+
+// Dirty test: Torn and damaged batches end the journal; foreign files are refused
+void test_journal_damaged_records()
+{
+    remove(TEST_JOURNAL);
+    ini_journal_t *journal = NULL;
+    assert(ini_journal_open(TEST_JOURNAL, 0, &journal) == INI_STATUS_SUCCESS);
+    ini_journal_entry_t const entries[] = {{"a", "x", "1"}, {"a", "y", "2"}, {"a", "z", "3"}};
+    for (size_t i = 0; i < 3; i++)
+        assert(ini_journal_append(journal, &entries[i], 1) == INI_STATUS_SUCCESS);
+    size_t const full = (size_t)ini_journal_size(journal);
+    ini_journal_close(journal);
+
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(TEST_JOURNAL, &data, &size) == INI_STATUS_SUCCESS && size == full);
+    size_t const batch = (full - sizeof(ini_journal_header_t)) / 3; // Equal-sized batches
+
+    // A crash in the middle of the last batch
+    write_bytes(TEST_JOURNAL, data, full - 3);
+    replay_log_t log;
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 2);
+
+    // Opening cuts the torn batch off before appending
+    assert(ini_journal_open(TEST_JOURNAL, 0, &journal) == INI_STATUS_SUCCESS);
+    assert(ini_journal_size(journal) == full - batch && file_size(TEST_JOURNAL) == full - batch);
+    ini_journal_entry_t const retry = {"a", "z", "4"};
+    assert(ini_journal_append(journal, &retry, 1) == INI_STATUS_SUCCESS);
+    ini_journal_close(journal);
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 3 && strcmp(log.lines[2], "a/z=4") == 0);
+
+    // A flipped byte in the second batch hides it and everything after it
+    data[sizeof(ini_journal_header_t) + batch + sizeof(ini_journal_batch_t) + sizeof(ini_journal_record_t)] ^= 0x20;
+    write_bytes(TEST_JOURNAL, data, full);
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 1 && strcmp(log.lines[0], "a/x=1") == 0);
+
+    // A batch torn inside its second record gives back none of its records
+    remove(TEST_JOURNAL);
+    assert(ini_journal_open(TEST_JOURNAL, 0, &journal) == INI_STATUS_SUCCESS);
+    assert(ini_journal_append(journal, &retry, 1) == INI_STATUS_SUCCESS);
+    size_t const before = (size_t)ini_journal_size(journal);
+    assert(ini_journal_append(journal, entries, 3) == INI_STATUS_SUCCESS);
+    ini_journal_close(journal);
+    char *three = NULL;
+    assert(ini_read_file(TEST_JOURNAL, &three, &size) == INI_STATUS_SUCCESS);
+    size_t const record = sizeof(ini_journal_record_t) + sizeof("a") + sizeof("x") + sizeof("1");
+    write_bytes(TEST_JOURNAL, three, before + sizeof(ini_journal_batch_t) + record + 5);
+    free(three);
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 1 && strcmp(log.lines[0], "a/z=4") == 0);
+    assert(ini_journal_open(TEST_JOURNAL, 0, &journal) == INI_STATUS_SUCCESS);
+    assert(ini_journal_size(journal) == before && file_size(TEST_JOURNAL) == before);
+    ini_journal_close(journal);
+
+    // A header cut short holds nothing and is rewritten on open
+    write_bytes(TEST_JOURNAL, data, 5);
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 0);
+    assert(ini_journal_open(TEST_JOURNAL, 0, &journal) == INI_STATUS_SUCCESS);
+    assert(ini_journal_size(journal) == sizeof(ini_journal_header_t));
+    ini_journal_close(journal);
+
+    // Not a journal
+    create_test_file(TEST_JOURNAL, "[section]\nkey=value\n");
+    assert(ini_journal_replay(TEST_JOURNAL, record_line, &log, NULL) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(ini_journal_open(TEST_JOURNAL, 0, &journal) == INI_STATUS_FILE_BAD_FORMAT && journal == NULL);
+    remove_test_file(TEST_JOURNAL);
+
+    // No journal at all: nothing to replay
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 0);
+
+    free(data);
+    print_success("test_journal_damaged_records passed\n");
+}
+
+// Clean test: Dropping a prefix keeps the later records
+void test_journal_drop()
+{
+    remove(TEST_JOURNAL);
+    ini_journal_t *journal = NULL;
+    assert(ini_journal_open(TEST_JOURNAL, 1, &journal) == INI_STATUS_SUCCESS);
+    ini_journal_entry_t const entries[] = {{"a", "x", "1"}, {"a", "y", "2"}};
+    assert(ini_journal_append(journal, entries, 2) == INI_STATUS_SUCCESS);
+    uint64_t const folded = ini_journal_size(journal);
+    ini_journal_entry_t const later = {"b", "z", NULL};
+    assert(ini_journal_append(journal, &later, 1) == INI_STATUS_SUCCESS);
+
+    assert(ini_journal_drop(journal, folded) == INI_STATUS_SUCCESS);
+    replay_log_t log;
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 1 && strcmp(log.lines[0], "b/z-") == 0);
+    assert(ini_journal_size(journal) == file_size(TEST_JOURNAL));
+
+    // Appends continue in the new file
+    assert(ini_journal_append(journal, entries, 1) == INI_STATUS_SUCCESS);
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 2 && strcmp(log.lines[1], "a/x=1") == 0);
+
+    assert(ini_journal_drop(journal, ini_journal_size(journal)) == INI_STATUS_SUCCESS);
+    assert(ini_journal_size(journal) == sizeof(ini_journal_header_t));
+    assert(file_size(TEST_JOURNAL) == sizeof(ini_journal_header_t));
+    assert(ini_journal_drop(journal, 0) == INI_STATUS_SUCCESS);
+    assert(ini_journal_drop(journal, ini_journal_size(journal) + 1) == INI_STATUS_INVALID_ARGUMENT);
+    ini_journal_close(journal);
+
+    remove_test_file(TEST_JOURNAL);
+    print_success("test_journal_drop passed\n");
+}
+
+// Clean test: Changes go to the journal, not the file, and come back on the next load
+void test_journal_context_records_changes()
+{
+    char const *file = "test_journal.ini";
+    char const *base = "[app]\nmode=fast\nlevel=1\n";
+    create_test_file(file, base);
+    remove(TEST_JOURNAL);
+
+    ini_journal_options_t const options = {0, 1};
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_journal(ctx, file, &options) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    assert(ini_set_value(ctx, "app", "mode", "slow") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "extra", "on", "yes") == INI_STATUS_SUCCESS);
+    assert(ini_remove_value(ctx, "app", "level") == INI_STATUS_SUCCESS);
+    assert(ini_remove_value(ctx, "app", "level") == INI_STATUS_KEY_NOT_FOUND); // Not recorded
+
+    ini_txn_t *txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    assert(ini_txn_set(txn, "app", "a", "1") == INI_STATUS_SUCCESS);
+    assert(ini_txn_set(txn, "app", "b", "2") == INI_STATUS_SUCCESS);
+    assert(ini_txn_commit(txn, file) == INI_STATUS_SUCCESS);
+    expect_value(ctx, "app", "b", "2");
+
+    // The INI file is untouched; the journal holds one record per change
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, base) == 0);
+    free(data);
+    replay_log_t log;
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 5 && strcmp(log.lines[2], "app/level-") == 0);
+
+    // A reader that only sets INI_LOAD_JOURNAL sees the same values
+    ini_context_t *reader = ini_create_context();
+    assert(reader != NULL);
+    assert(ini_set_load_flags(reader, INI_LOAD_JOURNAL | INI_LOAD_LAZY) == INI_STATUS_SUCCESS);
+    assert(ini_load(reader, file) == INI_STATUS_SUCCESS);
+    expect_value(reader, "app", "mode", "slow");
+    expect_value(reader, "app", "level", NULL);
+    expect_value(reader, "extra", "on", "yes");
+    expect_value(reader, "app", "a", "1");
+    assert(!ini_is_dirty(reader));
+    assert(ini_free(reader) == INI_STATUS_SUCCESS);
+
+    // Without the flag only the file is read
+    reader = ini_create_context();
+    assert(reader != NULL);
+    assert(ini_load(reader, file) == INI_STATUS_SUCCESS);
+    expect_value(reader, "app", "mode", "fast");
+    assert(ini_free(reader) == INI_STATUS_SUCCESS);
+
+    // Switching the journal off stops recording
+    assert(ini_set_journal(ctx, NULL, NULL) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "app", "mode", "off") == INI_STATUS_SUCCESS);
+    replay_into(TEST_JOURNAL, &log);
+    assert(log.count == 5);
+    assert(ini_sync_journal(ctx) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_compact_journal(ctx) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_set_journal(NULL, file, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_set_journal(ctx, "", NULL) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    remove_test_file(TEST_JOURNAL);
+    print_success("test_journal_context_records_changes passed\n");
+}
+
+// Dirty test: A transaction whose journal batch is torn comes back not at all
+void test_journal_torn_transaction()
+{
+    char const *file = "test_journal.ini";
+    create_test_file(file, "[app]\nmode=fast\n");
+    remove(TEST_JOURNAL);
+
+    ini_journal_options_t const options = {0, 1};
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_journal(ctx, file, &options) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "app", "mode", "slow") == INI_STATUS_SUCCESS);
+    size_t const before = file_size(TEST_JOURNAL);
+
+    ini_txn_t *txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    assert(ini_txn_set(txn, "app", "a", "1") == INI_STATUS_SUCCESS);
+    assert(ini_txn_set(txn, "app", "b", "2") == INI_STATUS_SUCCESS);
+    assert(ini_txn_set(txn, "app", "c", "3") == INI_STATUS_SUCCESS);
+    assert(ini_txn_commit(txn, file) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    // The crash hits inside the second record of the transaction
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(TEST_JOURNAL, &data, &size) == INI_STATUS_SUCCESS);
+    size_t const record = sizeof(ini_journal_record_t) + sizeof("app") + sizeof("a") + sizeof("1");
+    write_bytes(TEST_JOURNAL, data, before + sizeof(ini_journal_batch_t) + record + 6);
+    free(data);
+
+    ini_context_t *reader = ini_create_context();
+    assert(reader != NULL);
+    assert(ini_set_load_flags(reader, INI_LOAD_JOURNAL) == INI_STATUS_SUCCESS);
+    assert(ini_load(reader, file) == INI_STATUS_SUCCESS);
+    expect_value(reader, "app", "mode", "slow");
+    expect_value(reader, "app", "a", NULL);
+    expect_value(reader, "app", "b", NULL);
+    assert(ini_free(reader) == INI_STATUS_SUCCESS);
+
+    // Opening the journal again drops the torn batch before anything is appended
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_journal(ctx, file, &options) == INI_STATUS_SUCCESS);
+    assert(file_size(TEST_JOURNAL) == before);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(file);
+    remove_test_file(TEST_JOURNAL);
+    print_success("test_journal_torn_transaction passed\n");
+}
+
+// Clean test: Reloads replay the journal, so changes not compacted yet are kept
+void test_journal_survives_reload()
+{
+    char const *file = "test_journal.ini";
+    create_test_file(file, "[s]\na=1\n");
+    remove(TEST_JOURNAL);
+
+    ini_journal_options_t const manual = {0, 1};
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_journal(ctx, file, &manual) == INI_STATUS_SUCCESS);
+    assert(ini_set_load_flags(ctx, INI_LOAD_JOURNAL | INI_LOAD_PRESERVE_FORMAT) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "s", "b", "2") == INI_STATUS_SUCCESS);
+
+    // Another writer changes the file; its size alone changes the fingerprint
+    int reloaded = 0;
+    create_test_file(file, "[s]\na=1\nc=3\n");
+    assert(ini_reload_if_changed(ctx, file, &reloaded) == INI_STATUS_SUCCESS);
+    assert(reloaded == 1);
+    expect_value(ctx, "s", "b", "2");
+    expect_value(ctx, "s", "c", "3");
+
+    // The journaled key is not reported as a change of the file
+    ini_change_set_t changes;
+    memset(&changes, 0, sizeof(changes));
+    create_test_file(file, "[s]\na=10\nc=3\n");
+    assert(ini_reload_incremental(ctx, file, &changes) == INI_STATUS_SUCCESS);
+    assert(changes.count == 1);
+    assert(changes.items[0].kind == INI_CHANGE_MODIFIED && strcmp(changes.items[0].key, "a") == 0);
+    ini_free_changes(&changes);
+    expect_value(ctx, "s", "a", "10");
+    expect_value(ctx, "s", "b", "2");
+
+    // The preserved text lacks the replayed value, so compaction still writes it
+    assert(ini_compact_journal(ctx) == INI_STATUS_SUCCESS);
+    expect_file_text(file, "[s]\na=10\nc=3\nb=2\n");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(file);
+    remove_test_file(TEST_JOURNAL);
+    print_success("test_journal_survives_reload passed\n");
+}
+
+// Clean test: Compaction folds the journal into the file, on demand and in the background
+void test_journal_compaction()
+{
+    char const *file = "test_journal.ini";
+    create_test_file(file, "[app]\nmode=fast\n");
+    remove(TEST_JOURNAL);
+
+    ini_journal_options_t const manual = {0, 0};
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_journal(ctx, file, &manual) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "app", "mode", "slow") == INI_STATUS_SUCCESS);
+    assert(ini_sync_journal(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_compact_journal(ctx) == INI_STATUS_SUCCESS);
+    assert(file_size(TEST_JOURNAL) == sizeof(ini_journal_header_t));
+
+    ini_context_t *reader = ini_create_context();
+    assert(reader != NULL);
+    assert(ini_load(reader, file) == INI_STATUS_SUCCESS);
+    expect_value(reader, "app", "mode", "slow");
+    assert(ini_free(reader) == INI_STATUS_SUCCESS);
+
+    // A small threshold: compactions start while values keep changing
+    ini_journal_options_t const automatic = {256, 16};
+    assert(ini_set_journal(ctx, file, &automatic) == INI_STATUS_SUCCESS);
+    for (int i = 0; i < 500; i++)
+    {
+        char key[16];
+        char value[16];
+        snprintf(key, sizeof(key), "k%d", i % 20);
+        snprintf(value, sizeof(value), "%d", i);
+        assert(ini_set_value(ctx, "counters", key, value) == INI_STATUS_SUCCESS);
+    }
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS); // Waits for the compactor
+
+    // The file alone has some of the values; file plus journal has all of them
+    reader = ini_create_context();
+    assert(reader != NULL);
+    assert(ini_load(reader, file) == INI_STATUS_SUCCESS);
+    assert(ini_get_section(reader, "counters") != NULL);
+    assert(ini_free(reader) == INI_STATUS_SUCCESS);
+
+    reader = ini_create_context();
+    assert(reader != NULL);
+    assert(ini_set_load_flags(reader, INI_LOAD_JOURNAL) == INI_STATUS_SUCCESS);
+    assert(ini_load(reader, file) == INI_STATUS_SUCCESS);
+    expect_value(reader, "counters", "k0", "480");
+    expect_value(reader, "counters", "k19", "499");
+    expect_value(reader, "app", "mode", "slow");
+    assert(ini_free(reader) == INI_STATUS_SUCCESS);
+
+    // A context that preserves the format compacts into the same layout and keeps the written text
+    create_test_file(file, "; settings\n[app]\n  mode = fast ; default\nlevel=1\n");
+    remove(TEST_JOURNAL);
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_journal(ctx, file, &manual) == INI_STATUS_SUCCESS);
+    assert(ini_set_load_flags(ctx, INI_LOAD_JOURNAL | INI_LOAD_PRESERVE_FORMAT) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "app", "level", "2") == INI_STATUS_SUCCESS);
+    assert(ini_compact_journal(ctx) == INI_STATUS_SUCCESS);
+    char const *compacted = "; settings\n[app]\n  mode = fast ; default\nlevel=2\n";
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, compacted) == 0);
+    free(data);
+    assert(ctx->document_size == strlen(compacted) && memcmp(ctx->document, compacted, ctx->document_size) == 0);
+
+    assert(ini_set_value(ctx, "app", "mode", "slow") == INI_STATUS_SUCCESS);
+    assert(ini_compact_journal(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_read_file(file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "; settings\n[app]\nmode=slow\nlevel=2\n") == 0);
+    free(data);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(file);
+    remove_test_file(TEST_JOURNAL);
+    print_success("test_journal_compaction passed\n");
+}
+
+int main()
+{
+    __helper_init_log_file();
+
+    test_journal_append_and_replay();
+    test_journal_damaged_records();
+    test_journal_drop();
+    test_journal_context_records_changes();
+    test_journal_torn_transaction();
+    test_journal_compaction();
+    test_journal_survives_reload();
+
+    print_success("All ini_journal tests passed!\n\n");
+    __helper_close_log_file();
+    return EXIT_SUCCESS;
+}
@@ -6,6 +6,7 @@
 #include "helper.h"
 
 #include "ini_mutex.h"
+#include "ini_thread.h"
 
 // Clean test: Successfully initialize and destroy a mutex
 void test_mutex_init_destroy_success()
@@ -141,11 +142,15 @@ void test_mutex_recursive_lock()
     assert(ini_mutex_lock(&mutex) == INI_STATUS_SUCCESS);
     assert(mutex.locked == INI_MUTEX_LOCKED);
 
-    // First unlock
+    // First unlock only undoes the inner lock
+    assert(ini_mutex_unlock(&mutex) == INI_STATUS_SUCCESS);
+    assert(mutex.locked == INI_MUTEX_LOCKED);
+
+    // Second unlock releases the mutex
     assert(ini_mutex_unlock(&mutex) == INI_STATUS_SUCCESS);
     assert(mutex.locked == INI_MUTEX_UNLOCKED);
 
-    // Second unlock
+    // Third unlock
     // Should return success even if already unlocked
     // because this function does nothing if mutex is not locked, just returns success
     assert(ini_mutex_unlock(&mutex) == INI_STATUS_SUCCESS);
@@ -169,6 +174,87 @@ void test_mutex_destroy_locked()
     print_success("test_mutex_destroy_locked passed\n");
 }
 
+typedef struct
+{
+    ini_mutex_t *mutex;
+    int acquired;
+} contender_t;
+
+static void contend_for_mutex(void *arg)
+{
+    contender_t *contender = (contender_t *)arg;
+    assert(ini_mutex_lock(contender->mutex) == INI_STATUS_SUCCESS);
+    contender->acquired = 1;
+    assert(ini_mutex_unlock(contender->mutex) == INI_STATUS_SUCCESS);
+}
+
+// Clean test: Another thread blocks while the mutex is held
+void test_mutex_blocks_other_threads()
+{
+    ini_mutex_t mutex = INI_MUTEX_INITIALIZER;
+    assert(ini_mutex_init(&mutex) == INI_STATUS_SUCCESS);
+    assert(ini_mutex_lock(&mutex) == INI_STATUS_SUCCESS);
+
+    contender_t contender = {&mutex, 0};
+    ini_thread_t thread;
+    assert(ini_thread_create(&thread, contend_for_mutex, &contender) == INI_STATUS_SUCCESS);
+
+    ini_thread_sleep(50);
+    assert(contender.acquired == 0);
+
+    assert(ini_mutex_unlock(&mutex) == INI_STATUS_SUCCESS);
+    assert(ini_thread_join(&thread) == INI_STATUS_SUCCESS);
+    assert(contender.acquired == 1);
+
+    assert(ini_mutex_destroy(&mutex) == INI_STATUS_SUCCESS);
+    print_success("test_mutex_blocks_other_threads passed\n");
+}
+
+typedef struct
+{
+    ini_mutex_t mutex;
+    ini_cond_t cond;
+    int ready;
+} signal_t;
+
+static void raise_signal(void *arg)
+{
+    signal_t *signal = (signal_t *)arg;
+    ini_thread_sleep(20);
+    assert(ini_mutex_lock(&signal->mutex) == INI_STATUS_SUCCESS);
+    signal->ready = 1;
+    assert(ini_cond_broadcast(&signal->cond) == INI_STATUS_SUCCESS);
+    assert(ini_mutex_unlock(&signal->mutex) == INI_STATUS_SUCCESS);
+}
+
+// Clean test: A wait releases a nested lock as a whole and restores its depth
+void test_cond_wait_nested_lock()
+{
+    signal_t signal;
+    memset(&signal, 0, sizeof(signal));
+    assert(ini_mutex_init(&signal.mutex) == INI_STATUS_SUCCESS);
+    assert(ini_cond_init(&signal.cond) == INI_STATUS_SUCCESS);
+    assert(ini_cond_wait(&signal.cond, &signal.mutex) == INI_STATUS_INVALID_ARGUMENT); // Not held
+
+    assert(ini_mutex_lock(&signal.mutex) == INI_STATUS_SUCCESS);
+    assert(ini_mutex_lock(&signal.mutex) == INI_STATUS_SUCCESS);
+
+    ini_thread_t thread;
+    assert(ini_thread_create(&thread, raise_signal, &signal) == INI_STATUS_SUCCESS);
+    while (!signal.ready)
+        assert(ini_cond_wait(&signal.cond, &signal.mutex) == INI_STATUS_SUCCESS);
+
+    assert(ini_mutex_unlock(&signal.mutex) == INI_STATUS_SUCCESS);
+    assert(signal.mutex.locked == INI_MUTEX_LOCKED);
+    assert(ini_mutex_unlock(&signal.mutex) == INI_STATUS_SUCCESS);
+    assert(signal.mutex.locked == INI_MUTEX_UNLOCKED);
+
+    assert(ini_thread_join(&thread) == INI_STATUS_SUCCESS);
+    assert(ini_cond_destroy(&signal.cond) == INI_STATUS_SUCCESS);
+    assert(ini_mutex_destroy(&signal.mutex) == INI_STATUS_SUCCESS);
+    print_success("test_cond_wait_nested_lock passed\n");
+}
+
 int main()
 {
     __helper_init_log_file();
@@ -184,6 +270,8 @@ int main()
     test_mutex_locked_state();
     test_mutex_recursive_lock();
     test_mutex_destroy_locked();
+    test_mutex_blocks_other_threads();
+    test_cond_wait_nested_lock();
 
     print_success("All ini_mutex tests passed!\n\n");
     __helper_close_log_file();
@@ -0,0 +1,227 @@
+#include <assert.h>
+#include <locale.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helper.h"
+
+#include "ini_number.h"
+
+// Clean test: Decimal and hexadecimal integers up to the int64 limits
+void test_parse_int64_valid()
+{
+    int64_t value = 0;
+    assert(ini_parse_int64("0", &value) == INI_STATUS_SUCCESS && value == 0);
+    assert(ini_parse_int64("42", &value) == INI_STATUS_SUCCESS && value == 42);
+    assert(ini_parse_int64("+17", &value) == INI_STATUS_SUCCESS && value == 17);
+    assert(ini_parse_int64("-17", &value) == INI_STATUS_SUCCESS && value == -17);
+    assert(ini_parse_int64("007", &value) == INI_STATUS_SUCCESS && value == 7);
+    assert(ini_parse_int64("0x1F", &value) == INI_STATUS_SUCCESS && value == 31);
+    assert(ini_parse_int64("-0Xff", &value) == INI_STATUS_SUCCESS && value == -255);
+    assert(ini_parse_int64("9223372036854775807", &value) == INI_STATUS_SUCCESS && value == INT64_MAX);
+    assert(ini_parse_int64("-9223372036854775808", &value) == INI_STATUS_SUCCESS && value == INT64_MIN);
+    assert(ini_parse_int64("0x7fffffffffffffff", &value) == INI_STATUS_SUCCESS && value == INT64_MAX);
+    print_success("test_parse_int64_valid passed\n");
+}
+
+// Dirty test: Anything but a whole in-range integer is a type mismatch and leaves the output alone
+void test_parse_int64_invalid()
+{
+    char const *bad[] = {"",     "-",   "+",   " 1", "1 ",  "1.5", "12abc", "0x", "0xg",
+                         "--1",  "1e3", "abc", "9223372036854775808", "-9223372036854775809",
+                         "0x8000000000000000", "99999999999999999999999"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+    {
+        int64_t value = 123;
+        assert(ini_parse_int64(bad[i], &value) == INI_STATUS_TYPE_MISMATCH);
+        assert(value == 123);
+    }
+
+    int64_t value = 0;
+    assert(ini_parse_int64(NULL, &value) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_parse_int64("1", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    print_success("test_parse_int64_invalid passed\n");
+}
+
+// Clean test: Doubles match strtod() on both the fast and the slow path
+void test_parse_double_valid()
+{
+    char const *inputs[] = {"0",      "1",        "-2.5",           "3.14159",          ".5",
+                            "5.",     "1e10",     "1E-5",           "+6.02214076e23",   "0.1",
+                            "123456789012345678901234567890",     "1.7976931348623157e308",
+                            "4.9e-324", "2.2250738585072014e-308", "0.000000000000000000000000001",
+                            "9007199254740993", "1e-400"};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        double value = -1.0;
+        assert(ini_parse_double(inputs[i], &value) == INI_STATUS_SUCCESS);
+        assert(value == strtod(inputs[i], NULL));
+    }
+
+    double value = 0.0;
+    assert(ini_parse_double("inf", &value) == INI_STATUS_SUCCESS && isinf(value) && value > 0);
+    assert(ini_parse_double("-Infinity", &value) == INI_STATUS_SUCCESS && isinf(value) && value < 0);
+    assert(ini_parse_double("NaN", &value) == INI_STATUS_SUCCESS && isnan(value));
+    print_success("test_parse_double_valid passed\n");
+}
+
+// Dirty test: Malformed or overflowing doubles are type mismatches
+void test_parse_double_invalid()
+{
+    char const *bad[] = {"", ".", "-", "e5", "1e", "1e+", "1.2.3", " 1", "1 ", "1,5", "0x10", "infinite", "1e400"};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+    {
+        double value = 7.0;
+        assert(ini_parse_double(bad[i], &value) == INI_STATUS_TYPE_MISMATCH);
+        assert(value == 7.0);
+    }
+
+    double value = 0.0;
+    assert(ini_parse_double(NULL, &value) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_parse_double("1", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    print_success("test_parse_double_invalid passed\n");
+}
+
+// Clean test: A locale with a comma separator does not change how '.' is read
+void test_parse_double_ignores_locale()
+{
+    char const *locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "ru_RU.UTF-8"};
+    char const *selected = NULL;
+    for (size_t i = 0; i < sizeof(locales) / sizeof(locales[0]) && !selected; i++)
+        selected = setlocale(LC_NUMERIC, locales[i]);
+    if (!selected)
+    {
+        print_success("test_parse_double_ignores_locale skipped (no comma locale installed)\n");
+        return;
+    }
+
+    double value = 0.0;
+    assert(ini_parse_double("2.5", &value) == INI_STATUS_SUCCESS && value == 2.5);
+    // Long enough for the strtod() path
+    assert(ini_parse_double("0.1000000000000000055511151231257827", &value) == INI_STATUS_SUCCESS && value == 0.1);
+    assert(ini_parse_double("2,5", &value) == INI_STATUS_TYPE_MISMATCH);
+
+    setlocale(LC_NUMERIC, "C");
+    print_success("test_parse_double_ignores_locale passed\n");
+}
+
+// Clean test: Boolean words in any case
+void test_parse_bool()
+{
+    char const *truthy[] = {"true", "TRUE", "Yes", "on", "1"};
+    char const *falsy[] = {"false", "False", "NO", "off", "0"};
+    for (size_t i = 0; i < 5; i++)
+    {
+        int value = -1;
+        assert(ini_parse_bool(truthy[i], &value) == INI_STATUS_SUCCESS && value == 1);
+        assert(ini_parse_bool(falsy[i], &value) == INI_STATUS_SUCCESS && value == 0);
+    }
+
+    int value = -1;
+    assert(ini_parse_bool("", &value) == INI_STATUS_TYPE_MISMATCH);
+    assert(ini_parse_bool("truee", &value) == INI_STATUS_TYPE_MISMATCH);
+    assert(ini_parse_bool("2", &value) == INI_STATUS_TYPE_MISMATCH);
+    assert(ini_parse_bool(" on", &value) == INI_STATUS_TYPE_MISMATCH);
+    assert(value == -1);
+    assert(ini_parse_bool(NULL, &value) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_parse_bool("1", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    print_success("test_parse_bool passed\n");
+}
+
+// Clean test: Doubles are written in their short form and read back exactly
+void test_format_double()
+{
+    struct
+    {
+        double value;
+        char const *text;
+    } const cases[] = {
+        {0.0, "0"},
+        {-0.0, "-0"},
+        {0.1, "0.1"},
+        {-2.5, "-2.5"},
+        {1500.0, "1500"},
+        {0.000001, "0.000001"},
+        {1e-7, "1e-7"},
+        {1e21, "1e+21"},
+        {123456789012345680000.0, "123456789012345680000"},
+        {5e-324, "5e-324"},
+        {1.7976931348623157e308, "1.7976931348623157e+308"},
+        {0.30000000000000004, "0.30000000000000004"},
+    };
+    char buffer[INI_NUMBER_BUFFER_SIZE];
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        assert(ini_format_double(cases[i].value, buffer) == strlen(cases[i].text));
+        assert(strcmp(buffer, cases[i].text) == 0);
+    }
+
+    assert(ini_format_double(HUGE_VAL, buffer) == 3 && strcmp(buffer, "inf") == 0);
+    assert(ini_format_double(-HUGE_VAL, buffer) == 4 && strcmp(buffer, "-inf") == 0);
+    assert(ini_format_double(NAN, buffer) == 3 && strcmp(buffer, "nan") == 0);
+    assert(ini_format_double(1.0, NULL) == 0);
+
+    // Bit patterns spread over the whole range, subnormals included
+    uint64_t bits = 0x9E3779B97F4A7C15u;
+    for (int i = 0; i < 100000; i++)
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isnan(value) || isinf(value))
+            continue;
+        double parsed = 0.0;
+        assert(ini_format_double(value, buffer) < INI_NUMBER_BUFFER_SIZE);
+        assert(ini_parse_double(buffer, &parsed) == INI_STATUS_SUCCESS && parsed == value);
+    }
+    print_success("test_format_double passed\n");
+}
+
+// Clean test: Floats use their own precision
+void test_format_float()
+{
+    char buffer[INI_NUMBER_BUFFER_SIZE];
+    assert(ini_format_float(0.1f, buffer) == 3 && strcmp(buffer, "0.1") == 0);
+    assert(ini_format_float(3.14159f, buffer) && strcmp(buffer, "3.14159") == 0);
+    assert(ini_format_float(16777216.0f, buffer) && strcmp(buffer, "16777216") == 0);
+    assert(ini_format_float(1e-45f, buffer) && strcmp(buffer, "1e-45") == 0);
+    assert(ini_format_float(-HUGE_VALF, buffer) && strcmp(buffer, "-inf") == 0);
+
+    uint32_t bits = 0x2545F491u;
+    for (int i = 0; i < 100000; i++)
+    {
+        bits ^= bits << 13;
+        bits ^= bits >> 17;
+        bits ^= bits << 5;
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        if (isnan(value) || isinf(value))
+            continue;
+        double parsed = 0.0;
+        ini_format_float(value, buffer);
+        assert(ini_parse_double(buffer, &parsed) == INI_STATUS_SUCCESS && (float)parsed == value);
+    }
+    print_success("test_format_float passed\n");
+}
+
+int main()
+{
+    __helper_init_log_file();
+
+    test_parse_int64_valid();
+    test_parse_int64_invalid();
+    test_parse_double_valid();
+    test_parse_double_invalid();
+    test_parse_double_ignores_locale();
+    test_parse_bool();
+    test_format_double();
+    test_format_float();
+
+    print_success("All ini_number tests passed!\n\n");
+    __helper_close_log_file();
+    return EXIT_SUCCESS;
+}
@@ -15,6 +15,7 @@
 #endif
 
 #include "helper.h"
+#include "ini_binary.h"
 #include "ini_parser.h"
 
 // ======================================================================== //
@@ -751,13 +752,13 @@ void test_ini_good_bad_format_unbalanced_quotes()
     remove_test_file(TEST_FILE);
 }
 
-void test_ini_good_bad_format_arrays_not_supported()
+void test_ini_good_comma_lists()
 {
-    char TEST_FILE[] = "test_bad_format_arrays_not_supported.ini";
-    create_test_file(TEST_FILE, "[section]\nkey=1,2,3\n");
+    char TEST_FILE[] = "test_comma_lists.ini";
+    create_test_file(TEST_FILE, "[section]\nkey=1,2,3\nhosts[]=a\nhosts[]=b\n");
     ini_status_t err = ini_good(TEST_FILE);
-    assert(err == INI_STATUS_FILE_BAD_FORMAT);
-    print_success("test_ini_good_bad_format_arrays_not_supported passed\n");
+    assert(err == INI_STATUS_SUCCESS);
+    print_success("test_ini_good_comma_lists passed\n");
     remove_test_file(TEST_FILE);
 }
 
@@ -972,17 +973,24 @@ void test_ini_load_bad_format_unbalanced_quotes()
     print_success("test_ini_load_bad_format_unbalanced_quotes passed\n");
 }
 
-void test_ini_load_bad_format_arrays_not_supported()
+void test_ini_load_comma_lists()
 {
-    create_test_file("bad_arrays.ini", "[section]\nkey=1,2,3\n");
+    create_test_file("comma_lists.ini", "[section]\nkey=1,2,3\n");
     ini_context_t *ctx = ini_create_context();
     assert(ctx != NULL);
-    ini_status_t err = ini_load(ctx, "bad_arrays.ini");
-    assert(err == INI_STATUS_FILE_BAD_FORMAT);
-    remove_test_file("bad_arrays.ini");
+    ini_status_t err = ini_load(ctx, "comma_lists.ini");
+    assert(err == INI_STATUS_SUCCESS);
+    remove_test_file("comma_lists.ini");
+
+    // The value keeps its text; ini_get_array() splits it
+    char *value = NULL;
+    assert(ini_get_value(ctx, "section", "key", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "1,2,3") == 0);
+    free(value);
+
     err = ini_free(ctx);
     assert(err == INI_STATUS_SUCCESS);
-    print_success("test_ini_load_bad_format_arrays_not_supported passed\n");
+    print_success("test_ini_load_comma_lists passed\n");
 }
 
 void test_ini_load_utf8_chars()
@@ -2089,6 +2097,99 @@ void test_save_section_value_thread_safety()
     print_success("test_save_section_value_thread_safety passed\n");
 #endif
 }
+
+// Clean test: Updating a key in an existing file keeps the rest of it, at every durability level
+void test_save_section_value_existing_file_durability()
+{
+    char TEST_FILE_LOAD[] = "test_save_section_value_existing_file_durability_load.ini";
+    char TEST_FILE_SAVE[] = "test_save_section_value_existing_file_durability_save.ini";
+
+    create_test_file(TEST_FILE_LOAD, "[section1]\nkey1=updated value\n");
+    create_test_file(TEST_FILE_SAVE, "; settings\n[section1]\nkey1=original\nkey2=value2\n\n[section2]\nkey3=value3\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE_LOAD) == INI_STATUS_SUCCESS);
+    assert(ini_set_durability(ctx, (ini_durability_t)42) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_set_durability(NULL, INI_DURABILITY_FILE) == INI_STATUS_INVALID_ARGUMENT);
+
+    ini_durability_t const levels[] = {INI_DURABILITY_NONE, INI_DURABILITY_FILE, INI_DURABILITY_DIRECTORY};
+    for (size_t i = 0; i < 3; i++)
+    {
+        assert(ini_set_durability(ctx, levels[i]) == INI_STATUS_SUCCESS);
+        assert(ini_save_section_value(ctx, TEST_FILE_SAVE, "section1", "key1") == INI_STATUS_SUCCESS);
+
+        // Only the key line changed; the comment and the other keys stay as they were
+        char *data = NULL;
+        size_t size = 0;
+        assert(ini_read_file(TEST_FILE_SAVE, &data, &size) == INI_STATUS_SUCCESS);
+        assert(strcmp(data, "; settings\n[section1]\nkey1=\"updated value\"\nkey2=value2\n\n[section2]\nkey3=value3\n") ==
+               0);
+        free(data);
+    }
+
+    // ini_save() honours the setting too
+    assert(ini_save(ctx, TEST_FILE_SAVE) == INI_STATUS_SUCCESS);
+    ini_context_t *ctx2 = ini_create_context();
+    assert(ctx2 != NULL);
+    assert(ini_load(ctx2, TEST_FILE_SAVE) == INI_STATUS_SUCCESS);
+    char *value = NULL;
+    assert(ini_get_value(ctx2, "section1", "key1", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "updated value") == 0);
+    free(value);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx2) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE_LOAD);
+    remove_test_file(TEST_FILE_SAVE);
+    print_success("test_save_section_value_existing_file_durability passed\n");
+}
+
+// Clean test: Saving into an existing file touches only the affected lines
+void test_save_section_value_patches_in_place()
+{
+    char TEST_FILE_LOAD[] = "test_save_section_value_patches_in_place_load.ini";
+    char TEST_FILE_SAVE[] = "test_save_section_value_patches_in_place_save.ini";
+
+    create_test_file(TEST_FILE_LOAD, "[app]\nname=new name\nport=9090\nadded=yes\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE_LOAD) == INI_STATUS_SUCCESS);
+
+    // A whole section: known keys are replaced where they stand, unknown lines kept, missing keys added
+    create_test_file(TEST_FILE_SAVE, "# head\n[app]\n  name = old   ; note\n; comment\nport=80\nextra=1\n\n[db]\nport=5432\n");
+    assert(ini_save_section_value(ctx, TEST_FILE_SAVE, "app", NULL) == INI_STATUS_SUCCESS);
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(TEST_FILE_SAVE, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "# head\n[app]\nname=\"new name\"\n; comment\nport=9090\nextra=1\nadded=yes\n\n[db]\nport=5432\n") == 0);
+    free(data);
+
+    // One key missing from the section is added after its last key, even without a final newline
+    create_test_file(TEST_FILE_SAVE, "[app]\nport=80");
+    assert(ini_save_section_value(ctx, TEST_FILE_SAVE, "app", "added") == INI_STATUS_SUCCESS);
+    assert(ini_read_file(TEST_FILE_SAVE, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "[app]\nport=80\nadded=yes\n") == 0);
+    free(data);
+
+    // A missing section is appended; an empty file just gets the section
+    create_test_file(TEST_FILE_SAVE, "[db]\nport=5432\n");
+    assert(ini_save_section_value(ctx, TEST_FILE_SAVE, "app", "port") == INI_STATUS_SUCCESS);
+    assert(ini_read_file(TEST_FILE_SAVE, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "[db]\nport=5432\n\n[app]\nport=9090\n") == 0);
+    free(data);
+
+    create_test_file(TEST_FILE_SAVE, "");
+    assert(ini_save_section_value(ctx, TEST_FILE_SAVE, "app", "port") == INI_STATUS_SUCCESS);
+    assert(ini_read_file(TEST_FILE_SAVE, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "[app]\nport=9090\n") == 0);
+    free(data);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE_LOAD);
+    remove_test_file(TEST_FILE_SAVE);
+    print_success("test_save_section_value_patches_in_place passed\n");
+}
 // ************************************************************************ //
 // ======================================================================== //
 
@@ -2591,146 +2692,2036 @@ void test_ini_save_to_existing_file()
     remove_test_file(TEST_FILE_SAVE);
     print_success("test_ini_save_to_existing_file passed\n");
 }
+
+// Clean test: Quoting is decided per value wherever the special character falls, and the file holds exactly the text
+void test_ini_save_quoting_positions()
+{
+    char TEST_FILE_LOAD[] = "test_ini_save_quoting_positions_load.ini";
+    char TEST_FILE_SAVE[] = "test_ini_save_quoting_positions_save.ini";
+    char TEST_FILE_EXACT[] = "test_ini_save_quoting_positions_exact.ini";
+    // Long values put the character in the word-wise scan, short ones in the tail
+    create_test_file(TEST_FILE_LOAD, "[s]\n"
+                                     "a=\"abcdefghijklmn#p\"\n"
+                                     "b=\"abcdefg;\"\n"
+                                     "c=\"ab\tc\"\n"
+                                     "d=abcdefghijklmnopqrstuvwxyz\n"
+                                     "e=\"abcdefghijklmnopq r\"\n"
+                                     "f=x\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE_LOAD) == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, TEST_FILE_SAVE) == INI_STATUS_SUCCESS);
+
+    ini_context_t *ctx2 = ini_create_context();
+    assert(ctx2 != NULL);
+    assert(ini_load(ctx2, TEST_FILE_SAVE) == INI_STATUS_SUCCESS);
+    char const *keys[] = {"a", "b", "c", "d", "e", "f"};
+    char const *expected[] = {"abcdefghijklmn#p", "abcdefg;", "ab\tc", "abcdefghijklmnopqrstuvwxyz",
+                              "abcdefghijklmnopq r", "x"};
+    for (size_t i = 0; i < 6; i++)
+    {
+        char *value = NULL;
+        assert(ini_get_value(ctx2, "s", keys[i], &value) == INI_STATUS_SUCCESS);
+        assert(strcmp(value, expected[i]) == 0);
+        free(value);
+    }
+
+    // Section order follows the table, so either order is accepted
+    create_test_file(TEST_FILE_LOAD, "[one]\nk=1\n[two]\nkey=\"two words\"\n");
+    ini_context_t *ctx3 = ini_create_context();
+    assert(ctx3 != NULL);
+    assert(ini_load(ctx3, TEST_FILE_LOAD) == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx3, TEST_FILE_EXACT) == INI_STATUS_SUCCESS);
+    FILE *file = fopen(TEST_FILE_EXACT, "rb");
+    assert(file != NULL);
+    char buffer[256] = {0};
+    size_t size = fread(buffer, 1, sizeof(buffer) - 1, file);
+    fclose(file);
+    assert(size == strlen(buffer));
+    assert(strcmp(buffer, "[one]\nk=1\n\n[two]\nkey=\"two words\"\n") == 0 ||
+           strcmp(buffer, "[two]\nkey=\"two words\"\n\n[one]\nk=1\n") == 0);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx2) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx3) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE_LOAD);
+    remove_test_file(TEST_FILE_SAVE);
+    remove_test_file(TEST_FILE_EXACT);
+    print_success("test_ini_save_quoting_positions passed\n");
+}
 // ************************************************************************ //
 // ======================================================================== //
 
-int main()
+// ======================================================================== //
+// === Test 9. ini_load() in-situ mode ==================================== //
+// ======================================================================== //
+void test_ini_load_insitu_values()
 {
-    __helper_init_log_file();
+    char TEST_FILE[] = "test_ini_load_insitu_values.ini";
+    create_test_file(TEST_FILE, "[section]\r\n  key = value \r\nquoted=\"a b\"\n[other]\nk=v");
 
-    // === Test 1. ini_create_context() ====== //
-    test_ini_create_context_success();
-    test_ini_create_context_platform_specific();
-    test_ini_create_context_reentrancy();
-    test_ini_create_context_resource_leak();
-    print_success("All ini_create_context() tests passed!\n\n");
-    // ======================================= //
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_INSITU) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ctx->buffer != NULL);
 
-    // === Test 2. ini_create_context() ====== //
-    test_ini_free_null_context();
-    test_ini_free_empty_context();
-    test_ini_free_loaded_context();
-    test_ini_free_double_free();
-    test_ini_free_platform_specific();
-    test_ini_free_memory_leak();
-    test_ini_free_with_sections();
-    test_ini_free_with_subsections();
-    print_success("All ini_free() tests passed!\n\n");
-    // ======================================= //
+    char *value = NULL;
+    assert(ini_get_value(ctx, "section", "key", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "value") == 0);
+    free(value);
 
-    // === Test 3. ini_get_value() =========== //
-    test_ini_get_value_empty_value();
-    test_ini_get_value_get_existing_value();
-    test_ini_get_value_key_not_found();
-    test_ini_get_value_section_not_found();
-    test_ini_get_value_subsection();
-    test_ini_get_value_whitespace_value();
-    test_ini_get_value_unicode();
-    test_ini_get_value_utf8_bom();
-    test_ini_get_value_quoted_values();
-    test_ini_get_value_null_arguments();
-    test_ini_get_value_reuse_value_pointer();
-    test_ini_get_value_existing_value_memory();
-    test_ini_get_value_thread_safety();
-    test_ini_get_value_reuse_context();
-    test_ini_get_value_corrupted_file();
-    print_success("All ini_get_value() tests passed!\n\n");
-    // ======================================= //
+    assert(ini_get_value(ctx, "section", "quoted", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "a b") == 0);
+    free(value);
 
-    // === Test 4. ini_good() ================ //
-    test_ini_good_null_filepath();
-    test_ini_good_nonexistent_file();
-    // test_ini_good_directory();
-    test_ini_good_empty_file();
-    test_ini_good_valid_file();
-    test_ini_good_bad_format_missing_bracket();
-    test_ini_good_bad_format_empty_key();
-    test_ini_good_empty_value();
-    test_ini_good_no_read_permission();
-    test_ini_good_bad_format_unbalanced_quotes();
-    test_ini_good_bad_format_arrays_not_supported();
-    test_ini_good_utf8_chars();
-    test_ini_good_windows_line_endings();
-    test_ini_good_line_too_long();
-    test_ini_good_file_deleted_during_check();
-    test_ini_good_binary_data();
-    test_ini_good_symlink();
-    test_ini_good_special_chars();
-    print_success("All ini_good() tests passed!\n\n");
-    // ======================================= //
+    assert(ini_get_value(ctx, "other", "k", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "v") == 0);
+    free(value);
 
-    // === Test 5. ini_load() ================ //
-    test_ini_load_null_ctx_and_filepath();
-    test_ini_load_null_filepath();
-    test_ini_load_nonexistent_file();
-    // test_ini_load_directory();
-    test_ini_load_empty_file();
-    test_ini_load_valid_file();
-    test_ini_load_bad_format_missing_bracket();
-    test_ini_load_bad_format_empty_key();
-    test_ini_load_empty_value();
-    test_ini_load_bad_format_unbalanced_quotes();
-    test_ini_load_bad_format_arrays_not_supported();
-    test_ini_load_utf8_chars();
-    test_ini_load_windows_line_endings();
-    test_ini_load_line_too_long();
-    test_ini_load_file_deleted_during_check();
-    test_ini_load_binary_data();
-    test_ini_load_reuse_ctx();
-    test_ini_load_no_read_permission();
-    test_ini_load_symlink();
-    test_ini_load_special_chars();
-    print_success("All ini_load() tests passed!\n\n");
-    // ======================================= //
+    // Entries point into the context buffer instead of separate allocations
+    ini_ht_t *section_ht = ini_get_section_ht(ctx->sections, "section");
+    assert(section_ht != NULL);
+    char const *stored = ini_ht_get(section_ht, "key");
+    assert(stored >= ctx->buffer && stored < ctx->buffer + ctx->buffer_size);
 
-    // === Test 6. ini_print() =============== //
-    test_ini_print_basic_section();
-    test_ini_print_with_subsections();
-    test_ini_print_unicode();
-    test_ini_print_null_stream();
-    test_ini_print_null_ctx();
-    test_ini_print_malformed_section_names();
-    test_ini_print_malformed_pairs();
-    test_ini_print_large_output();
-    test_ini_print_stream_errors();
-    test_ini_print_fprintf_failure();
-    test_ini_print_long_names();
-    test_ini_print_empty_sections();
-    test_ini_print_mixed_encoding();
-    print_success("All ini_print() tests passed!\n\n");
-    // ======================================= //
+    // Updating a borrowed value copies the new one
+    assert(ini_ht_set(section_ht, "key", "updated") != NULL);
+    assert(ini_get_value(ctx, "section", "key", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "updated") == 0);
+    free(value);
 
-    // === Test 7. ini_save_section_value() == //
-    test_save_section_value_null_context();
-    test_save_section_value_null_filepath();
-    test_save_section_value_null_section();
-    test_save_section_value_section_not_found();
-    test_save_section_value_key_not_found();
-    test_save_section_value_save_section_key();
-    test_save_section_value_save_entire_section();
-    test_save_section_value_update_existing_file();
-    test_save_section_value_subsection_save();
-    test_save_section_value_save_with_special_chars();
-    test_save_section_value_save_empty_value();
-    test_save_section_value_unicode();
-    // test_save_section_value_to_directory();
-    // test_save_section_value_no_write_permission();
-    test_save_section_value_thread_safety();
-    print_success("All ini_save_section_value() tests passed!\n\n");
-    // ======================================= //
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_insitu_values passed\n");
+}
 
-    // === Test 8. ini_save() ================ //
-    test_ini_save_null_context();
-    test_ini_save_null_filepath();
-    test_ini_save_empty_context();
-    test_ini_save_simple_context();
-    test_ini_save_with_subsections();
-    test_ini_save_with_special_chars();
-    test_ini_save_empty_values();
-    test_ini_save_unicode();
-    test_ini_save_to_existing_file();
-    test_ini_save_thread_safety();
-    print_success("All ini_save() tests passed!\n\n");
+void test_ini_load_insitu_duplicate_sections()
+{
+    char TEST_FILE[] = "test_ini_load_insitu_duplicate_sections.ini";
+    create_test_file(TEST_FILE, "[a]\nx=1\ny=2\n[b]\nz=3\n[a]\nx=4\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_INSITU) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "a", "x", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "4") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "a", "y", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "2") == 0);
+    free(value);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_insitu_duplicate_sections passed\n");
+}
+
+void test_ini_load_insitu_bad_format_keeps_context()
+{
+    char GOOD_FILE[] = "test_ini_load_insitu_good.ini";
+    char BAD_FILE[] = "test_ini_load_insitu_bad.ini";
+    create_test_file(GOOD_FILE, "[section]\nkey=value\n");
+    create_test_file(BAD_FILE, "[section\nkey=other\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_INSITU) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, GOOD_FILE) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, BAD_FILE) == INI_STATUS_FILE_BAD_FORMAT);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "section", "key", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "value") == 0);
+    free(value);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(GOOD_FILE);
+    remove_test_file(BAD_FILE);
+    print_success("test_ini_load_insitu_bad_format_keeps_context passed\n");
+}
+
+void test_ini_set_load_flags_invalid()
+{
+    assert(ini_set_load_flags(NULL, INI_LOAD_INSITU) == INI_STATUS_INVALID_ARGUMENT);
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, 0x80000000u) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    print_success("test_ini_set_load_flags_invalid passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 10. ini_load_sections() ======================================= //
+// ======================================================================== //
+void test_ini_load_sections_selected()
+{
+    char TEST_FILE[] = "test_ini_load_sections_selected.ini";
+    create_test_file(TEST_FILE,
+                     "[fleet]\nregion=eu\n"
+                     "[db]\nhost=db.local\n"
+                     "[cache]\nsize=64\n"
+                     "[db]\nport=5432\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+
+    char const *wanted[] = {"db", "missing"};
+    assert(ini_load_sections(ctx, TEST_FILE, wanted, 2) == INI_STATUS_SUCCESS);
+
+    // Repeated headers of a kept section are merged
+    char *value = NULL;
+    assert(ini_get_value(ctx, "db", "host", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "db.local") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "db", "port", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "5432") == 0);
+    free(value);
+
+    assert(ini_get_value(ctx, "fleet", "region", &value) == INI_STATUS_SECTION_NOT_FOUND);
+    assert(ini_get_value(ctx, "cache", "size", &value) == INI_STATUS_SECTION_NOT_FOUND);
+    assert(ini_get_value(ctx, "missing", "key", &value) == INI_STATUS_SECTION_NOT_FOUND);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_sections_selected passed\n");
+}
+
+void test_ini_load_sections_skips_bad_sections()
+{
+    char TEST_FILE[] = "test_ini_load_sections_skips_bad_sections.ini";
+    create_test_file(TEST_FILE,
+                     "[legacy]\nlist=1,2,3\n=broken\n"
+                     "  [app]\nname=demo\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+
+    // Skipped sections are not validated...
+    char const *wanted[] = {"app"};
+    assert(ini_load_sections(ctx, TEST_FILE, wanted, 1) == INI_STATUS_SUCCESS);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "app", "name", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "demo") == 0);
+    free(value);
+
+    // ...but kept ones are, and a failure leaves the context untouched
+    char const *bad[] = {"legacy"};
+    assert(ini_load_sections(ctx, TEST_FILE, bad, 1) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(ini_get_value(ctx, "app", "name", &value) == INI_STATUS_SUCCESS);
+    free(value);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_sections_skips_bad_sections passed\n");
+}
+
+void test_ini_load_sections_prefix()
+{
+    char TEST_FILE[] = "test_ini_load_sections_prefix.ini";
+    create_test_file(TEST_FILE,
+                     "[db.primary]\nhost=a\n"
+                     "[web]\nport=80\n"
+                     "[db.replica]\nhost=b\n"
+                     "[dbx]\nhost=c\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_INSITU) == INI_STATUS_SUCCESS);
+
+    char const *prefixes[] = {"db."};
+    assert(ini_load_sections_prefix(ctx, TEST_FILE, prefixes, 1) == INI_STATUS_SUCCESS);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "db.primary", "host", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "a") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "db.replica", "host", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "b") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "dbx", "host", &value) == INI_STATUS_SECTION_NOT_FOUND);
+    assert(ini_get_value(ctx, "web", "port", &value) == INI_STATUS_SECTION_NOT_FOUND);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_sections_prefix passed\n");
+}
+
+void test_ini_load_sections_invalid_arguments()
+{
+    char TEST_FILE[] = "test_ini_load_sections_invalid_arguments.ini";
+    create_test_file(TEST_FILE, "[s]\nk=v\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+
+    char const *wanted[] = {"s"};
+    assert(ini_load_sections(ctx, NULL, wanted, 1) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_load_sections(ctx, TEST_FILE, NULL, 1) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_load_sections_prefix(ctx, "", wanted, 1) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_load_sections_prefix(ctx, TEST_FILE, NULL, 2) == INI_STATUS_INVALID_ARGUMENT);
+
+    // No names selects no sections
+    assert(ini_load_sections(ctx, TEST_FILE, NULL, 0) == INI_STATUS_SUCCESS);
+    char *value = NULL;
+    assert(ini_get_value(ctx, "s", "k", &value) == INI_STATUS_SECTION_NOT_FOUND);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_sections_invalid_arguments passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 11. ini_load() lazy mode ====================================== //
+// ======================================================================== //
+void test_ini_load_lazy_materializes_on_access()
+{
+    char TEST_FILE[] = "test_ini_load_lazy_materializes_on_access.ini";
+    create_test_file(TEST_FILE,
+                     "; fleet config\n"
+                     "[db]\nhost = db.local\n"
+                     "[web]\nport=80\n"
+                     "  [db]\nport=\"5432\"\nhost=db.remote\n"
+                     "[cache]\nsize=64");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_LAZY) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    // Nothing is parsed at load time
+    assert(ctx->span_count == 4);
+    assert(ini_ht_length(ctx->sections) == 0);
+
+    // Repeated sections are merged in file order on first access
+    char *value = NULL;
+    assert(ini_get_value(ctx, "db", "host", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "db.remote") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "db", "port", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "5432") == 0);
+    free(value);
+    assert(ini_ht_length(ctx->sections) == 1);
+    assert(ini_get_section_ht(ctx->sections, "web") == NULL);
+
+    ini_ht_t *cache_ht = ini_get_section(ctx, "cache");
+    assert(cache_ht != NULL);
+    assert(strcmp(ini_ht_get(cache_ht, "size"), "64") == 0);
+    assert(ini_get_value(ctx, "missing", "key", &value) == INI_STATUS_SECTION_NOT_FOUND);
+
+    // Iteration materializes the rest
+    ini_ht_t *sections = ini_get_sections(ctx);
+    assert(sections != NULL);
+    assert(ini_ht_length(sections) == 3);
+    assert(ctx->span_count == 0);
+    assert(ini_get_value(ctx, "web", "port", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "80") == 0);
+    free(value);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_lazy_materializes_on_access passed\n");
+}
+
+void test_ini_load_lazy_validates_and_saves()
+{
+    char TEST_FILE[] = "test_ini_load_lazy_validates_and_saves.ini";
+    char SAVE_FILE[] = "test_ini_load_lazy_validates_and_saves_out.ini";
+    create_test_file(TEST_FILE, "[a]\nk=1\n[b]\n=nokey\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_LAZY) == INI_STATUS_SUCCESS);
+
+    // The scan still rejects files ini_good() rejects
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(ctx->span_count == 0);
+
+    create_test_file(TEST_FILE, "[a]\nk=1\n[b]\nk=2\n");
+    char const *wanted[] = {"b"};
+    assert(ini_load_sections(ctx, TEST_FILE, wanted, 1) == INI_STATUS_SUCCESS);
+    assert(ctx->span_count == 1);
+
+    // Saving writes the sections that were never touched
+    create_test_file(SAVE_FILE, "");
+    assert(ini_save(ctx, SAVE_FILE) == INI_STATUS_SUCCESS);
+
+    ini_context_t *saved = ini_create_context();
+    assert(saved != NULL);
+    assert(ini_load(saved, SAVE_FILE) == INI_STATUS_SUCCESS);
+    char *value = NULL;
+    assert(ini_get_value(saved, "b", "k", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "2") == 0);
+    free(value);
+    assert(ini_get_value(saved, "a", "k", &value) == INI_STATUS_SECTION_NOT_FOUND);
+
+    assert(ini_free(saved) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    remove_test_file(SAVE_FILE);
+    print_success("test_ini_load_lazy_validates_and_saves passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 12. ini_reload_if_changed() =================================== //
+// ======================================================================== //
+void test_ini_reload_if_changed_skips_unchanged()
+{
+    char TEST_FILE[] = "test_ini_reload_if_changed_skips_unchanged.ini";
+    create_test_file(TEST_FILE, "[app]\nmode=old\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ctx->has_fingerprint);
+
+    int reloaded = -1;
+    assert(ini_reload_if_changed(ctx, TEST_FILE, &reloaded) == INI_STATUS_SUCCESS);
+    assert(reloaded == 0);
+
+    // A different size is always a change
+    create_test_file(TEST_FILE, "[app]\nmode=newer\n");
+    assert(ini_reload_if_changed(ctx, TEST_FILE, &reloaded) == INI_STATUS_SUCCESS);
+    assert(reloaded == 1);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "app", "mode", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "newer") == 0);
+    free(value);
+
+    assert(ini_reload_if_changed(ctx, TEST_FILE, &reloaded) == INI_STATUS_SUCCESS);
+    assert(reloaded == 0);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_reload_if_changed_skips_unchanged passed\n");
+}
+
+void test_ini_reload_if_changed_content_hash()
+{
+    char TEST_FILE[] = "test_ini_reload_if_changed_content_hash.ini";
+    create_test_file(TEST_FILE, "[app]\nmode=same\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_CONTENT_HASH | INI_LOAD_INSITU) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    // Rewriting identical bytes is not a change, whatever happened to the mtime
+    create_test_file(TEST_FILE, "[app]\nmode=same\n");
+    int reloaded = -1;
+    assert(ini_reload_if_changed(ctx, TEST_FILE, &reloaded) == INI_STATUS_SUCCESS);
+    assert(reloaded == 0);
+
+    ini_file_fingerprint_t current;
+    assert(ini_get_file_fingerprint(TEST_FILE, &current) == INI_STATUS_SUCCESS);
+    assert(ini_file_fingerprint_equal(&current, &ctx->fingerprint));
+
+    create_test_file(TEST_FILE, "[app]\nmode=changed\n");
+    assert(ini_reload_if_changed(ctx, TEST_FILE, &reloaded) == INI_STATUS_SUCCESS);
+    assert(reloaded == 1);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "app", "mode", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "changed") == 0);
+    free(value);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_reload_if_changed_content_hash passed\n");
+}
+
+void test_ini_reload_if_changed_bad_format()
+{
+    char TEST_FILE[] = "test_ini_reload_if_changed_bad_format.ini";
+    create_test_file(TEST_FILE, "[app]\nmode=good\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    // A broken file is reported on every call and the context keeps its data
+    create_test_file(TEST_FILE, "[app\nmode=broken\n");
+    int reloaded = -1;
+    assert(ini_reload_if_changed(ctx, TEST_FILE, &reloaded) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(reloaded == 0);
+    assert(ini_reload_if_changed(ctx, TEST_FILE, NULL) == INI_STATUS_FILE_BAD_FORMAT);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "app", "mode", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "good") == 0);
+    free(value);
+
+    assert(ini_reload_if_changed(NULL, TEST_FILE, &reloaded) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_reload_if_changed(ctx, "", &reloaded) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_reload_if_changed(ctx, "missing_reload_file.ini", &reloaded) == INI_STATUS_FILE_NOT_FOUND);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_reload_if_changed_bad_format passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 13. ini_reload_incremental() ================================== //
+// ======================================================================== //
+static int has_change(ini_change_set_t const *changes, ini_change_kind_t kind,
+                      char const *section, char const *key)
+{
+    for (size_t i = 0; i < changes->count; i++)
+    {
+        ini_change_t const *change = &changes->items[i];
+        if (change->kind == kind && strcmp(change->section, section) == 0 &&
+            (key ? change->key && strcmp(change->key, key) == 0 : change->key == NULL))
+            return 1;
+    }
+    return 0;
+}
+
+void test_ini_reload_incremental_change_set()
+{
+    char TEST_FILE[] = "test_ini_reload_incremental_change_set.ini";
+    create_test_file(TEST_FILE, "[same]\na=1\n[edit]\nkeep=1\nchange=old\ndrop=1\n[gone]\nx=1\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    ini_ht_t *same_ht = ini_get_section(ctx, "same");
+    ini_ht_t *edit_ht = ini_get_section(ctx, "edit");
+
+    create_test_file(TEST_FILE, "[edit]\nchange=new\nkeep=1\nadd=2\n[same]\na=1\n[new]\ny=2\n");
+    ini_change_set_t changes = {0};
+    assert(ini_reload_incremental(ctx, TEST_FILE, &changes) == INI_STATUS_SUCCESS);
+
+    assert(changes.count == 7);
+    assert(has_change(&changes, INI_CHANGE_MODIFIED, "edit", "change"));
+    assert(has_change(&changes, INI_CHANGE_ADDED, "edit", "add"));
+    assert(has_change(&changes, INI_CHANGE_REMOVED, "edit", "drop"));
+    assert(has_change(&changes, INI_CHANGE_REMOVED, "gone", NULL));
+    assert(has_change(&changes, INI_CHANGE_REMOVED, "gone", "x"));
+    assert(has_change(&changes, INI_CHANGE_ADDED, "new", NULL));
+    assert(has_change(&changes, INI_CHANGE_ADDED, "new", "y"));
+
+    // Sections are patched in place, not rebuilt
+    assert(ini_get_section(ctx, "same") == same_ht);
+    assert(ini_get_section(ctx, "edit") == edit_ht);
+    assert(ini_get_section(ctx, "gone") == NULL);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "edit", "change", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "new") == 0);
+    free(value);
+    value = NULL;
+    assert(ini_get_value(ctx, "edit", "drop", &value) == INI_STATUS_KEY_NOT_FOUND);
+    assert(ini_get_value(ctx, "new", "y", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "2") == 0);
+    free(value);
+
+    // Unchanged file: nothing to report, the previous result is released
+    assert(ini_reload_incremental(ctx, TEST_FILE, &changes) == INI_STATUS_SUCCESS);
+    assert(changes.count == 0);
+
+    ini_free_changes(&changes);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_reload_incremental_change_set passed\n");
+}
+
+void test_ini_reload_incremental_lazy_insitu()
+{
+    char TEST_FILE[] = "test_ini_reload_incremental_lazy_insitu.ini";
+    create_test_file(TEST_FILE, "[a]\nk=1\n[b]\nk=2\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_LAZY | INI_LOAD_CONTENT_HASH) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    // Entries borrowed from the load buffer are replaced by copies
+    create_test_file(TEST_FILE, "[a]\nk=1\n[b]\nk=33\n");
+    ini_change_set_t changes = {0};
+    assert(ini_reload_incremental(ctx, TEST_FILE, &changes) == INI_STATUS_SUCCESS);
+    assert(changes.count == 1);
+    assert(has_change(&changes, INI_CHANGE_MODIFIED, "b", "k"));
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "b", "k", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "33") == 0);
+    free(value);
+
+    // A broken file reports an error and changes nothing
+    create_test_file(TEST_FILE, "[a\nk=9\n");
+    assert(ini_reload_incremental(ctx, TEST_FILE, &changes) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(changes.count == 0);
+    value = NULL;
+    assert(ini_get_value(ctx, "a", "k", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "1") == 0);
+    free(value);
+
+    assert(ini_reload_incremental(NULL, TEST_FILE, &changes) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_reload_incremental(ctx, "missing_reload_file.ini", NULL) == INI_STATUS_FILE_NOT_FOUND);
+    ini_free_changes(NULL);
+
+    ini_free_changes(&changes);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_reload_incremental_lazy_insitu passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 14. ini_set_cache_dir() ======================================= //
+// ======================================================================== //
+#define TEST_CACHE_DIR "test_ini_cache_dir"
+
+// Mirrors the cache naming: hash of the canonical source path
+static void cache_image_path_of(char const *filepath, char *path, size_t size)
+{
+    char canonical[INI_PATH_MAX];
+#if INI_OS_WINDOWS
+    assert(_fullpath(canonical, filepath, sizeof(canonical)) != NULL);
+#else
+    assert(realpath(filepath, canonical) != NULL);
+#endif
+    snprintf(path, size, "%s/%016llx.inic", TEST_CACHE_DIR, (unsigned long long)hash_key(canonical));
+}
+
+static ini_context_t *load_with_cache(char const *filepath)
+{
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_cache_dir(ctx, TEST_CACHE_DIR) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, filepath) == INI_STATUS_SUCCESS);
+    return ctx;
+}
+
+static void expect_cached_value(ini_context_t *ctx, char const *expected)
+{
+    char *value = NULL;
+    assert(ini_get_value(ctx, "app", "mode", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, expected) == 0);
+    free(value);
+}
+
+void test_ini_set_cache_dir_reuses_image()
+{
+    char TEST_FILE[] = "test_ini_set_cache_dir_reuses_image.ini";
+    create_test_file(TEST_FILE, "[app]\nmode=first\n");
+    create_test_dir(TEST_CACHE_DIR);
+    char image_path[INI_PATH_MAX];
+    cache_image_path_of(TEST_FILE, image_path, sizeof(image_path));
+
+    // First run parses the text and leaves an image behind
+    ini_context_t *ctx = load_with_cache(TEST_FILE);
+    assert(ctx->image == NULL);
+    expect_cached_value(ctx, "first");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_file_exists(image_path) == INI_STATUS_SUCCESS);
+
+    // Second run maps the image
+    ctx = load_with_cache(TEST_FILE);
+    assert(ctx->image != NULL);
+    assert(ctx->has_fingerprint);
+    expect_cached_value(ctx, "first");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    // An edit invalidates the image, which is then rebuilt
+    create_test_file(TEST_FILE, "[app]\nmode=second\n");
+    ctx = load_with_cache(TEST_FILE);
+    assert(ctx->image == NULL);
+    expect_cached_value(ctx, "second");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    ctx = load_with_cache(TEST_FILE);
+    assert(ctx->image != NULL);
+    expect_cached_value(ctx, "second");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    // Same bytes under a new inode still hit, and the image gets re-stamped
+    create_test_file("test_ini_set_cache_dir_reuses_image.tmp", "[app]\nmode=second\n");
+    assert(rename("test_ini_set_cache_dir_reuses_image.tmp", TEST_FILE) == 0);
+    ctx = load_with_cache(TEST_FILE);
+    assert(ctx->image != NULL);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    ini_file_fingerprint_t current;
+    assert(ini_get_file_fingerprint(TEST_FILE, &current) == INI_STATUS_SUCCESS);
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load_binary(ctx, image_path) == INI_STATUS_SUCCESS);
+    assert(((ini_binary_header_t const *)ctx->image)->source_inode == current.inode);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(image_path);
+    remove_test_dir(TEST_CACHE_DIR);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_set_cache_dir_reuses_image passed\n");
+}
+
+void test_ini_set_cache_dir_damaged_image()
+{
+    char TEST_FILE[] = "test_ini_set_cache_dir_damaged_image.ini";
+    create_test_file(TEST_FILE, "[app]\nmode=text\n");
+    create_test_dir(TEST_CACHE_DIR);
+    char image_path[INI_PATH_MAX];
+    cache_image_path_of(TEST_FILE, image_path, sizeof(image_path));
+
+    // A damaged image is ignored and replaced
+    create_test_file(image_path, "not an image");
+    ini_context_t *ctx = load_with_cache(TEST_FILE);
+    assert(ctx->image == NULL);
+    expect_cached_value(ctx, "text");
+
+    // Partial loads bypass the cache
+    char const *sections[] = {"app"};
+    assert(ini_load_sections(ctx, TEST_FILE, sections, 1) == INI_STATUS_SUCCESS);
+    assert(ctx->image == NULL);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    ctx = load_with_cache(TEST_FILE);
+    assert(ctx->image != NULL);
+    expect_cached_value(ctx, "text");
+
+    assert(ini_set_cache_dir(ctx, NULL) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ctx->image == NULL);
+
+    assert(ini_set_cache_dir(ctx, "missing_cache_dir") == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_set_cache_dir(ctx, TEST_FILE) == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_set_cache_dir(ctx, "") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_set_cache_dir(NULL, TEST_CACHE_DIR) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(image_path);
+    remove_test_dir(TEST_CACHE_DIR);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_set_cache_dir_damaged_image passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 15. ini_load_dir() ============================================ //
+// ======================================================================== //
+#define TEST_CONF_DIR "test_ini_conf_d"
+
+static void expect_dir_value(ini_context_t *ctx, char const *section, char const *key, char const *expected)
+{
+    char *value = NULL;
+    assert(ini_get_value(ctx, section, key, &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, expected) == 0);
+    free(value);
+}
+
+void test_ini_load_dir_merges_in_order()
+{
+    create_test_dir(TEST_CONF_DIR);
+    create_test_file(TEST_CONF_DIR "/20-site.ini", "[server]\nport=9090\n[site]\nname=demo\n");
+    create_test_file(TEST_CONF_DIR "/10-base.ini", "[server]\nhost=localhost\nport=8080\n");
+    create_test_file(TEST_CONF_DIR "/30-empty.ini", "");
+    create_test_file(TEST_CONF_DIR "/99-notes.txt", "[server]\nport=1\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_threads(ctx, 4) == INI_STATUS_SUCCESS);
+    assert(ini_load_dir(ctx, TEST_CONF_DIR, NULL) == INI_STATUS_SUCCESS);
+
+    // Later files override earlier ones key by key
+    expect_dir_value(ctx, "server", "host", "localhost");
+    expect_dir_value(ctx, "server", "port", "9090");
+    expect_dir_value(ctx, "site", "name", "demo");
+    assert(!ctx->has_fingerprint);
+
+    // A custom pattern picks other files
+    assert(ini_load_dir(ctx, TEST_CONF_DIR "/", "*.txt") == INI_STATUS_SUCCESS);
+    expect_dir_value(ctx, "server", "port", "1");
+    assert(ini_get_section(ctx, "site") == NULL);
+
+    // Nothing matching is an empty configuration
+    assert(ini_load_dir(ctx, TEST_CONF_DIR, "*.conf") == INI_STATUS_SUCCESS);
+    assert(ini_ht_length(ini_get_sections(ctx)) == 0);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_CONF_DIR "/10-base.ini");
+    remove_test_file(TEST_CONF_DIR "/20-site.ini");
+    remove_test_file(TEST_CONF_DIR "/30-empty.ini");
+    remove_test_file(TEST_CONF_DIR "/99-notes.txt");
+    remove_test_dir(TEST_CONF_DIR);
+    print_success("test_ini_load_dir_merges_in_order passed\n");
+}
+
+void test_ini_load_dir_includes()
+{
+    char TEST_FILE[] = "test_ini_load_dir_includes.ini";
+    create_test_dir(TEST_CONF_DIR);
+    create_test_file(TEST_FILE, "[include]\nb=" TEST_CONF_DIR "/*.ini\na=test_ini_load_dir_includes.extra\n"
+                                "[app]\nmode=main\nlevel=1\n");
+    create_test_file("test_ini_load_dir_includes.extra", "[app]\nmode=extra\nextra=yes\n");
+    create_test_file(TEST_CONF_DIR "/local.ini", "[app]\nlevel=2\n[include]\nnested=nested.part\n");
+    create_test_file(TEST_CONF_DIR "/nested.part", "[app]\nnested=yes\n");
+
+    // Without the flag [include] is an ordinary section
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ini_get_section(ctx, "include") != NULL);
+    expect_dir_value(ctx, "app", "mode", "main");
+
+    // Includes follow the including file; keys are taken in lexical order
+    assert(ini_set_load_flags(ctx, INI_LOAD_INCLUDES) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ini_get_section(ctx, "include") == NULL);
+    expect_dir_value(ctx, "app", "mode", "extra");
+    expect_dir_value(ctx, "app", "extra", "yes");
+    expect_dir_value(ctx, "app", "level", "2");
+    expect_dir_value(ctx, "app", "nested", "yes");
+
+    // Reloading picks up changes in included files too
+    int reloaded = 0;
+    create_test_file(TEST_CONF_DIR "/nested.part", "[app]\nnested=changed\n");
+    assert(ini_reload_if_changed(ctx, TEST_FILE, &reloaded) == INI_STATUS_SUCCESS);
+    assert(reloaded);
+    expect_dir_value(ctx, "app", "nested", "changed");
+
+    assert(ini_load_dir(ctx, TEST_CONF_DIR, NULL) == INI_STATUS_SUCCESS);
+    expect_dir_value(ctx, "app", "level", "2");
+    expect_dir_value(ctx, "app", "nested", "changed");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file("test_ini_load_dir_includes.extra");
+    remove_test_file(TEST_CONF_DIR "/local.ini");
+    remove_test_file(TEST_CONF_DIR "/nested.part");
+    remove_test_dir(TEST_CONF_DIR);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_dir_includes passed\n");
+}
+
+void test_ini_load_dir_errors()
+{
+    char TEST_FILE[] = "test_ini_load_dir_errors.ini";
+    create_test_dir(TEST_CONF_DIR);
+    create_test_file(TEST_CONF_DIR "/a.ini", "[app]\nmode=good\n");
+    create_test_file(TEST_CONF_DIR "/b.ini", "[app\nmode=broken\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    create_test_file(TEST_FILE, "[app]\nmode=old\n");
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    // One bad file fails the whole load and keeps the context
+    assert(ini_load_dir(ctx, TEST_CONF_DIR, NULL) == INI_STATUS_FILE_BAD_FORMAT);
+    expect_dir_value(ctx, "app", "mode", "old");
+
+    // A missing literal include fails, an include cycle hits the depth limit
+    assert(ini_set_load_flags(ctx, INI_LOAD_INCLUDES) == INI_STATUS_SUCCESS);
+    create_test_file(TEST_FILE, "[include]\nx=test_ini_load_dir_missing.ini\n");
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_FILE_NOT_FOUND);
+    create_test_file(TEST_FILE, "[include]\nself=test_ini_load_dir_errors.ini\n[app]\nmode=loop\n");
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_FILE_BAD_FORMAT);
+    expect_dir_value(ctx, "app", "mode", "old");
+
+    assert(ini_load_dir(ctx, "test_ini_missing_conf_d", NULL) == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_load_dir(ctx, TEST_FILE, NULL) == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_load_dir(ctx, TEST_CONF_DIR, "sub/*.ini") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_load_dir(ctx, "", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_load_dir(NULL, TEST_CONF_DIR, NULL) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_CONF_DIR "/a.ini");
+    remove_test_file(TEST_CONF_DIR "/b.ini");
+    remove_test_dir(TEST_CONF_DIR);
+    remove_test_file(TEST_FILE);
+    print_success("test_ini_load_dir_errors passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 16. ini_load_many() =========================================== //
+// ======================================================================== //
+#define TEST_MANY_COUNT 40
+
+void test_ini_load_many_loads_each_file()
+{
+    char names[TEST_MANY_COUNT][64];
+    char const *paths[TEST_MANY_COUNT];
+    for (int i = 0; i < TEST_MANY_COUNT; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "test_ini_load_many_%d.ini", i);
+        char content[128];
+        // Sizes vary so the per-worker buffers have to grow and get reused
+        snprintf(content, sizeof(content), "[file]\nindex=%d\n%s", i, i % 3 == 0 ? "[pad]\nkey=padding padding\n" : "");
+        create_test_file(names[i], content);
+        paths[i] = names[i];
+    }
+
+    ini_context_t *out[TEST_MANY_COUNT];
+    ini_status_t statuses[TEST_MANY_COUNT];
+    assert(ini_load_many(paths, TEST_MANY_COUNT, out, statuses, 4) == INI_STATUS_SUCCESS);
+    for (int i = 0; i < TEST_MANY_COUNT; i++)
+    {
+        char expected[16];
+        snprintf(expected, sizeof(expected), "%d", i);
+        assert(statuses[i] == INI_STATUS_SUCCESS);
+        assert(out[i] != NULL && out[i]->has_fingerprint);
+
+        char *value = NULL;
+        assert(ini_get_value(out[i], "file", "index", &value) == INI_STATUS_SUCCESS);
+        assert(strcmp(value, expected) == 0);
+        free(value);
+        assert((ini_get_section(out[i], "pad") != NULL) == (i % 3 == 0));
+        assert(ini_free(out[i]) == INI_STATUS_SUCCESS);
+    }
+
+    // Validation only, on the calling thread
+    assert(ini_load_many(paths, TEST_MANY_COUNT, NULL, NULL, 1) == INI_STATUS_SUCCESS);
+    assert(ini_load_many(NULL, 0, NULL, NULL, 0) == INI_STATUS_SUCCESS);
+
+    for (int i = 0; i < TEST_MANY_COUNT; i++)
+        remove_test_file(names[i]);
+    print_success("test_ini_load_many_loads_each_file passed\n");
+}
+
+void test_ini_load_many_reports_per_file()
+{
+    create_test_file("test_ini_load_many_good.ini", "[app]\nmode=good\n");
+    create_test_file("test_ini_load_many_bad.ini", "[app\nmode=bad\n");
+    create_test_file("test_ini_load_many_empty.ini", "");
+    char const *paths[] = {"test_ini_load_many_good.ini", "test_ini_load_many_missing.ini",
+                           "test_ini_load_many_bad.ini", "test_ini_load_many_empty.ini", NULL};
+
+    ini_context_t *out[5];
+    ini_status_t statuses[5];
+    assert(ini_load_many(paths, 5, out, statuses, 0) == INI_STATUS_FILE_NOT_FOUND);
+    assert(statuses[0] == INI_STATUS_SUCCESS && out[0] != NULL);
+    assert(statuses[1] == INI_STATUS_FILE_NOT_FOUND && out[1] == NULL);
+    assert(statuses[2] == INI_STATUS_FILE_BAD_FORMAT && out[2] == NULL);
+    assert(statuses[3] == INI_STATUS_FILE_EMPTY && out[3] == NULL);
+    assert(statuses[4] == INI_STATUS_INVALID_ARGUMENT && out[4] == NULL);
+    assert(ini_free(out[0]) == INI_STATUS_SUCCESS);
+
+    assert(ini_load_many(NULL, 1, out, statuses, 0) == INI_STATUS_INVALID_ARGUMENT);
+
+    remove_test_file("test_ini_load_many_good.ini");
+    remove_test_file("test_ini_load_many_bad.ini");
+    remove_test_file("test_ini_load_many_empty.ini");
+    print_success("test_ini_load_many_reports_per_file passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 17. ini_get_int64() / ini_get_double() / ini_get_bool() ======= //
+// ======================================================================== //
+void test_ini_get_typed_values()
+{
+    char const *file = "test_ini_get_typed_values.ini";
+    create_test_file(file, "[limits]\nworkers=16\nmask=0xff\nratio=0.75\nenabled=Yes\nname=server\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    int64_t number = 0;
+    double real = 0.0;
+    int flag = -1;
+    // Twice each: the second read comes from the cached conversion
+    for (int pass = 0; pass < 2; pass++)
+    {
+        assert(ini_get_int64(ctx, "limits", "workers", &number) == INI_STATUS_SUCCESS && number == 16);
+        assert(ini_get_int64(ctx, "limits", "mask", &number) == INI_STATUS_SUCCESS && number == 255);
+        assert(ini_get_double(ctx, "limits", "ratio", &real) == INI_STATUS_SUCCESS && real == 0.75);
+        assert(ini_get_double(ctx, "limits", "workers", &real) == INI_STATUS_SUCCESS && real == 16.0);
+        assert(ini_get_bool(ctx, "limits", "enabled", &flag) == INI_STATUS_SUCCESS && flag == 1);
+        assert(ini_get_int64(ctx, "limits", "name", &number) == INI_STATUS_TYPE_MISMATCH);
+        assert(ini_get_bool(ctx, "limits", "ratio", &flag) == INI_STATUS_TYPE_MISMATCH);
+    }
+    assert(number == 255 && flag == 1);
+
+    ini_ht_key_value_t const *entry = ini_ht_find(ini_get_section(ctx, "limits"), "workers");
+    assert(entry != NULL);
+    assert(entry->typed & INI_HT_TYPED_INT);
+    assert(entry->typed & INI_HT_TYPED_DOUBLE);
+    assert(!(entry->typed & INI_HT_TYPED_BOOL_CHECKED));
+
+    assert(ini_get_int64(ctx, "limits", "missing", &number) == INI_STATUS_KEY_NOT_FOUND);
+    assert(ini_get_double(ctx, "nowhere", "ratio", &real) == INI_STATUS_SECTION_NOT_FOUND);
+    assert(ini_get_bool(NULL, "limits", "enabled", &flag) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_get_int64(ctx, NULL, "workers", &number) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_get_double(ctx, "limits", "ratio", NULL) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    print_success("test_ini_get_typed_values passed\n");
+}
+
+void test_ini_get_typed_values_follow_updates()
+{
+    char const *file = "test_ini_get_typed_values_follow_updates.ini";
+    create_test_file(file, "[flags]\nbeta=off\nlimit=10\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    int flag = -1;
+    int64_t number = 0;
+    assert(ini_get_bool(ctx, "flags", "beta", &flag) == INI_STATUS_SUCCESS && flag == 0);
+    assert(ini_get_int64(ctx, "flags", "limit", &number) == INI_STATUS_SUCCESS && number == 10);
+
+    // Changing the string drops the cached conversions
+    ini_ht_t *section = ini_get_section(ctx, "flags");
+    assert(ini_ht_set(section, "beta", "on") != NULL);
+    assert(ini_ht_set(section, "limit", "ten") != NULL);
+    assert(ini_get_bool(ctx, "flags", "beta", &flag) == INI_STATUS_SUCCESS && flag == 1);
+    assert(ini_get_int64(ctx, "flags", "limit", &number) == INI_STATUS_TYPE_MISMATCH);
+    assert(ini_ht_set(section, "limit", "-3") != NULL);
+    assert(ini_get_int64(ctx, "flags", "limit", &number) == INI_STATUS_SUCCESS && number == -3);
+
+    // And so does reloading the file
+    create_test_file(file, "[flags]\nbeta=false\nlimit=7\n");
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_get_bool(ctx, "flags", "beta", &flag) == INI_STATUS_SUCCESS && flag == 0);
+    assert(ini_get_int64(ctx, "flags", "limit", &number) == INI_STATUS_SUCCESS && number == 7);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    print_success("test_ini_get_typed_values_follow_updates passed\n");
+}
+
+void test_ini_get_typed_values_lazy_and_binary()
+{
+    char const *file = "test_ini_get_typed_values_lazy.ini";
+    char const *image = "test_ini_get_typed_values_lazy.bin";
+    create_test_file(file, "[a]\nx=1\n[b]\nport=8080\nscale=1.5e3\ndebug=true\n");
+
+    // A lazy load parses the section on the first typed read
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_LAZY) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    int64_t number = 0;
+    assert(ini_get_int64(ctx, "b", "port", &number) == INI_STATUS_SUCCESS && number == 8080);
+    assert(ini_save_binary(ctx, image) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    // A mapped image is converted on each read
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load_binary(ctx, image) == INI_STATUS_SUCCESS);
+    double real = 0.0;
+    int flag = -1;
+    assert(ini_get_int64(ctx, "b", "port", &number) == INI_STATUS_SUCCESS && number == 8080);
+    assert(ini_get_double(ctx, "b", "scale", &real) == INI_STATUS_SUCCESS && real == 1500.0);
+    assert(ini_get_bool(ctx, "b", "debug", &flag) == INI_STATUS_SUCCESS && flag == 1);
+    assert(ini_get_bool(ctx, "b", "port", &flag) == INI_STATUS_TYPE_MISMATCH);
+    assert(ini_get_int64(ctx, "b", "missing", &number) == INI_STATUS_KEY_NOT_FOUND);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(image);
+    remove_test_file(file);
+    print_success("test_ini_get_typed_values_lazy_and_binary passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 18. ini_get_array() =========================================== //
+// ======================================================================== //
+static int span_equals(ini_span_t const *span, char const *text)
+{
+    return span->len == strlen(text) && memcmp(span->ptr, text, span->len) == 0;
+}
+
+void test_ini_get_array_comma_lists()
+{
+    char const *file = "test_ini_get_array_comma_lists.ini";
+    create_test_file(file, "[net]\nhosts = alpha, beta ,gamma\nsingle=one\nempty=\n"
+                           "gaps=a,,b,\nquoted=\"x, y\"\nescaped = x\\, y , C:\\\\, C:\\dir\n");
+    unsigned const modes[] = {INI_LOAD_DEFAULT, INI_LOAD_INSITU, INI_LOAD_LAZY, INI_LOAD_PARALLEL};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        ini_context_t *ctx = ini_create_context();
+        assert(ctx != NULL);
+        assert(ini_set_load_flags(ctx, modes[m]) == INI_STATUS_SUCCESS);
+        assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+        ini_span_t const *items = NULL;
+        size_t count = 0;
+        assert(ini_get_array(ctx, "net", "hosts", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 3);
+        assert(span_equals(&items[0], "alpha") && span_equals(&items[1], "beta") && span_equals(&items[2], "gamma"));
+
+        // The split is cached: the same items come back
+        ini_span_t const *again = NULL;
+        assert(ini_get_array(ctx, "net", "hosts", &again, &count) == INI_STATUS_SUCCESS);
+        assert(again == items && count == 3);
+
+        assert(ini_get_array(ctx, "net", "single", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 1 && span_equals(&items[0], "one"));
+        assert(ini_get_array(ctx, "net", "empty", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 0);
+        assert(ini_get_array(ctx, "net", "gaps", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 4 && span_equals(&items[1], "") && span_equals(&items[3], ""));
+        assert(ini_get_array(ctx, "net", "quoted", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 2 && span_equals(&items[0], "x") && span_equals(&items[1], "y"));
+        assert(ini_get_array(ctx, "net", "escaped", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 3 && span_equals(&items[0], "x, y") && span_equals(&items[1], "C:\\") &&
+               span_equals(&items[2], "C:\\dir"));
+
+        assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    }
+    remove_test_file(file);
+    print_success("test_ini_get_array_comma_lists passed\n");
+}
+
+void test_ini_get_array_repeated_keys()
+{
+    char const *file = "test_ini_get_array_repeated_keys.ini";
+    char const *image = "test_ini_get_array_repeated_keys.bin";
+    FILE *fp = fopen(file, "w");
+    assert(fp != NULL);
+    fprintf(fp, "[pool]\nname=main\nlabel[]=a, b\nnames[]=x\nlabel[]=c\\\n[other]\nk=v\n[pool]\nlabel[]=d\n");
+    for (int i = 0; i < 1000; i++)
+        fprintf(fp, "hosts[] = host%d.example\n", i);
+    fprintf(fp, "names=reset\nnames[]=y\n");
+    fclose(fp);
+
+    unsigned const modes[] = {INI_LOAD_DEFAULT, INI_LOAD_INSITU};
+    for (size_t m = 0; m < 2; m++)
+    {
+        ini_context_t *ctx = ini_create_context();
+        assert(ctx != NULL);
+        assert(ini_set_load_flags(ctx, modes[m]) == INI_STATUS_SUCCESS);
+        assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+        ini_span_t const *items = NULL;
+        size_t count = 0;
+        assert(ini_get_array(ctx, "pool", "hosts", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 1000);
+        assert(span_equals(&items[0], "host0.example") && span_equals(&items[999], "host999.example"));
+
+        // Each line is one item, commas and backslashes included, also across a reopened section
+        assert(ini_get_array(ctx, "pool", "label", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 3 && span_equals(&items[0], "a, b") && span_equals(&items[1], "c\\") &&
+               span_equals(&items[2], "d"));
+
+        // A plain assignment restarts the list
+        assert(ini_get_array(ctx, "pool", "names", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 2 && span_equals(&items[0], "reset") && span_equals(&items[1], "y"));
+        if (m == 0)
+            assert(ini_save_binary(ctx, image) == INI_STATUS_SUCCESS);
+        assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    }
+
+    // A binary image keeps the joined list
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load_binary(ctx, image) == INI_STATUS_SUCCESS);
+    ini_span_t const *items = NULL;
+    size_t count = 0;
+    assert(ini_get_array(ctx, "pool", "hosts", &items, &count) == INI_STATUS_SUCCESS);
+    assert(count == 1000 && span_equals(&items[500], "host500.example"));
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(image);
+    remove_test_file(file);
+    print_success("test_ini_get_array_repeated_keys passed\n");
+}
+
+// Clean test: A list continued after a parallel chunk boundary is joined, not replaced
+void test_ini_get_array_across_chunks()
+{
+    char const *file = "test_ini_get_array_across_chunks.ini";
+    FILE *fp = fopen(file, "w");
+    assert(fp != NULL);
+    fprintf(fp, "[a]\nhosts[]=x\nlabel[]=p, q\nnames[]=old\nplain=1\n");
+    // About four minimum-sized chunks of filler put the repeated section in another chunk
+    for (int i = 0; i < 4 * INI_PARALLEL_MIN_CHUNK_SIZE / 16; i++)
+        fprintf(fp, "[fill%d]\nk=v\n", i);
+    fprintf(fp, "[a]\nhosts[]=y\nlabel[]=r\\\nnames=reset\nnames[]=new\nplain[]=2\n");
+    fclose(fp);
+
+    unsigned const modes[] = {INI_LOAD_DEFAULT, INI_LOAD_LAZY, INI_LOAD_PARALLEL, INI_LOAD_PARALLEL | INI_LOAD_INSITU};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        ini_context_t *ctx = ini_create_context();
+        assert(ctx != NULL);
+        assert(ini_set_load_flags(ctx, modes[m]) == INI_STATUS_SUCCESS);
+        assert(ini_set_load_threads(ctx, 4) == INI_STATUS_SUCCESS);
+        assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+        expect_value(ctx, "a", "hosts", "x,y");
+        expect_value(ctx, "a", "names", "reset,new");
+        expect_value(ctx, "a", "plain", "1,2");
+
+        ini_span_t const *items = NULL;
+        size_t count = 0;
+        assert(ini_get_array(ctx, "a", "label", &items, &count) == INI_STATUS_SUCCESS);
+        assert(count == 2 && span_equals(&items[0], "p, q") && span_equals(&items[1], "r\\"));
+        assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    }
+    remove_test_file(file);
+    print_success("test_ini_get_array_across_chunks passed\n");
+}
+
+void test_ini_get_array_errors_and_updates()
+{
+    char const *file = "test_ini_get_array_errors.ini";
+    create_test_file(file, "[s]\nlist=1,2\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    ini_span_t const *items = NULL;
+    size_t count = 0;
+    assert(ini_get_array(ctx, "s", "list", &items, &count) == INI_STATUS_SUCCESS && count == 2);
+
+    // A new value is split again
+    assert(ini_ht_set(ini_get_section(ctx, "s"), "list", "x,y,z") != NULL);
+    assert(ini_get_array(ctx, "s", "list", &items, &count) == INI_STATUS_SUCCESS);
+    assert(count == 3 && span_equals(&items[2], "z"));
+
+    assert(ini_get_array(ctx, "s", "missing", &items, &count) == INI_STATUS_KEY_NOT_FOUND);
+    assert(ini_get_array(ctx, "nowhere", "list", &items, &count) == INI_STATUS_SECTION_NOT_FOUND);
+    assert(ini_get_array(NULL, "s", "list", &items, &count) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_get_array(ctx, "s", "list", NULL, &count) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_get_array(ctx, "s", "list", &items, NULL) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    print_success("test_ini_get_array_errors_and_updates passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 19. ini_set_value() / ini_save_incremental() ================== //
+// ======================================================================== //
+// Clean test: Setting and removing values, on text, lazy and binary contexts
+void test_ini_set_value_tracks_changes()
+{
+    char const *file = "test_ini_set_value_tracks_changes.ini";
+    char const *image = "test_ini_set_value_tracks_changes.inib";
+    create_test_file(file, "[a]\nx=1\n[b]\ny=2\n");
+
+    unsigned const modes[] = {INI_LOAD_DEFAULT, INI_LOAD_INSITU, INI_LOAD_LAZY};
+    for (size_t m = 0; m < 4; m++)
+    {
+        ini_context_t *ctx = ini_create_context();
+        assert(ctx != NULL);
+        if (m < 3)
+        {
+            assert(ini_set_load_flags(ctx, modes[m]) == INI_STATUS_SUCCESS);
+            assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+            if (m == 0)
+                assert(ini_save_binary(ctx, image) == INI_STATUS_SUCCESS);
+        }
+        else
+            assert(ini_load_binary(ctx, image) == INI_STATUS_SUCCESS);
+        assert(!ini_is_dirty(ctx));
+
+        assert(ini_set_value(ctx, "a", "x", "one") == INI_STATUS_SUCCESS);
+        assert(ini_set_value(ctx, "new", "z", "3") == INI_STATUS_SUCCESS);
+        assert(ini_remove_value(ctx, "b", "y") == INI_STATUS_SUCCESS);
+        assert(ini_is_dirty(ctx));
+
+        char *value = NULL;
+        assert(ini_get_value(ctx, "a", "x", &value) == INI_STATUS_SUCCESS && strcmp(value, "one") == 0);
+        free(value);
+        int64_t number = 0;
+        assert(ini_get_int64(ctx, "new", "z", &number) == INI_STATUS_SUCCESS && number == 3);
+        assert(ini_get_value(ctx, "b", "y", &value) == INI_STATUS_KEY_NOT_FOUND);
+
+        assert(ini_remove_value(ctx, "b", "y") == INI_STATUS_KEY_NOT_FOUND);
+        assert(ini_remove_value(ctx, "nowhere", "y") == INI_STATUS_SECTION_NOT_FOUND);
+        assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    }
+
+    assert(ini_set_value(NULL, "a", "x", "1") == INI_STATUS_INVALID_ARGUMENT);
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_value(ctx, "a", NULL, "1") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_set_value(ctx, "a", "", "1") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_set_value(ctx, "a", "x", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_remove_value(ctx, "a", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(!ini_is_dirty(ctx) && !ini_is_dirty(NULL));
+
+    // A reload brings the context back in line with the file
+    assert(ini_set_value(ctx, "a", "x", "2") == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(!ini_is_dirty(ctx));
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(image);
+    remove_test_file(file);
+    print_success("test_ini_set_value_tracks_changes passed\n");
+}
+
+// Clean test: Only dirty lines change; comments, layout and other sections stay byte for byte
+void test_ini_save_incremental_patches_dirty_keys()
+{
+    char const *file = "test_ini_save_incremental_patches_dirty_keys.ini";
+    create_test_file(file, "; config\n[server]\nhost = example.org   ; primary\nport=80\nold=1\n\n"
+                           "[client]\n  retries=3\n# end\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    assert(ini_set_value(ctx, "server", "port", "8080") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "server", "name", "main site") == INI_STATUS_SUCCESS);
+    assert(ini_remove_value(ctx, "server", "old") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "client", "retries", "5") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "extra", "on", "yes") == INI_STATUS_SUCCESS);
+    assert(ini_save_incremental(ctx, file) == INI_STATUS_SUCCESS);
+    assert(!ini_is_dirty(ctx));
+
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "; config\n[server]\nhost = example.org   ; primary\nport=8080\nname=\"main site\"\n\n"
+                        "[client]\nretries=5\n# end\n\n[extra]\non=yes\n") == 0);
+    free(data);
+
+    // Clean: the file is not even rewritten
+    ini_file_fingerprint_t before;
+    ini_file_fingerprint_t after;
+    assert(ini_get_file_fingerprint(file, &before) == INI_STATUS_SUCCESS);
+    assert(ini_save_incremental(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_get_file_fingerprint(file, &after) == INI_STATUS_SUCCESS);
+    assert(ini_file_fingerprint_equal(&before, &after));
+
+    // The patched file reads back to the same values
+    ini_context_t *ctx2 = ini_create_context();
+    assert(ctx2 != NULL);
+    assert(ini_load(ctx2, file) == INI_STATUS_SUCCESS);
+    char *value = NULL;
+    assert(ini_get_value(ctx2, "server", "name", &value) == INI_STATUS_SUCCESS && strcmp(value, "main site") == 0);
+    free(value);
+    assert(ini_get_value(ctx2, "server", "old", &value) == INI_STATUS_KEY_NOT_FOUND);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx2) == INI_STATUS_SUCCESS);
+
+    // A BOM, indented headers and commented-out keys are read as the parser reads them
+    create_test_file(file, "\xEF\xBB\xBF[server]\nport=80\n  [client]\n;retries=1\n\tretries = 3\n");
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "server", "port", "8080") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "client", "retries", "5") == INI_STATUS_SUCCESS);
+    assert(ini_save_incremental(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_read_file(file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, "\xEF\xBB\xBF[server]\nport=8080\n  [client]\n;retries=1\nretries=5\n") == 0);
+    free(data);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    // Every `key[]=` line of a list goes, also in a reopened section; a set writes one pair
+    create_test_file(file, "[s]\nhosts[]=a\nname=x\nhosts[]=b\n[t]\nk=1\n[s]\nhosts[]=c\nports[]=1\nports[]=2\n");
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_remove_value(ctx, "s", "hosts") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "s", "ports", "9") == INI_STATUS_SUCCESS);
+    assert(ini_save_incremental(ctx, file) == INI_STATUS_SUCCESS);
+    expect_file_text(file, "[s]\nname=x\n[t]\nk=1\n[s]\nports=9\n");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    expect_value(ctx, "s", "hosts", NULL);
+    expect_value(ctx, "s", "ports", "9");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(file);
+    print_success("test_ini_save_incremental_patches_dirty_keys passed\n");
+}
+
+// Clean test: A missing file is written in full; full saves clear the dirty set, failed ones keep it
+void test_ini_save_incremental_full_and_failed_saves()
+{
+    char const *file = "test_ini_save_incremental_full.ini";
+    char const *copy = "test_ini_save_incremental_full_copy.ini";
+    create_test_file(file, "[a]\nx=1\ny=2\n");
+    remove(copy);
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    // Clean context: nothing is written, not even a missing file
+    assert(ini_save_incremental(ctx, copy) == INI_STATUS_SUCCESS);
+    assert(ini_file_exists(copy) == INI_STATUS_FILE_NOT_FOUND);
+
+    assert(ini_set_value(ctx, "a", "x", "10") == INI_STATUS_SUCCESS);
+    assert(ini_save_incremental(ctx, copy) == INI_STATUS_SUCCESS);
+    ini_context_t *ctx2 = ini_create_context();
+    assert(ctx2 != NULL);
+    assert(ini_load(ctx2, copy) == INI_STATUS_SUCCESS);
+    char *value = NULL;
+    assert(ini_get_value(ctx2, "a", "y", &value) == INI_STATUS_SUCCESS && strcmp(value, "2") == 0);
+    free(value);
+    assert(ini_free(ctx2) == INI_STATUS_SUCCESS);
+
+    // A save that fails leaves the changes dirty
+    assert(ini_set_value(ctx, "a", "y", "20") == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, "test_ini_save_incremental_missing_dir/out.ini") != INI_STATUS_SUCCESS);
+    assert(ini_is_dirty(ctx));
+    assert(ini_save(ctx, file) == INI_STATUS_SUCCESS);
+    assert(!ini_is_dirty(ctx));
+
+    assert(ini_save_incremental(NULL, file) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_save_incremental(ctx, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_save_incremental(ctx, "") == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    remove_test_file(copy);
+    print_success("test_ini_save_incremental_full_and_failed_saves passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 20. ini_txn_begin() / ini_txn_commit() ======================== //
+// ======================================================================== //
+// Clean test: Hundreds of staged updates land in the context and the file in one commit
+void test_ini_txn_commit_batches_updates()
+{
+    char const *file = "test_ini_txn_commit_batches_updates.ini";
+    size_t const key_count = 500;
+    size_t const capacity = 64 + key_count * 32;
+    char *before = (char *)malloc(capacity);
+    char *expected = (char *)malloc(capacity);
+    assert(before != NULL && expected != NULL);
+
+    size_t used = (size_t)snprintf(before, capacity, "; settings\n[keys]\n");
+    size_t expected_used = (size_t)snprintf(expected, capacity, "; settings\n[keys]\n");
+    for (size_t i = 0; i < key_count; i++)
+    {
+        used += (size_t)snprintf(before + used, capacity - used, "k%zu = %zu\n", i, i);
+        if (i != 7)
+            expected_used += (size_t)snprintf(expected + expected_used, capacity - expected_used, "k%zu=%zu\n", i,
+                                              i * 2);
+    }
+    snprintf(before + used, capacity - used, "\n[other]\nkeep = yes  ; untouched\n");
+    snprintf(expected + expected_used, capacity - expected_used,
+             "\n[other]\nkeep = yes  ; untouched\n\n[added]\nz=3\n");
+    create_test_file(file, before);
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    ini_txn_t *txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    for (size_t i = 0; i < key_count; i++)
+    {
+        char key[32];
+        char value[32];
+        snprintf(key, sizeof(key), "k%zu", i);
+        snprintf(value, sizeof(value), "%zu", i * 2);
+        assert(ini_txn_set(txn, "keys", key, value) == INI_STATUS_SUCCESS);
+    }
+    assert(ini_txn_remove(txn, "keys", "k7") == INI_STATUS_SUCCESS);
+    assert(ini_txn_remove(txn, "keys", "absent") == INI_STATUS_SUCCESS);
+    assert(ini_txn_set(txn, "added", "z", "2") == INI_STATUS_SUCCESS);
+    assert(ini_txn_set(txn, "added", "z", "3") == INI_STATUS_SUCCESS); // Later changes win
+    assert(ini_txn_size(txn) == key_count + 4);
+
+    // Staging leaves the context alone
+    char *value = NULL;
+    assert(ini_get_value(ctx, "keys", "k1", &value) == INI_STATUS_SUCCESS && strcmp(value, "1") == 0);
+    free(value);
+
+    assert(ini_txn_commit(txn, file) == INI_STATUS_SUCCESS);
+    assert(!ini_is_dirty(ctx));
+    assert(ini_get_value(ctx, "keys", "k499", &value) == INI_STATUS_SUCCESS && strcmp(value, "998") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "keys", "k7", &value) == INI_STATUS_KEY_NOT_FOUND);
+
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(file, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(data, expected) == 0);
+    free(data);
+
+    // An empty transaction writes nothing
+    ini_file_fingerprint_t fp_before;
+    ini_file_fingerprint_t fp_after;
+    assert(ini_get_file_fingerprint(file, &fp_before) == INI_STATUS_SUCCESS);
+    assert(ini_txn_commit(ini_txn_begin(ctx), file) == INI_STATUS_SUCCESS);
+    assert(ini_get_file_fingerprint(file, &fp_after) == INI_STATUS_SUCCESS);
+    assert(ini_file_fingerprint_equal(&fp_before, &fp_after));
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    free(before);
+    free(expected);
+    remove_test_file(file);
+    print_success("test_ini_txn_commit_batches_updates passed\n");
+}
+
+// Dirty test: Aborted and failed transactions leave the context as it was
+void test_ini_txn_abort_and_rollback()
+{
+    char const *file = "test_ini_txn_abort_and_rollback.ini";
+    char const *copy = "test_ini_txn_abort_and_rollback_copy.ini";
+    create_test_file(file, "[a]\nx=1\ny=2\n");
+    remove(copy);
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    ini_txn_t *txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    assert(ini_txn_set(txn, "a", "x", "10") == INI_STATUS_SUCCESS);
+    ini_txn_abort(txn);
+    ini_txn_abort(NULL);
+
+    // The write fails: changed, removed and created entries are all put back
+    txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    assert(ini_txn_set(txn, "a", "x", "10") == INI_STATUS_SUCCESS);
+    assert(ini_txn_remove(txn, "a", "y") == INI_STATUS_SUCCESS);
+    assert(ini_txn_set(txn, "b", "z", "3") == INI_STATUS_SUCCESS);
+    assert(ini_txn_set(txn, NULL, "g", "4") == INI_STATUS_SUCCESS);
+    assert(ini_txn_commit(txn, "test_ini_txn_missing_dir/out.ini") != INI_STATUS_SUCCESS);
+
+    char *value = NULL;
+    assert(ini_get_value(ctx, "a", "x", &value) == INI_STATUS_SUCCESS && strcmp(value, "1") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "a", "y", &value) == INI_STATUS_SUCCESS && strcmp(value, "2") == 0);
+    free(value);
+    assert(ini_get_value(ctx, "b", "z", &value) == INI_STATUS_SECTION_NOT_FOUND);
+    assert(ini_get_value(ctx, "", "g", &value) == INI_STATUS_SECTION_NOT_FOUND);
+
+    // A missing file receives the whole context
+    txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    assert(ini_txn_set(txn, "b", "z", "3") == INI_STATUS_SUCCESS);
+    assert(ini_txn_commit(txn, copy) == INI_STATUS_SUCCESS);
+    char *data = NULL;
+    size_t size = 0;
+    assert(ini_read_file(copy, &data, &size) == INI_STATUS_SUCCESS);
+    assert(strstr(data, "[a]\n") != NULL && strstr(data, "y=2\n") != NULL && strstr(data, "[b]\nz=3\n") != NULL);
+    free(data);
+
+    assert(ini_txn_begin(NULL) == NULL);
+    assert(ini_txn_size(NULL) == 0);
+    assert(ini_txn_set(NULL, "a", "x", "1") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_txn_remove(NULL, "a", "x") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_txn_commit(NULL, file) == INI_STATUS_INVALID_ARGUMENT);
+    txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    assert(ini_txn_set(txn, "a", "", "1") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_txn_set(txn, "a", "x", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_txn_remove(txn, "a", NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_txn_size(txn) == 0);
+    assert(ini_txn_commit(txn, "") == INI_STATUS_INVALID_ARGUMENT); // Frees it as well
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    remove_test_file(copy);
+    print_success("test_ini_txn_abort_and_rollback passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 21. INI_LOAD_PRESERVE_FORMAT ================================== //
+// ======================================================================== //
+// Clean test: Untouched lines survive a save byte for byte; only changed keys are rewritten
+void test_ini_save_preserves_format()
+{
+    char const *file = "test_ini_save_preserves_format.ini";
+    char const *copy = "test_ini_save_preserves_format_copy.ini";
+    char const *text = "; Hand-written config\r\n"
+                       "\n"
+                       "[server]\n"
+                       "  host   =   example.org\n"
+                       "motd = \"hello world\"\n"
+                       "port=80\n"
+                       "# keep me\n"
+                       "old = gone\n"
+                       "\n"
+                       "[client]\n"
+                       "retries = 3";
+    create_test_file(file, text);
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_PRESERVE_FORMAT) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    // No changes: the same bytes, unlike the regenerated text of a plain context
+    assert(ini_save(ctx, copy) == INI_STATUS_SUCCESS);
+    expect_file_text(copy, text);
+
+    assert(ini_set_value(ctx, "server", "port", "8080") == INI_STATUS_SUCCESS);
+    assert(ini_remove_value(ctx, "server", "old") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "server", "name", "main site") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "client", "timeout", "30") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "extra", "on", "yes") == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, file) == INI_STATUS_SUCCESS);
+    assert(!ini_is_dirty(ctx));
+    char const *saved = "; Hand-written config\r\n"
+                        "\n"
+                        "[server]\n"
+                        "  host   =   example.org\n"
+                        "motd = \"hello world\"\n"
+                        "port=8080\n"
+                        "# keep me\n"
+                        "name=\"main site\"\n"
+                        "\n"
+                        "[client]\n"
+                        "retries = 3\n"
+                        "timeout=30\n"
+                        "\n"
+                        "[extra]\n"
+                        "on=yes\n";
+    expect_file_text(file, saved);
+
+    // The saved text is what the next save starts from
+    assert(ini_set_value(ctx, "server", "port", "9090") == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, copy) == INI_STATUS_SUCCESS);
+    char *expected = strdup(saved);
+    assert(expected != NULL);
+    memcpy(strstr(expected, "port=8080"), "port=9090", 9);
+    expect_file_text(copy, expected);
+    free(expected);
+
+    // The result parses to the context's values
+    ini_context_t *ctx2 = ini_create_context();
+    assert(ctx2 != NULL);
+    assert(ini_load(ctx2, copy) == INI_STATUS_SUCCESS);
+    char *value = NULL;
+    assert(ini_get_value(ctx2, "server", "host", &value) == INI_STATUS_SUCCESS && strcmp(value, "example.org") == 0);
+    free(value);
+    assert(ini_get_value(ctx2, "server", "old", &value) == INI_STATUS_KEY_NOT_FOUND);
+    assert(ini_get_value(ctx2, "server", "motd", &value) == INI_STATUS_SUCCESS && strcmp(value, "hello world") == 0);
+    free(value);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx2) == INI_STATUS_SUCCESS);
+
+    // A BOM, indented headers and CRLF endings survive; new lines end like their neighbours
+    create_test_file(file, "\xEF\xBB\xBF[server]\r\n"
+                           "port=80\r\n"
+                           "  [client]\r\n"
+                           "\tretries = 3\r\n");
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_PRESERVE_FORMAT) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "server", "port", "8080") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "client", "retries", "5") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "client", "timeout", "30") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "extra", "on", "yes") == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, file) == INI_STATUS_SUCCESS);
+    expect_file_text(file, "\xEF\xBB\xBF[server]\r\n"
+                           "port=8080\r\n"
+                           "  [client]\r\n"
+                           "retries=5\r\n"
+                           "timeout=30\r\n"
+                           "\r\n"
+                           "[extra]\r\n"
+                           "on=yes\r\n");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    // A list keeps its items until it is set, then becomes one pair
+    create_test_file(file, "[s]\nhosts[]=a\n; note\nhosts[]=b\nports[]=1\n");
+    ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_PRESERVE_FORMAT) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "s", "hosts", "z") == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, file) == INI_STATUS_SUCCESS);
+    expect_file_text(file, "[s]\nhosts=z\n; note\nports[]=1\n");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    remove_test_file(file);
+    remove_test_file(copy);
+    print_success("test_ini_save_preserves_format passed\n");
+}
+
+// Clean test: Lazy loads, transactions and reloads keep the preserved text in step
+void test_ini_save_preserves_format_other_paths()
+{
+    char const *file = "test_ini_save_preserves_format_paths.ini";
+    char const *copy = "test_ini_save_preserves_format_paths_copy.ini";
+    create_test_file(file, "[a]\nx = 1 ; one\ny = 2\n\n[b]\nz = 3\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_PRESERVE_FORMAT | INI_LOAD_LAZY) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+
+    // Transaction changes are not dirty but still count as edits of the text
+    ini_txn_t *txn = ini_txn_begin(ctx);
+    assert(txn != NULL);
+    assert(ini_txn_set(txn, "b", "z", "30") == INI_STATUS_SUCCESS);
+    assert(ini_txn_commit(txn, copy) == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, copy) == INI_STATUS_SUCCESS);
+    expect_file_text(copy, "[a]\nx = 1 ; one\ny = 2\n\n[b]\nz=30\n");
+
+    // Edits saved incrementally elsewhere still reach the next full save
+    assert(ini_set_value(ctx, "a", "y", "20") == INI_STATUS_SUCCESS);
+    assert(ini_save_incremental(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, copy) == INI_STATUS_SUCCESS);
+    expect_file_text(copy, "[a]\nx = 1 ; one\ny=20\n\n[b]\nz=30\n");
+
+    // An incremental reload takes over the new text
+    create_test_file(file, "[a]\n# reloaded\nx = 5\n");
+    ini_change_set_t changes = {0};
+    assert(ini_reload_incremental(ctx, file, &changes) == INI_STATUS_SUCCESS);
+    ini_free_changes(&changes);
+    assert(ini_save(ctx, copy) == INI_STATUS_SUCCESS);
+    expect_file_text(copy, "[a]\n# reloaded\nx = 5\n");
+
+    // Without the flag a load drops the text and saves regenerate the file
+    assert(ini_set_load_flags(ctx, INI_LOAD_DEFAULT) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, copy) == INI_STATUS_SUCCESS);
+    expect_file_text(copy, "[a]\nx=5\n");
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    remove_test_file(copy);
+    print_success("test_ini_save_preserves_format_other_paths passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+// ======================================================================== //
+// === Test 22. ini_save_to_buffer() / ini_save_fd() ====================== //
+// ======================================================================== //
+// Clean test: The buffer holds exactly what ini_save() writes, and rendering changes nothing
+void test_ini_save_to_buffer_matches_save()
+{
+    char const *file = "test_ini_save_to_buffer.ini";
+    char const *copy = "test_ini_save_to_buffer_copy.ini";
+    create_test_file(file, "[a]\nx=1\nmsg = \"hi there\"\n\n[b]\ny=2\n");
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_LAZY) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "b", "z", "3") == INI_STATUS_SUCCESS);
+
+    char *text = NULL;
+    size_t size = 0;
+    assert(ini_save_to_buffer(ctx, &text, &size) == INI_STATUS_SUCCESS);
+    assert(text != NULL && strlen(text) == size);
+    assert(ini_is_dirty(ctx));
+    assert(ini_save(ctx, copy) == INI_STATUS_SUCCESS);
+    expect_file_text(copy, text);
+    free(text);
+
+    // A format-preserving context renders its preserved text
+    ini_context_t *doc = ini_create_context();
+    assert(doc != NULL);
+    assert(ini_set_load_flags(doc, INI_LOAD_PRESERVE_FORMAT) == INI_STATUS_SUCCESS);
+    assert(ini_load(doc, file) == INI_STATUS_SUCCESS);
+    assert(ini_set_value(doc, "a", "x", "10") == INI_STATUS_SUCCESS);
+    assert(ini_save_to_buffer(doc, &text, &size) == INI_STATUS_SUCCESS);
+    assert(strcmp(text, "[a]\nx=10\nmsg = \"hi there\"\n\n[b]\ny=2\n") == 0);
+    free(text);
+    // Rendering does not consume the edit
+    assert(ini_save(doc, copy) == INI_STATUS_SUCCESS);
+    expect_file_text(copy, "[a]\nx=10\nmsg = \"hi there\"\n\n[b]\ny=2\n");
+
+    assert(ini_save_to_buffer(NULL, &text, &size) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_save_to_buffer(ctx, NULL, &size) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_save_to_buffer(ctx, &text, NULL) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    assert(ini_free(doc) == INI_STATUS_SUCCESS);
+    remove_test_file(file);
+    remove_test_file(copy);
+    print_success("test_ini_save_to_buffer_matches_save passed\n");
+}
+
+// Clean test: ini_save_fd() writes the same text to a descriptor and leaves it open
+void test_ini_save_fd_writes_text()
+{
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_value(ctx, "net", "host", "example.org") == INI_STATUS_SUCCESS);
+    assert(ini_set_value(ctx, "net", "port", "8080") == INI_STATUS_SUCCESS);
+
+    char *expected = NULL;
+    size_t size = 0;
+    assert(ini_save_to_buffer(ctx, &expected, &size) == INI_STATUS_SUCCESS);
+
+    FILE *output = tmpfile();
+    assert(output != NULL);
+    assert(ini_save_fd(ctx, fileno(output)) == INI_STATUS_SUCCESS);
+    assert(ini_save_fd(ctx, fileno(output)) == INI_STATUS_SUCCESS); // Still open: appends
+    rewind(output);
+    char *written = (char *)malloc(2 * size + 1);
+    assert(written != NULL);
+    assert(fread(written, 1, 2 * size + 1, output) == 2 * size);
+    assert(memcmp(written, expected, size) == 0 && memcmp(written + size, expected, size) == 0);
+    fclose(output);
+    free(written);
+    free(expected);
+
+    assert(ini_save_fd(NULL, 1) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_save_fd(ctx, -1) == INI_STATUS_INVALID_ARGUMENT);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    print_success("test_ini_save_fd_writes_text passed\n");
+}
+// ************************************************************************ //
+// ======================================================================== //
+
+int main()
+{
+    __helper_init_log_file();
+
+    // === Test 1. ini_create_context() ====== //
+    test_ini_create_context_success();
+    test_ini_create_context_platform_specific();
+    test_ini_create_context_reentrancy();
+    test_ini_create_context_resource_leak();
+    print_success("All ini_create_context() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 2. ini_create_context() ====== //
+    test_ini_free_null_context();
+    test_ini_free_empty_context();
+    test_ini_free_loaded_context();
+    test_ini_free_double_free();
+    test_ini_free_platform_specific();
+    test_ini_free_memory_leak();
+    test_ini_free_with_sections();
+    test_ini_free_with_subsections();
+    print_success("All ini_free() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 3. ini_get_value() =========== //
+    test_ini_get_value_empty_value();
+    test_ini_get_value_get_existing_value();
+    test_ini_get_value_key_not_found();
+    test_ini_get_value_section_not_found();
+    test_ini_get_value_subsection();
+    test_ini_get_value_whitespace_value();
+    test_ini_get_value_unicode();
+    test_ini_get_value_utf8_bom();
+    test_ini_get_value_quoted_values();
+    test_ini_get_value_null_arguments();
+    test_ini_get_value_reuse_value_pointer();
+    test_ini_get_value_existing_value_memory();
+    test_ini_get_value_thread_safety();
+    test_ini_get_value_reuse_context();
+    test_ini_get_value_corrupted_file();
+    print_success("All ini_get_value() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 4. ini_good() ================ //
+    test_ini_good_null_filepath();
+    test_ini_good_nonexistent_file();
+    // test_ini_good_directory();
+    test_ini_good_empty_file();
+    test_ini_good_valid_file();
+    test_ini_good_bad_format_missing_bracket();
+    test_ini_good_bad_format_empty_key();
+    test_ini_good_empty_value();
+    test_ini_good_no_read_permission();
+    test_ini_good_bad_format_unbalanced_quotes();
+    test_ini_good_comma_lists();
+    test_ini_good_utf8_chars();
+    test_ini_good_windows_line_endings();
+    test_ini_good_line_too_long();
+    test_ini_good_file_deleted_during_check();
+    test_ini_good_binary_data();
+    test_ini_good_symlink();
+    test_ini_good_special_chars();
+    print_success("All ini_good() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 5. ini_load() ================ //
+    test_ini_load_null_ctx_and_filepath();
+    test_ini_load_null_filepath();
+    test_ini_load_nonexistent_file();
+    // test_ini_load_directory();
+    test_ini_load_empty_file();
+    test_ini_load_valid_file();
+    test_ini_load_bad_format_missing_bracket();
+    test_ini_load_bad_format_empty_key();
+    test_ini_load_empty_value();
+    test_ini_load_bad_format_unbalanced_quotes();
+    test_ini_load_comma_lists();
+    test_ini_load_utf8_chars();
+    test_ini_load_windows_line_endings();
+    test_ini_load_line_too_long();
+    test_ini_load_file_deleted_during_check();
+    test_ini_load_binary_data();
+    test_ini_load_reuse_ctx();
+    test_ini_load_no_read_permission();
+    test_ini_load_symlink();
+    test_ini_load_special_chars();
+    print_success("All ini_load() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 6. ini_print() =============== //
+    test_ini_print_basic_section();
+    test_ini_print_with_subsections();
+    test_ini_print_unicode();
+    test_ini_print_null_stream();
+    test_ini_print_null_ctx();
+    test_ini_print_malformed_section_names();
+    test_ini_print_malformed_pairs();
+    test_ini_print_large_output();
+    test_ini_print_stream_errors();
+    test_ini_print_fprintf_failure();
+    test_ini_print_long_names();
+    test_ini_print_empty_sections();
+    test_ini_print_mixed_encoding();
+    print_success("All ini_print() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 7. ini_save_section_value() == //
+    test_save_section_value_null_context();
+    test_save_section_value_null_filepath();
+    test_save_section_value_null_section();
+    test_save_section_value_section_not_found();
+    test_save_section_value_key_not_found();
+    test_save_section_value_save_section_key();
+    test_save_section_value_save_entire_section();
+    test_save_section_value_update_existing_file();
+    test_save_section_value_subsection_save();
+    test_save_section_value_save_with_special_chars();
+    test_save_section_value_save_empty_value();
+    test_save_section_value_unicode();
+    // test_save_section_value_to_directory();
+    // test_save_section_value_no_write_permission();
+    test_save_section_value_thread_safety();
+    test_save_section_value_existing_file_durability();
+    test_save_section_value_patches_in_place();
+    print_success("All ini_save_section_value() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 8. ini_save() ================ //
+    test_ini_save_null_context();
+    test_ini_save_null_filepath();
+    test_ini_save_empty_context();
+    test_ini_save_simple_context();
+    test_ini_save_with_subsections();
+    test_ini_save_with_special_chars();
+    test_ini_save_empty_values();
+    test_ini_save_unicode();
+    test_ini_save_to_existing_file();
+    test_ini_save_quoting_positions();
+    test_ini_save_thread_safety();
+    print_success("All ini_save() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 9. ini_load() in-situ ======== //
+    test_ini_load_insitu_values();
+    test_ini_load_insitu_duplicate_sections();
+    test_ini_load_insitu_bad_format_keeps_context();
+    test_ini_set_load_flags_invalid();
+    print_success("All in-situ ini_load() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 10. ini_load_sections() ====== //
+    test_ini_load_sections_selected();
+    test_ini_load_sections_skips_bad_sections();
+    test_ini_load_sections_prefix();
+    test_ini_load_sections_invalid_arguments();
+    print_success("All ini_load_sections() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 11. ini_load() lazy ========== //
+    test_ini_load_lazy_materializes_on_access();
+    test_ini_load_lazy_validates_and_saves();
+    print_success("All lazy ini_load() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 12. ini_reload_if_changed() == //
+    test_ini_reload_if_changed_skips_unchanged();
+    test_ini_reload_if_changed_content_hash();
+    test_ini_reload_if_changed_bad_format();
+    print_success("All ini_reload_if_changed() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 13. ini_reload_incremental() = //
+    test_ini_reload_incremental_change_set();
+    test_ini_reload_incremental_lazy_insitu();
+    print_success("All ini_reload_incremental() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 14. ini_set_cache_dir() ====== //
+    test_ini_set_cache_dir_reuses_image();
+    test_ini_set_cache_dir_damaged_image();
+    print_success("All ini_set_cache_dir() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 15. ini_load_dir() =========== //
+    test_ini_load_dir_merges_in_order();
+    test_ini_load_dir_includes();
+    test_ini_load_dir_errors();
+    print_success("All ini_load_dir() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 16. ini_load_many() ========== //
+    test_ini_load_many_loads_each_file();
+    test_ini_load_many_reports_per_file();
+    print_success("All ini_load_many() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 17. typed accessors ========== //
+    test_ini_get_typed_values();
+    test_ini_get_typed_values_follow_updates();
+    test_ini_get_typed_values_lazy_and_binary();
+    print_success("All typed accessor tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 18. ini_get_array() ========== //
+    test_ini_get_array_comma_lists();
+    test_ini_get_array_repeated_keys();
+    test_ini_get_array_across_chunks();
+    test_ini_get_array_errors_and_updates();
+    print_success("All ini_get_array() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 19. ini_save_incremental() === //
+    test_ini_set_value_tracks_changes();
+    test_ini_save_incremental_patches_dirty_keys();
+    test_ini_save_incremental_full_and_failed_saves();
+    print_success("All ini_save_incremental() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 20. ini_txn_commit() ========= //
+    test_ini_txn_commit_batches_updates();
+    test_ini_txn_abort_and_rollback();
+    print_success("All ini_txn_commit() tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 21. INI_LOAD_PRESERVE_FORMAT = //
+    test_ini_save_preserves_format();
+    test_ini_save_preserves_format_other_paths();
+    print_success("All format-preserving save tests passed!\n\n");
+    // ======================================= //
+
+    // === Test 22. ini_save_to_buffer() ===== //
+    test_ini_save_to_buffer_matches_save();
+    test_ini_save_fd_writes_text();
+    print_success("All ini_save_to_buffer() tests passed!\n\n");
     // ======================================= //
 
     __helper_close_log_file();
@@ -0,0 +1,260 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helper.h"
+
+#include "ini_stream.h"
+
+#define TEST_FILE "test_stream.ini"
+
+// Collects tokenizer events for the assertions below
+typedef struct
+{
+    int sections;
+    int pairs;
+    int comments;
+    int errors;
+    unsigned last_error_line;
+    int stop_after_pairs; // 0 = never stop
+    char last_section[64];
+    char last_key[64];
+    char last_value[64];
+} counter_t;
+
+static ini_parse_action_t count_section(void *user, char const *name, size_t name_len, unsigned line)
+{
+    counter_t *counter = (counter_t *)user;
+    (void)line;
+    counter->sections++;
+    snprintf(counter->last_section, sizeof(counter->last_section), "%.*s", (int)name_len, name);
+    return INI_PARSE_CONTINUE;
+}
+
+static ini_parse_action_t count_key_value(void *user,
+                                          char const *section, size_t section_len,
+                                          char const *key, size_t key_len,
+                                          char const *value, size_t value_len,
+                                          unsigned line)
+{
+    counter_t *counter = (counter_t *)user;
+    (void)line;
+    counter->pairs++;
+    assert(section_len == strlen(counter->last_section));
+    assert(memcmp(section, counter->last_section, section_len) == 0);
+    snprintf(counter->last_key, sizeof(counter->last_key), "%.*s", (int)key_len, key);
+    snprintf(counter->last_value, sizeof(counter->last_value), "%.*s", (int)value_len, value);
+    if (counter->stop_after_pairs && counter->pairs >= counter->stop_after_pairs)
+        return INI_PARSE_STOP;
+    return INI_PARSE_CONTINUE;
+}
+
+static ini_parse_action_t count_comment(void *user, char const *text, size_t text_len, unsigned line)
+{
+    counter_t *counter = (counter_t *)user;
+    (void)text;
+    (void)text_len;
+    (void)line;
+    counter->comments++;
+    return INI_PARSE_CONTINUE;
+}
+
+static ini_parse_action_t count_error(void *user, ini_status_t status, unsigned line)
+{
+    counter_t *counter = (counter_t *)user;
+    assert(status == INI_STATUS_FILE_BAD_FORMAT);
+    counter->errors++;
+    counter->last_error_line = line;
+    return INI_PARSE_CONTINUE;
+}
+
+static ini_handler_t const counting_handler = {count_section, count_key_value, count_comment, count_error};
+
+// Clean test: Events from a buffer
+void test_parse_buffer_events()
+{
+    char const data[] = "; header\n[server]\n host = example.org \nport=\"80\"\r\n# note\n\n[client]\nname=x";
+    counter_t counter = {0};
+
+    ini_status_t err = ini_parse_buffer(data, sizeof(data) - 1, &counting_handler, &counter);
+    assert(err == INI_STATUS_SUCCESS);
+    assert(counter.sections == 2);
+    assert(counter.pairs == 3);
+    assert(counter.comments == 2);
+    assert(counter.errors == 0);
+    assert(strcmp(counter.last_section, "client") == 0);
+    assert(strcmp(counter.last_key, "name") == 0);
+    assert(strcmp(counter.last_value, "x") == 0);
+    print_success("test_parse_buffer_events passed\n");
+}
+
+// Clean test: Quotes and whitespace are stripped like ini_load() does
+void test_parse_buffer_value_trimming()
+{
+    char const data[] = "[s]\nkey = \"a b\"\n";
+    counter_t counter = {0};
+
+    assert(ini_parse_buffer(data, sizeof(data) - 1, &counting_handler, &counter) == INI_STATUS_SUCCESS);
+    assert(strcmp(counter.last_key, "key") == 0);
+    assert(strcmp(counter.last_value, "a b") == 0);
+    print_success("test_parse_buffer_value_trimming passed\n");
+}
+
+// Dirty test: Errors report line numbers and can be skipped
+void test_parse_buffer_errors_with_lines()
+{
+    char const data[] = "[s]\nok=1\n[broken\n=nokey\nnoequals\nok2=2\n";
+    counter_t counter = {0};
+
+    ini_status_t err = ini_parse_buffer(data, sizeof(data) - 1, &counting_handler, &counter);
+    assert(err == INI_STATUS_FILE_BAD_FORMAT);
+    assert(counter.errors == 3);
+    assert(counter.last_error_line == 5);
+    assert(counter.pairs == 2);
+    print_success("test_parse_buffer_errors_with_lines passed\n");
+}
+
+// Dirty test: Without an error callback parsing stops at the first error
+void test_parse_buffer_stops_without_error_handler()
+{
+    char const data[] = "key=outside\n[s]\nk=v\n";
+    ini_handler_t handler = counting_handler;
+    handler.on_error = NULL;
+    counter_t counter = {0};
+
+    assert(ini_parse_buffer(data, sizeof(data) - 1, &handler, &counter) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(counter.sections == 0);
+    assert(counter.pairs == 0);
+    print_success("test_parse_buffer_stops_without_error_handler passed\n");
+}
+
+// Clean test: A callback can stop the parse early
+void test_parse_buffer_stop_early()
+{
+    char const data[] = "[s]\na=1\nb=2\nc=3\n";
+    counter_t counter = {0};
+    counter.stop_after_pairs = 2;
+
+    assert(ini_parse_buffer(data, sizeof(data) - 1, &counting_handler, &counter) == INI_STATUS_SUCCESS);
+    assert(counter.pairs == 2);
+    assert(strcmp(counter.last_key, "b") == 0);
+    print_success("test_parse_buffer_stop_early passed\n");
+}
+
+static ini_parse_action_t skip_odd_sections(void *user, char const *name, size_t name_len, unsigned line)
+{
+    count_section(user, name, name_len, line);
+    return (name[name_len - 1] - '0') % 2 ? INI_PARSE_SKIP_SECTION : INI_PARSE_CONTINUE;
+}
+
+// Clean test: Skipped sections are fast-forwarded without being tokenized
+void test_parse_buffer_skip_section()
+{
+    char const data[] = "[s1]\na=1\n;hidden\nbad,line\n[s2]\nb=2\n[s3]\nc=3\n\t[s4]\nd=4\n";
+    ini_handler_t handler = counting_handler;
+    handler.on_section = skip_odd_sections;
+    counter_t counter = {0};
+
+    assert(ini_parse_buffer(data, sizeof(data) - 1, &handler, &counter) == INI_STATUS_SUCCESS);
+    assert(counter.sections == 4);
+    assert(counter.pairs == 2);
+    assert(counter.comments == 0);
+    assert(counter.errors == 0);
+    assert(strcmp(counter.last_key, "d") == 0);
+
+    // Line numbers keep counting through skipped lines
+    char const bad[] = "[s1]\nx=1\n[s2]\n=oops\n";
+    memset(&counter, 0, sizeof(counter));
+    assert(ini_parse_buffer(bad, sizeof(bad) - 1, &handler, &counter) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(counter.last_error_line == 4);
+    print_success("test_parse_buffer_skip_section passed\n");
+}
+
+// Dirty test: NULL arguments
+void test_parse_null_arguments()
+{
+    assert(ini_parse_stream(NULL, &counting_handler, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_parse_buffer(NULL, 10, &counting_handler, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_parse_buffer("[s]\n", 4, NULL, NULL) == INI_STATUS_SUCCESS);
+    print_success("test_parse_null_arguments passed\n");
+}
+
+// Clean test: A stream larger than the read buffer produces the same events
+void test_parse_stream_large_file()
+{
+    int const sections = 2000;
+    int const keys = 20;
+
+    FILE *fp = fopen(TEST_FILE, "wb");
+    assert(fp != NULL);
+    fprintf(fp, "%c%c%c", 0xEF, 0xBB, 0xBF);
+    for (int i = 0; i < sections; i++)
+    {
+        fprintf(fp, "[section%d]\n; comment %d\n", i, i);
+        for (int j = 0; j < keys; j++)
+            fprintf(fp, "key%d=value%d_%d\n", j, i, j);
+    }
+    fclose(fp);
+
+    fp = fopen(TEST_FILE, "rb");
+    assert(fp != NULL);
+    counter_t counter = {0};
+    assert(ini_parse_stream(fp, &counting_handler, &counter) == INI_STATUS_SUCCESS);
+    fclose(fp);
+
+    assert(counter.sections == sections);
+    assert(counter.pairs == sections * keys);
+    assert(counter.comments == sections);
+    assert(counter.errors == 0);
+    assert(strcmp(counter.last_section, "section1999") == 0);
+    assert(strcmp(counter.last_value, "value1999_19") == 0);
+
+    remove_test_file(TEST_FILE);
+    print_success("test_parse_stream_large_file passed\n");
+}
+
+// Dirty test: A line longer than the read buffer is reported once and skipped
+void test_parse_stream_overlong_line()
+{
+    FILE *fp = fopen(TEST_FILE, "wb");
+    assert(fp != NULL);
+    fprintf(fp, "[s]\nlong=");
+    for (int i = 0; i < INI_STREAM_BUFFER_SIZE * 2; i++)
+        fputc('a', fp);
+    fprintf(fp, "\nafter=1\n");
+    fclose(fp);
+
+    fp = fopen(TEST_FILE, "rb");
+    assert(fp != NULL);
+    counter_t counter = {0};
+    assert(ini_parse_stream(fp, &counting_handler, &counter) == INI_STATUS_FILE_BAD_FORMAT);
+    fclose(fp);
+
+    assert(counter.errors == 1);
+    assert(counter.last_error_line == 2);
+    assert(counter.pairs == 1);
+    assert(strcmp(counter.last_key, "after") == 0);
+
+    remove_test_file(TEST_FILE);
+    print_success("test_parse_stream_overlong_line passed\n");
+}
+
+int main()
+{
+    __helper_init_log_file();
+
+    test_parse_buffer_events();
+    test_parse_buffer_value_trimming();
+    test_parse_buffer_errors_with_lines();
+    test_parse_buffer_stops_without_error_handler();
+    test_parse_buffer_stop_early();
+    test_parse_buffer_skip_section();
+    test_parse_null_arguments();
+    test_parse_stream_large_file();
+    test_parse_stream_overlong_line();
+
+    print_success("All ini_stream tests passed!\n\n");
+    __helper_close_log_file();
+    return EXIT_SUCCESS;
+}
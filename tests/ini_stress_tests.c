@@ -22,6 +22,7 @@
 
 #include "helper.h"
 #include "ini_parser.h"
+#include "ini_writer.h"
 
 #define TEST_FILE "test_stress.ini"
 #define LARGE_FILE "test_large.ini"
@@ -29,34 +30,53 @@
 #define NUM_SECTIONS 100
 #define NUM_KEYS_PER_SECTION 50
 #define LARGE_KEY_SIZE 2048
+#define PARALLEL_SCALE 40 // Corpus multiplier for the parallel load tests
+
+// Monotonic wall-clock time in seconds; clock() counts CPU time of all threads and hides parallel speedup
+static double wall_seconds()
+{
+#if INI_OS_WINDOWS
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
 
 // Generate a large INI file with many sections and keys
 void generate_large_ini_file(const char *filename, int num_sections, int keys_per_section)
 {
-    FILE *fp = fopen(filename, "w");
-    if (!fp)
+    ini_writer_t *writer = NULL;
+    if (ini_writer_open_path(filename, INI_DURABILITY_NONE, &writer) != INI_STATUS_SUCCESS)
     {
         return;
     }
 
+    char name[32];
+    char value[32];
     for (int i = 0; i < num_sections; i++)
     {
-        fprintf(fp, "[section%d]\n", i);
+        snprintf(name, sizeof(name), "section%d", i);
+        ini_writer_section(writer, name);
         for (int j = 0; j < keys_per_section; j++)
         {
-            fprintf(fp, "key%d=value%d_%d\n", j, i, j);
+            snprintf(name, sizeof(name), "key%d", j);
+            snprintf(value, sizeof(value), "value%d_%d", i, j);
+            ini_writer_kv(writer, name, value);
         }
-        fprintf(fp, "\n");
     }
 
-    fclose(fp);
+    ini_writer_close(writer);
 }
 
 // Test loading a large INI file
 void test_large_file_load()
 {
-    clock_t start, end;
-    double cpu_time_used;
+    double start, end;
 
     // Generate a large INI file
     generate_large_ini_file(LARGE_FILE, NUM_SECTIONS, NUM_KEYS_PER_SECTION);
@@ -65,13 +85,13 @@ void test_large_file_load()
     ini_context_t *ctx = ini_create_context();
     assert(ctx != NULL);
 
-    start = clock();
+    start = wall_seconds();
     ini_status_t err = ini_load(ctx, LARGE_FILE);
-    end = clock();
+    end = wall_seconds();
 
     assert(err == INI_STATUS_SUCCESS);
 
-    cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
+    print_info("large file load: %.3fs\n", end - start);
 
     // Verify random access to values
     for (int i = 0; i < 10; i++)
@@ -105,8 +125,7 @@ void test_large_file_load()
 // Test saving a large INI file
 void test_large_file_save()
 {
-    clock_t start, end;
-    double cpu_time_used;
+    double start, end;
 
     // Create a context with many sections and keys
     ini_context_t *ctx = ini_create_context();
@@ -118,13 +137,13 @@ void test_large_file_save()
     assert(err == INI_STATUS_SUCCESS);
 
     // Save the file and measure time
-    start = clock();
+    start = wall_seconds();
     err = ini_save(ctx, TEST_FILE);
-    end = clock();
+    end = wall_seconds();
 
     assert(err == INI_STATUS_SUCCESS);
 
-    cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
+    print_info("large file save: %.3fs\n", end - start);
 
     // Verify the saved file
     ini_context_t *ctx2 = ini_create_context();
@@ -165,6 +184,96 @@ void test_large_file_save()
     print_success("test_large_file_save passed\n");
 }
 
+// Test parallel loading of a scaled-up corpus against the serial parser
+void test_large_file_parallel_load()
+{
+    int num_sections = NUM_SECTIONS * PARALLEL_SCALE;
+    generate_large_ini_file(LARGE_FILE, num_sections, NUM_KEYS_PER_SECTION);
+
+    // Repeat a section from the beginning at the end: the later chunk must win
+    FILE *fp = fopen(LARGE_FILE, "a");
+    assert(fp != NULL);
+    fprintf(fp, "[section0]\nkey0=overridden\nextra=added\n");
+    fclose(fp);
+
+    ini_context_t *serial = ini_create_context();
+    ini_context_t *parallel = ini_create_context();
+    assert(serial != NULL && parallel != NULL);
+    assert(ini_set_load_flags(parallel, INI_LOAD_PARALLEL) == INI_STATUS_SUCCESS);
+    assert(ini_set_load_threads(parallel, 4) == INI_STATUS_SUCCESS);
+
+    double start = wall_seconds();
+    assert(ini_load(serial, LARGE_FILE) == INI_STATUS_SUCCESS);
+    double middle = wall_seconds();
+    assert(ini_load(parallel, LARGE_FILE) == INI_STATUS_SUCCESS);
+    double end = wall_seconds();
+
+    print_info("serial load: %.3fs, parallel load: %.3fs (wall clock)\n", middle - start, end - middle);
+
+    assert(ini_ht_length(parallel->sections) == (size_t)num_sections);
+
+    char *value = NULL;
+    assert(ini_get_value(parallel, "section0", "key0", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "overridden") == 0);
+    free(value);
+    assert(ini_get_value(parallel, "section0", "key1", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "value0_1") == 0);
+    free(value);
+    assert(ini_get_value(parallel, "section0", "extra", &value) == INI_STATUS_SUCCESS);
+    free(value);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        char section[32];
+        char key[32];
+        sprintf(section, "section%d", rand() % num_sections);
+        sprintf(key, "key%d", rand() % NUM_KEYS_PER_SECTION);
+
+        char *expected = NULL;
+        char *actual = NULL;
+        assert(ini_get_value(serial, section, key, &expected) == INI_STATUS_SUCCESS);
+        assert(ini_get_value(parallel, section, key, &actual) == INI_STATUS_SUCCESS);
+        assert(strcmp(expected, actual) == 0);
+        free(expected);
+        free(actual);
+    }
+
+    // In-situ and parallel combine
+    assert(ini_set_load_flags(parallel, INI_LOAD_PARALLEL | INI_LOAD_INSITU) == INI_STATUS_SUCCESS);
+    assert(ini_load(parallel, LARGE_FILE) == INI_STATUS_SUCCESS);
+    assert(ini_get_value(parallel, "section0", "key0", &value) == INI_STATUS_SUCCESS);
+    assert(strcmp(value, "overridden") == 0);
+    free(value);
+
+    assert(ini_free(serial) == INI_STATUS_SUCCESS);
+    assert(ini_free(parallel) == INI_STATUS_SUCCESS);
+    remove_test_file(LARGE_FILE);
+
+    print_success("test_large_file_parallel_load passed\n");
+}
+
+// Test that a syntax error in a late chunk fails the whole parallel load
+void test_large_file_parallel_bad_format()
+{
+    generate_large_ini_file(LARGE_FILE, NUM_SECTIONS * PARALLEL_SCALE, NUM_KEYS_PER_SECTION);
+
+    FILE *fp = fopen(LARGE_FILE, "a");
+    assert(fp != NULL);
+    fprintf(fp, "[broken\nkey=value\n");
+    fclose(fp);
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_set_load_flags(ctx, INI_LOAD_PARALLEL) == INI_STATUS_SUCCESS);
+    assert(ini_load(ctx, LARGE_FILE) == INI_STATUS_FILE_BAD_FORMAT);
+    assert(ini_ht_length(ctx->sections) == 0);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(LARGE_FILE);
+
+    print_success("test_large_file_parallel_bad_format passed\n");
+}
+
 // Test with very large keys and values
 void test_large_keys_values()
 {
@@ -528,6 +637,8 @@ int main(int argc, char *argv[])
     // Run stress tests
     test_large_file_load();
     test_large_file_save();
+    test_large_file_parallel_load();
+    test_large_file_parallel_bad_format();
     test_large_keys_values();
 
     // #if INI_OS_WINDOWS || INI_OS_LINUX
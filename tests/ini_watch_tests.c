@@ -0,0 +1,233 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helper.h"
+
+#include "ini_thread.h"
+#include "ini_watch.h"
+
+#define TEST_FILE "test_watch.ini"
+#define TEST_FILE_TMP "test_watch.ini.tmp"
+#define WAIT_LIMIT_MS 3000
+
+/// @brief Records watcher notifications (written on the watcher thread).
+typedef struct
+{
+    ini_mutex_t mutex;
+    int reloads;
+    ini_status_t last_status;
+    int unwatch_in_callback;
+} watch_log_t;
+
+static void on_reload(ini_context_t *ctx, char const *filepath, ini_status_t status, void *user)
+{
+    watch_log_t *log = (watch_log_t *)user;
+    ini_mutex_lock(&log->mutex);
+    log->reloads++;
+    log->last_status = status;
+    ini_mutex_unlock(&log->mutex);
+
+    if (log->unwatch_in_callback)
+        assert(ini_unwatch(ctx, filepath) == INI_STATUS_SUCCESS);
+}
+
+static int reload_count(watch_log_t *log)
+{
+    ini_mutex_lock(&log->mutex);
+    int reloads = log->reloads;
+    ini_mutex_unlock(&log->mutex);
+    return reloads;
+}
+
+// Waits until at least `expected` reloads were reported
+static int wait_for_reloads(watch_log_t *log, int expected)
+{
+    for (int waited = 0; waited < WAIT_LIMIT_MS; waited += 10)
+    {
+        if (reload_count(log) >= expected)
+            return 1;
+        ini_thread_sleep(10);
+    }
+    return 0;
+}
+
+static void watch_log_init(watch_log_t *log)
+{
+    memset(log, 0, sizeof(*log));
+    assert(ini_mutex_init(&log->mutex) == INI_STATUS_SUCCESS);
+}
+
+static char *get_value(ini_context_t *ctx, char const *section, char const *key)
+{
+    char *value = NULL;
+    if (ini_get_value(ctx, section, key, &value) != INI_STATUS_SUCCESS)
+        return NULL;
+    return value;
+}
+
+// Clean test: Saving through a temporary file and a rename triggers one reload
+void test_watch_reloads_on_rename_save()
+{
+    create_test_file(TEST_FILE, "[app]\nmode=old\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    watch_log_t log;
+    watch_log_init(&log);
+    assert(ini_watch(ctx, TEST_FILE, on_reload, &log) == INI_STATUS_SUCCESS);
+
+    // Editor-style burst: write a temporary file, then several renames in a row
+    for (int i = 0; i < 3; i++)
+    {
+        create_test_file(TEST_FILE_TMP, i == 2 ? "[app]\nmode=new\n" : "[app]\nmode=mid\n");
+        assert(rename(TEST_FILE_TMP, TEST_FILE) == 0);
+    }
+
+    assert(wait_for_reloads(&log, 1));
+    ini_thread_sleep(INI_WATCH_DEBOUNCE_MS * 4);
+    assert(reload_count(&log) == 1);
+    assert(log.last_status == INI_STATUS_SUCCESS);
+
+    char *value = get_value(ctx, "app", "mode");
+    assert(value && strcmp(value, "new") == 0);
+    free(value);
+
+    assert(ini_unwatch(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    ini_mutex_destroy(&log.mutex);
+    remove_test_file(TEST_FILE);
+    print_success("test_watch_reloads_on_rename_save passed\n");
+}
+
+// Clean test: Events that do not change the file do not reload it
+void test_watch_ignores_unchanged_file()
+{
+    create_test_file(TEST_FILE, "[app]\nmode=same\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    watch_log_t log;
+    watch_log_init(&log);
+    assert(ini_watch(ctx, TEST_FILE, on_reload, &log) == INI_STATUS_SUCCESS);
+
+    // Opening for writing without writing raises an event but changes nothing
+    FILE *file = fopen(TEST_FILE, "a");
+    assert(file != NULL);
+    fclose(file);
+
+    ini_thread_sleep(INI_WATCH_DEBOUNCE_MS * 4);
+    assert(reload_count(&log) == 0);
+
+    // A real change still gets through
+    create_test_file(TEST_FILE, "[app]\nmode=changed\n");
+    assert(wait_for_reloads(&log, 1));
+
+    assert(ini_unwatch(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    ini_mutex_destroy(&log.mutex);
+    remove_test_file(TEST_FILE);
+    print_success("test_watch_ignores_unchanged_file passed\n");
+}
+
+// Dirty test: A broken save is reported and the context keeps its data
+void test_watch_bad_format_keeps_context()
+{
+    create_test_file(TEST_FILE, "[app]\nmode=good\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    watch_log_t log;
+    watch_log_init(&log);
+    assert(ini_watch(ctx, TEST_FILE, on_reload, &log) == INI_STATUS_SUCCESS);
+
+    create_test_file(TEST_FILE, "[app\nmode=broken\n");
+    assert(wait_for_reloads(&log, 1));
+    assert(log.last_status == INI_STATUS_FILE_BAD_FORMAT);
+
+    char *value = get_value(ctx, "app", "mode");
+    assert(value && strcmp(value, "good") == 0);
+    free(value);
+
+    assert(ini_unwatch(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    ini_mutex_destroy(&log.mutex);
+    remove_test_file(TEST_FILE);
+    print_success("test_watch_bad_format_keeps_context passed\n");
+}
+
+// Clean test: Unwatching stops reloads, also from inside the callback
+void test_unwatch_stops_reloads()
+{
+    create_test_file(TEST_FILE, "[app]\nmode=1\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    watch_log_t log;
+    watch_log_init(&log);
+    log.unwatch_in_callback = 1;
+    assert(ini_watch(ctx, TEST_FILE, on_reload, &log) == INI_STATUS_SUCCESS);
+
+    create_test_file(TEST_FILE, "[app]\nmode=2\n");
+    assert(wait_for_reloads(&log, 1));
+
+    create_test_file(TEST_FILE, "[app]\nmode=three\n");
+    ini_thread_sleep(INI_WATCH_DEBOUNCE_MS * 4);
+    assert(reload_count(&log) == 1);
+    assert(ini_unwatch(ctx, TEST_FILE) == INI_STATUS_INVALID_ARGUMENT);
+
+    // Watching again works after the self-removal
+    log.unwatch_in_callback = 0;
+    assert(ini_watch(ctx, TEST_FILE, on_reload, &log) == INI_STATUS_SUCCESS);
+    assert(ini_unwatch(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    create_test_file(TEST_FILE, "[app]\nmode=4\n");
+    ini_thread_sleep(INI_WATCH_DEBOUNCE_MS * 4);
+    assert(reload_count(&log) == 1);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    ini_mutex_destroy(&log.mutex);
+    remove_test_file(TEST_FILE);
+    print_success("test_unwatch_stops_reloads passed\n");
+}
+
+// Dirty test: Invalid arguments
+void test_watch_invalid_arguments()
+{
+    create_test_file(TEST_FILE, "[app]\nmode=1\n");
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+
+    assert(ini_watch(NULL, TEST_FILE, NULL, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_watch(ctx, NULL, NULL, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_watch(ctx, "missing_watch_file.ini", NULL, NULL) == INI_STATUS_FILE_NOT_FOUND);
+    assert(ini_unwatch(ctx, TEST_FILE) == INI_STATUS_INVALID_ARGUMENT);
+
+    // The same pair cannot be watched twice
+    assert(ini_watch(ctx, TEST_FILE, NULL, NULL) == INI_STATUS_SUCCESS);
+    assert(ini_watch(ctx, TEST_FILE, NULL, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_unwatch(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+    remove_test_file(TEST_FILE);
+    print_success("test_watch_invalid_arguments passed\n");
+}
+
+int main()
+{
+    __helper_init_log_file();
+
+    test_watch_reloads_on_rename_save();
+    test_watch_ignores_unchanged_file();
+    test_watch_bad_format_keeps_context();
+    test_unwatch_stops_reloads();
+    test_watch_invalid_arguments();
+
+    print_success("All ini_watch tests passed!\n\n");
+    __helper_close_log_file();
+    return EXIT_SUCCESS;
+}
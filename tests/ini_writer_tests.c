@@ -0,0 +1,255 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "helper.h"
+
+#include "ini_parser.h"
+#include "ini_writer.h"
+
+#define TEST_FILE "test_writer.ini"
+
+// Returns everything written to `file` so far (caller frees)
+static char *read_back(FILE *file, size_t *size)
+{
+    fflush(file);
+    long end = ftell(file);
+    assert(end >= 0);
+    char *text = (char *)malloc((size_t)end + 1);
+    assert(text != NULL);
+    rewind(file);
+    assert(fread(text, 1, (size_t)end, file) == (size_t)end);
+    text[end] = '\0';
+    *size = (size_t)end;
+    return text;
+}
+
+// Clean test: Global keys, blank lines between sections and quoting follow the ini_save() layout
+void test_writer_layout()
+{
+    FILE *file = tmpfile();
+    assert(file != NULL);
+
+    ini_writer_t *writer = NULL;
+    assert(ini_writer_open_fd(fileno(file), &writer) == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "version", "3") == INI_STATUS_SUCCESS);
+    assert(ini_writer_section(writer, "server") == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "host", "example.org") == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "motd", "hello world") == INI_STATUS_SUCCESS);
+    assert(ini_writer_section(writer, "empty") == INI_STATUS_SUCCESS);
+    assert(ini_writer_section(writer, "paths") == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "tag", "#1") == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "blank", "") == INI_STATUS_SUCCESS);
+    assert(ini_writer_close(writer) == INI_STATUS_SUCCESS);
+
+    size_t size = 0;
+    char *text = read_back(file, &size);
+    assert(strcmp(text, "version=3\n"
+                        "\n"
+                        "[server]\n"
+                        "host=example.org\n"
+                        "motd=\"hello world\"\n"
+                        "\n"
+                        "[empty]\n"
+                        "\n"
+                        "[paths]\n"
+                        "tag=\"#1\"\n"
+                        "blank=\n") == 0);
+    free(text);
+    fclose(file);
+    print_success("test_writer_layout passed\n");
+}
+
+// Clean test: A file much larger than the buffer loads back key for key
+void test_writer_large_file_round_trip()
+{
+    enum
+    {
+        SECTIONS = 200,
+        KEYS = 500
+    };
+    char name[32];
+    char value[64];
+
+    ini_writer_t *writer = NULL;
+    assert(ini_writer_open_path(TEST_FILE, INI_DURABILITY_NONE, &writer) == INI_STATUS_SUCCESS);
+    for (int s = 0; s < SECTIONS; s++)
+    {
+        snprintf(name, sizeof(name), "section%d", s);
+        assert(ini_writer_section(writer, name) == INI_STATUS_SUCCESS);
+        for (int k = 0; k < KEYS; k++)
+        {
+            snprintf(name, sizeof(name), "key%d", k);
+            snprintf(value, sizeof(value), "value %d of %d", k, s);
+            assert(ini_writer_kv(writer, name, value) == INI_STATUS_SUCCESS);
+        }
+    }
+    assert(ini_writer_close(writer) == INI_STATUS_SUCCESS);
+
+    size_t size = 0;
+    assert(ini_get_file_size(TEST_FILE, &size) == INI_STATUS_SUCCESS);
+    assert(size > 2 * INI_WRITER_BUFFER_SIZE);
+
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    expect_value(ctx, "section0", "key0", "value 0 of 0");
+    expect_value(ctx, "section117", "key321", "value 321 of 117");
+    expect_value(ctx, "section199", "key499", "value 499 of 199");
+    ini_free(ctx);
+
+    remove(TEST_FILE);
+    print_success("test_writer_large_file_round_trip passed\n");
+}
+
+// Edge test: A value larger than the buffer is written through whole, in order with its neighbours
+void test_writer_value_larger_than_buffer()
+{
+    size_t length = INI_WRITER_BUFFER_SIZE + INI_WRITER_BUFFER_SIZE / 2;
+    char *value = (char *)malloc(length + 1);
+    assert(value != NULL);
+    memset(value, 'x', length);
+    value[length] = '\0';
+
+    FILE *file = tmpfile();
+    assert(file != NULL);
+    ini_writer_t *writer = NULL;
+    assert(ini_writer_open_fd(fileno(file), &writer) == INI_STATUS_SUCCESS);
+    assert(ini_writer_section(writer, "big") == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "data", value) == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "after", "1") == INI_STATUS_SUCCESS);
+    assert(ini_writer_close(writer) == INI_STATUS_SUCCESS);
+
+    size_t size = 0;
+    char *text = read_back(file, &size);
+    assert(size == strlen("[big]\ndata=") + length + strlen("\nafter=1\n"));
+    assert(strncmp(text, "[big]\ndata=xxx", 14) == 0);
+    assert(strcmp(text + size - strlen("x\nafter=1\n"), "x\nafter=1\n") == 0);
+    free(text);
+    fclose(file);
+    free(value);
+    print_success("test_writer_value_larger_than_buffer passed\n");
+}
+
+// Clean test: A path writer leaves the old file in place until it is closed
+void test_writer_replaces_on_close()
+{
+    FILE *file = fopen(TEST_FILE, "wb");
+    assert(file != NULL);
+    fputs("[old]\nkey=1\n", file);
+    fclose(file);
+
+    ini_writer_t *writer = NULL;
+    assert(ini_writer_open_path(TEST_FILE, INI_DURABILITY_FILE, &writer) == INI_STATUS_SUCCESS);
+    assert(ini_writer_section(writer, "new") == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "key", "2") == INI_STATUS_SUCCESS);
+    expect_file_text(TEST_FILE, "[old]\nkey=1\n");
+    assert(ini_writer_close(writer) == INI_STATUS_SUCCESS);
+    expect_file_text(TEST_FILE, "[new]\nkey=2\n");
+
+    remove(TEST_FILE);
+    print_success("test_writer_replaces_on_close passed\n");
+}
+
+// Dirty test: Text the parser would misread is rejected, and a failed write sticks
+void test_writer_invalid_arguments()
+{
+    ini_writer_t *writer = NULL;
+    assert(ini_writer_open_fd(-1, &writer) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_open_fd(1, NULL) == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_open_path(NULL, INI_DURABILITY_NONE, &writer) != INI_STATUS_SUCCESS);
+    assert(ini_writer_section(NULL, "s") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(NULL, "k", "v") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_close(NULL) == INI_STATUS_SUCCESS);
+
+    FILE *file = fopen(TEST_FILE, "wb");
+    assert(file != NULL);
+    fputs("[keep]\nkey=1\n", file);
+    fclose(file);
+
+    assert(ini_writer_open_path(TEST_FILE, INI_DURABILITY_NONE, &writer) == INI_STATUS_SUCCESS);
+    assert(ini_writer_section(writer, "s") == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "ok", "1") == INI_STATUS_SUCCESS);
+
+    // Rejected calls report the problem but do not poison the writer
+    assert(ini_writer_section(writer, "") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_section(writer, "a]b") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_section(writer, "two\nlines") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "", "v") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "a=b", "v") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "[k", "v") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, ";k", "v") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "k", "line\r\nbreak") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "k", NULL) == INI_STATUS_INVALID_ARGUMENT);
+
+    // Blanks around a name or key would be trimmed on the way back
+    assert(ini_writer_section(writer, " s ") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_section(writer, "\ts") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "key ", "v") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, " key", "v") == INI_STATUS_INVALID_ARGUMENT);
+
+    // A quote cannot be escaped: inside a quoted value or at the start it changes the value
+    assert(ini_writer_kv(writer, "q", "a\"b c") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "q", "\"x\"") == INI_STATUS_INVALID_ARGUMENT);
+    assert(ini_writer_kv(writer, "q", "a\"b") == INI_STATUS_SUCCESS);
+
+    assert(ini_writer_kv(writer, "k", "a=b") == INI_STATUS_SUCCESS);
+    assert(ini_writer_close(writer) == INI_STATUS_SUCCESS);
+    expect_file_text(TEST_FILE, "[s]\nok=1\nq=a\"b\nk=a=b\n");
+
+    // What was accepted reads back as it was written
+    ini_context_t *ctx = ini_create_context();
+    assert(ctx != NULL);
+    assert(ini_load(ctx, TEST_FILE) == INI_STATUS_SUCCESS);
+    expect_value(ctx, "s", "q", "a\"b");
+    expect_value(ctx, "s", "k", "a=b");
+
+    // ini_save() refuses the same values instead of writing a file that does not load
+    assert(ini_set_value(ctx, "s", "q", "a\"b c") == INI_STATUS_SUCCESS);
+    assert(ini_save(ctx, TEST_FILE) == INI_STATUS_INVALID_ARGUMENT);
+    expect_file_text(TEST_FILE, "[s]\nok=1\nq=a\"b\nk=a=b\n");
+    assert(ini_free(ctx) == INI_STATUS_SUCCESS);
+
+    // A failed write sticks: later calls return it and write nothing
+    FILE *input = fopen(TEST_FILE, "rb");
+    assert(input != NULL);
+    assert(ini_writer_open_fd(fileno(input), &writer) == INI_STATUS_SUCCESS);
+    assert(ini_writer_section(writer, "s") == INI_STATUS_SUCCESS);
+    ini_status_t err = ini_writer_close(writer);
+    assert(err != INI_STATUS_SUCCESS);
+    fclose(input);
+
+    char *value = (char *)malloc(INI_WRITER_BUFFER_SIZE + 1);
+    assert(value != NULL);
+    memset(value, 'v', INI_WRITER_BUFFER_SIZE);
+    value[INI_WRITER_BUFFER_SIZE] = '\0';
+    input = fopen(TEST_FILE, "rb");
+    assert(input != NULL);
+    assert(ini_writer_open_fd(fileno(input), &writer) == INI_STATUS_SUCCESS);
+    assert(ini_writer_kv(writer, "k", value) == err);
+    assert(ini_writer_section(writer, "s") == err);
+    assert(ini_writer_kv(writer, "k", "v") == err);
+    assert(ini_writer_close(writer) == err);
+    fclose(input);
+    free(value);
+
+    expect_file_text(TEST_FILE, "[s]\nok=1\nq=a\"b\nk=a=b\n");
+    remove(TEST_FILE);
+    print_success("test_writer_invalid_arguments passed\n");
+}
+
+int main()
+{
+    __helper_init_log_file();
+
+    test_writer_layout();
+    test_writer_large_file_round_trip();
+    test_writer_value_larger_than_buffer();
+    test_writer_replaces_on_close();
+    test_writer_invalid_arguments();
+
+    print_success("All ini_writer tests passed!\n\n");
+    __helper_close_log_file();
+    return EXIT_SUCCESS;
+}